@@ -1,10 +1,27 @@
 #include <memory>
 #include <string>
+#include <cstdlib>
 
 #include "Window.h"
 #include "Logger.h"
+#include "Profiler.h"
 
 int main(int argc, char *argv[]) {
+  /* --profile keeps the CPU profiler recording, --trace [frames] writes a trace of the first frames */
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--profile") {
+      Profiler::setEnabled(true);
+    } else if (arg == "--trace") {
+      unsigned int traceFrames = Profiler::DEFAULT_TRACE_FRAMES;
+      if (i + 1 < argc && std::atoi(argv[i + 1]) > 0) {
+        traceFrames = std::atoi(argv[++i]);
+      }
+      Profiler::requestTrace(traceFrames);
+    } else {
+      Logger::log(1, "%s: ignoring unknown argument '%s'\n", __FUNCTION__, arg.c_str());
+    }
+  }
 
   std::unique_ptr<Window> w = std::make_unique<Window>();
 
@@ -0,0 +1,67 @@
+#include <random>
+#include <benchmark/benchmark.h>
+
+#include "AssimpModel.h"
+
+namespace {
+  /* same table size as the AABB lookups baked by OGLRenderer */
+  const int lookupSize = 1023;
+  const unsigned int numClips = 8;
+  const float maxClipDuration = 2000.0f;
+
+  /* no file is loaded, the model only carries the synthetic lookup tables */
+  void createAnimatedModel(AssimpModel& model, unsigned int seed = 42) {
+    std::mt19937 randomEngine(seed);
+    std::uniform_real_distribution<float> extentDist(0.5f, 2.0f);
+
+    std::vector<std::vector<AABB>> aabbLookups(numClips);
+    for (auto& clipLookup : aabbLookups) {
+      for (int i = 0; i < lookupSize; ++i) {
+        AABB aabb;
+        aabb.create(glm::vec3(-extentDist(randomEngine), 0.0f, -extentDist(randomEngine)));
+        aabb.addPoint(glm::vec3(extentDist(randomEngine), 2.0f * extentDist(randomEngine), extentDist(randomEngine)));
+        clipLookup.emplace_back(aabb);
+      }
+    }
+
+    model.setAABBLookup(aabbLookups);
+    model.setMaxClipDuration(maxClipDuration);
+  }
+
+  /* two blended clips per instance, every second instance with swapped axes */
+  std::vector<InstanceSettings> createInstances(unsigned int count, unsigned int seed = 42) {
+    std::mt19937 randomEngine(seed);
+    std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+    std::uniform_int_distribution<unsigned int> clipDist(0, numClips - 1);
+
+    std::vector<InstanceSettings> instances(count);
+    for (unsigned int i = 0; i < count; ++i) {
+      InstanceSettings& settings = instances.at(i);
+      settings.isFirstAnimClipNr = clipDist(randomEngine);
+      settings.isSecondAnimClipNr = clipDist(randomEngine);
+      settings.isFirstClipAnimPlayTimePos = unitDist(randomEngine) * maxClipDuration;
+      settings.isSecondClipAnimPlayTimePos = unitDist(randomEngine) * maxClipDuration;
+      settings.isAnimBlendFactor = unitDist(randomEngine);
+      settings.isWorldRotation = glm::vec3(0.0f, unitDist(randomEngine) * 360.0f - 180.0f, 0.0f);
+      settings.isWorldPosition = glm::vec3(unitDist(randomEngine), 0.0f, unitDist(randomEngine)) * 100.0f;
+      settings.isSwapYZAxis = (i % 2) == 1;
+    }
+    return instances;
+  }
+}
+
+/* arg 0: number of instances, matches the per-frame AABB update of all animated instances */
+static void BM_AssimpModelGetAnimatedAABB(benchmark::State& state) {
+  AssimpModel model;
+  createAnimatedModel(model);
+  std::vector<InstanceSettings> instances = createInstances(state.range(0));
+
+  for (auto _ : state) {
+    for (const auto& settings : instances) {
+      AABB aabb = model.getAnimatedAABB(settings);
+      benchmark::DoNotOptimize(aabb);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * instances.size());
+}
+BENCHMARK(BM_AssimpModelGetAnimatedAABB)->Arg(100)->Arg(1000)->Arg(10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,98 @@
+#include <random>
+#include <assimp/scene.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+
+#include "BenchmarkData.h"
+#include "AABB.h"
+#include "Logger.h"
+
+std::string BenchmarkData::getSourcePath(std::string relativePath) {
+  return std::string(BENCHMARK_SOURCE_DIR) + "/" + relativePath;
+}
+
+const std::vector<MeshTriangle>& BenchmarkData::getLevelTriangles() {
+  static std::vector<MeshTriangle> levelTriangles{};
+  if (!levelTriangles.empty()) {
+    return levelTriangles;
+  }
+
+  std::string levelFileName = getSourcePath(LEVEL_FILE);
+  Assimp::Importer importer;
+  const aiScene* scene = importer.ReadFile(levelFileName,
+    aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_PreTransformVertices);
+  if (!scene || !scene->mRootNode) {
+    Logger::log(0, "%s error: could not load level '%s'\n", __FUNCTION__, levelFileName.c_str());
+    return levelTriangles;
+  }
+
+  int index = 0;
+  for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+    const aiMesh* mesh = scene->mMeshes[m];
+    for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+      const aiFace& face = mesh->mFaces[f];
+      if (face.mNumIndices != 3) {
+        continue;
+      }
+
+      MeshTriangle tri{};
+      for (int i = 0; i < 3; ++i) {
+        const aiVector3D& pos = mesh->mVertices[face.mIndices[i]];
+        tri.points.at(i) = glm::vec3(pos.x, pos.y, pos.z) * LEVEL_SCALE;
+      }
+
+      tri.edges.at(0) = tri.points.at(1) - tri.points.at(0);
+      tri.edges.at(1) = tri.points.at(2) - tri.points.at(1);
+      tri.edges.at(2) = tri.points.at(0) - tri.points.at(2);
+
+      tri.edgeLengths.at(0) = glm::length(tri.edges.at(0));
+      tri.edgeLengths.at(1) = glm::length(tri.edges.at(1));
+      tri.edgeLengths.at(2) = glm::length(tri.edges.at(2));
+
+      AABB triangleAABB;
+      triangleAABB.clear();
+      triangleAABB.addPoint(tri.points.at(0));
+      triangleAABB.addPoint(tri.points.at(1));
+      triangleAABB.addPoint(tri.points.at(2));
+      tri.boundingBox = BoundingBox3D(triangleAABB.getMinPos() - glm::vec3(0.0001f),
+                                      triangleAABB.getMaxPos() - triangleAABB.getMinPos() + glm::vec3(0.0002f));
+
+      const aiVector3D& normal = mesh->mNormals[face.mIndices[0]];
+      tri.normal = glm::normalize(glm::vec3(normal.x, normal.y, normal.z));
+
+      tri.index = index++;
+      levelTriangles.emplace_back(tri);
+    }
+  }
+
+  Logger::log(0, "%s: loaded %i level triangles from '%s'\n", __FUNCTION__, levelTriangles.size(), levelFileName.c_str());
+  return levelTriangles;
+}
+
+BoundingBox3D BenchmarkData::getLevelBoundingBox() {
+  AABB levelAABB;
+  levelAABB.clear();
+  for (const auto& tri : getLevelTriangles()) {
+    levelAABB.addPoint(tri.points.at(0));
+    levelAABB.addPoint(tri.points.at(1));
+    levelAABB.addPoint(tri.points.at(2));
+  }
+  return BoundingBox3D(levelAABB.getMinPos(), levelAABB.getMaxPos() - levelAABB.getMinPos());
+}
+
+std::vector<BoundingBox3D> BenchmarkData::createRandomBoxes(unsigned int count, BoundingBox3D worldBox,
+    glm::vec3 minSize, glm::vec3 maxSize, unsigned int seed) {
+  std::mt19937 randomEngine(seed);
+  std::uniform_real_distribution<float> unitDist(0.0f, 1.0f);
+
+  std::vector<BoundingBox3D> boxes{};
+  boxes.reserve(count);
+  for (unsigned int i = 0; i < count; ++i) {
+    glm::vec3 size = glm::mix(minSize, maxSize, glm::vec3(unitDist(randomEngine), unitDist(randomEngine), unitDist(randomEngine)));
+    glm::vec3 maxPos = glm::max(worldBox.getSize() - size, glm::vec3(0.0f));
+    glm::vec3 pos = worldBox.getFrontTopLeft() +
+      maxPos * glm::vec3(unitDist(randomEngine), unitDist(randomEngine), unitDist(randomEngine));
+    boxes.emplace_back(pos, size);
+  }
+  return boxes;
+}
@@ -0,0 +1,28 @@
+/* shared input data for the benchmarks, everything is deterministic and GPU-free */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "OGLRenderData.h"
+#include "BoundingBox3D.h"
+
+class BenchmarkData {
+  public:
+    /* resolves paths relative to the source tree, independent of the working directory */
+    static std::string getSourcePath(std::string relativePath);
+
+    /* same triangle data as OGLRenderer::generateLevelOctree(), loaded without creating GL objects */
+    static const std::vector<MeshTriangle>& getLevelTriangles();
+    static BoundingBox3D getLevelBoundingBox();
+
+    static std::vector<BoundingBox3D> createRandomBoxes(unsigned int count, BoundingBox3D worldBox, glm::vec3 minSize,
+      glm::vec3 maxSize, unsigned int seed = 42);
+
+    /* level settings of config/de_dust_nav.acfg */
+    static constexpr const char* LEVEL_FILE = "assets/level/de_dust.glb";
+    static constexpr float LEVEL_SCALE = 5.0f;
+    static constexpr float LEVEL_GROUND_SLOPE = 40.0f;
+    static constexpr float LEVEL_STAIRSTEP_HEIGHT = 2.0f;
+};
@@ -0,0 +1,22 @@
+#include <benchmark/benchmark.h>
+
+#include "Logger.h"
+#include "MemoryTracker.h"
+
+int main(int argc, char* argv[]) {
+  /* the engine classes log a lot on level 1, keep the benchmark output readable */
+  Logger::setLogLevel(0);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  /* peak bytes per tag of all benchmarks */
+  Logger::setLogLevel(1);
+  MemoryTracker::logReport();
+
+  return 0;
+}
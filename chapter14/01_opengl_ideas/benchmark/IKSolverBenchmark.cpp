@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "IKSolver.h"
+
+/* arg 0: chain length, arg 1: iterations; the feet IK uses three nodes (foot, knee, hip) */
+static void BM_IKSolverSolveFABRIK(benchmark::State& state) {
+  int chainLength = state.range(0);
+  IKSolver ikSolver(state.range(1));
+
+  /* effector at index 0, root at the end, one unit per bone */
+  std::vector<glm::mat4> nodeMatrices(chainLength);
+  for (int i = 0; i < chainLength; ++i) {
+    nodeMatrices.at(i) = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, static_cast<float>(i), 0.1f * i));
+  }
+
+  /* reachable targets around the effector, the solver never hits the close threshold early */
+  const std::vector<glm::vec3> targets = {
+    glm::vec3(0.3f, 0.2f, 0.0f), glm::vec3(-0.2f, 0.4f, 0.3f),
+    glm::vec3(0.0f, 0.5f, -0.4f), glm::vec3(0.4f, 0.1f, 0.2f)
+  };
+
+  size_t targetIndex = 0;
+  for (auto _ : state) {
+    std::vector<glm::vec3> positions = ikSolver.solveFARBIK(nodeMatrices, targets.at(targetIndex++ % targets.size()));
+    benchmark::DoNotOptimize(positions);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IKSolverSolveFABRIK)->Args({3, 10})->Args({3, 20})->Args({8, 10})->Args({16, 10});
@@ -0,0 +1,118 @@
+#include <memory>
+#include <benchmark/benchmark.h>
+
+#include "Octree.h"
+#include "TriangleOctree.h"
+#include "BenchmarkData.h"
+
+namespace {
+  /* world and instance sizes roughly match a populated de_dust level */
+  const BoundingBox3D worldBox = BoundingBox3D(glm::vec3(-500.0f, -20.0f, -500.0f), glm::vec3(1000.0f, 60.0f, 1000.0f));
+  const glm::vec3 minInstanceSize = glm::vec3(0.5f, 1.5f, 0.5f);
+  const glm::vec3 maxInstanceSize = glm::vec3(2.0f, 2.5f, 2.0f);
+
+  /* default values of OGLRenderData */
+  const int octreeThreshold = 10;
+  const int octreeMaxDepth = 5;
+
+  std::shared_ptr<Octree> createOctree(const std::vector<BoundingBox3D>& boxes) {
+    std::shared_ptr<Octree> octree = std::make_shared<Octree>(std::make_shared<BoundingBox3D>(worldBox),
+      octreeThreshold, octreeMaxDepth);
+    octree->mInstanceGetBoundingBoxCallbackFunction = [&boxes](int instanceId) {
+      return boxes.at(instanceId);
+    };
+    return octree;
+  }
+}
+
+static void BM_OctreeAdd(benchmark::State& state) {
+  std::vector<BoundingBox3D> boxes = BenchmarkData::createRandomBoxes(state.range(0), worldBox, minInstanceSize,
+    maxInstanceSize);
+  std::shared_ptr<Octree> octree = createOctree(boxes);
+
+  for (auto _ : state) {
+    octree->clear();
+    for (int i = 0; i < static_cast<int>(boxes.size()); ++i) {
+      octree->add(i);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(BM_OctreeAdd)->Arg(1000)->Arg(5000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+static void BM_OctreeFindAllIntersections(benchmark::State& state) {
+  std::vector<BoundingBox3D> boxes = BenchmarkData::createRandomBoxes(state.range(0), worldBox, minInstanceSize,
+    maxInstanceSize);
+  std::shared_ptr<Octree> octree = createOctree(boxes);
+  for (int i = 0; i < static_cast<int>(boxes.size()); ++i) {
+    octree->add(i);
+  }
+
+  size_t numIntersections = 0;
+  for (auto _ : state) {
+    std::set<std::pair<int, int>> intersections = octree->findAllIntersections();
+    numIntersections = intersections.size();
+    benchmark::DoNotOptimize(intersections);
+  }
+  state.counters["intersections"] = numIntersections;
+  state.SetItemsProcessed(state.iterations() * boxes.size());
+}
+BENCHMARK(BM_OctreeFindAllIntersections)->Arg(1000)->Arg(5000)->Arg(10000)->Arg(50000)->Unit(benchmark::kMicrosecond);
+
+static void BM_OctreeQuery(benchmark::State& state) {
+  std::vector<BoundingBox3D> boxes = BenchmarkData::createRandomBoxes(state.range(0), worldBox, minInstanceSize,
+    maxInstanceSize);
+  std::vector<BoundingBox3D> queryBoxes = BenchmarkData::createRandomBoxes(1024, worldBox, glm::vec3(5.0f),
+    glm::vec3(20.0f), 7);
+  std::shared_ptr<Octree> octree = createOctree(boxes);
+  for (int i = 0; i < static_cast<int>(boxes.size()); ++i) {
+    octree->add(i);
+  }
+
+  size_t queryIndex = 0;
+  for (auto _ : state) {
+    std::set<int> result = octree->query(queryBoxes.at(queryIndex++ % queryBoxes.size()));
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_OctreeQuery)->Arg(1000)->Arg(10000)->Arg(50000);
+
+static void BM_TriangleOctreeAdd(benchmark::State& state) {
+  const std::vector<MeshTriangle>& triangles = BenchmarkData::getLevelTriangles();
+  std::shared_ptr<BoundingBox3D> levelBox = std::make_shared<BoundingBox3D>(BenchmarkData::getLevelBoundingBox());
+
+  for (auto _ : state) {
+    TriangleOctree triangleOctree(levelBox, octreeThreshold, octreeMaxDepth);
+    for (const auto& tri : triangles) {
+      triangleOctree.add(tri);
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * triangles.size());
+}
+BENCHMARK(BM_TriangleOctreeAdd)->Unit(benchmark::kMillisecond);
+
+static void BM_TriangleOctreeQuery(benchmark::State& state) {
+  const std::vector<MeshTriangle>& triangles = BenchmarkData::getLevelTriangles();
+  BoundingBox3D levelBox = BenchmarkData::getLevelBoundingBox();
+  TriangleOctree triangleOctree(std::make_shared<BoundingBox3D>(levelBox), octreeThreshold, octreeMaxDepth);
+  for (const auto& tri : triangles) {
+    triangleOctree.add(tri);
+  }
+
+  /* instance sized boxes, the same query the level collision does per instance and frame */
+  std::vector<BoundingBox3D> queryBoxes = BenchmarkData::createRandomBoxes(1024, levelBox, minInstanceSize,
+    maxInstanceSize);
+
+  size_t queryIndex = 0;
+  size_t numTriangles = 0;
+  for (auto _ : state) {
+    std::vector<MeshTriangle> result = triangleOctree.query(queryBoxes.at(queryIndex++ % queryBoxes.size()));
+    numTriangles += result.size();
+    benchmark::DoNotOptimize(result);
+  }
+  state.counters["trianglesPerQuery"] = benchmark::Counter(numTriangles, benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TriangleOctreeQuery);
@@ -0,0 +1,112 @@
+#include <cmath>
+#include <random>
+#include <memory>
+#include <benchmark/benchmark.h>
+#include <algorithm>
+
+#include "PathFinder.h"
+#include "TriangleOctree.h"
+#include "Tools.h"
+#include "BenchmarkData.h"
+
+namespace {
+  const int levelOctreeThreshold = 10;
+  const int levelOctreeMaxDepth = 5;
+
+  std::shared_ptr<TriangleOctree> createLevelOctree() {
+    std::shared_ptr<TriangleOctree> triangleOctree = std::make_shared<TriangleOctree>(
+      std::make_shared<BoundingBox3D>(BenchmarkData::getLevelBoundingBox()), levelOctreeThreshold, levelOctreeMaxDepth);
+    for (const auto& tri : BenchmarkData::getLevelTriangles()) {
+      triangleOctree->add(tri);
+    }
+    return triangleOctree;
+  }
+
+  OGLRenderData createRenderData() {
+    OGLRenderData renderData{};
+    renderData.rdMaxLevelGroundSlopeAngle = BenchmarkData::LEVEL_GROUND_SLOPE;
+    renderData.rdMaxStairstepHeight = BenchmarkData::LEVEL_STAIRSTEP_HEIGHT;
+    return renderData;
+  }
+}
+
+static void BM_PathFinderGenerateGroundTriangles(benchmark::State& state) {
+  std::shared_ptr<TriangleOctree> triangleOctree = createLevelOctree();
+  OGLRenderData renderData = createRenderData();
+  BoundingBox3D levelBox = BenchmarkData::getLevelBoundingBox();
+
+  for (auto _ : state) {
+    PathFinder pathFinder;
+    pathFinder.generateGroundTriangles(renderData, triangleOctree, levelBox);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * BenchmarkData::getLevelTriangles().size());
+}
+BENCHMARK(BM_PathFinderGenerateGroundTriangles)->Unit(benchmark::kMillisecond);
+
+static void BM_PathFinderFindPath(benchmark::State& state) {
+  std::shared_ptr<TriangleOctree> triangleOctree = createLevelOctree();
+  OGLRenderData renderData = createRenderData();
+  PathFinder pathFinder;
+  pathFinder.generateGroundTriangles(renderData, triangleOctree, BenchmarkData::getLevelBoundingBox());
+
+  /* same ground criterion as generateGroundTriangles() */
+  std::vector<int> groundTriangles{};
+  float minGroundDot = std::cos(glm::radians(renderData.rdMaxLevelGroundSlopeAngle));
+  for (const auto& tri : BenchmarkData::getLevelTriangles()) {
+    if (glm::dot(tri.normal, glm::vec3(0.0f, 1.0f, 0.0f)) >= minGroundDot) {
+      groundTriangles.emplace_back(tri.index);
+    }
+  }
+  if (groundTriangles.empty()) {
+    state.SkipWithError("no ground triangles found");
+    return;
+  }
+
+  std::mt19937 randomEngine(42);
+  std::uniform_int_distribution<size_t> triangleDist(0, groundTriangles.size() - 1);
+  std::vector<std::pair<int, int>> pathRequests(256);
+  for (auto& request : pathRequests) {
+    request = { groundTriangles.at(triangleDist(randomEngine)), groundTriangles.at(triangleDist(randomEngine)) };
+  }
+
+  size_t requestIndex = 0;
+  size_t pathLength = 0;
+  for (auto _ : state) {
+    const auto& request = pathRequests.at(requestIndex++ % pathRequests.size());
+    std::vector<int> path = pathFinder.findPath(request.first, request.second);
+    pathLength += path.size();
+    benchmark::DoNotOptimize(path);
+  }
+  state.counters["pathLength"] = benchmark::Counter(pathLength, benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PathFinderFindPath)->Unit(benchmark::kMicrosecond);
+
+static void BM_ToolsRayTriangleIntersection(benchmark::State& state) {
+  const std::vector<MeshTriangle>& triangles = BenchmarkData::getLevelTriangles();
+
+  /* downward rays like the ground check, about half of them hit */
+  std::mt19937 randomEngine(42);
+  std::uniform_real_distribution<float> offsetDist(-1.0f, 1.0f);
+  std::vector<glm::vec3> rayOrigins(triangles.size());
+  for (size_t i = 0; i < triangles.size(); ++i) {
+    const MeshTriangle& tri = triangles.at(i);
+    glm::vec3 center = (tri.points.at(0) + tri.points.at(1) + tri.points.at(2)) / 3.0f;
+    rayOrigins.at(i) = center + glm::vec3(offsetDist(randomEngine), 10.0f, offsetDist(randomEngine)) *
+      std::max(tri.edgeLengths.at(0), 0.01f);
+  }
+  const glm::vec3 rayDirection = glm::vec3(0.0f, -1.0f, 0.0f);
+
+  size_t numHits = 0;
+  for (auto _ : state) {
+    for (size_t i = 0; i < triangles.size(); ++i) {
+      std::optional<glm::vec3> hit = Tools::rayTriangleIntersection(rayOrigins.at(i), rayDirection, triangles.at(i));
+      numHits += hit.has_value() ? 1 : 0;
+      benchmark::DoNotOptimize(hit);
+    }
+  }
+  state.counters["hitRate"] = static_cast<double>(numHits) / (state.iterations() * triangles.size());
+  state.SetItemsProcessed(state.iterations() * triangles.size());
+}
+BENCHMARK(BM_ToolsRayTriangleIntersection)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,65 @@
+#include <filesystem>
+#include <memory>
+#include <benchmark/benchmark.h>
+
+#include "YamlParser.h"
+#include "Camera.h"
+#include "BenchmarkData.h"
+
+namespace {
+  const std::vector<std::string> configFiles = { "config/conf.acfg", "config/de_dust_nav.acfg" };
+}
+
+/* the same getters as OGLRenderer::loadConfigFile(), without creating the models */
+static void BM_YamlParserLoad(benchmark::State& state) {
+  std::string configFileName = BenchmarkData::getSourcePath(configFiles.at(state.range(0)));
+  state.SetLabel(configFiles.at(state.range(0)));
+
+  for (auto _ : state) {
+    YamlParser parser;
+    if (!parser.loadYamlFile(configFileName)) {
+      state.SkipWithError("could not load config file");
+      break;
+    }
+    benchmark::DoNotOptimize(parser.getFileVersion());
+    benchmark::DoNotOptimize(parser.getModelConfigs());
+    benchmark::DoNotOptimize(parser.getInstanceConfigs());
+    benchmark::DoNotOptimize(parser.getCameraConfigs());
+    benchmark::DoNotOptimize(parser.getBehaviorData());
+    benchmark::DoNotOptimize(parser.getLevelConfigs());
+  }
+}
+BENCHMARK(BM_YamlParserLoad)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
+
+/* models, instances and levels need GL objects, only settings and cameras are written */
+static void BM_YamlParserSave(benchmark::State& state) {
+  std::string configFileName = BenchmarkData::getSourcePath(configFiles.at(state.range(0)));
+  state.SetLabel(configFiles.at(state.range(0)));
+
+  YamlParser loadParser;
+  if (!loadParser.loadYamlFile(configFileName)) {
+    state.SkipWithError("could not load config file");
+    return;
+  }
+  loadParser.getFileVersion();
+
+  OGLRenderData renderData{};
+  ModelInstanceCamData modInstCamData{};
+  for (const auto& camSettings : loadParser.getCameraConfigs()) {
+    std::shared_ptr<Camera> camera = std::make_shared<Camera>();
+    camera->setCameraSettings(camSettings);
+    modInstCamData.micCameras.emplace_back(camera);
+  }
+
+  std::string outputFileName = (std::filesystem::temp_directory_path() / "benchmark_config.acfg").string();
+  for (auto _ : state) {
+    YamlParser saveParser;
+    saveParser.createConfigFile(renderData, modInstCamData);
+    if (!saveParser.writeYamlFile(outputFileName)) {
+      state.SkipWithError("could not write config file");
+      break;
+    }
+  }
+  std::filesystem::remove(outputFileName);
+}
+BENCHMARK(BM_YamlParserSave)->DenseRange(0, 1)->Unit(benchmark::kMicrosecond);
@@ -589,8 +589,9 @@ void AssimpInstance::setInstanceOnGround(bool value) {
   mInstanceSettings.isInstanceOnGround = value;
 }
 
-void AssimpInstance::setCollidingTriangles(std::vector<MeshTriangle>& collidingTriangles) {
-  mInstanceSettings.isCollidingTriangles = collidingTriangles;
+void AssimpInstance::setCollidingTriangles(const std::pmr::vector<MeshTriangle>& collidingTriangles) {
+  /* keeps the capacity of the previous frame */
+  mInstanceSettings.isCollidingTriangles.assign(collidingTriangles.begin(), collidingTriangles.end());
 }
 
 void AssimpInstance::setCurrentGroundTriangleIndex(int index) {
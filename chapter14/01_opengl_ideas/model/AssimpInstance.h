@@ -3,6 +3,7 @@
 #include <string>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <glm/glm.hpp>
 
@@ -67,7 +68,7 @@ class AssimpInstance {
     void setHeadAnim(glm::vec2 leftRightUpDownValues);
     void applyGravity(float deltaTime);
     void setInstanceOnGround(bool value);
-    void setCollidingTriangles(std::vector<MeshTriangle>& collidingTriangles);
+    void setCollidingTriangles(const std::pmr::vector<MeshTriangle>& collidingTriangles);
 
     void setCurrentGroundTriangleIndex(int index);
     int getCurrentGroundTriangleIndex();
@@ -6,8 +6,12 @@
 #include "AssimpMesh.h"
 #include "Tools.h"
 #include "Logger.h"
+#include "TextureManager.h"
+#include "MaterialResolver.h"
+#include "MemoryTracker.h"
 
-bool AssimpLevel::loadLevel(std::string levelFilename, unsigned int extraImportFlags) {
+bool AssimpLevel::loadLevel(std::string levelFilename, ThreadPool& decodePool, unsigned int extraImportFlags) {
+  MEMORY_TAG_SCOPE(memoryTag::levelGeometry);
   Logger::log(1, "%s: loading level from file '%s'\n", __FUNCTION__, levelFilename.c_str());
 
   Assimp::Importer importer;
@@ -34,6 +38,7 @@ bool AssimpLevel::loadLevel(std::string levelFilename, unsigned int extraImportF
 
   aiNode* rootNode = scene->mRootNode;
 
+  /* the textures are decoded in parallel, only the final upload happens on this thread */
   if (scene->HasTextures()) {
     unsigned int numTextures = scene->mNumTextures;
 
@@ -44,8 +49,9 @@ bool AssimpLevel::loadLevel(std::string levelFilename, unsigned int extraImportF
       int width = scene->mTextures[i]->mWidth;
       aiTexel* data = scene->mTextures[i]->pcData;
 
-      std::shared_ptr<Texture> newTex = std::make_shared<Texture>();
-      if (!newTex->loadTexture(texName, data, width, height)) {
+      std::shared_ptr<Texture> newTex = TextureManager::getTexture(decodePool, texName, data, width, height);
+      if (!newTex) {
+        releaseTextures();
         return false;
       }
 
@@ -58,12 +64,8 @@ bool AssimpLevel::loadLevel(std::string levelFilename, unsigned int extraImportF
   }
 
   /* add a placeholder texture in case there is no diffuse tex */
-  mPlaceholderTexture = std::make_shared<Texture>();
   std::string placeholderTexName = "textures/missing_tex.png";
-  if (!mPlaceholderTexture->loadTexture(placeholderTexName)) {
-    Logger::log(1, "%s error: could not load placeholder texture '%s'\n", __FUNCTION__, placeholderTexName.c_str());
-    return false;
-  }
+  mPlaceholderTexture = TextureManager::getTexture(decodePool, placeholderTexName);
 
   /* the textures are stored directly or relative to the level file */
   std::string assetDirectory = levelFilename.substr(0, levelFilename.find_last_of('/'));
@@ -76,10 +78,35 @@ bool AssimpLevel::loadLevel(std::string levelFilename, unsigned int extraImportF
   Logger::log(2, "%s: root node name: '%s'\n", __FUNCTION__, rootNodeName.c_str());
 
   /* process all nodes in the level file */
-  processNode(mRootNode, rootNode, scene, assetDirectory);
+  processNode(mRootNode, rootNode, scene, assetDirectory, decodePool);
 
   Logger::log(1, "%s: ... processing nodes finished...\n", __FUNCTION__);
 
+  /* wait for the decoding jobs and upload the images */
+  if (!mPlaceholderTexture->finishLoading()) {
+    Logger::log(1, "%s error: could not load placeholder texture '%s'\n", __FUNCTION__, placeholderTexName.c_str());
+    releaseTextures();
+    return false;
+  }
+
+  for (auto iter = mTextures.begin(); iter != mTextures.end();) {
+    if (iter->second->finishLoading()) {
+      ++iter;
+      continue;
+    }
+
+    /* embedded textures are mandatory, missing texture files are replaced by the placeholder */
+    TextureManager::releaseTexture(iter->second);
+    if (iter->first.find("*") == 0) {
+      Logger::log(1, "%s error: could not load embedded texture '%s'\n", __FUNCTION__, iter->first.c_str());
+      mTextures.erase(iter);
+      releaseTextures();
+      return false;
+    }
+    Logger::log(1, "%s error: could not load texture file '%s', skipping\n", __FUNCTION__, iter->first.c_str());
+    iter = mTextures.erase(iter);
+  }
+
   for (const auto& entry : mNodeList) {
     std::vector<std::shared_ptr<AssimpNode>> childNodes = entry->getChilds();
 
@@ -91,9 +118,14 @@ bool AssimpLevel::loadLevel(std::string levelFilename, unsigned int extraImportF
     }
   }
 
+  mMaterialBuffer.setMemoryTag(memoryTag::materials);
+  mUseBindlessTextures = MaterialResolver::resolveMaterials(mLevelMeshes, mTextures, mPlaceholderTexture,
+    mMaterialTextures, mMeshMaterialIds, mMaterialBuffer);
+
   /* create vertex buffers for the meshes */
   for (const auto& mesh : mLevelMeshes) {
     VertexIndexBuffer buffer;
+    buffer.setMemoryTag(memoryTag::levelGeometry);
     buffer.init();
     buffer.uploadData(mesh.vertices, mesh.indices);
     mVertexBuffers.emplace_back(buffer);
@@ -115,7 +147,8 @@ bool AssimpLevel::loadLevel(std::string levelFilename, unsigned int extraImportF
   return true;
 }
 
-void AssimpLevel::processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory) {
+void AssimpLevel::processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory,
+    ThreadPool& decodePool) {
   std::string nodeName = aNode->mName.C_Str();
   Logger::log(1, "%s: node name: '%s'\n", __FUNCTION__, nodeName.c_str());
 
@@ -126,7 +159,7 @@ void AssimpLevel::processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, c
       aiMesh* modelMesh = scene->mMeshes[aNode->mMeshes[i]];
 
       AssimpMesh mesh;
-      mesh.processMesh(modelMesh, scene, assetDirectory, mTextures);
+      mesh.processMesh(modelMesh, scene, assetDirectory, mTextures, decodePool);
       OGLMesh vertexMesh = mesh.getMesh();
 
       mLevelMeshes.emplace_back(vertexMesh);
@@ -143,38 +176,30 @@ void AssimpLevel::processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, c
     Logger::log(1, "%s: --- found child node '%s'\n", __FUNCTION__, childName.c_str());
 
     std::shared_ptr<AssimpNode> childNode = node->addChild(childName);
-    processNode(childNode, aNode->mChildren[i], scene, assetDirectory);
+    processNode(childNode, aNode->mChildren[i], scene, assetDirectory, decodePool);
   }
 }
 
-void AssimpLevel::draw() {
+void AssimpLevel::submit(RenderQueue& renderQueue, RenderCommand baseCommand) {
   for (unsigned int i = 0; i < mLevelMeshes.size(); ++i) {
-    OGLMesh& mesh = mLevelMeshes.at(i);
-    // find diffuse texture by name
-
-    std::shared_ptr<Texture> diffuseTex = nullptr;
-    auto diffuseTexName = mesh.textures.find(aiTextureType_DIFFUSE);
-    if (diffuseTexName != mesh.textures.end()) {
-      auto diffuseTexture = mTextures.find(diffuseTexName->second);
-      if (diffuseTexture != mTextures.end()) {
-        diffuseTex = diffuseTexture->second;
-      }
-    }
-
-    glActiveTexture(GL_TEXTURE0);
-    if (diffuseTex) {
-      diffuseTex->bind();
+    unsigned int materialId = mMeshMaterialIds.at(i);
+
+    RenderCommand command = baseCommand;
+    command.rcVertexArray = mVertexBuffers.at(i).getVertexArray();
+    command.rcIndexCount = mLevelMeshes.at(i).indices.size();
+
+    if (mUseBindlessTextures) {
+      command.rcStorageBuffers.at(0).rsbBuffer = mMaterialBuffer.getBufferId();
+      command.rcStorageBuffers.at(0).rsbBinding = MATERIAL_BINDING_POINT;
+      command.rcUniforms.at(1).ruLocation = MATERIAL_ID_LOCATION;
+      command.rcUniforms.at(1).ruValue = materialId;
+      command.rcSortKey = RenderQueue::setSortKeyMaterial(command.rcSortKey, materialId);
     } else {
-      mPlaceholderTexture->bind();
+      command.rcTexture = mMaterialTextures.at(materialId)->getTextureId();
+      command.rcSortKey = RenderQueue::setSortKeyMaterial(command.rcSortKey, command.rcTexture);
     }
 
-    mVertexBuffers.at(i).bindAndDrawIndirect(GL_TRIANGLES, mesh.indices.size());
-
-    if (diffuseTex) {
-      diffuseTex->unbind();
-    } else {
-      mPlaceholderTexture->unbind();
-    }
+    renderQueue.submit(command);
   }
 }
 
@@ -209,13 +234,25 @@ void AssimpLevel::cleanup(){
     buffer.cleanup();
   }
 
+  releaseTextures();
+
+  mMaterialTextures.clear();
+  mMaterialBuffer.cleanup();
+}
+
+void AssimpLevel::releaseTextures() {
+  /* textures may be shared with other models and levels */
   for (auto& tex : mTextures) {
-    tex.second->cleanup();
+    tex.second->waitForDecoding();
+    TextureManager::releaseTexture(tex.second);
   }
+  mTextures.clear();
 
   /* empty for null level */
   if (mPlaceholderTexture) {
-    mPlaceholderTexture->cleanup();
+    mPlaceholderTexture->waitForDecoding();
+    TextureManager::releaseTexture(mPlaceholderTexture);
+    mPlaceholderTexture = nullptr;
   }
 }
 
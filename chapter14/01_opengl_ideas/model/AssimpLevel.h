@@ -14,16 +14,21 @@
 
 #include "OGLRenderData.h"
 #include "Texture.h"
+#include "ThreadPool.h"
 #include "VertexIndexBuffer.h"
+#include "ShaderStorageBuffer.h"
+#include "RenderQueue.h"
 #include "AssimpNode.h"
 #include "LevelSettings.h"
 #include "AABB.h"
 
 class AssimpLevel {
   public:
-    bool loadLevel(std::string levelFilename, unsigned int extraImportFlags = 0);
+    /* the textures are decoded on decodePool, all jobs of this asset are finished on return */
+    bool loadLevel(std::string levelFilename, ThreadPool& decodePool, unsigned int extraImportFlags = 0);
 
-    void draw();
+    /* program and sort key are set by the caller, the level adds mesh and material */
+    void submit(RenderQueue& renderQueue, RenderCommand baseCommand);
     unsigned int getTriangleCount();
 
     void updateLevelRootMatrix();
@@ -44,7 +49,10 @@ class AssimpLevel {
     void cleanup();
 
   private:
-    void processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory);
+    void processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory,
+      ThreadPool& decodePool);
+    /* returns all texture references, also used by the error paths of loading */
+    void releaseTextures();
 
     unsigned int mTriangleCount = 0;
     unsigned int mVertexCount = 0;
@@ -73,5 +81,14 @@ class AssimpLevel {
     std::unordered_map<std::string, std::shared_ptr<Texture>> mTextures{};
     std::shared_ptr<Texture> mPlaceholderTexture = nullptr;
 
+    /* materials are resolved once at load time, no string lookups while drawing */
+    const int MATERIAL_BINDING_POINT = 6;
+    /* uniform location of the material id in the fragment shader, bindless only */
+    const int MATERIAL_ID_LOCATION = 1;
+    std::vector<std::shared_ptr<Texture>> mMaterialTextures{};
+    std::vector<unsigned int> mMeshMaterialIds{};
+    ShaderStorageBuffer mMaterialBuffer{};
+    bool mUseBindlessTextures = false;
+
     AABB mLevelAABB{};
 };
@@ -2,9 +2,11 @@
 
 #include "Logger.h"
 #include "Tools.h"
+#include "MeshOptimizer.h"
+#include "TextureManager.h"
 
 bool AssimpMesh::processMesh(aiMesh* mesh, const aiScene* scene, std::string assetDirectory,
-    std::unordered_map<std::string, std::shared_ptr<Texture>>& textures) {
+    std::unordered_map<std::string, std::shared_ptr<Texture>>& textures, ThreadPool& decodePool) {
   mMeshName = mesh->mName.C_Str();
 
   mTriangleCount = mesh->mNumFaces;
@@ -94,12 +96,9 @@ bool AssimpMesh::processMesh(aiMesh* mesh, const aiScene* scene, std::string ass
 
             // do not try to load internal textures
             if (!texName.empty() && texName.find("*") != 0) {
-              std::shared_ptr<Texture> newTex = std::make_shared<Texture>();
+              /* only decoding is started here, the model finishes the texture after all meshes are done */
               std::string texNameWithPath = assetDirectory + '/' + texName;
-              if (!newTex->loadTexture(texNameWithPath)) {
-                Logger::log(1, "%s error: could not load texture file '%s', skipping\n", __FUNCTION__, texNameWithPath.c_str());
-                continue;
-              }
+              std::shared_ptr<Texture> newTex = TextureManager::getTexture(decodePool, texNameWithPath);
 
               textures.insert({texName, newTex});
             }
@@ -187,9 +186,44 @@ bool AssimpMesh::processMesh(aiMesh* mesh, const aiScene* scene, std::string ass
     }
   }
 
+  optimizeMesh();
+
   return true;
 }
 
+void AssimpMesh::optimizeMesh() {
+  if (mMesh.indices.empty()) {
+    return;
+  }
+
+  Timer optimizeTimer{};
+  optimizeTimer.start();
+
+  VertexCacheStats oldStats = MeshOptimizer::analyzeVertexCache(mMesh.indices, mVertexCount);
+
+  /* triangle order first, the vertex fetch remap must see the final index order */
+  MeshOptimizer::optimizeVertexCache(mMesh.indices, mVertexCount);
+
+  std::vector<glm::vec3> positions{};
+  positions.reserve(mMesh.vertices.size());
+  for (const auto& vertex : mMesh.vertices) {
+    positions.emplace_back(glm::vec3(vertex.position));
+  }
+  MeshOptimizer::optimizeOverdraw(mMesh.indices, positions);
+
+  std::vector<uint32_t> remap = MeshOptimizer::optimizeVertexFetchRemap(mMesh.indices, mVertexCount);
+  MeshOptimizer::remapVertexBuffer(mMesh.vertices, remap);
+  /* morph vertices are matched by index, move them too */
+  for (auto& morphMesh : mMesh.morphMeshes) {
+    MeshOptimizer::remapVertexBuffer(morphMesh.morphVertices, remap);
+  }
+
+  VertexCacheStats newStats = MeshOptimizer::analyzeVertexCache(mMesh.indices, mVertexCount);
+
+  Logger::log(1, "%s: -- mesh '%s' optimized in %4.2f ms, ACMR %4.3f => %4.3f, ATVR %4.3f => %4.3f\n", __FUNCTION__,
+    mMeshName.c_str(), optimizeTimer.stop(), oldStats.acmr, newStats.acmr, oldStats.atvr, newStats.atvr);
+}
+
 std::vector<uint32_t> AssimpMesh::getIndices() {
   return mMesh.indices;
 }
@@ -9,11 +9,13 @@
 #include "OGLRenderData.h"
 #include "Texture.h"
 #include "AssimpBone.h"
+#include "Timer.h"
+#include "ThreadPool.h"
 
 class AssimpMesh {
   public:
     bool processMesh(aiMesh* mesh, const aiScene* scene, std::string assetDirectory,
-      std::unordered_map<std::string, std::shared_ptr<Texture>>& textures);
+      std::unordered_map<std::string, std::shared_ptr<Texture>>& textures, ThreadPool& decodePool);
 
     std::string getMeshName();
     unsigned int getTriangleCount();
@@ -24,6 +26,9 @@ class AssimpMesh {
     std::vector<std::shared_ptr<AssimpBone>> getBoneList();
 
   private:
+    /* reorders indices and vertices for better GPU cache usage */
+    void optimizeMesh();
+
     std::string mMeshName;
     unsigned int mTriangleCount = 0;
     unsigned int mVertexCount = 0;
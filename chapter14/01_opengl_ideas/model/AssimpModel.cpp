@@ -15,8 +15,12 @@
 #include "AssimpModel.h"
 #include "Tools.h"
 #include "Logger.h"
+#include "TextureManager.h"
+#include "MaterialResolver.h"
+#include "MemoryTracker.h"
 
-bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportFlags) {
+bool AssimpModel::loadModel(std::string modelFilename, ThreadPool& decodePool, unsigned int extraImportFlags) {
+  MEMORY_TAG_SCOPE(memoryTag::modelGeometry);
   Logger::log(1, "%s: loading model from file '%s'\n", __FUNCTION__, modelFilename.c_str());
 
   Assimp::Importer importer;
@@ -43,6 +47,7 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
 
   aiNode* rootNode = scene->mRootNode;
 
+  /* the textures are decoded in parallel, only the final upload happens on this thread */
   if (scene->HasTextures()) {
     unsigned int numTextures = scene->mNumTextures;
 
@@ -53,8 +58,9 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
       int width = scene->mTextures[i]->mWidth;
       aiTexel* data = scene->mTextures[i]->pcData;
 
-      std::shared_ptr<Texture> newTex = std::make_shared<Texture>();
-      if (!newTex->loadTexture(texName, data, width, height)) {
+      std::shared_ptr<Texture> newTex = TextureManager::getTexture(decodePool, texName, data, width, height);
+      if (!newTex) {
+        releaseTextures();
         return false;
       }
 
@@ -67,12 +73,8 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
   }
 
   /* add a placeholder texture in case there is no diffuse tex */
-  mPlaceholderTexture = std::make_shared<Texture>();
   std::string placeholderTexName = "textures/missing_tex.png";
-  if (!mPlaceholderTexture->loadTexture(placeholderTexName)) {
-    Logger::log(1, "%s error: could not load placeholder texture '%s'\n", __FUNCTION__, placeholderTexName.c_str());
-    return false;
-  }
+  mPlaceholderTexture = TextureManager::getTexture(decodePool, placeholderTexName);
 
   /* the textures are stored directly or relative to the model file */
   std::string assetDirectory = modelFilename.substr(0, modelFilename.find_last_of('/'));
@@ -84,10 +86,35 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
   mRootNode = AssimpNode::createNode(rootNodeName);
   Logger::log(2, "%s: root node name: '%s'\n", __FUNCTION__, rootNodeName.c_str());
 
-  processNode(mRootNode, rootNode, scene, assetDirectory);
+  processNode(mRootNode, rootNode, scene, assetDirectory, decodePool);
 
   Logger::log(1, "%s: ... processing nodes finished...\n", __FUNCTION__);
 
+  /* wait for the decoding jobs and upload the images */
+  if (!mPlaceholderTexture->finishLoading()) {
+    Logger::log(1, "%s error: could not load placeholder texture '%s'\n", __FUNCTION__, placeholderTexName.c_str());
+    releaseTextures();
+    return false;
+  }
+
+  for (auto iter = mTextures.begin(); iter != mTextures.end();) {
+    if (iter->second->finishLoading()) {
+      ++iter;
+      continue;
+    }
+
+    /* embedded textures are mandatory, missing texture files are replaced by the placeholder */
+    TextureManager::releaseTexture(iter->second);
+    if (iter->first.find("*") == 0) {
+      Logger::log(1, "%s error: could not load embedded texture '%s'\n", __FUNCTION__, iter->first.c_str());
+      mTextures.erase(iter);
+      releaseTextures();
+      return false;
+    }
+    Logger::log(1, "%s error: could not load texture file '%s', skipping\n", __FUNCTION__, iter->first.c_str());
+    iter = mTextures.erase(iter);
+  }
+
   for (const auto& entry : mNodeList) {
     std::vector<std::shared_ptr<AssimpNode>> childNodes = entry->getChilds();
 
@@ -120,6 +147,17 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
   Logger::log(1, "%s: -- bone parents --\n", __FUNCTION__);
 
 
+  mShaderBoneParentBuffer.setMemoryTag(memoryTag::animationLookup);
+  mShaderBoneMatrixOffsetBuffer.setMemoryTag(memoryTag::animationLookup);
+  mShaderInverseBoneMatrixOffsetBuffer.setMemoryTag(memoryTag::animationLookup);
+  mAnimLookupBuffer.setMemoryTag(memoryTag::animationLookup);
+  mAnimMeshVerticesBuffer.setMemoryTag(memoryTag::morphAnimation);
+  mPreSkinningVertexBuffer.setMemoryTag(memoryTag::modelGeometry);
+  mMaterialBuffer.setMemoryTag(memoryTag::materials);
+
+  mUseBindlessTextures = MaterialResolver::resolveMaterials(mModelMeshes, mTextures, mPlaceholderTexture,
+    mMaterialTextures, mMeshMaterialIds, mMaterialBuffer);
+
   /* create vertex buffers for the meshes */
   for (const auto& mesh : mModelMeshes) {
     VertexIndexBuffer buffer;
@@ -133,6 +171,7 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
     if (mesh.morphMeshes.empty()) {
       continue;
     }
+    MEMORY_TAG_SCOPE(memoryTag::morphAnimation);
     OGLMorphMesh animMesh;
     animMesh.morphVertices.resize(mesh.vertices.size() * mNumAnimatedMeshes);
 
@@ -147,6 +186,22 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
     Logger::log(1, "%s: model has %i morphs, SSBO has %i vertices\n", __FUNCTION__, mNumAnimatedMeshes, mAnimatedMeshVertexSize);
   }
 
+  /* all vertices of skinned meshes without morph anims in one SSBO, input for the pre-skinning compute shader */
+  if (!mBoneList.empty()) {
+    std::vector<OGLVertex> preSkinningVertices{};
+    for (const auto& mesh : mModelMeshes) {
+      mPreSkinningMeshOffsets.emplace_back(preSkinningVertices.size());
+      if (!mesh.morphMeshes.empty()) {
+        continue;
+      }
+      preSkinningVertices.insert(preSkinningVertices.end(), mesh.vertices.begin(), mesh.vertices.end());
+    }
+    mPreSkinningVertexCount = preSkinningVertices.size();
+
+    mPreSkinningVertexBuffer.uploadSsboData(preSkinningVertices);
+    Logger::log(1, "%s: pre-skinning SSBO has %i vertices\n", __FUNCTION__, mPreSkinningVertexCount);
+  }
+
   mShaderBoneMatrixOffsetBuffer.uploadSsboData(mBoneOffsetMatricesList);
   mShaderInverseBoneMatrixOffsetBuffer.uploadSsboData(mInverseBoneOffsetMatricesList);
   mShaderBoneParentBuffer.uploadSsboData(mBoneParentIndexList);
@@ -160,6 +215,7 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
   Logger::log(1, "%s: longest clip duration is %f\n", __FUNCTION__, mMaxClipDuration);
 
   for (unsigned int i = 0; i < numAnims; ++i) {
+    MEMORY_TAG_SCOPE(memoryTag::animationLookup);
     aiAnimation* animation = scene->mAnimations[i];
 
     Logger::log(1, "%s: -- animation clip %i has %i skeletal channels, %i mesh channels, and %i morph mesh channels\n",
@@ -201,6 +257,7 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
   }
 
   if (!mAnimClips.empty()) {
+    MEMORY_TAG_SCOPE(memoryTag::animationLookup);
     std::vector<glm::vec4> animLookupData{};
 
     /* store inverse scaling factor in first element of lookup row */
@@ -272,7 +329,8 @@ bool AssimpModel::loadModel(std::string modelFilename, unsigned int extraImportF
   return true;
 }
 
-void AssimpModel::processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory) {
+void AssimpModel::processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory,
+    ThreadPool& decodePool) {
   std::string nodeName = aNode->mName.C_Str();
   Logger::log(1, "%s: node name: '%s'\n", __FUNCTION__, nodeName.c_str());
 
@@ -283,7 +341,7 @@ void AssimpModel::processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, c
       aiMesh* modelMesh = scene->mMeshes[aNode->mMeshes[i]];
 
       AssimpMesh mesh;
-      mesh.processMesh(modelMesh, scene, assetDirectory, mTextures);
+      mesh.processMesh(modelMesh, scene, assetDirectory, mTextures, decodePool);
       OGLMesh vertexMesh = mesh.getMesh();
       mNumAnimatedMeshes += vertexMesh.morphMeshes.size();
 
@@ -311,7 +369,7 @@ void AssimpModel::processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, c
     Logger::log(1, "%s: --- found child node '%s'\n", __FUNCTION__, childName.c_str());
 
     std::shared_ptr<AssimpNode> childNode = node->addChild(childName);
-    processNode(childNode, aNode->mChildren[i], scene, assetDirectory);
+    processNode(childNode, aNode->mChildren[i], scene, assetDirectory, decodePool);
   }
 }
 
@@ -320,89 +378,95 @@ glm::mat4 AssimpModel::getRootTranformationMatrix() {
 }
 
 void AssimpModel::draw() {
+  bindMaterials();
   for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
-    OGLMesh& mesh = mModelMeshes.at(i);
-    // find diffuse texture by name
-
-    std::shared_ptr<Texture> diffuseTex = nullptr;
-    auto diffuseTexName = mesh.textures.find(aiTextureType_DIFFUSE);
-    if (diffuseTexName != mesh.textures.end()) {
-      auto diffuseTexture = mTextures.find(diffuseTexName->second);
-      if (diffuseTexture != mTextures.end()) {
-        diffuseTex = diffuseTexture->second;
-      }
-    }
-
-    glActiveTexture(GL_TEXTURE0);
-    if (diffuseTex) {
-      diffuseTex->bind();
-    } else {
-      mPlaceholderTexture->bind();
-    }
-
-    mVertexBuffers.at(i).bindAndDrawIndirect(GL_TRIANGLES, mesh.indices.size());
-
-    if (diffuseTex) {
-      diffuseTex->unbind();
-    } else {
-      mPlaceholderTexture->unbind();
-    }
+    unsigned int materialId = mMeshMaterialIds.at(i);
+    bindMeshTexture(materialId);
+    mVertexBuffers.at(i).bindAndDrawIndirectInstanced(GL_TRIANGLES, mModelMeshes.at(i).indices.size(), 1);
   }
 }
 
-void AssimpModel::drawInstanced(int instanceCount) {
+void AssimpModel::submitInstanced(RenderQueue& renderQueue, RenderCommand baseCommand) {
   for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
-    OGLMesh& mesh = mModelMeshes.at(i);
-    drawInstanced(mesh, i, instanceCount);
+    submitInstanced(renderQueue, baseCommand, i);
   }
 }
 
-void AssimpModel::drawInstancedNoMorphAnims(int instanceCount) {
+void AssimpModel::submitInstancedNoMorphAnims(RenderQueue& renderQueue, RenderCommand baseCommand) {
   for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
     /* skip meshes with morph animations */
     if (!mModelMeshes.at(i).morphMeshes.empty()) {
       continue;
     }
-    OGLMesh& mesh = mModelMeshes.at(i);
-    drawInstanced(mesh, i, instanceCount);
+    submitInstanced(renderQueue, baseCommand, i);
   }
 }
 
-void AssimpModel::drawInstancedMorphAnims(int instanceCount) {
+void AssimpModel::submitInstancedMorphAnims(RenderQueue& renderQueue, RenderCommand baseCommand) {
   for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
     /* draw only meshes with morph animations */
     if (mModelMeshes.at(i).morphMeshes.empty()) {
       continue;
     }
-    OGLMesh& mesh = mModelMeshes.at(i);
-    drawInstanced(mesh, i, instanceCount);
+    baseCommand.rcStorageBuffers.at(1).rsbBuffer = mAnimMeshVerticesBuffer.getBufferId();
+    baseCommand.rcStorageBuffers.at(1).rsbBinding = MORPH_VERTICES_BINDING_POINT;
+    submitInstanced(renderQueue, baseCommand, i);
   }
 }
 
-void AssimpModel::drawInstanced(OGLMesh& mesh, unsigned int meshIndex, int instanceCount) {
-  // find diffuse texture by name
-  std::shared_ptr<Texture> diffuseTex = nullptr;
-  auto diffuseTexName = mesh.textures.find(aiTextureType_DIFFUSE);
-  if (diffuseTexName != mesh.textures.end()) {
-    auto diffuseTexture = mTextures.find(diffuseTexName->second);
-    if (diffuseTexture != mTextures.end()) {
-      diffuseTex = diffuseTexture->second;
+void AssimpModel::submitInstancedPreSkinned(RenderQueue& renderQueue, RenderCommand baseCommand) {
+  for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
+    /* morph anims are not part of the pre-skinned vertices */
+    if (!mModelMeshes.at(i).morphMeshes.empty()) {
+      continue;
     }
+    /* the vertex shader needs the start of the mesh inside the skinned vertices of an instance */
+    baseCommand.rcUniforms.at(0).ruLocation = PRE_SKINNING_MESH_OFFSET_LOCATION;
+    baseCommand.rcUniforms.at(0).ruValue = mPreSkinningMeshOffsets.at(i);
+    submitInstanced(renderQueue, baseCommand, i);
   }
+}
 
-  glActiveTexture(GL_TEXTURE0);
-  if (diffuseTex) {
-    diffuseTex->bind();
+void AssimpModel::submitInstanced(RenderQueue& renderQueue, RenderCommand command, unsigned int meshIndex) {
+  unsigned int materialId = mMeshMaterialIds.at(meshIndex);
+
+  command.rcVertexArray = mVertexBuffers.at(meshIndex).getVertexArray();
+  command.rcIndexCount = mModelMeshes.at(meshIndex).indices.size();
+
+  if (mUseBindlessTextures) {
+    command.rcStorageBuffers.at(0).rsbBuffer = mMaterialBuffer.getBufferId();
+    command.rcStorageBuffers.at(0).rsbBinding = MATERIAL_BINDING_POINT;
+    command.rcUniforms.at(1).ruLocation = MATERIAL_ID_LOCATION;
+    command.rcUniforms.at(1).ruValue = materialId;
+    command.rcSortKey = RenderQueue::setSortKeyMaterial(command.rcSortKey, materialId);
   } else {
-    mPlaceholderTexture->bind();
+    /* sort by texture object, models share the textures */
+    command.rcTexture = mMaterialTextures.at(materialId)->getTextureId();
+    command.rcSortKey = RenderQueue::setSortKeyMaterial(command.rcSortKey, command.rcTexture);
   }
 
-  mVertexBuffers.at(meshIndex).bindAndDrawIndirectInstanced(GL_TRIANGLES, mesh.indices.size(), instanceCount);
+  renderQueue.submit(command);
+}
 
-  if (diffuseTex) {
-    diffuseTex->unbind();
-  } else {
-    mPlaceholderTexture->unbind();
+void AssimpModel::bindMaterials() {
+  if (mUseBindlessTextures) {
+    mMaterialBuffer.bind(MATERIAL_BINDING_POINT);
+  }
+  mBoundTexture = nullptr;
+}
+
+void AssimpModel::bindMeshTexture(unsigned int materialId) {
+  if (mUseBindlessTextures) {
+    glUniform1i(MATERIAL_ID_LOCATION, materialId);
+    return;
+  }
+
+  /* consecutive meshes often share the texture, skip the redundant binds */
+  Texture* texture = mMaterialTextures.at(materialId).get();
+  if (texture != mBoundTexture) {
+    glActiveTexture(GL_TEXTURE0);
+    texture->bind();
+    mBoundTexture = texture;
   }
 }
 
@@ -415,13 +479,26 @@ void AssimpModel::cleanup() {
     buffer.cleanup();
   }
 
+  releaseTextures();
+
+  mMaterialTextures.clear();
+  mMaterialBuffer.cleanup();
+  mPreSkinningVertexBuffer.cleanup();
+}
+
+void AssimpModel::releaseTextures() {
+  /* textures may be shared with other models and levels */
   for (auto& tex : mTextures) {
-    tex.second->cleanup();
+    tex.second->waitForDecoding();
+    TextureManager::releaseTexture(tex.second);
   }
+  mTextures.clear();
 
   /* empty for null model */
   if (mPlaceholderTexture) {
-    mPlaceholderTexture->cleanup();
+    mPlaceholderTexture->waitForDecoding();
+    TextureManager::releaseTexture(mPlaceholderTexture);
+    mPlaceholderTexture = nullptr;
   }
 }
 
@@ -489,6 +566,10 @@ void AssimpModel::setAABBLookup(std::vector<std::vector<AABB>> lookupData) {
   mAabbLookups = lookupData;
 }
 
+void AssimpModel::setMaxClipDuration(float duration) {
+  mMaxClipDuration = duration;
+}
+
 AABB AssimpModel::getAABB(InstanceSettings instSettings) {
   if (hasAnimations()) {
     return getAnimatedAABB(instSettings);
@@ -614,6 +695,14 @@ void AssimpModel::bindMorphAnimBuffer(int bindingPoint) {
   mAnimMeshVerticesBuffer.bind(bindingPoint);
 }
 
+unsigned int AssimpModel::getPreSkinningVertexCount() {
+  return mPreSkinningVertexCount;
+}
+
+void AssimpModel::bindPreSkinningVertexBuffer(int bindingPoint) {
+  mPreSkinningVertexBuffer.bind(bindingPoint);
+}
+
 bool AssimpModel::hasHeadMovementAnimationsMapped() {
   if (mModelSettings.msHeadMoveClipMappings.size() < 4) {
     return false;
@@ -9,10 +9,12 @@
 #include <glm/glm.hpp>
 
 #include "Texture.h"
+#include "ThreadPool.h"
 #include "AssimpMesh.h"
 #include "AssimpNode.h"
 #include "AssimpAnimClip.h"
 #include "VertexIndexBuffer.h"
+#include "RenderQueue.h"
 #include "ShaderStorageBuffer.h"
 #include "ModelSettings.h"
 #include "InstanceSettings.h"
@@ -22,13 +24,17 @@
 
 class AssimpModel {
   public:
-    bool loadModel(std::string modelFilename, unsigned int extraImportFlags = 0);
+    /* the textures are decoded on decodePool, all jobs of this asset are finished on return */
+    bool loadModel(std::string modelFilename, ThreadPool& decodePool, unsigned int extraImportFlags = 0);
     glm::mat4 getRootTranformationMatrix();
 
     void draw();
-    void drawInstanced(int instanceCount);
-    void drawInstancedNoMorphAnims(int instanceCount);
-    void drawInstancedMorphAnims(int instanceCount);
+    /* program, sort key and base instance are set by the caller, the model adds mesh and material */
+    void submitInstanced(RenderQueue& renderQueue, RenderCommand baseCommand);
+    void submitInstancedNoMorphAnims(RenderQueue& renderQueue, RenderCommand baseCommand);
+    void submitInstancedMorphAnims(RenderQueue& renderQueue, RenderCommand baseCommand);
+    /* non-morph meshes, vertices already skinned by the pre-skinning compute shader */
+    void submitInstancedPreSkinned(RenderQueue& renderQueue, RenderCommand baseCommand);
     unsigned int getTriangleCount();
 
     std::string getModelFileName();
@@ -54,6 +60,8 @@ class AssimpModel {
     ModelSettings getModelSettings();
 
     void setAABBLookup(std::vector<std::vector<AABB>> lookupData);
+    /* loadModel() sets the real duration, used to drive synthetic lookup tables */
+    void setMaxClipDuration(float duration);
     AABB getAABB(InstanceSettings instSettings);
     AABB getAnimatedAABB(InstanceSettings instSettings);
     AABB getNonAnimatedAABB(InstanceSettings instSettings);
@@ -62,6 +70,9 @@ class AssimpModel {
     unsigned int getAnimMeshVertexSize();
     void bindMorphAnimBuffer(int bindingPoint);
 
+    unsigned int getPreSkinningVertexCount();
+    void bindPreSkinningVertexBuffer(int bindingPoint);
+
     bool hasHeadMovementAnimationsMapped();
 
     glm::mat4 getBoneOffsetMatrix(int boneId);
@@ -75,9 +86,14 @@ class AssimpModel {
     void cleanup();
 
 private:
-    void processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory);
+    void processNode(std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory,
+      ThreadPool& decodePool);
     void createNodeList(std::shared_ptr<AssimpNode> node, std::shared_ptr<AssimpNode> newNode, std::vector<std::shared_ptr<AssimpNode>> &list);
-    void drawInstanced(OGLMesh& mesh, unsigned int meshIndex, int instanceCount);
+    void submitInstanced(RenderQueue& renderQueue, RenderCommand command, unsigned int meshIndex);
+    /* returns all texture references, also used by the error paths of loading */
+    void releaseTextures();
+    void bindMaterials();
+    void bindMeshTexture(unsigned int materialId);
 
     unsigned int mTriangleCount = 0;
     unsigned int mVertexCount = 0;
@@ -112,6 +128,16 @@ private:
     std::unordered_map<std::string, std::shared_ptr<Texture>> mTextures{};
     std::shared_ptr<Texture> mPlaceholderTexture = nullptr;
 
+    /* materials are resolved once at load time, no string lookups while drawing */
+    const int MATERIAL_BINDING_POINT = 6;
+    /* uniform location of the material id in the fragment shaders, bindless only */
+    const int MATERIAL_ID_LOCATION = 1;
+    std::vector<std::shared_ptr<Texture>> mMaterialTextures{};
+    std::vector<unsigned int> mMeshMaterialIds{};
+    ShaderStorageBuffer mMaterialBuffer{};
+    bool mUseBindlessTextures = false;
+    Texture* mBoundTexture = nullptr;
+
     glm::mat4 mRootTransformMatrix = glm::mat4(1.0f);
 
     ModelSettings mModelSettings{};
@@ -120,4 +146,11 @@ private:
     unsigned int mNumAnimatedMeshes = 0;
     unsigned int mAnimatedMeshVertexSize = 0;
     ShaderStorageBuffer mAnimMeshVerticesBuffer{};
+    const int MORPH_VERTICES_BINDING_POINT = 4;
+
+    /* uniform location of the mesh offset in the pre-skinned vertex shader */
+    const int PRE_SKINNING_MESH_OFFSET_LOCATION = 0;
+    unsigned int mPreSkinningVertexCount = 0;
+    std::vector<unsigned int> mPreSkinningMeshOffsets{};
+    ShaderStorageBuffer mPreSkinningVertexBuffer{};
 };
@@ -1,5 +1,6 @@
 #include "AssimpSettingsContainer.h"
 #include "Logger.h"
+#include "MemoryTracker.h"
 
 AssimpSettingsContainer::AssimpSettingsContainer(std::shared_ptr<AssimpInstance> nullInstance) {
   mNullInstance = nullInstance;
@@ -44,6 +45,7 @@ instanceEditMode AssimpSettingsContainer::getCurrentEditMode() {
 }
 
 void AssimpSettingsContainer::applyNewInstance(std::shared_ptr<AssimpInstance> instance, int selectedInstanceId, int prevSelectedInstanceId) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: add new instance\n", __FUNCTION__);
 
   UndoRedoSettings undoSettings;
@@ -65,6 +67,7 @@ void AssimpSettingsContainer::applyNewInstance(std::shared_ptr<AssimpInstance> i
 }
 
 void AssimpSettingsContainer::applyDeleteInstance(std::shared_ptr<AssimpInstance> instance, int selectedInstanceId, int prevSelectedInstanceId) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: delete instance\n", __FUNCTION__);
 
   UndoRedoSettings undoSettings;
@@ -85,6 +88,7 @@ void AssimpSettingsContainer::applyDeleteInstance(std::shared_ptr<AssimpInstance
 }
 
 void AssimpSettingsContainer::applyEditInstanceSettings(std::shared_ptr<AssimpInstance> instance, InstanceSettings newSettings, InstanceSettings oldSettings) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: save instance settings\n", __FUNCTION__);
 
   UndoRedoSettings undoSettings;
@@ -107,6 +111,7 @@ void AssimpSettingsContainer::applyEditInstanceSettings(std::shared_ptr<AssimpIn
 }
 
 void AssimpSettingsContainer::applyNewMultiInstance(std::vector<std::shared_ptr<AssimpInstance>> instances, int selectedInstanceId, int prevSelectedInstanceId) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: save multi instance\n", __FUNCTION__);
 
   UndoRedoSettings undoSettings;
@@ -132,6 +137,7 @@ void AssimpSettingsContainer::applyNewMultiInstance(std::vector<std::shared_ptr<
 }
 
 void AssimpSettingsContainer::applyChangeEditMode(instanceEditMode editMode, instanceEditMode savedEditMode) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: save instance mode (new: %i, old: %i)\n", __FUNCTION__, editMode, savedEditMode);
 
   UndoRedoSettings undoSettings;
@@ -147,6 +153,7 @@ void AssimpSettingsContainer::applyChangeEditMode(instanceEditMode editMode, ins
 }
 
 void AssimpSettingsContainer::applySelectInstance(int selectedInstanceId, int savedSelectedInstanceId) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: select instance\n", __FUNCTION__);
 
   UndoRedoSettings undoSettings;
@@ -163,6 +170,7 @@ void AssimpSettingsContainer::applySelectInstance(int selectedInstanceId, int sa
 
 void AssimpSettingsContainer::applyLoadModel(std::shared_ptr<AssimpModel> model, int indexPos, std::shared_ptr<AssimpInstance> firstInstance,
                                              int selectedModelId, int prevSelectedModelId, int selectedInstanceId, int prevSelectedInstanceId) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: add model\n", __FUNCTION__);
 
   UndoRedoSettings undoSettings;
@@ -192,6 +200,7 @@ void AssimpSettingsContainer::applyLoadModel(std::shared_ptr<AssimpModel> model,
 
 void AssimpSettingsContainer::applyDeleteModel(std::shared_ptr<AssimpModel> model, int indexPos, std::vector<std::shared_ptr<AssimpInstance>> instances,
       int selectedModelId, int prevSelectedModelId, int selectedInstanceId, int prevSelectedInstanceId) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: delete model\n", __FUNCTION__);
 
   UndoRedoSettings undoSettings;
@@ -219,6 +228,7 @@ void AssimpSettingsContainer::applyDeleteModel(std::shared_ptr<AssimpModel> mode
 }
 
 void AssimpSettingsContainer::applyEditCameraSettings(std::shared_ptr<Camera> camera, CameraSettings newSettings, CameraSettings oldSettings) {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   Logger::log(1, "%s: save camera settings\n", __FUNCTION__);
 
   UndoRedoSettings undoSettings;
@@ -249,6 +259,7 @@ int AssimpSettingsContainer::getRedoSize() {
 }
 
 void AssimpSettingsContainer::undo() {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   if (mUndoStack.empty()) {
     return;
   }
@@ -371,6 +382,7 @@ void AssimpSettingsContainer::undo() {
 }
 
 void AssimpSettingsContainer::redo() {
+  MEMORY_TAG_SCOPE(memoryTag::undoStack);
   if (mRedoStack.empty()) {
     return;
   }
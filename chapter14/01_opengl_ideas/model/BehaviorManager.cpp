@@ -1,6 +1,7 @@
 #include "BehaviorManager.h"
 
 #include "Logger.h"
+#include "Profiler.h"
 
 /* use internal logging as callback by default  */
 BehaviorManager::BehaviorManager() {
@@ -21,6 +22,7 @@ void BehaviorManager::setNodeActionCallback(instanceNodeActionCallback callbackF
 }
 
 void BehaviorManager::update(float deltaTime) {
+  PROFILE_FUNCTION();
   for (auto& instance : mInstanceToBehaviorMap) {
     instance.second.update(deltaTime);
   }
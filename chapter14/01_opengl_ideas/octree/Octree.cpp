@@ -2,9 +2,11 @@
 
 #include "Octree.h"
 #include "Logger.h"
+#include "MemoryTracker.h"
 
 Octree::Octree(std::shared_ptr<BoundingBox3D> rootBox, int threshold, int maxDepth) :
    mRootBoundingBox(*rootBox), mThreshold(threshold), mMaxDepth(maxDepth) {
+  MEMORY_TAG_SCOPE(memoryTag::octree);
   mRootNode = std::make_shared<OctreeNode>();
 }
 
@@ -131,6 +133,7 @@ int Octree::getOctantId(BoundingBox3D nodeBox, BoundingBox3D valueBox) {
 }
 
 void Octree::add(int instanceId) {
+  MEMORY_TAG_SCOPE(memoryTag::octree);
   /* do not add instance when outside of octree */
   if (!mRootBoundingBox.intersects(mInstanceGetBoundingBoxCallbackFunction(instanceId))) {
     return;
@@ -256,14 +259,21 @@ void Octree::update(int instanceId) {
 }
 
 std::set<int> Octree::query(BoundingBox3D box) {
-  std::vector<int> values;
-  values = query(mRootNode, mRootBoundingBox, box);
+  std::pmr::vector<int> values;
+  query(box, values);
   return std::set<int>(values.begin(), values.end());
 }
 
-std::vector<int> Octree::query(std::shared_ptr<OctreeNode> node, BoundingBox3D box, BoundingBox3D queryBox) {
-  std::vector<int> values;
+void Octree::query(BoundingBox3D box, std::pmr::vector<int>& instanceIds) {
+  instanceIds.clear();
+  query(mRootNode, mRootBoundingBox, box, instanceIds);
 
+  std::sort(instanceIds.begin(), instanceIds.end());
+  instanceIds.erase(std::unique(instanceIds.begin(), instanceIds.end()), instanceIds.end());
+}
+
+void Octree::query(std::shared_ptr<OctreeNode> node, BoundingBox3D box, BoundingBox3D queryBox,
+    std::pmr::vector<int>& values) {
   for (const auto& instanceId : node->instancIds) {
     if (queryBox.intersects(mInstanceGetBoundingBoxCallbackFunction(instanceId))) {
       values.emplace_back(instanceId);
@@ -274,42 +284,50 @@ std::vector<int> Octree::query(std::shared_ptr<OctreeNode> node, BoundingBox3D b
     for (int i = 0; i < node->childs.size(); ++i) {
       BoundingBox3D childBox = getChildOctant(box, i);
       if (queryBox.intersects(childBox)) {
-        std::vector<int> childValues = query(node->childs.at(i), childBox, queryBox);
-        values.insert(values.end(), childValues.begin(), childValues.end());
+        query(node->childs.at(i), childBox, queryBox, values);
       }
     }
   }
-  return values;
 }
 
 void Octree::clear() {
+  MEMORY_TAG_SCOPE(memoryTag::octree);
   mRootNode.reset();
   mRootNode = std::make_shared<OctreeNode>();
 }
 
 std::set<std::pair<int, int>> Octree::findAllIntersections() {
-  std::set<std::pair<int, int>> values;
-  values = findAllIntersections(mRootNode);
+  std::pmr::vector<std::pair<int, int>> values;
+  findAllIntersections(values);
+  return std::set<std::pair<int, int>>(values.begin(), values.end());
+}
 
-  for (auto it = values.begin(); it != values.end(); ) {
-    auto reversePair = std::make_pair((*it).second, (*it).first);
-    if (values.count(reversePair) > 0) {
-      values.erase(it++);
-    } else {
-      ++it;
+void Octree::findAllIntersections(std::pmr::vector<std::pair<int, int>>& intersections) {
+  intersections.clear();
+  findAllIntersections(mRootNode, intersections);
+
+  std::sort(intersections.begin(), intersections.end());
+  intersections.erase(std::unique(intersections.begin(), intersections.end()), intersections.end());
+
+  /* if a pair was found in both directions, keep only the (larger, smaller) one */
+  size_t writeIndex = 0;
+  for (size_t i = 0; i < intersections.size(); ++i) {
+    std::pair<int, int> value = intersections.at(i);
+    /* the reverse pair sorts behind the current one, that part was not compacted yet */
+    if (value.first < value.second && std::binary_search(intersections.begin() + i + 1, intersections.end(),
+        std::make_pair(value.second, value.first))) {
+      continue;
     }
+    intersections.at(writeIndex++) = value;
   }
-
-  return values;
+  intersections.resize(writeIndex);
 }
 
-std::set<std::pair<int, int>> Octree::findAllIntersections(std::shared_ptr<OctreeNode> node) {
-  std::set<std::pair<int, int>> values;
-
+void Octree::findAllIntersections(std::shared_ptr<OctreeNode> node, std::pmr::vector<std::pair<int, int>>& values) {
   for (int i = 0; i < node->instancIds.size(); ++i) {
     for (int j = 0; j < i; ++j) {
       if (mInstanceGetBoundingBoxCallbackFunction(node->instancIds.at(i)).intersects(mInstanceGetBoundingBoxCallbackFunction(node->instancIds.at(j)))) {
-        values.insert({node->instancIds[i], node->instancIds[j]});
+        values.emplace_back(node->instancIds[i], node->instancIds[j]);
       }
     }
   }
@@ -317,37 +335,28 @@ std::set<std::pair<int, int>> Octree::findAllIntersections(std::shared_ptr<Octre
   if (!isLeaf(node)) {
     for (const auto& child : node->childs) {
       for (const auto& value : node->instancIds) {
-        std::set<std::pair<int, int>> childValues;
-        childValues = findIntersectionsInDescendants(child, value);
-        values.insert(childValues.begin(), childValues.end());
+        findIntersectionsInDescendants(child, value, values);
       }
     }
     for (const auto& child : node->childs) {
-      std::set<std::pair<int, int>> childValues;
-      childValues = findAllIntersections(child);
-      values.insert(childValues.begin(), childValues.end());
+      findAllIntersections(child, values);
     }
   }
-  return values;
 }
 
-std::set<std::pair<int, int>> Octree::findIntersectionsInDescendants(std::shared_ptr<OctreeNode> node, int instanceId) {
-  std::set<std::pair<int, int>> values;
-
+void Octree::findIntersectionsInDescendants(std::shared_ptr<OctreeNode> node, int instanceId,
+    std::pmr::vector<std::pair<int, int>>& values) {
   for (const auto& other : node->instancIds) {
     if (mInstanceGetBoundingBoxCallbackFunction(instanceId).intersects(mInstanceGetBoundingBoxCallbackFunction(other))) {
-      values.insert({instanceId, other});
+      values.emplace_back(instanceId, other);
     }
   }
 
   if (!isLeaf(node)) {
     for (const auto& child : node->childs) {
-      std::set<std::pair<int, int>> childValues;
-      childValues = findIntersectionsInDescendants(child, instanceId);
-      values.insert(childValues.begin(), childValues.end());
+      findIntersectionsInDescendants(child, instanceId, values);
     }
   }
-  return values;
 }
 
 std::vector<BoundingBox3D> Octree::getTreeBoxes() {
@@ -7,6 +7,7 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <memory_resource>
 #include <set>
 
 #include "Enums.h"
@@ -24,6 +25,10 @@ class Octree {
     std::set<int> query(BoundingBox3D box);
     std::set<std::pair<int, int>> findAllIntersections();
 
+    /* same results as sorted vectors without duplicates, no temporaries apart from the vector */
+    void query(BoundingBox3D box, std::pmr::vector<int>& instanceIds);
+    void findAllIntersections(std::pmr::vector<std::pair<int, int>>& intersections);
+
     std::vector<BoundingBox3D> getTreeBoxes();
 
     void clear();
@@ -53,10 +58,12 @@ class Octree {
     void removeInstance(std::shared_ptr<OctreeNode> node, int instanceId);
     bool tryMerge(std::shared_ptr<OctreeNode> node);
 
-    std::vector<int> query(std::shared_ptr<OctreeNode> node, BoundingBox3D box, BoundingBox3D queryBox);
+    void query(std::shared_ptr<OctreeNode> node, BoundingBox3D box, BoundingBox3D queryBox,
+      std::pmr::vector<int>& values);
 
-    std::set<std::pair<int, int>> findAllIntersections(std::shared_ptr<OctreeNode> node);
-    std::set<std::pair<int, int>> findIntersectionsInDescendants(std::shared_ptr<OctreeNode> node, int instanceId);
+    void findAllIntersections(std::shared_ptr<OctreeNode> node, std::pmr::vector<std::pair<int, int>>& values);
+    void findIntersectionsInDescendants(std::shared_ptr<OctreeNode> node, int instanceId,
+      std::pmr::vector<std::pair<int, int>>& values);
 
     std::vector<BoundingBox3D> getTreeBoxes(std::shared_ptr<OctreeNode> node, BoundingBox3D box);
 };
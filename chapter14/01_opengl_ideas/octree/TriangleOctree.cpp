@@ -4,9 +4,11 @@
 
 #include "TriangleOctree.h"
 #include "Logger.h"
+#include "MemoryTracker.h"
 
 TriangleOctree::TriangleOctree(std::shared_ptr<BoundingBox3D> rootBox, int threshold, int maxDepth) :
    mRootBoundingBox(*rootBox), mThreshold(threshold), mMaxDepth(maxDepth) {
+  MEMORY_TAG_SCOPE(memoryTag::octree);
   mRootNode = std::make_shared<TriangleOctreeNode>();
 }
 
@@ -136,6 +138,7 @@ int TriangleOctree::getOctantId(BoundingBox3D nodeBox, BoundingBox3D valueBox) {
 }
 
 void TriangleOctree::add(MeshTriangle triangle) {
+  MEMORY_TAG_SCOPE(memoryTag::octree);
   add(mRootNode, 0, mRootBoundingBox, triangle);
 }
 
@@ -216,15 +219,10 @@ void TriangleOctree::split(std::shared_ptr<TriangleOctreeNode> node, BoundingBox
   node->triangles = std::move(newTriangles);
 }
 
-std::vector<MeshTriangle> TriangleOctree::query(BoundingBox3D box) {
-  std::vector<MeshTriangle> values;
-  values = query(mRootNode, mRootBoundingBox, box);
-  return values;
-}
-
-std::vector<MeshTriangle> TriangleOctree::query(std::shared_ptr<TriangleOctreeNode> node, BoundingBox3D box, BoundingBox3D queryBox) {
-  std::vector<MeshTriangle> values;
-
+/* both variants append to one vector, no temporary vectors per node */
+template <typename TriangleVector>
+void TriangleOctree::query(std::shared_ptr<TriangleOctreeNode> node, BoundingBox3D box, BoundingBox3D queryBox,
+    TriangleVector& values) {
   for (const auto& tri : node->triangles) {
     if (queryBox.intersects(tri.boundingBox)) {
       values.emplace_back(tri);
@@ -235,15 +233,25 @@ std::vector<MeshTriangle> TriangleOctree::query(std::shared_ptr<TriangleOctreeNo
     for (int i = 0; i < node->childs.size(); ++i) {
       BoundingBox3D childBox = getChildOctant(box, i);
       if (queryBox.intersects(childBox)) {
-        std::vector<MeshTriangle> childValues = query(node->childs.at(i), childBox, queryBox);
-        values.insert(values.end(), childValues.begin(), childValues.end());
+        query(node->childs.at(i), childBox, queryBox, values);
       }
     }
   }
+}
+
+std::vector<MeshTriangle> TriangleOctree::query(BoundingBox3D box) {
+  std::vector<MeshTriangle> values;
+  query(mRootNode, mRootBoundingBox, box, values);
   return values;
 }
 
+void TriangleOctree::query(BoundingBox3D box, std::pmr::vector<MeshTriangle>& triangles) {
+  triangles.clear();
+  query(mRootNode, mRootBoundingBox, box, triangles);
+}
+
 void TriangleOctree::clear() {
+  MEMORY_TAG_SCOPE(memoryTag::octree);
   mRootNode.reset();
   mRootNode = std::make_shared<TriangleOctreeNode>();
 }
@@ -7,6 +7,7 @@
 #include <vector>
 #include <tuple>
 #include <memory>
+#include <memory_resource>
 
 #include "Enums.h"
 #include "Callbacks.h"
@@ -20,6 +21,8 @@ class TriangleOctree {
     void add(MeshTriangle triangle);
 
     std::vector<MeshTriangle> query(BoundingBox3D box);
+    /* clears the vector first, use with a frame arena to avoid heap allocations */
+    void query(BoundingBox3D box, std::pmr::vector<MeshTriangle>& triangles);
 
     std::vector<BoundingBox3D> getTreeBoxes();
 
@@ -44,7 +47,9 @@ class TriangleOctree {
     void add(std::shared_ptr<TriangleOctreeNode> node, int depth, BoundingBox3D box, MeshTriangle triangle);
     void split(std::shared_ptr<TriangleOctreeNode> node, BoundingBox3D box);
 
-    std::vector<MeshTriangle> query(std::shared_ptr<TriangleOctreeNode> node, BoundingBox3D box, BoundingBox3D queryBox);
+    template <typename TriangleVector>
+    void query(std::shared_ptr<TriangleOctreeNode> node, BoundingBox3D box, BoundingBox3D queryBox,
+      TriangleVector& values);
 
     std::vector<BoundingBox3D> getTreeBoxes(std::shared_ptr<TriangleOctreeNode> node, BoundingBox3D box);
 };
@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+#include "DebugDraw.h"
+#include "Logger.h"
+
+bool DebugDraw::init(unsigned int maxVertices) {
+  glGenVertexArrays(1, &mVAO);
+
+  if (!createBuffer(maxVertices)) {
+    glDeleteVertexArrays(1, &mVAO);
+    mVAO = 0;
+    return false;
+  }
+
+  Logger::log(1, "%s: debug draw stream with %i vertices per frame initialized\n", __FUNCTION__, mMaxVertices);
+  return true;
+}
+
+bool DebugDraw::createBuffer(unsigned int maxVertices) {
+  GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  GLsizeiptr bufferSize = static_cast<GLsizeiptr>(maxVertices) * NUM_REGIONS * sizeof(OGLLineVertex);
+
+  glGenBuffers(1, &mVertexVBO);
+  glBindVertexArray(mVAO);
+
+  glBindBuffer(GL_ARRAY_BUFFER, mVertexVBO);
+  glBufferStorage(GL_ARRAY_BUFFER, bufferSize, nullptr, flags);
+  mMappedVertices = static_cast<OGLLineVertex*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, bufferSize, flags));
+
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(OGLLineVertex), (void*) offsetof(OGLLineVertex, position));
+  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(OGLLineVertex), (void*) offsetof(OGLLineVertex, color));
+
+  glEnableVertexAttribArray(0);
+  glEnableVertexAttribArray(1);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindVertexArray(0);
+
+  if (!mMappedVertices) {
+    Logger::log(1, "%s error: could not map debug draw buffer of %i bytes\n", __FUNCTION__, bufferSize);
+    glDeleteBuffers(1, &mVertexVBO);
+    mVertexVBO = 0;
+    return false;
+  }
+
+  mMaxVertices = maxVertices;
+  mRegion = 0;
+  mVertexCount = 0;
+  return true;
+}
+
+void DebugDraw::deleteBuffer() {
+  for (unsigned int i = 0; i < NUM_REGIONS; ++i) {
+    waitForRegion(i);
+  }
+
+  if (mMappedVertices) {
+    glBindBuffer(GL_ARRAY_BUFFER, mVertexVBO);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    mMappedVertices = nullptr;
+  }
+
+  glDeleteBuffers(1, &mVertexVBO);
+  mVertexVBO = 0;
+  mMaxVertices = 0;
+}
+
+void DebugDraw::waitForRegion(unsigned int region) {
+  GLsync fence = mRegionFences.at(region);
+  if (!fence) {
+    return;
+  }
+
+  /* normally signaled long ago, the region was drawn NUM_REGIONS - 1 frames before */
+  GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+  while (result == GL_TIMEOUT_EXPIRED) {
+    result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+  }
+
+  glDeleteSync(fence);
+  mRegionFences.at(region) = nullptr;
+}
+
+void DebugDraw::setCategoryEnabled(debugDrawCategory category, bool enabled) {
+  uint32_t categoryBit = 1u << static_cast<uint8_t>(category);
+  if (enabled) {
+    mEnabledCategories |= categoryBit;
+  } else {
+    mEnabledCategories &= ~categoryBit;
+  }
+}
+
+OGLLineVertex* DebugDraw::reserveVertices(unsigned int count) {
+  if (!mMappedVertices || mVertexCount + count > mMaxVertices) {
+    /* the stream grows on the next flush, drop the lines of this frame */
+    mDroppedVertices += count;
+    return nullptr;
+  }
+
+  OGLLineVertex* vertices = mMappedVertices + mRegion * mMaxVertices + mVertexCount;
+  mVertexCount += count;
+  return vertices;
+}
+
+void DebugDraw::addLine(debugDrawCategory category, glm::vec3 start, glm::vec3 end, glm::vec3 color) {
+  if (!isEnabled(category)) {
+    return;
+  }
+
+  OGLLineVertex* vertices = reserveVertices(2);
+  if (!vertices) {
+    return;
+  }
+
+  vertices[0] = OGLLineVertex(start, color);
+  vertices[1] = OGLLineVertex(end, color);
+}
+
+void DebugDraw::addLines(debugDrawCategory category, const std::vector<OGLLineVertex>& vertices) {
+  if (!isEnabled(category) || vertices.empty()) {
+    return;
+  }
+
+  OGLLineVertex* target = reserveVertices(static_cast<unsigned int>(vertices.size()));
+  if (!target) {
+    return;
+  }
+
+  std::memcpy(target, vertices.data(), vertices.size() * sizeof(OGLLineVertex));
+}
+
+void DebugDraw::addBox(debugDrawCategory category, glm::vec3 minPos, glm::vec3 maxPos, glm::vec3 color) {
+  if (!isEnabled(category)) {
+    return;
+  }
+
+  OGLLineVertex* vertices = reserveVertices(24);
+  if (!vertices) {
+    return;
+  }
+
+  const glm::vec3 corners[8] = {
+    {minPos.x, minPos.y, minPos.z}, {maxPos.x, minPos.y, minPos.z},
+    {maxPos.x, maxPos.y, minPos.z}, {minPos.x, maxPos.y, minPos.z},
+    {minPos.x, minPos.y, maxPos.z}, {maxPos.x, minPos.y, maxPos.z},
+    {maxPos.x, maxPos.y, maxPos.z}, {minPos.x, maxPos.y, maxPos.z}
+  };
+
+  /* front and back quad, then the four connecting edges */
+  static constexpr int edges[24] = {
+    0, 1, 1, 2, 2, 3, 3, 0,
+    4, 5, 5, 6, 6, 7, 7, 4,
+    0, 4, 1, 5, 2, 6, 3, 7
+  };
+
+  for (int i = 0; i < 24; ++i) {
+    vertices[i] = OGLLineVertex(corners[edges[i]], color);
+  }
+}
+
+void DebugDraw::addCross(debugDrawCategory category, glm::vec3 center, float halfSize, glm::vec3 color,
+    glm::mat3 orientation) {
+  if (!isEnabled(category)) {
+    return;
+  }
+
+  OGLLineVertex* vertices = reserveVertices(4);
+  if (!vertices) {
+    return;
+  }
+
+  glm::vec3 xAxis = orientation * glm::vec3(halfSize, 0.0f, 0.0f);
+  glm::vec3 zAxis = orientation * glm::vec3(0.0f, 0.0f, halfSize);
+
+  vertices[0] = OGLLineVertex(center + xAxis, color);
+  vertices[1] = OGLLineVertex(center - xAxis, color);
+  vertices[2] = OGLLineVertex(center - zAxis, color);
+  vertices[3] = OGLLineVertex(center + zAxis, color);
+}
+
+void DebugDraw::addTriangle(debugDrawCategory category, glm::vec3 p0, glm::vec3 p1, glm::vec3 p2, glm::vec3 color) {
+  if (!isEnabled(category)) {
+    return;
+  }
+
+  OGLLineVertex* vertices = reserveVertices(6);
+  if (!vertices) {
+    return;
+  }
+
+  vertices[0] = OGLLineVertex(p0, color);
+  vertices[1] = OGLLineVertex(p1, color);
+  vertices[2] = OGLLineVertex(p1, color);
+  vertices[3] = OGLLineVertex(p2, color);
+  vertices[4] = OGLLineVertex(p2, color);
+  vertices[5] = OGLLineVertex(p0, color);
+}
+
+void DebugDraw::addSphere(debugDrawCategory category, glm::vec3 center, float radius, glm::vec3 color,
+    unsigned int segments) {
+  if (!isEnabled(category) || segments < 3) {
+    return;
+  }
+
+  OGLLineVertex* vertices = reserveVertices(segments * 6);
+  if (!vertices) {
+    return;
+  }
+
+  float angleStep = glm::two_pi<float>() / static_cast<float>(segments);
+  for (unsigned int i = 0; i < segments; ++i) {
+    float sin0 = std::sin(angleStep * i) * radius;
+    float cos0 = std::cos(angleStep * i) * radius;
+    float sin1 = std::sin(angleStep * (i + 1)) * radius;
+    float cos1 = std::cos(angleStep * (i + 1)) * radius;
+
+    /* XY, XZ and YZ circle */
+    *vertices++ = OGLLineVertex(center + glm::vec3(cos0, sin0, 0.0f), color);
+    *vertices++ = OGLLineVertex(center + glm::vec3(cos1, sin1, 0.0f), color);
+    *vertices++ = OGLLineVertex(center + glm::vec3(cos0, 0.0f, sin0), color);
+    *vertices++ = OGLLineVertex(center + glm::vec3(cos1, 0.0f, sin1), color);
+    *vertices++ = OGLLineVertex(center + glm::vec3(0.0f, cos0, sin0), color);
+    *vertices++ = OGLLineVertex(center + glm::vec3(0.0f, cos1, sin1), color);
+  }
+}
+
+void DebugDraw::submit(RenderQueue& renderQueue, RenderCommand baseCommand) {
+  if (mVertexCount == 0) {
+    return;
+  }
+
+  baseCommand.rcVertexArray = mVAO;
+  baseCommand.rcMode = GL_LINES;
+  baseCommand.rcFirstVertex = mRegion * mMaxVertices;
+  baseCommand.rcVertexCount = mVertexCount;
+  renderQueue.submit(baseCommand);
+}
+
+void DebugDraw::endFrame() {
+  if (mVertexCount > 0) {
+    mRegionFences.at(mRegion) = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  }
+
+  mLastVertexCount = mVertexCount;
+  mVertexCount = 0;
+  mRegion = (mRegion + 1) % NUM_REGIONS;
+  waitForRegion(mRegion);
+
+  if (mDroppedVertices > 0) {
+    unsigned int newMaxVertices = std::max(mMaxVertices * 2, mLastVertexCount + mDroppedVertices);
+    Logger::log(1, "%s: %i debug vertices dropped, resizing stream from %i to %i vertices\n", __FUNCTION__,
+      mDroppedVertices, mMaxVertices, newMaxVertices);
+    mDroppedVertices = 0;
+
+    deleteBuffer();
+    createBuffer(newMaxVertices);
+  }
+}
+
+unsigned int DebugDraw::getLastVertexCount() {
+  return mLastVertexCount;
+}
+
+void DebugDraw::cleanup() {
+  deleteBuffer();
+  glDeleteVertexArrays(1, &mVAO);
+  mVAO = 0;
+}
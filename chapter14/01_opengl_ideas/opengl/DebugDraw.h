@@ -0,0 +1,64 @@
+/* immediate mode debug lines, collected into one persistent mapped vertex stream */
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glad/glad.h>
+
+#include "Enums.h"
+#include "OGLRenderData.h"
+#include "RenderQueue.h"
+
+class DebugDraw {
+  public:
+    bool init(unsigned int maxVertices = 65536);
+
+    void setCategoryEnabled(debugDrawCategory category, bool enabled);
+    /* check before building expensive debug geometry */
+    bool isEnabled(debugDrawCategory category) {
+      return (mEnabledCategories & (1u << static_cast<uint8_t>(category))) != 0;
+    }
+
+    void addLine(debugDrawCategory category, glm::vec3 start, glm::vec3 end, glm::vec3 color);
+    /* vertex pairs, as used by GL_LINES */
+    void addLines(debugDrawCategory category, const std::vector<OGLLineVertex>& vertices);
+    void addBox(debugDrawCategory category, glm::vec3 minPos, glm::vec3 maxPos, glm::vec3 color);
+    /* flat cross in the local XZ plane */
+    void addCross(debugDrawCategory category, glm::vec3 center, float halfSize, glm::vec3 color,
+      glm::mat3 orientation = glm::mat3(1.0f));
+    void addTriangle(debugDrawCategory category, glm::vec3 p0, glm::vec3 p1, glm::vec3 p2, glm::vec3 color);
+    /* three great circles */
+    void addSphere(debugDrawCategory category, glm::vec3 center, float radius, glm::vec3 color,
+      unsigned int segments = 16);
+
+    /* all lines since the last frame as one draw, program and sort key are set by the caller */
+    void submit(RenderQueue& renderQueue, RenderCommand baseCommand);
+    /* call after the queue flushed the lines, fences the region and switches to the next one */
+    void endFrame();
+    unsigned int getLastVertexCount();
+
+    void cleanup();
+
+  private:
+    OGLLineVertex* reserveVertices(unsigned int count);
+    bool createBuffer(unsigned int maxVertices);
+    void deleteBuffer();
+    void waitForRegion(unsigned int region);
+
+    /* the CPU writes one region while the GPU may still read the other two */
+    static constexpr unsigned int NUM_REGIONS = 3;
+
+    GLuint mVAO = 0;
+    GLuint mVertexVBO = 0;
+    OGLLineVertex* mMappedVertices = nullptr;
+    std::array<GLsync, NUM_REGIONS> mRegionFences{};
+
+    unsigned int mMaxVertices = 0;
+    unsigned int mRegion = 0;
+    unsigned int mVertexCount = 0;
+    unsigned int mLastVertexCount = 0;
+    unsigned int mDroppedVertices = 0;
+
+    uint32_t mEnabledCategories = 0;
+};
@@ -218,3 +218,80 @@ inline timeOfDay operator+(timeOfDay A, int num) {
   A = static_cast<timeOfDay>(n);
   return A;
 }
+
+/* shader feature flags, every set flag adds its #define to the shader variant */
+enum class shaderFeature : uint8_t {
+  none = 0x00,
+  morphAnim = 0x01,
+  selection = 0x02,
+  headMove = 0x04
+};
+
+inline shaderFeature operator | (shaderFeature lhs, shaderFeature rhs) {
+  using T = std::underlying_type_t <shaderFeature>;
+  return static_cast<shaderFeature>(static_cast<T>(lhs) | static_cast<T>(rhs));
+}
+
+inline shaderFeature& operator |= (shaderFeature& lhs, shaderFeature rhs) {
+  lhs = lhs | rhs;
+  return lhs;
+}
+
+inline shaderFeature operator & (shaderFeature lhs, shaderFeature rhs) {
+  using T = std::underlying_type_t <shaderFeature>;
+  return static_cast<shaderFeature>(static_cast<T>(lhs) & static_cast<T>(rhs));
+}
+
+/* highest sort key bits, passes are drawn in this order */
+enum class renderPass : uint8_t {
+  level = 0,
+  skinnedModels,
+  morphModels,
+  staticModels,
+  debugLines,
+  NUM
+};
+
+/* debug geometry groups, a disabled group drops its geometry before any work is done */
+enum class debugDrawCategory : uint8_t {
+  coordArrows = 0,
+  interaction,
+  collision,
+  levelCollision,
+  groundNeighbors,
+  instancePaths,
+  ikFootPoints,
+  NUM
+};
+
+/* GPU timed sections of a frame */
+enum class gpuPass : uint8_t {
+  skybox = 0,
+  level,
+  transformCompute,
+  matrixCompute,
+  preSkinning,
+  skinning,
+  morph,
+  staticModels,
+  debugLines,
+  ui,
+  NUM
+};
+
+/* memory accounting groups, CPU allocations are only attributed with the MEMORY_TAG_HOOK build option */
+enum class memoryTag : uint8_t {
+  untagged = 0,
+  modelGeometry,
+  levelGeometry,
+  animationLookup,
+  aabbLookup,
+  morphAnimation,
+  materials,
+  textures,
+  octree,
+  navigation,
+  undoStack,
+  rendererBuffers,
+  NUM
+};
@@ -0,0 +1,32 @@
+/* result of one simulation step, written by the simulation and only read by the render stage */
+#pragma once
+#include <vector>
+#include <memory>
+#include <glm/glm.hpp>
+
+#include "OGLRenderData.h"
+
+class AssimpModel;
+class Octree;
+
+struct FramePacketModel {
+  std::shared_ptr<AssimpModel> fpmModel = nullptr;
+  size_t fpmNumberOfInstances = 0;
+  std::vector<PerInstanceAnimData> fpmPerInstanceAnimData{};
+  std::vector<glm::mat4> fpmWorldPosMatrices{};
+  std::vector<glm::vec4> fpmFaceAnimPerInstanceData{};
+};
+
+struct FramePacket {
+  /* same order as the model list, entries are reused to keep the vector capacities */
+  std::vector<FramePacketModel> fpModels{};
+  size_t fpNumberOfModels = 0;
+  Octree* fpOctree = nullptr;
+  bool fpValid = false;
+
+  float fpSimulationTime = 0.0f;
+  float fpFaceAnimTime = 0.0f;
+  float fpLevelCollisionTime = 0.0f;
+  float fpPathFindingTime = 0.0f;
+  float fpLevelGroundNeighborUpdateTime = 0.0f;
+};
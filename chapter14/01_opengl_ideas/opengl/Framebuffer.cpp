@@ -1,9 +1,12 @@
+#include <algorithm>
+
 #include "Framebuffer.h"
 #include "Logger.h"
 
 bool Framebuffer::init(unsigned int width, unsigned int height) {
   mBufferWidth = width;
   mBufferHeight = height;
+  updateRenderSize();
 
   glGenFramebuffers(1, &mBuffer);
   glBindFramebuffer(GL_FRAMEBUFFER, mBuffer);
@@ -72,19 +75,38 @@ bool Framebuffer::resize(unsigned int newWidth, unsigned int newHeight) {
   return init(newWidth, newHeight);
 }
 
+void Framebuffer::setRenderScale(float scale) {
+  mRenderScale = std::clamp(scale, 0.5f, 1.0f);
+  updateRenderSize();
+}
+
+float Framebuffer::getRenderScale() {
+  return mRenderScale;
+}
+
+void Framebuffer::updateRenderSize() {
+  /* the buffers keep the window size, a scale change needs no new textures */
+  mRenderWidth = std::max(1u, static_cast<unsigned int>(mBufferWidth * mRenderScale));
+  mRenderHeight = std::max(1u, static_cast<unsigned int>(mBufferHeight * mRenderScale));
+}
+
 void Framebuffer::bind() {
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER, mBuffer);
+  glViewport(0, 0, mRenderWidth, mRenderHeight);
 }
 
 void Framebuffer::unbind() {
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+  glViewport(0, 0, mBufferWidth, mBufferHeight);
 }
 
 void Framebuffer::drawToScreen() {
   glBindFramebuffer(GL_READ_FRAMEBUFFER, mBuffer);
   glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
-  glBlitFramebuffer(0, 0, mBufferWidth, mBufferHeight, 0, 0, mBufferWidth, mBufferHeight,
-                  GL_COLOR_BUFFER_BIT, GL_NEAREST);
+  /* upscale with linear filtering if rendered below window resolution */
+  GLenum filter = (mRenderWidth == mBufferWidth && mRenderHeight == mBufferHeight) ? GL_NEAREST : GL_LINEAR;
+  glBlitFramebuffer(0, 0, mRenderWidth, mRenderHeight, 0, 0, mBufferWidth, mBufferHeight,
+                  GL_COLOR_BUFFER_BIT, filter);
   glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
 }
 
@@ -117,6 +139,10 @@ float Framebuffer::readPixelFromPos(unsigned int xPos, unsigned int yPos) {
   /* random default value to detect errors */
   float pixelColor = -444.0f;
 
+  /* positions are in window coordinates */
+  xPos = std::min(xPos * mRenderWidth / mBufferWidth, mRenderWidth - 1);
+  yPos = std::min(yPos * mRenderHeight / mBufferHeight, mRenderHeight - 1);
+
   glBindFramebuffer(GL_READ_FRAMEBUFFER, mBuffer);
   glReadBuffer(GL_COLOR_ATTACHMENT1);
 
@@ -8,6 +8,10 @@ class Framebuffer {
     bool init(unsigned int width, unsigned int height);
     bool resize(unsigned int newWidth, unsigned int newHeight);
 
+    /* render into the lower left part of the buffers only, drawToScreen() scales it up */
+    void setRenderScale(float scale);
+    float getRenderScale();
+
     void bind();
     void unbind();
 
@@ -21,10 +25,14 @@ class Framebuffer {
   private:
     unsigned int mBufferWidth = 640;
     unsigned int mBufferHeight = 480;
+    float mRenderScale = 1.0f;
+    unsigned int mRenderWidth = 640;
+    unsigned int mRenderHeight = 480;
     GLuint mBuffer = 0;
     GLuint mColorTex = 0;
     GLuint mSelectionTex = 0;
     GLuint mDepthBuffer = 0;
 
     bool checkComplete();
+    void updateRenderSize();
 };
@@ -0,0 +1,146 @@
+#include "GpuTimer.h"
+#include "Logger.h"
+
+bool GpuTimer::init() {
+  mOpenIntervals.fill(-1);
+  mPassTimes.fill(0.0f);
+
+  GLint counterBits = 0;
+  glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &counterBits);
+  if (counterBits == 0) {
+    Logger::log(1, "%s error: timestamp queries not supported\n", __FUNCTION__);
+    return false;
+  }
+  mAvailable = true;
+
+  Logger::log(1, "%s: GPU timer with %i bit timestamps initialized\n", __FUNCTION__, counterBits);
+  return true;
+}
+
+void GpuTimer::start(gpuPass pass) {
+  if (!mAvailable) {
+    return;
+  }
+
+  unsigned int passIndex = static_cast<unsigned int>(pass);
+  if (mOpenIntervals.at(passIndex) != -1) {
+    Logger::log(1, "%s error: GPU timer for pass %i already running\n", __FUNCTION__, passIndex);
+    return;
+  }
+
+  GpuTimerFrame& frame = mFrames.at(mCurrentFrame);
+  unsigned int interval = frame.gtfUsedIntervals++;
+
+  /* the pool only grows, queries are reused every NUM_FRAMES frames */
+  if (interval >= frame.gtfIntervalPasses.size()) {
+    frame.gtfIntervalPasses.resize(interval + 1);
+    frame.gtfQueries.resize((interval + 1) * 2);
+    glGenQueries(2, &frame.gtfQueries.at(interval * 2));
+  }
+
+  frame.gtfIntervalPasses.at(interval) = pass;
+  mOpenIntervals.at(passIndex) = interval;
+  glQueryCounter(frame.gtfQueries.at(interval * 2), GL_TIMESTAMP);
+}
+
+void GpuTimer::stop(gpuPass pass) {
+  if (!mAvailable) {
+    return;
+  }
+
+  unsigned int passIndex = static_cast<unsigned int>(pass);
+  int interval = mOpenIntervals.at(passIndex);
+  if (interval == -1) {
+    Logger::log(1, "%s error: GPU timer for pass %i not running\n", __FUNCTION__, passIndex);
+    return;
+  }
+
+  glQueryCounter(mFrames.at(mCurrentFrame).gtfQueries.at(interval * 2 + 1), GL_TIMESTAMP);
+  mOpenIntervals.at(passIndex) = -1;
+}
+
+bool GpuTimer::collectFrame(GpuTimerFrame& frame) {
+  if (frame.gtfUsedIntervals == 0) {
+    return false;
+  }
+
+  /* queries finish in order, if the last one is available all others are too */
+  GLint available = 0;
+  glGetQueryObjectiv(frame.gtfQueries.at(frame.gtfUsedIntervals * 2 - 1), GL_QUERY_RESULT_AVAILABLE, &available);
+  if (!available) {
+    return false;
+  }
+
+  mPassTimes.fill(0.0f);
+  for (unsigned int i = 0; i < frame.gtfUsedIntervals; ++i) {
+    GLuint64 startTime = 0;
+    GLuint64 stopTime = 0;
+    glGetQueryObjectui64v(frame.gtfQueries.at(i * 2), GL_QUERY_RESULT, &startTime);
+    glGetQueryObjectui64v(frame.gtfQueries.at(i * 2 + 1), GL_QUERY_RESULT, &stopTime);
+
+    mPassTimes.at(static_cast<unsigned int>(frame.gtfIntervalPasses.at(i))) += (stopTime - startTime) / 1000000.0f;
+  }
+
+  return true;
+}
+
+bool GpuTimer::endFrame() {
+  if (!mAvailable) {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < NUM_PASSES; ++i) {
+    if (mOpenIntervals.at(i) != -1) {
+      Logger::log(1, "%s error: GPU timer for pass %i still running at frame end\n", __FUNCTION__, i);
+      stop(static_cast<gpuPass>(i));
+    }
+  }
+
+  GpuTimerFrame& currentFrame = mFrames.at(mCurrentFrame);
+  currentFrame.gtfPending = currentFrame.gtfUsedIntervals > 0;
+
+  /* oldest slot first, frames finish in order */
+  bool collected = false;
+  for (unsigned int i = 1; i <= NUM_FRAMES; ++i) {
+    GpuTimerFrame& frame = mFrames.at((mCurrentFrame + i) % NUM_FRAMES);
+    if (!frame.gtfPending) {
+      continue;
+    }
+    if (!collectFrame(frame)) {
+      break;
+    }
+    frame.gtfPending = false;
+    collected = true;
+  }
+
+  /* the next slot is only still pending if the GPU is far behind, drop it instead of stalling */
+  mCurrentFrame = (mCurrentFrame + 1) % NUM_FRAMES;
+  GpuTimerFrame& nextFrame = mFrames.at(mCurrentFrame);
+  if (nextFrame.gtfPending) {
+    ++mSkippedFrames;
+    nextFrame.gtfPending = false;
+  }
+  nextFrame.gtfUsedIntervals = 0;
+  return collected;
+}
+
+float GpuTimer::getPassTime(gpuPass pass) {
+  return mPassTimes.at(static_cast<unsigned int>(pass));
+}
+
+unsigned int GpuTimer::getSkippedFrames() {
+  return mSkippedFrames;
+}
+
+void GpuTimer::cleanup() {
+  for (auto& frame : mFrames) {
+    if (!frame.gtfQueries.empty()) {
+      glDeleteQueries(frame.gtfQueries.size(), frame.gtfQueries.data());
+    }
+    frame.gtfQueries.clear();
+    frame.gtfIntervalPasses.clear();
+    frame.gtfUsedIntervals = 0;
+    frame.gtfPending = false;
+  }
+  mAvailable = false;
+}
@@ -0,0 +1,49 @@
+/* GPU pass timing with timestamp queries, results are read when the GPU has finished the frame */
+#pragma once
+#include <vector>
+#include <array>
+#include <glad/glad.h>
+
+#include "Enums.h"
+
+class GpuTimer {
+  public:
+    bool init();
+
+    /* a pass can be started and stopped several times per frame, the times add up */
+    void start(gpuPass pass);
+    void stop(gpuPass pass);
+    /* collects all finished frames, never waits.
+     * returns true if the pass times have been updated */
+    bool endFrame();
+
+    /* milliseconds of the last finished frame */
+    float getPassTime(gpuPass pass);
+    unsigned int getSkippedFrames();
+
+    void cleanup();
+
+  private:
+    struct GpuTimerFrame {
+      /* two timestamps per interval */
+      std::vector<GLuint> gtfQueries{};
+      std::vector<gpuPass> gtfIntervalPasses{};
+      unsigned int gtfUsedIntervals = 0;
+      /* submitted, but the results have not been read yet */
+      bool gtfPending = false;
+    };
+
+    /* a slot is only dropped if the GPU is NUM_FRAMES - 1 frames behind */
+    static constexpr unsigned int NUM_FRAMES = 4;
+    static constexpr unsigned int NUM_PASSES = static_cast<unsigned int>(gpuPass::NUM);
+
+    bool collectFrame(GpuTimerFrame& frame);
+
+    std::array<GpuTimerFrame, NUM_FRAMES> mFrames{};
+    unsigned int mCurrentFrame = 0;
+
+    std::array<int, NUM_PASSES> mOpenIntervals{};
+    std::array<float, NUM_PASSES> mPassTimes{};
+    unsigned int mSkippedFrames = 0;
+    bool mAvailable = false;
+};
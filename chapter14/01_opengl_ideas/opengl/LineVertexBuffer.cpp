@@ -62,3 +62,7 @@ void LineVertexBuffer::bindAndDrawInstanced(GLuint mode, unsigned int start, uns
   glDrawArraysInstanced(mode, start, num, instances);
   unbind();
 }
+
+GLuint LineVertexBuffer::getVertexArray() {
+  return mVAO;
+}
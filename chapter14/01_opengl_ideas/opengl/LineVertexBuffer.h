@@ -15,6 +15,7 @@ class LineVertexBuffer {
     void draw(GLuint mode, unsigned int start, unsigned int num);
     void bindAndDraw(GLuint mode, unsigned int start, unsigned int num);
     void bindAndDrawInstanced(GLuint mode, unsigned int start, unsigned int num, unsigned int instances);
+    GLuint getVertexArray();
     void cleanup();
 
   private:
@@ -0,0 +1,46 @@
+#include <algorithm>
+
+#include "MaterialResolver.h"
+#include "Logger.h"
+
+bool MaterialResolver::resolveMaterials(const std::vector<OGLMesh>& meshes,
+    const std::unordered_map<std::string, std::shared_ptr<Texture>>& textures,
+    std::shared_ptr<Texture> placeholderTexture, std::vector<std::shared_ptr<Texture>>& materialTextures,
+    std::vector<unsigned int>& meshMaterialIds, ShaderStorageBuffer& materialBuffer) {
+  materialTextures.clear();
+  meshMaterialIds.clear();
+
+  /* material 0 is the placeholder for meshes without diffuse texture */
+  materialTextures.emplace_back(placeholderTexture);
+
+  for (const auto& mesh : meshes) {
+    unsigned int materialId = 0;
+    auto diffuseTexName = mesh.textures.find(aiTextureType_DIFFUSE);
+    if (diffuseTexName != mesh.textures.end()) {
+      auto diffuseTexture = textures.find(diffuseTexName->second);
+      if (diffuseTexture != textures.end()) {
+        auto materialIter = std::find(materialTextures.begin(), materialTextures.end(), diffuseTexture->second);
+        materialId = std::distance(materialTextures.begin(), materialIter);
+        if (materialIter == materialTextures.end()) {
+          materialTextures.emplace_back(diffuseTexture->second);
+        }
+      }
+    }
+    meshMaterialIds.emplace_back(materialId);
+  }
+
+  /* shaders fetch the texture handle by the material id passed as base instance */
+  bool useBindlessTextures = Texture::isBindlessSupported();
+  if (useBindlessTextures) {
+    std::vector<glm::uvec2> textureHandles{};
+    for (const auto& texture : materialTextures) {
+      GLuint64 handle = texture->getBindlessHandle();
+      textureHandles.emplace_back(glm::uvec2(handle & 0xffffffff, handle >> 32));
+    }
+    materialBuffer.uploadSsboData(textureHandles);
+  }
+
+  Logger::log(1, "%s: resolved %i materials for %i meshes (%s)\n", __FUNCTION__, materialTextures.size(),
+    meshMaterialIds.size(), useBindlessTextures ? "bindless" : "texture binds");
+  return useBindlessTextures;
+}
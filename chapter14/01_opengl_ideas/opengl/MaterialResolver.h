@@ -0,0 +1,20 @@
+/* maps mesh diffuse textures to material ids, shared by models and levels */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include "Texture.h"
+#include "ShaderStorageBuffer.h"
+#include "OGLRenderData.h"
+
+class MaterialResolver {
+  public:
+    /* material 0 is the placeholder, returns true if the materials use bindless handles */
+    static bool resolveMaterials(const std::vector<OGLMesh>& meshes,
+      const std::unordered_map<std::string, std::shared_ptr<Texture>>& textures,
+      std::shared_ptr<Texture> placeholderTexture, std::vector<std::shared_ptr<Texture>>& materialTextures,
+      std::vector<unsigned int>& meshMaterialIds, ShaderStorageBuffer& materialBuffer);
+};
@@ -36,7 +36,8 @@ struct ModelInstanceCamData {
   std::unordered_map<moveDirection, std::string> micMoveDirectionMap{};
   std::unordered_map<moveState, std::string> micMoveStateMap{};
 
-  std::set<std::pair<int, int>> micInstanceCollisions{};
+  /* sorted, without duplicates */
+  std::vector<std::pair<int, int>> micInstanceCollisions{};
 
   std::map<std::string, std::shared_ptr<SingleInstanceBehavior>> micBehaviorData{};
   std::unordered_map<nodeEvent, std::string> micNodeUpdateMap{};
@@ -39,6 +39,13 @@ struct OGLVertex {
   glm::vec4 boneWeight = glm::vec4(0.0f);
 };
 
+/* output of the pre-skinning compute shader, world space */
+struct OGLSkinnedVertex {
+  glm::vec4 position = glm::vec4(0.0f); // last float is uv.x
+  glm::vec4 color = glm::vec4(1.0f);
+  glm::vec4 normal = glm::vec4(0.0f); // last float is uv.y
+};
+
 struct OGLMesh {
   std::vector<OGLVertex> vertices{};
   std::vector<uint32_t> indices{};
@@ -129,6 +136,12 @@ struct OGLRenderData {
   float rdIKTime = 0.0f;
   float rdLevelGroundNeighborUpdateTime = 0.0f;
   float rdPathFindingTime = 0.0f;
+  float rdSimulationTime = 0.0f;
+
+  /* GPU execution time per pass, one frame behind the CPU timers */
+  std::array<float, static_cast<size_t>(gpuPass::NUM)> rdGpuPassTimes{};
+  std::unordered_map<gpuPass, std::string> rdGpuPassNameMap{};
+  unsigned int rdGpuSkippedFrames = 0;
 
   int rdMoveForward = 0;
   int rdMoveRight = 0;
@@ -210,6 +223,29 @@ struct OGLRenderData {
 
   bool rdDrawSkybox = false;
 
+  /* skin vertices in a compute shader once per frame instead of in every vertex shader pass */
+  bool rdComputePreSkinning = false;
+  /* simulate the next frame on a worker thread while the current frame is presented */
+  bool rdPipelinedSimulation = true;
+  /* render the scene below window resolution to hold the GPU frame time budget, UI stays at full size */
+  bool rdDynamicResolution = true;
+  float rdTargetGpuFrameTime = 16.0f;
+  /* 0.5 to 1.0, set by the controller or by the user if dynamic resolution is off */
+  float rdRenderScale = 1.0f;
+
+  /* render queue state changes in the last frame */
+  unsigned int rdDrawCalls = 0;
+  unsigned int rdProgramChanges = 0;
+  unsigned int rdVertexArrayChanges = 0;
+  unsigned int rdTextureChanges = 0;
+  unsigned int rdBufferChanges = 0;
+  unsigned int rdSkippedStateChanges = 0;
+  /* lines of all enabled debug draw categories */
+  unsigned int rdDebugDrawVertices = 0;
+  unsigned int rdFrameHeapAllocations = 0;
+  size_t rdFrameArenaBytes = 0;
+  size_t rdFrameArenaCapacity = 0;
+
   float rdLightSourceAngleEastWest = 40.0f;
   float rdLightSourceAngleNorthSouth = 40.0f;
   glm::vec3 rdLightSourceColor = glm::vec3(1.0f);
@@ -5,9 +5,11 @@
 
 #include <ctime>
 #include <cstdlib>
+#include <cmath>
 #include <algorithm>
 #include <filesystem>
 #include <set>
+#include <memory_resource>
 
 #include "OGLRenderer.h"
 #include "InstanceSettings.h"
@@ -15,6 +17,10 @@
 #include "YamlParser.h"
 #include "Logger.h"
 #include "Tools.h"
+#include "TextureManager.h"
+#include "Profiler.h"
+#include "AllocationCounter.h"
+#include "MemoryTracker.h"
 
 OGLRenderer::OGLRenderer(GLFWwindow *window) {
   mRenderData.rdWindow = window;
@@ -30,6 +36,17 @@ bool OGLRenderer::init(unsigned int width, unsigned int height) {
   mRenderData.mAppModeMap[appMode::edit] = "Edit";
   mRenderData.mAppModeMap[appMode::view] = "View";
 
+  mRenderData.rdGpuPassNameMap[gpuPass::skybox] = "Skybox";
+  mRenderData.rdGpuPassNameMap[gpuPass::level] = "Level";
+  mRenderData.rdGpuPassNameMap[gpuPass::transformCompute] = "Transform Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::matrixCompute] = "Matrix Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::preSkinning] = "Pre-Skinning Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::skinning] = "Skinning";
+  mRenderData.rdGpuPassNameMap[gpuPass::morph] = "Morph Anims";
+  mRenderData.rdGpuPassNameMap[gpuPass::staticModels] = "Static Models";
+  mRenderData.rdGpuPassNameMap[gpuPass::debugLines] = "Debug Lines";
+  mRenderData.rdGpuPassNameMap[gpuPass::ui] = "User Interface";
+
   /* save orig window title, add current mode */
   mOrigWindowTitle = mModelInstCamData.micGetWindowTitleFunction();
   setModeInWindowTitle();
@@ -64,10 +81,24 @@ bool OGLRenderer::init(unsigned int width, unsigned int height) {
   mLevelAABBVertexBuffer.init();
   mLevelOctreeVertexBuffer.init();
   mLevelWireframeVertexBuffer.init();
-  mIKLinesVertexBuffer.init();
   mSkyboxBuffer.init();
   Logger::log(1, "%s: line vertex buffer successfully created\n", __FUNCTION__);
 
+  if (!mDebugDraw.init()) {
+    Logger::log(1, "%s error: could not init debug draw stream\n", __FUNCTION__);
+    return false;
+  }
+
+  if (!mFrameArena.init()) {
+    Logger::log(1, "%s error: could not init frame arena\n", __FUNCTION__);
+    return false;
+  }
+
+  /* not fatal, the GPU pass times just stay at zero */
+  if (!mGpuTimer.init()) {
+    Logger::log(1, "%s: GPU timer not available\n", __FUNCTION__);
+  }
+
   mGroundMeshVertexBuffer.init();
   Logger::log(1, "%s: ground vertex buffer successfully created\n", __FUNCTION__);
 
@@ -85,53 +116,30 @@ bool OGLRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
-  if (!mAssimpShader.loadShaders("shader/assimp.vert", "shader/assimp.frag")) {
-    Logger::log(1, "%s: Assimp shader loading failed\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!mAssimpSkinningShader.loadShaders("shader/assimp_skinning.vert", "shader/assimp_skinning.frag")) {
-    Logger::log(1, "%s: Assimp GPU skinning shader loading failed\n", __FUNCTION__);
-    return false;
-  }
-  if (!mAssimpSkinningShader.getUniformLocation("aModelStride")) {
-    Logger::log(1, "%s: could not find symbol 'aModelStride' in GPU skinning shader\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!mAssimpSkinningMorphShader.loadShaders("shader/assimp_skinning_morph.vert", "shader/assimp_skinning_morph.frag")) {
-    Logger::log(1, "%s: Assimp GPU skinning with morph anims shader loading failed\n", __FUNCTION__);
-    return false;
-  }
-  if (!mAssimpSkinningMorphShader.getUniformLocation("aModelStride")) {
-    Logger::log(1, "%s: could not find symbol 'aModelStride' in GPU skinning with morph anims shader\n", __FUNCTION__);
-    return false;
+  /* fetch textures by material id instead of binding them for every mesh */
+  std::vector<std::string> textureDefines{};
+  if (Texture::isBindlessSupported()) {
+    textureDefines.emplace_back("BINDLESS_TEXTURES");
+    Logger::log(1, "%s: using bindless textures\n", __FUNCTION__);
   }
 
-  if (!mAssimpSelectionShader.loadShaders("shader/assimp_selection.vert", "shader/assimp_selection.frag")) {
-    Logger::log(1, "%s: Assimp selection shader loading failed\n", __FUNCTION__);
+  /* only the base variants are compiled here, the others on first use */
+  if (!mAssimpShader.loadShaders("shader/assimp.vert", "shader/assimp.frag", textureDefines)) {
+    Logger::log(1, "%s: Assimp shader loading failed\n", __FUNCTION__);
     return false;
   }
 
-  if (!mAssimpSkinningSelectionShader.loadShaders("shader/assimp_skinning_selection.vert", "shader/assimp_skinning_selection.frag")) {
-    Logger::log(1, "%s: Assimp GPU skinning selection shader loading failed\n", __FUNCTION__);
-    return false;
-  }
-  if (!mAssimpSkinningSelectionShader.getUniformLocation("aModelStride")) {
-    Logger::log(1, "%s: could not find symbol 'aModelStride' in GPU skinning selection shader\n", __FUNCTION__);
+  if (!mAssimpSkinningShader.loadShaders("shader/assimp_skinning.vert", "shader/assimp_skinning.frag", textureDefines)) {
+    Logger::log(1, "%s: Assimp GPU skinning shader loading failed\n", __FUNCTION__);
     return false;
   }
 
-  if (!mAssimpSkinningMorphSelectionShader.loadShaders("shader/assimp_skinning_morph_selection.vert", "shader/assimp_skinning_morph_selection.frag")) {
-    Logger::log(1, "%s: Assimp GPU skinning with morph anims and selection shader loading failed\n", __FUNCTION__);
-    return false;
-  }
-  if (!mAssimpSkinningMorphSelectionShader.getUniformLocation("aModelStride")) {
-    Logger::log(1, "%s: could not find symbol 'aModelStride' in GPU skinning with morph anims and selection shader\n", __FUNCTION__);
+  if (!mAssimpPreSkinnedShader.loadShaders("shader/assimp_pre_skinned.vert", "shader/assimp_skinning.frag", textureDefines)) {
+    Logger::log(1, "%s: Assimp pre-skinned shader loading failed\n", __FUNCTION__);
     return false;
   }
 
-  if (!mAssimpLevelShader.loadShaders("shader/assimp_level.vert", "shader/assimp_level.frag")) {
+  if (!mAssimpLevelShader.loadShaders("shader/assimp_level.vert", "shader/assimp_level.frag", textureDefines)) {
     Logger::log(1, "%s: Assimp Level shader loading failed\n", __FUNCTION__);
     return false;
   }
@@ -145,8 +153,12 @@ bool OGLRenderer::init(unsigned int width, unsigned int height) {
     Logger::log(1, "%s: Assimp GPU node transform compute shader loading failed\n", __FUNCTION__);
     return false;
   }
-  if (!mAssimpTransformHeadMoveComputeShader.loadComputeShader("shader/assimp_instance_headmove_transform.comp")) {
-    Logger::log(1, "%s: Assimp GPU node transform with head move compute shader loading failed\n", __FUNCTION__);
+  if (!mAssimpPreSkinningComputeShader.loadComputeShader("shader/assimp_pre_skinning.comp")) {
+    Logger::log(1, "%s: Assimp GPU pre-skinning compute shader loading failed\n", __FUNCTION__);
+    return false;
+  }
+  if (!mAssimpPreSkinningComputeShader.getUniformLocation("aModelStride")) {
+    Logger::log(1, "%s: could not find symbol 'aModelStride' in GPU pre-skinning compute shader\n", __FUNCTION__);
     return false;
   }
   if (!mAssimpMatrixComputeShader.loadComputeShader("shader/assimp_instance_matrix_mult.comp")) {
@@ -195,7 +207,13 @@ bool OGLRenderer::init(unsigned int width, unsigned int height) {
   mEmptyWorldPositionBuffer.init(256);
   mBoundingSphereBuffer.init(256);
   mBoundingSphereAdjustmentBuffer.init(256);
+  mFaceAnimPerInstanceDataBuffer.setMemoryTag(memoryTag::morphAnimation);
   mFaceAnimPerInstanceDataBuffer.init(256);
+  mPreSkinnedVertexBuffer.init(256);
+  mLevelMatrixBuffer.init(256);
+  mDrawWorldPosMatrixBuffer.init(256);
+  mDrawBoneMatrixBuffer.init(256);
+  mDrawInstanceOffsetBuffer.init(256);
   Logger::log(1, "%s: SSBOs initialized\n", __FUNCTION__);
 
   mWorldBoundaries = std::make_shared<BoundingBox3D>(mRenderData.rdDefaultWorldStartPos, mRenderData.rdDefaultWorldSize);
@@ -338,16 +356,10 @@ bool OGLRenderer::init(unsigned int width, unsigned int height) {
   Logger::log(1, "%s: enum to string maps initialized\n", __FUNCTION__);
 
   /* valid, but empty line meshes */
-  mLineMesh = std::make_shared<OGLLineMesh>();
-  mAABBMesh = std::make_shared<OGLLineMesh>();
   mLevelAABBMesh = std::make_shared<OGLLineMesh>();
   mLevelOctreeMesh = std::make_shared<OGLLineMesh>();
   mLevelWireframeMesh = std::make_shared<OGLLineMesh>();
-  mLevelCollidingTriangleMesh = std::make_shared<OGLLineMesh>();
-  mIKFootPointMesh = std::make_shared<OGLLineMesh>();
   mRenderData.rdLevelWireframeMiniMapMesh = std::make_shared<OGLLineMesh>();
-  mLevelGroundNeighborsMesh = std::make_shared<OGLLineMesh>();
-  mInstancePathMesh = std::make_shared<OGLLineMesh>();
   Logger::log(1, "%s: line mesh storages initialized\n", __FUNCTION__);
 
   mSphereModel = SphereModel(1.0, 5, 8, glm::vec3(1.0f, 1.0f, 1.0f));
@@ -842,7 +854,7 @@ bool OGLRenderer::addModel(std::string modelFileName, bool addInitialInstance, b
   }
 
   std::shared_ptr<AssimpModel> model = std::make_shared<AssimpModel>();
-  if (!model->loadModel(modelFileName)) {
+  if (!model->loadModel(modelFileName, mTextureDecodePool)) {
     Logger::log(1, "%s error: could not load model file '%s'\n", __FUNCTION__, modelFileName.c_str());
     return false;
   }
@@ -1367,7 +1379,7 @@ bool OGLRenderer::addLevel(std::string levelFileName, bool updateVertexData) {
   }
 
   std::shared_ptr<AssimpLevel> level = std::make_shared<AssimpLevel>();
-  if (!level->loadLevel(levelFileName)) {
+  if (!level->loadLevel(levelFileName, mTextureDecodePool)) {
     Logger::log(1, "%s error: could not load level file '%s'\n", __FUNCTION__, levelFileName.c_str());
     return false;
   }
@@ -1829,6 +1841,16 @@ void OGLRenderer::handleKeyEvents(int key, int scancode, int action, int mods) {
    mRenderData.rdShowControlsHelpRequest = true;
   }
 
+  /* F9 writes the recorded CPU zones as Chrome trace, or records the next frames */
+  if (action == GLFW_PRESS && key == GLFW_KEY_F9) {
+    if (Profiler::isEnabled()) {
+      Profiler::writeChromeTrace("trace_frame_" + std::to_string(Profiler::getFrame()) + ".json",
+        Profiler::DEFAULT_TRACE_FRAMES);
+    } else {
+      Profiler::requestTrace(Profiler::DEFAULT_TRACE_FRAMES);
+    }
+  }
+
   if (mRenderData.rdApplicationMode == appMode::edit) {
     /* instance edit modes */
     if (glfwGetKey(mRenderData.rdWindow, GLFW_KEY_1) == GLFW_PRESS) {
@@ -2291,6 +2313,7 @@ void OGLRenderer::handleMovementKeys() {
 }
 
 void OGLRenderer::createAABBLookup(std::shared_ptr<AssimpModel> model) {
+  MEMORY_TAG_SCOPE(memoryTag::aabbLookup);
   const int LOOKUP_SIZE = 1023;
   /* we use a single instance per clip */
   size_t numberOfClips = model->getAnimClips().size();
@@ -2344,7 +2367,7 @@ void OGLRenderer::createAABBLookup(std::shared_ptr<AssimpModel> model) {
       }
 
       /* do a single iteration of all clips in parallel */
-      mAssimpTransformComputeShader.use();
+      mAssimpTransformComputeShader.getVariant().use();
 
       mUploadToUBOTimer.start();
       model->bindAnimLookupBuffer(0);
@@ -2395,33 +2418,36 @@ void OGLRenderer::createAABBLookup(std::shared_ptr<AssimpModel> model) {
 }
 
 void OGLRenderer::checkForInstanceCollisions() {
+  PROFILE_FUNCTION();
   /* get bounding box intersections */
-  mModelInstCamData.micInstanceCollisions = mOctree->findAllIntersections();
+  std::pmr::vector<std::pair<int, int>> intersections(&mFrameArena);
+  mOctree->findAllIntersections(intersections);
+  mModelInstCamData.micInstanceCollisions.assign(intersections.begin(), intersections.end());
 
   /* save bounding box collisions of non-animated instances */
-  std::set<std::pair<int, int>> nonAnimatedCollisions{};
+  std::pmr::vector<std::pair<int, int>> nonAnimatedCollisions(&mFrameArena);
   for (const auto& instancePair : mModelInstCamData.micInstanceCollisions) {
      if (!mModelInstCamData.micAssimpInstances.at(instancePair.first)->getModel()->hasAnimations() ||
          !mModelInstCamData.micAssimpInstances.at(instancePair.second)->getModel()->hasAnimations()) {
-     nonAnimatedCollisions.insert(instancePair);
+     nonAnimatedCollisions.emplace_back(instancePair);
     }
   }
 
   if (mRenderData.rdCheckCollisions == collisionChecks::boundingSpheres) {
     mBoundingSpheresPerInstance.clear();
   /* calculate collision spheres per model */
-    std::map<std::string, std::set<int>> modelToInstanceMapping;
+    std::pmr::map<std::shared_ptr<AssimpModel>, std::pmr::set<int>> modelToInstanceMapping(&mFrameArena);
 
     for (const auto& instancePair : mModelInstCamData.micInstanceCollisions) {
-      modelToInstanceMapping[mModelInstCamData.micAssimpInstances.at(instancePair.first)->getModel()->getModelFileName()].insert(instancePair.first);
-      modelToInstanceMapping[mModelInstCamData.micAssimpInstances.at(instancePair.second)->getModel()->getModelFileName()].insert(instancePair.second);
+      modelToInstanceMapping[mModelInstCamData.micAssimpInstances.at(instancePair.first)->getModel()].insert(instancePair.first);
+      modelToInstanceMapping[mModelInstCamData.micAssimpInstances.at(instancePair.second)->getModel()].insert(instancePair.second);
     }
 
     for (const auto& collisionInstances : modelToInstanceMapping) {
-      std::shared_ptr<AssimpModel> model = getModel(collisionInstances.first);
+      std::shared_ptr<AssimpModel> model = collisionInstances.first;
 
       size_t numInstances = collisionInstances.second.size();
-      std::vector<int> instanceIds = std::vector(collisionInstances.second.begin(), collisionInstances.second.end());
+      std::pmr::vector<int> instanceIds(collisionInstances.second.begin(), collisionInstances.second.end(), &mFrameArena);
 
       size_t numberOfBones = model->getBoneList().size();
 
@@ -2471,8 +2497,11 @@ void OGLRenderer::checkForInstanceCollisions() {
     checkForBoundingSphereCollisions();
   }
 
-  /* add up non-animated collisions */
-  mModelInstCamData.micInstanceCollisions.merge(nonAnimatedCollisions);
+  /* add up non-animated collisions, std::sort does not allocate */
+  std::vector<std::pair<int, int>>& collisions = mModelInstCamData.micInstanceCollisions;
+  collisions.insert(collisions.end(), nonAnimatedCollisions.begin(), nonAnimatedCollisions.end());
+  std::sort(collisions.begin(), collisions.end());
+  collisions.erase(std::unique(collisions.begin(), collisions.end()), collisions.end());
 
   /* get (possibly cleaned) number of collisions */
   mRenderData.rdNumberOfCollisions = mModelInstCamData.micInstanceCollisions.size();
@@ -2483,8 +2512,7 @@ void OGLRenderer::checkForInstanceCollisions() {
 }
 
 void OGLRenderer::checkForLevelCollisions() {
-  mLevelCollidingTriangleMesh->vertices.clear();
-
+  PROFILE_FUNCTION();
   for (const auto& instance : mModelInstCamData.micAssimpInstances) {
     InstanceSettings instSettings = instance->getInstanceSettings();
     if (instSettings.isInstanceIndexPosition == 0) {
@@ -2544,25 +2572,9 @@ void OGLRenderer::checkForLevelCollisions() {
         }
       }
 
-      if (mRenderData.rdDrawLevelCollisionTriangles) {
-        OGLLineVertex vert;
-        vert.color = vertexColor;
-        /* move wireframe overdraw a bit above the planes */
-        vert.position = glm::vec4(tri.points.at(0) + tri.normal * 0.01f, 1.0f);
-        mLevelCollidingTriangleMesh->vertices.push_back(vert);
-        vert.position = glm::vec4(tri.points.at(1) + tri.normal * 0.01f, 1.0f);
-        mLevelCollidingTriangleMesh->vertices.push_back(vert);
-
-        vert.position = glm::vec4(tri.points.at(1) + tri.normal * 0.01f, 1.0f);
-        mLevelCollidingTriangleMesh->vertices.push_back(vert);
-        vert.position = glm::vec4(tri.points.at(2) + tri.normal * 0.01f, 1.0f);
-        mLevelCollidingTriangleMesh->vertices.push_back(vert);
-
-        vert.position = glm::vec4(tri.points.at(2) + tri.normal * 0.01f, 1.0f);
-        mLevelCollidingTriangleMesh->vertices.push_back(vert);
-        vert.position = glm::vec4(tri.points.at(0) + tri.normal * 0.01f, 1.0f);
-        mLevelCollidingTriangleMesh->vertices.push_back(vert);
-      }
+      /* move wireframe overdraw a bit above the planes */
+      mDebugDraw.addTriangle(debugDrawCategory::levelCollision, tri.points.at(0) + tri.normal * 0.01f,
+        tri.points.at(1) + tri.normal * 0.01f, tri.points.at(2) + tri.normal * 0.01f, vertexColor);
     }
   }
 }
@@ -2593,7 +2605,7 @@ void OGLRenderer::checkForBorderCollisions() {
 }
 
 void OGLRenderer::checkForBoundingSphereCollisions() {
-  std::set<std::pair<int, int>> sphereCollisions{};
+  std::pmr::vector<std::pair<int, int>> sphereCollisions(&mFrameArena);
 
   for (const auto& instancePairs : mModelInstCamData.micInstanceCollisions) {
     int firstId = instancePairs.first;
@@ -2643,19 +2655,18 @@ void OGLRenderer::checkForBoundingSphereCollisions() {
       }
     }
 
-    /* store collisions in set */
+    /* input is sorted, so the output is too */
     if (collisionDetected) {
-      sphereCollisions.insert({firstId, secondId});
+      sphereCollisions.emplace_back(firstId, secondId);
     }
   }
 
   /* replace collided instance data with new ones */
-  mModelInstCamData.micInstanceCollisions.clear();
-  mModelInstCamData.micInstanceCollisions.insert(sphereCollisions.begin(), sphereCollisions.end());
+  mModelInstCamData.micInstanceCollisions.assign(sphereCollisions.begin(), sphereCollisions.end());
 }
 
 void OGLRenderer::reactToInstanceCollisions() {
-  std::vector<std::shared_ptr<AssimpInstance>> instances = mModelInstCamData.micAssimpInstances;
+  const std::vector<std::shared_ptr<AssimpInstance>>& instances = mModelInstCamData.micAssimpInstances;
 
   for (const auto& instancePairs : mModelInstCamData.micInstanceCollisions) {
     std::shared_ptr<AssimpInstance> firstInstance = instances.at(instancePairs.first);
@@ -2698,23 +2709,26 @@ void OGLRenderer::findInteractionInstances() {
   glm::vec3 querySize = glm::vec3(mRenderData.rdInteractionMaxRange);
   BoundingBox3D queryBox = BoundingBox3D(instancePos - querySize / 2.0f, querySize);
 
-  std::set<int> queriedNearInstances = mOctree->query(queryBox);
+  std::pmr::vector<int> queriedNearInstances(&mFrameArena);
+  mOctree->query(queryBox, queriedNearInstances);
 
   /* skip ourselve */
-  queriedNearInstances.erase(curInstSettings.isInstanceIndexPosition);
+  queriedNearInstances.erase(std::remove(queriedNearInstances.begin(), queriedNearInstances.end(),
+    curInstSettings.isInstanceIndexPosition), queriedNearInstances.end());
 
   if (queriedNearInstances.empty()) {
     return;
   }
 
-  std::set<int> nearInstances{};
+  /* the ids stay sorted and unique in all filter steps */
+  std::pmr::vector<int> nearInstances(&mFrameArena);
   for (const auto& id : queriedNearInstances) {
     std::shared_ptr<AssimpInstance> instance = mModelInstCamData.micAssimpInstances.at(id);
     InstanceSettings instSettings = instance->getInstanceSettings();
 
     float distance = glm::length(instSettings.isWorldPosition - curInstSettings.isWorldPosition);
     if (distance > mRenderData.rdInteractionMinRange) {
-      nearInstances.emplace(id);
+      nearInstances.emplace_back(id);
     }
   }
 
@@ -2725,10 +2739,10 @@ void OGLRenderer::findInteractionInstances() {
   mRenderData.rdNumberOfInteractionCandidates = nearInstances.size();
 
   if (mRenderData.rdDrawInteractionAABBs == interactionDebugDraw::distance) {
-    mRenderData.rdInteractionCandidates = nearInstances;
+    mRenderData.rdInteractionCandidates.insert(nearInstances.begin(), nearInstances.end());
   }
 
-  std::set<int> instancesFacingToUs{};
+  std::pmr::vector<int> instancesFacingToUs(&mFrameArena);
   for (const auto& id : nearInstances) {
     std::shared_ptr<AssimpInstance> instance = mModelInstCamData.micAssimpInstances.at(id);
     InstanceSettings instSettings = instance->getInstanceSettings();
@@ -2738,7 +2752,7 @@ void OGLRenderer::findInteractionInstances() {
     float instAngle = glm::degrees(glm::acos(glm::dot(instance->get2DRotationVector(), -distanceVector)));
 
     if (angle < mRenderData.rdInteractionFOV && instAngle < mRenderData.rdInteractionFOV)  {
-      instancesFacingToUs.emplace(id);
+      instancesFacingToUs.emplace_back(id);
     }
   }
 
@@ -2747,10 +2761,10 @@ void OGLRenderer::findInteractionInstances() {
   }
 
   if (mRenderData.rdDrawInteractionAABBs == interactionDebugDraw::facingTowardsUs) {
-    mRenderData.rdInteractionCandidates = instancesFacingToUs;
+    mRenderData.rdInteractionCandidates.insert(instancesFacingToUs.begin(), instancesFacingToUs.end());
   }
 
-  std::vector<std::pair<float, int>> sortedDistances;
+  std::pmr::vector<std::pair<float, int>> sortedDistances(&mFrameArena);
   for (const auto& id : instancesFacingToUs) {
     std::shared_ptr<AssimpInstance> instance = mModelInstCamData.micAssimpInstances.at(id);
     InstanceSettings instSettings = instance->getInstanceSettings();
@@ -2774,10 +2788,6 @@ void OGLRenderer::drawInteractionDebug() {
 
   glm::vec4 aabbColor = glm::vec4(0.0f, 1.0f, 0.0f, 1.0f);
 
-  OGLLineMesh InteractionMesh;
-  OGLLineVertex vertex;
-  vertex.color = aabbColor;
-
   std::shared_ptr<AssimpInstance> instance = mModelInstCamData.micAssimpInstances.at(mModelInstCamData.micSelectedInstance);
   InstanceSettings instSettings = instance->getInstanceSettings();
 
@@ -2791,47 +2801,11 @@ void OGLRenderer::drawInteractionDebug() {
     glm::vec2 maxQueryBoxTopLeft = glm::vec2(instancePos2D) - glm::vec2(mRenderData.rdInteractionMaxRange / 2.0f);
     glm::vec2 maxQueryBoxBottomRight = glm::vec2(instancePos2D) + glm::vec2(mRenderData.rdInteractionMaxRange / 2.0f);
 
-    /* min range */
-    vertex.position = glm::vec3(minQueryBoxTopLeft.x, instancePos.y, minQueryBoxTopLeft.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-    vertex.position = glm::vec3(minQueryBoxTopLeft.x, instancePos.y, minQueryBoxBottomRight.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-
-    vertex.position = glm::vec3(minQueryBoxTopLeft.x, instancePos.y, minQueryBoxBottomRight.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-    vertex.position = glm::vec3(minQueryBoxBottomRight.x, instancePos.y, minQueryBoxBottomRight.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-
-    vertex.position = glm::vec3(minQueryBoxBottomRight.x, instancePos.y, minQueryBoxBottomRight.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-    vertex.position = glm::vec3(minQueryBoxBottomRight.x, instancePos.y, minQueryBoxTopLeft.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-
-    vertex.position = glm::vec3(minQueryBoxBottomRight.x, instancePos.y, minQueryBoxTopLeft.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-    vertex.position = glm::vec3(minQueryBoxTopLeft.x, instancePos.y, minQueryBoxTopLeft.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-
-    /* max range */
-    vertex.position = glm::vec3(maxQueryBoxTopLeft.x, instancePos.y, maxQueryBoxTopLeft.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-    vertex.position = glm::vec3(maxQueryBoxTopLeft.x, instancePos.y, maxQueryBoxBottomRight.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-
-    vertex.position = glm::vec3(maxQueryBoxTopLeft.x, instancePos.y, maxQueryBoxBottomRight.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-    vertex.position = glm::vec3(maxQueryBoxBottomRight.x, instancePos.y, maxQueryBoxBottomRight.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-
-    vertex.position = glm::vec3(maxQueryBoxBottomRight.x, instancePos.y, maxQueryBoxBottomRight.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-    vertex.position = glm::vec3(maxQueryBoxBottomRight.x, instancePos.y, maxQueryBoxTopLeft.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-
-    vertex.position = glm::vec3(maxQueryBoxBottomRight.x, instancePos.y, maxQueryBoxTopLeft.y);
-    InteractionMesh.vertices.emplace_back(vertex);
-    vertex.position = glm::vec3(maxQueryBoxTopLeft.x, instancePos.y, maxQueryBoxTopLeft.y);
-    InteractionMesh.vertices.emplace_back(vertex);
+    /* min and max range */
+    mDebugDraw.addBox(debugDrawCategory::interaction, glm::vec3(minQueryBoxTopLeft.x, instancePos.y, minQueryBoxTopLeft.y),
+      glm::vec3(minQueryBoxBottomRight.x, instancePos.y, minQueryBoxBottomRight.y), aabbColor);
+    mDebugDraw.addBox(debugDrawCategory::interaction, glm::vec3(maxQueryBoxTopLeft.x, instancePos.y, maxQueryBoxTopLeft.y),
+      glm::vec3(maxQueryBoxBottomRight.x, instancePos.y, maxQueryBoxBottomRight.y), aabbColor);
   }
 
   /* draw FOV lines */
@@ -2843,9 +2817,6 @@ void OGLRenderer::drawInteractionDebug() {
       std::shared_ptr<AssimpInstance> fovInstance = mModelInstCamData.micAssimpInstances.at(id);
       InstanceSettings fovInstSettings = fovInstance->getInstanceSettings();
 
-      vertex.position = fovInstSettings.isWorldPosition;
-      InteractionMesh.vertices.emplace_back(vertex);
-
       float minAngle = fovInstSettings.isWorldRotation.y - mRenderData.rdInteractionFOV;
       if (minAngle < -180.0f) {
          minAngle += 360.0f;
@@ -2855,11 +2826,8 @@ void OGLRenderer::drawInteractionDebug() {
       }
       float sinRot = std::sin(glm::radians(minAngle));
       float cosRot = std::cos(glm::radians(minAngle));
-      vertex.position = fovInstSettings.isWorldPosition + glm::normalize(glm::vec3(sinRot, 0.0f, cosRot)) * 3.0f;
-      InteractionMesh.vertices.emplace_back(vertex);
-
-      vertex.position = fovInstSettings.isWorldPosition;
-      InteractionMesh.vertices.emplace_back(vertex);
+      mDebugDraw.addLine(debugDrawCategory::interaction, fovInstSettings.isWorldPosition,
+        fovInstSettings.isWorldPosition + glm::normalize(glm::vec3(sinRot, 0.0f, cosRot)) * 3.0f, aabbColor);
 
       float maxAngle = fovInstSettings.isWorldRotation.y + mRenderData.rdInteractionFOV;
       if (maxAngle < -180.0f) {
@@ -2870,20 +2838,11 @@ void OGLRenderer::drawInteractionDebug() {
       }
       sinRot = std::sin(glm::radians(maxAngle));
       cosRot = std::cos(glm::radians(maxAngle));
-      vertex.position = fovInstSettings.isWorldPosition + glm::normalize(glm::vec3(sinRot, 0.0f, cosRot)) * 3.0f;
-      InteractionMesh.vertices.emplace_back(vertex);
+      mDebugDraw.addLine(debugDrawCategory::interaction, fovInstSettings.isWorldPosition,
+        fovInstSettings.isWorldPosition + glm::normalize(glm::vec3(sinRot, 0.0f, cosRot)) * 3.0f, aabbColor);
     }
   }
 
-  if (!InteractionMesh.vertices.empty()) {
-    mUploadToVBOTimer.start();
-    mLineVertexBuffer.uploadData(InteractionMesh);
-    mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
-
-    mLineShader.use();
-    mLineVertexBuffer.bindAndDraw(GL_LINES, 0, InteractionMesh.vertices.size());
-  }
-
   /* draw instance AABBs */
   if (mRenderData.rdInteractionCandidates.empty()) {
     return;
@@ -2894,42 +2853,25 @@ void OGLRenderer::drawInteractionDebug() {
     instancesToDraw.emplace_back(mModelInstCamData.micAssimpInstances.at(id));
   }
 
-  drawAABBs(instancesToDraw, aabbColor);
+  drawAABBs(instancesToDraw, aabbColor, debugDrawCategory::interaction);
 }
 
-void OGLRenderer::drawAABBs(std::vector<std::shared_ptr<AssimpInstance>> instances, glm::vec4 aabbColor) {
-  std::shared_ptr<OGLLineMesh> aabbLineMesh = nullptr;;
-
-  mAABBMesh->vertices.clear();
-  AABB instanceAABB;
-  mAABBMesh->vertices.resize(instances.size() * instanceAABB.getAABBLines(aabbColor)->vertices.size());
+void OGLRenderer::drawAABBs(std::vector<std::shared_ptr<AssimpInstance>> instances, glm::vec4 aabbColor,
+    debugDrawCategory category) {
+  if (!mDebugDraw.isEnabled(category)) {
+    return;
+  }
 
-  for (size_t i = 0; i < instances.size(); ++i) {
-    InstanceSettings instSettings = instances.at(i)->getInstanceSettings();
+  for (const auto& instance : instances) {
+    InstanceSettings instSettings = instance->getInstanceSettings();
 
     /* skip null instance */
     if (instSettings.isInstanceIndexPosition == 0) {
       continue;
     }
 
-    std::shared_ptr<AssimpModel> model = instances.at(i)->getModel();
-
-    instanceAABB = model->getAABB(instSettings);
-    aabbLineMesh = instanceAABB.getAABBLines(aabbColor);
-
-    if (aabbLineMesh) {
-      std::copy(aabbLineMesh->vertices.begin(), aabbLineMesh->vertices.end(),
-        mAABBMesh->vertices.begin() + i * aabbLineMesh->vertices.size());
-    }
-  }
-
-  if (!mAABBMesh->vertices.empty()) {
-    mUploadToVBOTimer.start();
-    mLineVertexBuffer.uploadData(*mAABBMesh);
-    mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
-
-    mLineShader.use();
-    mLineVertexBuffer.bindAndDraw(GL_LINES, 0, mAABBMesh->vertices.size());
+    AABB instanceAABB = instance->getModel()->getAABB(instSettings);
+    mDebugDraw.addBox(category, instanceAABB.getMinPos(), instanceAABB.getMaxPos(), aabbColor);
   }
 }
 
@@ -2996,58 +2938,18 @@ void OGLRenderer::resetLevelData() {
   }
 }
 
-void OGLRenderer::drawLevelAABB() {
-  if (!mLevelAABBMesh->vertices.empty()) {
-    mLineShader.use();
-    mLevelAABBVertexBuffer.bindAndDraw(GL_LINES, 0, mLevelAABBMesh->vertices.size());
-  }
-}
-
-void OGLRenderer::drawLevelWireframe() {
-  if (!mLevelWireframeMesh->vertices.empty()) {
-    mLineShader.use();
-    mLevelWireframeVertexBuffer.bindAndDraw(GL_LINES, 0, mLevelWireframeMesh->vertices.size());
-  }
-}
-
-void OGLRenderer::drawLevelOctree() {
-  if (!mLevelOctreeMesh->vertices.empty()) {
-    mLineShader.use();
-    mLevelOctreeVertexBuffer.bindAndDraw(GL_LINES, 0, mLevelOctreeMesh->vertices.size());
-  }
-}
-
-void OGLRenderer::drawLevelCollisionTriangles() {
-  if (!mLevelCollidingTriangleMesh->vertices.empty()) {
-    mUploadToVBOTimer.start();
-    mLineVertexBuffer.uploadData(*mLevelCollidingTriangleMesh);
-    mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
-
-    mLineShader.use();
-    mLineVertexBuffer.bindAndDraw(GL_LINES, 0, mLevelCollidingTriangleMesh->vertices.size());
-  }
-}
-
-void OGLRenderer::drawIKDebugLines() {
-  if (!mIKFootPointMesh->vertices.empty()) {
-    mUploadToVBOTimer.start();
-    mIKLinesVertexBuffer.uploadData(*mIKFootPointMesh);
-    mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
-
-    mLineShader.use();
-    mIKLinesVertexBuffer.bindAndDraw(GL_LINES, 0, mIKFootPointMesh->vertices.size());
+void OGLRenderer::submitLevelLines(LineVertexBuffer& lineBuffer, size_t vertexCount) {
+  if (vertexCount == 0) {
+    return;
   }
-}
-
-void OGLRenderer::drawAdjacentDebugTriangles() {
-  if (!mLevelGroundNeighborsMesh->vertices.empty()) {
-    mUploadToVBOTimer.start();
-    mLineVertexBuffer.uploadData(*mLevelGroundNeighborsMesh);
-    mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
 
-    mLineShader.use();
-    mLineVertexBuffer.bindAndDraw(GL_LINES, 0, mLevelGroundNeighborsMesh->vertices.size());
-  }
+  RenderCommand lineCommand{};
+  lineCommand.rcProgram = mLineShader.getProgram();
+  lineCommand.rcVertexArray = lineBuffer.getVertexArray();
+  lineCommand.rcMode = GL_LINES;
+  lineCommand.rcVertexCount = vertexCount;
+  lineCommand.rcSortKey = RenderQueue::createSortKey(renderPass::debugLines, lineCommand.rcProgram, 0, 0);
+  mRenderQueue.submit(lineCommand);
 }
 
 void OGLRenderer::drawGroundTriangles() {
@@ -3059,22 +2961,11 @@ void OGLRenderer::drawGroundTriangles() {
   glDisable(GL_BLEND);
 }
 
-void OGLRenderer::drawInstancePaths() {
-  if (!mInstancePathMesh->vertices.empty()) {
-    mUploadToVBOTimer.start();
-    mLineVertexBuffer.uploadData(*mInstancePathMesh);
-    mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
-
-    mLineShader.use();
-    mLineVertexBuffer.bindAndDraw(GL_LINES, 0, mInstancePathMesh->vertices.size());
-  }
-}
-
 void OGLRenderer::drawCollisionDebug() {
   /* draw AABB lines and bounding sphere of selected instance */
   if (mRenderData.rdDrawCollisionAABBs == collisionDebugDraw::colliding ||
       mRenderData.rdDrawCollisionAABBs == collisionDebugDraw::all) {
-    std::set<int> uniqueInstanceIds;
+    std::pmr::set<int> uniqueInstanceIds(&mFrameArena);
 
     for (const auto& colliding : mModelInstCamData.micInstanceCollisions) {
       uniqueInstanceIds.insert(colliding.first);
@@ -3091,7 +2982,7 @@ void OGLRenderer::drawCollisionDebug() {
       }
       /* draw red lines for collisions */
       aabbColor = glm::vec4(1.0f, 0.0f, 0.0f, 1.0f);
-      drawAABBs(instancestoDraw, aabbColor);
+      drawAABBs(instancestoDraw, aabbColor, debugDrawCategory::collision);
     }
 
     /* draw yellow lines for non-colliiding instances */
@@ -3099,7 +2990,7 @@ void OGLRenderer::drawCollisionDebug() {
     if (mRenderData.rdDrawCollisionAABBs == collisionDebugDraw::all) {
       instancestoDraw = mModelInstCamData.micAssimpInstances;
       aabbColor = glm::vec4(1.0f, 1.0f, 0.0f, 1.0f);
-      drawAABBs(instancestoDraw, aabbColor);
+      drawAABBs(instancestoDraw, aabbColor, debugDrawCategory::collision);
     }
   }
 
@@ -3174,20 +3065,20 @@ void OGLRenderer::drawSelectedBoundingSpheres() {
 
 void OGLRenderer::drawCollidingBoundingSpheres() {
   /* split instances in models - use a std::set to get unique instance IDs */
-  std::map<std::string, std::set<int>> modelToInstanceMapping;
+  std::pmr::map<std::shared_ptr<AssimpModel>, std::pmr::set<int>> modelToInstanceMapping(&mFrameArena);
 
   for (const auto& instancePairs : mModelInstCamData.micInstanceCollisions) {
-    modelToInstanceMapping[mModelInstCamData.micAssimpInstances.at(instancePairs.first)->getModel()->getModelFileName()].insert(instancePairs.first);
-    modelToInstanceMapping[mModelInstCamData.micAssimpInstances.at(instancePairs.second)->getModel()->getModelFileName()].insert(instancePairs.second);
+    modelToInstanceMapping[mModelInstCamData.micAssimpInstances.at(instancePairs.first)->getModel()].insert(instancePairs.first);
+    modelToInstanceMapping[mModelInstCamData.micAssimpInstances.at(instancePairs.second)->getModel()].insert(instancePairs.second);
   }
   for (const auto& collisionInstances : modelToInstanceMapping) {
-    std::shared_ptr<AssimpModel> model = getModel(collisionInstances.first);
+    std::shared_ptr<AssimpModel> model = collisionInstances.first;
     if (!model->hasAnimations()) {
       continue;
     }
 
     size_t numInstances = collisionInstances.second.size();
-    std::vector<int> instanceIds = std::vector(collisionInstances.second.begin(), collisionInstances.second.end());
+    std::pmr::vector<int> instanceIds(collisionInstances.second.begin(), collisionInstances.second.end(), &mFrameArena);
 
     size_t numberOfBones = model->getBoneList().size();
 
@@ -3297,7 +3188,7 @@ void OGLRenderer::runBoundingSphereComputeShaders(std::shared_ptr<AssimpModel> m
   mEmptyBoneOffsetBuffer.uploadSsboData(emptyBoneOffsets);
 
   /* do a single iteration of all clips in parallel */
-  mAssimpTransformComputeShader.use();
+  mAssimpTransformComputeShader.getVariant().use();
 
   mUploadToUBOTimer.start();
   model->bindAnimLookupBuffer(0);
@@ -3343,7 +3234,357 @@ void OGLRenderer::drawSkybox() {
   mSkyboxTexture.unbindCubemap();
 }
 
+/* advances all instances by one time step and stores the per-instance GPU data in the packet */
+void OGLRenderer::simulate(FramePacket& packet, float deltaTime, bool addDebugDraw) {
+  PROFILE_FUNCTION();
+  mSimulationTimer.start();
+
+  packet.fpFaceAnimTime = 0.0f;
+  packet.fpLevelCollisionTime = 0.0f;
+  packet.fpPathFindingTime = 0.0f;
+  packet.fpLevelGroundNeighborUpdateTime = 0.0f;
+
+  mOctree->clear();
+  packet.fpOctree = mOctree.get();
+
+  /* reused for all instances, the query clears it */
+  std::pmr::vector<MeshTriangle> collidingTriangles(&mFrameArena);
+
+  packet.fpNumberOfModels = mModelInstCamData.micModelList.size();
+  if (packet.fpModels.size() < packet.fpNumberOfModels) {
+    packet.fpModels.resize(packet.fpNumberOfModels);
+  }
+  /* do not keep deleted models alive */
+  for (size_t modelIndex = packet.fpNumberOfModels; modelIndex < packet.fpModels.size(); ++modelIndex) {
+    packet.fpModels.at(modelIndex).fpmModel.reset();
+  }
+
+  for (size_t modelIndex = 0; modelIndex < packet.fpNumberOfModels; ++modelIndex) {
+    const std::shared_ptr<AssimpModel>& model = mModelInstCamData.micModelList.at(modelIndex);
+    const std::vector<std::shared_ptr<AssimpInstance>>& instances = mModelInstCamData.micAssimpInstancesPerModel[model->getModelFileName()];
+    size_t numberOfInstances = instances.size();
+
+    FramePacketModel& packetModel = packet.fpModels.at(modelIndex);
+    packetModel.fpmModel = model;
+    packetModel.fpmNumberOfInstances = numberOfInstances;
+
+    if (numberOfInstances == 0 || model->getTriangleCount() == 0) {
+      continue;
+    }
+
+    packetModel.fpmWorldPosMatrices.resize(numberOfInstances);
+
+    if (model->hasAnimations() && !model->getBoneList().empty()) {
+      ModelSettings modSettings = model->getModelSettings();
+
+      packetModel.fpmPerInstanceAnimData.resize(numberOfInstances);
+      packetModel.fpmFaceAnimPerInstanceData.resize(numberOfInstances);
+
+      for (size_t i = 0; i < numberOfInstances; ++i) {
+        InstanceSettings instSettings = instances.at(i)->getInstanceSettings();
+
+        /* animations */
+        PerInstanceAnimData animData{};
+        animData.firstAnimClipNum = instSettings.isFirstAnimClipNr;
+        animData.secondAnimClipNum = instSettings.isSecondAnimClipNr;
+        animData.firstClipReplayTimestamp = instSettings.isFirstClipAnimPlayTimePos;
+        animData.secondClipReplayTimestamp = instSettings.isSecondClipAnimPlayTimePos;
+        animData.blendFactor = instSettings.isAnimBlendFactor;
+
+        if (model->hasHeadMovementAnimationsMapped()) {
+          if (instSettings.isHeadLeftRightMove > 0.0f) {
+            animData.headLeftRightAnimClipNum = modSettings.msHeadMoveClipMappings[headMoveDirection::left];
+          } else {
+            animData.headLeftRightAnimClipNum = modSettings.msHeadMoveClipMappings[headMoveDirection::right];
+          }
+          if (instSettings.isHeadUpDownMove > 0.0f) {
+            animData.headUpDownAnimClipNum = modSettings.msHeadMoveClipMappings[headMoveDirection::up];
+          } else {
+            animData.headUpDownAnimClipNum = modSettings.msHeadMoveClipMappings[headMoveDirection::down];
+          }
+          animData.headLeftRightReplayTimestamp = std::fabs(instSettings.isHeadLeftRightMove) * model->getMaxClipDuration();
+          animData.headUpDownReplayTimestamp = std::fabs(instSettings.isHeadUpDownMove) * model->getMaxClipDuration();
+        }
+
+        packetModel.fpmPerInstanceAnimData.at(i) = animData;
+
+        instances.at(i)->updateAnimation(deltaTime);
+
+        /* get AABB and calculate 3D boundaries */
+        AABB instanceAABB = model->getAABB(instSettings);
+
+        glm::vec3 position = instanceAABB.getMinPos();
+        glm::vec3 size = glm::vec3(std::fabs(instanceAABB.getMaxPos().x - instanceAABB.getMinPos().x),
+                                   std::fabs(instanceAABB.getMaxPos().y - instanceAABB.getMinPos().y),
+                                   std::fabs(instanceAABB.getMaxPos().z - instanceAABB.getMinPos().z));
+
+        BoundingBox3D box{position, size};
+        instances.at(i)->setBoundingBox(box);
+
+        /* add instance to octree */
+        mOctree->add(instSettings.isInstanceIndexPosition);
+
+        /* use a glm::vec3 to transport all morph data */
+        mFaceAnimTimer.start();
+
+        glm::vec4 morphData = glm::vec4(0.0f);
+        if (instSettings.isFaceAnimType != faceAnimation::none)  {
+          morphData.x = instSettings.isFaceAnimWeight;
+          morphData.y = static_cast<int>(instSettings.isFaceAnimType) - 1;
+          morphData.z = model->getAnimMeshVertexSize();
+        }
+        packetModel.fpmFaceAnimPerInstanceData.at(i) = morphData;
+
+        packet.fpFaceAnimTime += mFaceAnimTimer.stop();
+
+        /* gravity and ground collisions */
+        mLevelCollisionTimer.start();
+
+        /* extend the AABB a bit below the feet to allow a better ground collision handling */
+        glm::vec3 instBoxPos = position - mRenderData.rdLevelCollisionAABBExtension;
+        glm::vec3 instBoxSize = size + mRenderData.rdLevelCollisionAABBExtension;
+        BoundingBox3D instanceBox{instBoxPos, instBoxSize};
+
+        mTriangleOctree->query(instanceBox, collidingTriangles);
+        instances.at(i)->setCollidingTriangles(collidingTriangles);
+
+        /* set state to "instance on ground" if gravity is disabled */
+        bool instanceOnGround = true;
+        if (mRenderData.rdEnableSimpleGravity) {
+          glm::vec3 gravity = glm::vec3(0.0f, GRAVITY_CONSTANT * deltaTime, 0.0f);
+          glm::vec3 footPoint = instSettings.isWorldPosition;
+
+          instanceOnGround = false;
+          for (const auto& tri : collidingTriangles) {
+            /* check for slope */
+            bool isWalkable = false;
+            if (glm::dot(tri.normal, glm::vec3(0.0f, 1.0f, 0.0f)) >= std::cos(glm::radians(mRenderData.rdMaxLevelGroundSlopeAngle))) {
+              isWalkable = true;
+            }
+
+            if (isWalkable) {
+              std::optional<glm::vec3> result = Tools::rayTriangleIntersection(instSettings.isWorldPosition - gravity, glm::vec3(0.0f, 1.0f, 0.0f), tri);
+              if (result.has_value()) {
+                footPoint = result.value();
+                instances.at(i)->setWorldPosition(footPoint);
+                instanceOnGround = true;
+              }
+            }
+          }
+        }
+        instances.at(i)->setInstanceOnGround(instanceOnGround);
+        instances.at(i)->applyGravity(deltaTime);
+        packet.fpLevelCollisionTime += mLevelCollisionTimer.stop();
+
+        /* update instance speed and position */
+        instances.at(i)->updateInstanceSpeed(deltaTime);
+        instances.at(i)->updateInstancePosition(deltaTime);
+
+        packetModel.fpmWorldPosMatrices.at(i) = instances.at(i)->getWorldTransformMatrix();
+
+        /* path update */
+        if (mRenderData.rdEnableNavigation && instSettings.isNavigationEnabled) {
+          mPathFindingTimer.start();
+          int pathTargetInstance = instSettings.isPathTargetInstance;
+
+          /* invalid target, reset */
+          if (pathTargetInstance >= mModelInstCamData.micAssimpInstances.size()) {
+            pathTargetInstance = -1;
+            instances.at(i)->setPathTargetInstanceId(pathTargetInstance);
+          }
+
+          int pathTargetInstanceTriIndex = -1;
+          glm::vec3 pathTargetWorldPos = glm::vec3(0.0f);
+          if (pathTargetInstance != -1) {
+            /* target instance is always valid here */
+            std::shared_ptr<AssimpInstance> targetInstance = mModelInstCamData.micAssimpInstances.at(pathTargetInstance);
+            pathTargetInstanceTriIndex = targetInstance->getCurrentGroundTriangleIndex();
+            pathTargetWorldPos = targetInstance->getWorldPosition();
+          }
+
+          /* do a path update only if both start and end triangle indices are valid and we or target changed its triangle */
+          if ((instSettings.isCurrentGroundTriangleIndex > -1 && pathTargetInstanceTriIndex > -1) &&
+              (instSettings.isCurrentGroundTriangleIndex != instSettings.isPathStartTriangleIndex ||
+              pathTargetInstanceTriIndex != instSettings.isPathTargetTriangleIndex)) {
+            instances.at(i)->setPathStartTriIndex(instSettings.isCurrentGroundTriangleIndex);
+            instances.at(i)->setPathTargetTriIndex(pathTargetInstanceTriIndex);
+
+            std::vector<int> pathToTarget = mPathFinder.findPath(instSettings.isCurrentGroundTriangleIndex, pathTargetInstanceTriIndex);
+
+            /* disable navigation if target is unreachable */
+            if (pathToTarget.empty()) {
+              instances.at(i)->setNavigationEnabled(false);
+              instances.at(i)->setPathTargetInstanceId(-1);
+            } else {
+              instances.at(i)->setPathToTarget(pathToTarget);
+            }
+          }
+
+          std::vector<int> pathToTarget = instances.at(i)->getPathToTarget();
+
+          /* remove first and last elements, they are the target centers of start and target triangles */
+          if (pathToTarget.size() > 1) {
+            pathToTarget.pop_back();
+          }
+          if (!pathToTarget.empty()) {
+            pathToTarget.erase(pathToTarget.begin());
+          }
+
+          /* navigate to target */
+          if (!pathToTarget.empty()) {
+            /* navigate to next triangle, not the one we may stand on (start triangle)*/
+            int nextTarget = pathToTarget.at(0);
+            glm::vec3 destPos = mPathFinder.getTriangleCenter(nextTarget);
+            instances.at(i)->rotateTo(destPos, deltaTime);
+          } else {
+            /* empty path means we have only the target itself left */
+            instances.at(i)->rotateTo(pathTargetWorldPos, deltaTime);
+          }
+
+          if (addDebugDraw && mDebugDraw.isEnabled(debugDrawCategory::instancePaths) && pathTargetInstance > -1) {
+            glm::vec3 pathColor = glm::vec3(0.4f, 1.0f, 0.4f);
+            glm::vec3 pathYOffset = glm::vec3(0.0f, 1.0f, 0.0f);
+
+            glm::vec3 pathStartPos = instSettings.isWorldPosition + pathYOffset;
+            if (!pathToTarget.empty()) {
+              mDebugDraw.addLine(debugDrawCategory::instancePaths, pathStartPos,
+                mPathFinder.getTriangleCenter(pathToTarget.at(0)) + pathYOffset, pathColor);
+
+              mDebugLineVertices.clear();
+              mPathFinder.getPathLines(pathToTarget, pathColor, pathYOffset, mDebugLineVertices);
+              mDebugDraw.addLines(debugDrawCategory::instancePaths, mDebugLineVertices);
+
+              pathStartPos = mPathFinder.getTriangleCenter(pathToTarget.at(pathToTarget.size() - 1)) + pathYOffset;
+            }
+
+            mDebugDraw.addLine(debugDrawCategory::instancePaths, pathStartPos, pathTargetWorldPos + pathYOffset,
+              pathColor);
+          }
+          packet.fpPathFindingTime += mPathFindingTimer.stop();
+        }
+
+        /* neighbor triangles */
+        mLevelGroundNeighborUpdateTimer.start();
+        int groundTri = instSettings.isCurrentGroundTriangleIndex;
+        if (groundTri > -1) {
+          std::vector<int> neighborIndices = mPathFinder.getGroundTriangleNeighbors(groundTri);
+          instances.at(i)->setNeighborGroundTriangleIndices(neighborIndices);
+
+          if (addDebugDraw && mDebugDraw.isEnabled(debugDrawCategory::groundNeighbors)) {
+            mDebugLineVertices.clear();
+            mPathFinder.getTriangleLines(neighborIndices, glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.8f),
+              glm::vec3(0.0f, 0.01f, 0.0f), mDebugLineVertices);
+            mDebugDraw.addLines(debugDrawCategory::groundNeighbors, mDebugLineVertices);
+          }
+        }
+        packet.fpLevelGroundNeighborUpdateTime += mLevelGroundNeighborUpdateTimer.stop();
+      }
+    } else {
+      for (size_t i = 0; i < numberOfInstances; ++i) {
+        InstanceSettings instSettings = instances.at(i)->getInstanceSettings();
+
+        /* get AABB and calculate 3D boundaries */
+        AABB instanceAABB = model->getAABB(instSettings);
+
+        glm::vec3 position = instanceAABB.getMinPos();
+        glm::vec3 size = glm::vec3(std::fabs(instanceAABB.getMaxPos().x - instanceAABB.getMinPos().x),
+                                   std::fabs(instanceAABB.getMaxPos().y - instanceAABB.getMinPos().y),
+                                   std::fabs(instanceAABB.getMaxPos().z - instanceAABB.getMinPos().z));
+
+        BoundingBox3D box{position, size};
+        instances.at(i)->setBoundingBox(box);
+
+        /* add instance to octree */
+        mOctree->add(instSettings.isInstanceIndexPosition);
+
+        /* gravity and ground collisions */
+        mLevelCollisionTimer.start();
+
+        /* extend the AABB a bit below the feet to allow a better ground collision handling */
+        glm::vec3 instBoxPos = position - mRenderData.rdLevelCollisionAABBExtension;
+        glm::vec3 instBoxSize = size + mRenderData.rdLevelCollisionAABBExtension;
+        BoundingBox3D instanceBox{instBoxPos, instBoxSize};
+
+        mTriangleOctree->query(instanceBox, collidingTriangles);
+        instances.at(i)->setCollidingTriangles(collidingTriangles);
+
+        /* set state to "instance on ground" if gravity is disabled */
+        bool instanceOnGround = true;
+        if (mRenderData.rdEnableSimpleGravity) {
+          glm::vec3 gravity = glm::vec3(0.0f, GRAVITY_CONSTANT * deltaTime, 0.0f);
+          glm::vec3 footPoint = instSettings.isWorldPosition;
+
+          instanceOnGround = false;
+          for (const auto& tri : collidingTriangles) {
+            /* check for slope */
+            bool isWalkable = false;
+            if (glm::dot(tri.normal, glm::vec3(0.0f, 1.0f, 0.0f)) >= std::cos(glm::radians(mRenderData.rdMaxLevelGroundSlopeAngle))) {
+              isWalkable = true;
+            }
+
+            if (isWalkable) {
+              std::optional<glm::vec3> result = Tools::rayTriangleIntersection(instSettings.isWorldPosition - gravity, glm::vec3(0.0f, 1.0f, 0.0f), tri);
+              if (result.has_value()) {
+                footPoint = result.value();
+                instances.at(i)->setWorldPosition(footPoint);
+                instanceOnGround = true;
+              }
+            }
+          }
+        }
+        instances.at(i)->setInstanceOnGround(instanceOnGround);
+        instances.at(i)->applyGravity(deltaTime);
+        packet.fpLevelCollisionTime += mLevelCollisionTimer.stop();
+
+        instances.at(i)->updateInstancePosition(deltaTime);
+        packetModel.fpmWorldPosMatrices.at(i) = instances.at(i)->getWorldTransformMatrix();
+      }
+    }
+  }
+
+  packet.fpValid = true;
+  packet.fpSimulationTime = mSimulationTimer.stop();
+}
+
+bool OGLRenderer::isFramePacketCurrent(const FramePacket& packet) {
+  if (packet.fpOctree != mOctree.get() || packet.fpNumberOfModels != mModelInstCamData.micModelList.size()) {
+    return false;
+  }
+
+  for (size_t modelIndex = 0; modelIndex < packet.fpNumberOfModels; ++modelIndex) {
+    const std::shared_ptr<AssimpModel>& model = mModelInstCamData.micModelList.at(modelIndex);
+    const FramePacketModel& packetModel = packet.fpModels.at(modelIndex);
+    if (packetModel.fpmModel != model ||
+        packetModel.fpmNumberOfInstances != mModelInstCamData.micAssimpInstancesPerModel[model->getModelFileName()].size()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void OGLRenderer::startSimulation(float deltaTime) {
+  /* draw() skips frames without a time step, nothing would consume the packet */
+  if (!mRenderData.rdPipelinedSimulation || deltaTime == 0.0f || !mApplicationRunning) {
+    return;
+  }
+
+  unsigned int nextFramePacket = (mRenderFramePacket + 1) % mFramePackets.size();
+  mSimulationResult = mSimulationThread.submit([this, nextFramePacket, deltaTime]() {
+    simulate(mFramePackets.at(nextFramePacket), deltaTime, true);
+  });
+}
+
+void OGLRenderer::finishSimulation() {
+  if (!mSimulationResult.valid()) {
+    return;
+  }
+
+  mSimulationResult.get();
+  mRenderFramePacket = (mRenderFramePacket + 1) % mFramePackets.size();
+}
+
 bool OGLRenderer::draw(float deltaTime) {
+  PROFILE_FUNCTION();
   if (!mApplicationRunning) {
     return false;
   }
@@ -3369,6 +3610,12 @@ bool OGLRenderer::draw(float deltaTime) {
   mRenderData.rdFrameTime = mFrameTimer.stop();
   mFrameTimer.start();
 
+  /* the containers of the last frame are gone, all arena memory can be reused */
+  mFrameArena.reset();
+  mRenderData.rdFrameArenaBytes = mFrameArena.getLastFrameBytes();
+  mRenderData.rdFrameArenaCapacity = mFrameArena.getCapacity();
+  uint64_t frameStartAllocations = AllocationCounter::getAllocations();
+
   /* reset timers and other values */
   mRenderData.rdMatricesSize = 0;
   mRenderData.rdMatrixGenerateTime = 0.0f;
@@ -3390,9 +3637,20 @@ bool OGLRenderer::draw(float deltaTime) {
   mRenderData.rdIKTime = 0.0f;
   mRenderData.rdPathFindingTime = 0.0f;
   mRenderData.rdLevelGroundNeighborUpdateTime = 0.0f;
-
-  mLevelGroundNeighborsMesh->vertices.clear();
-  mInstancePathMesh->vertices.clear();
+  mRenderQueue.resetStats();
+
+  /* disabled categories drop their debug lines right at the add call */
+  bool hasLevels = mModelInstCamData.micLevels.size() > 1;
+  mDebugDraw.setCategoryEnabled(debugDrawCategory::coordArrows, mRenderData.rdApplicationMode == appMode::edit);
+  mDebugDraw.setCategoryEnabled(debugDrawCategory::interaction, mRenderData.rdInteraction);
+  mDebugDraw.setCategoryEnabled(debugDrawCategory::collision,
+    mRenderData.rdDrawCollisionAABBs != collisionDebugDraw::none);
+  mDebugDraw.setCategoryEnabled(debugDrawCategory::levelCollision,
+    hasLevels && mRenderData.rdDrawLevelCollisionTriangles);
+  mDebugDraw.setCategoryEnabled(debugDrawCategory::groundNeighbors,
+    hasLevels && mRenderData.rdDrawNeighborTriangles);
+  mDebugDraw.setCategoryEnabled(debugDrawCategory::instancePaths, hasLevels && mRenderData.rdDrawInstancePaths);
+  mDebugDraw.setCategoryEnabled(debugDrawCategory::ikFootPoints, mRenderData.rdDrawIKDebugLines);
 
   /* save the selected instance for color highlight */
   std::shared_ptr<AssimpInstance> currentSelectedInstance = nullptr;
@@ -3456,7 +3714,8 @@ bool OGLRenderer::draw(float deltaTime) {
 
   mViewMatrix = cam->getViewMatrix();
 
-  std::vector<glm::mat4> matrixData;
+  std::pmr::vector<glm::mat4> matrixData(&mFrameArena);
+  matrixData.reserve(3);
   matrixData.emplace_back(mViewMatrix);
   matrixData.emplace_back(mProjectionMatrix);
 
@@ -3501,41 +3760,100 @@ bool OGLRenderer::draw(float deltaTime) {
   mRenderData.rdMatrixGenerateTime += mMatrixGenerateTimer.stop();
 
   mUploadToUBOTimer.start();
-  mUniformBuffer.uploadUboData(matrixData, 0);
+  mUniformBuffer.uploadUboData(matrixData.data(), matrixData.size(), 0);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
   /* draw skybox first */
   if (mRenderData.rdDrawSkybox) {
+    PROFILE_SCOPE("skybox");
+    mGpuTimer.start(gpuPass::skybox);
     drawSkybox();
+    mGpuTimer.stop(gpuPass::skybox);
   }
 
-  /* draw level(s) second */
-  for (const auto& level : mModelInstCamData.micLevels) {
-    if (level->getTriangleCount() == 0) {
-      continue;
-    }
+  /* draw level(s) second, the base instance selects the level matrix */
+  {
+    PROFILE_SCOPE("level");
+    mLevelMatrices.clear();
+    unsigned int levelId = 0;
+    for (const auto& level : mModelInstCamData.micLevels) {
+      ++levelId;
+      if (level->getTriangleCount() == 0) {
+        continue;
+      }
 
-    mAssimpLevelShader.use();
+      RenderCommand levelCommand{};
+      levelCommand.rcProgram = mAssimpLevelShader.getProgram();
+      levelCommand.rcBaseInstance = mLevelMatrices.size();
+      levelCommand.rcSortKey = RenderQueue::createSortKey(renderPass::level, levelCommand.rcProgram, 0, levelId);
+      level->submit(mRenderQueue, levelCommand);
 
-    mUploadToUBOTimer.start();
-    mShaderModelRootMatrixBuffer.uploadSsboData(level->getWorldTransformMatrix(), 1);
+      mLevelMatrices.emplace_back(level->getWorldTransformMatrix());
+    }
 
+    mUploadToUBOTimer.start();
+    mLevelMatrixBuffer.uploadSsboData(mLevelMatrices, 1);
     mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
-    level->draw();
+    mGpuTimer.start(gpuPass::level);
+    mRenderQueue.flush(renderPass::level);
+    mGpuTimer.stop(gpuPass::level);
   }
 
-  mOctree->clear();
+  /* a pipelined packet already advanced the instances, only rebuild its data if the scene changed meanwhile */
+  FramePacket& packet = mFramePackets.at(mRenderFramePacket);
+  if (!packet.fpValid) {
+    simulate(packet, deltaTime, true);
+  } else if (!isFramePacketCurrent(packet)) {
+    simulate(packet, 0.0f, false);
+  }
+  packet.fpValid = false;
+
+  mRenderData.rdSimulationTime = packet.fpSimulationTime;
+  mRenderData.rdFaceAnimTime += packet.fpFaceAnimTime;
+  mRenderData.rdLevelCollisionTime += packet.fpLevelCollisionTime;
+  mRenderData.rdPathFindingTime += packet.fpPathFindingTime;
+  mRenderData.rdLevelGroundNeighborUpdateTime += packet.fpLevelGroundNeighborUpdateTime;
 
   int firstPersonCamWorldPos = -1;
 
-  if (mRenderData.rdDrawIKDebugLines) {
-    mIKFootPointMesh->vertices.clear();
+  /* the per-instance data of all models goes into combined buffers, size them before the first model writes */
+  size_t numberOfDrawInstances = 0;
+  size_t numberOfDrawBoneMatrices = 0;
+  size_t numberOfPreSkinnedVertices = 0;
+  for (const auto& model : mModelInstCamData.micModelList) {
+    size_t numberOfInstances = mModelInstCamData.micAssimpInstancesPerModel[model->getModelFileName()].size();
+    if (numberOfInstances == 0 || model->getTriangleCount() == 0) {
+      continue;
+    }
+
+    numberOfDrawInstances += numberOfInstances;
+    if (model->hasAnimations() && !model->getBoneList().empty()) {
+      numberOfDrawBoneMatrices += model->getBoneList().size() * numberOfInstances;
+      if (mRenderData.rdComputePreSkinning) {
+        numberOfPreSkinnedVertices += model->getPreSkinningVertexCount() * numberOfInstances;
+      }
+    }
   }
 
+  mDrawWorldPosMatrices.resize(numberOfDrawInstances);
+  mSelectedInstance.resize(numberOfDrawInstances);
+  mDrawFaceAnimData.resize(numberOfDrawInstances);
+  mDrawInstanceOffsets.resize(numberOfDrawInstances);
+  mDrawBoneMatrixBuffer.checkForResize(numberOfDrawBoneMatrices * sizeof(glm::mat4));
+  mPreSkinnedVertexBuffer.checkForResize(numberOfPreSkinnedVertices * sizeof(OGLSkinnedVertex));
+  mOutOfLevelInstances.clear();
+
+  size_t instanceOffset = 0;
+  size_t boneMatrixOffset = 0;
+  size_t preSkinnedVertexOffset = 0;
+
+  unsigned int modelId = 0;
   for (const auto& model : mModelInstCamData.micModelList) {
-    size_t numberOfInstances = mModelInstCamData.micAssimpInstancesPerModel[model->getModelFileName()].size();
-    std::vector<std::shared_ptr<AssimpInstance>> instances = mModelInstCamData.micAssimpInstancesPerModel[model->getModelFileName()];
+    PROFILE_SCOPE("model");
+    ++modelId;
+    const std::vector<std::shared_ptr<AssimpInstance>>& instances = mModelInstCamData.micAssimpInstancesPerModel[model->getModelFileName()];
+    size_t numberOfInstances = instances.size();
     if (numberOfInstances > 0 && model->getTriangleCount() > 0) {
 
       /* animated models */
@@ -3544,237 +3862,33 @@ bool OGLRenderer::draw(float deltaTime) {
         size_t numberOfBones = model->getBoneList().size();
         ModelSettings modSettings = model->getModelSettings();
 
-        mMatrixGenerateTimer.start();
-
-        mPerInstanceAnimData.resize(numberOfInstances);
-        mPerInstanceAABB.resize(numberOfInstances);
-        mWorldPosMatrices.resize(numberOfInstances);
-        mSelectedInstance.resize(numberOfInstances);
+        const FramePacketModel& packetModel = packet.fpModels.at(modelId - 1);
+        const std::vector<glm::mat4>& worldPosMatrices = packetModel.fpmWorldPosMatrices;
 
-        mFaceAnimPerInstanceData.resize(numberOfInstances);
+        mMatrixGenerateTimer.start();
 
         for (size_t i = 0; i < numberOfInstances; ++i) {
           InstanceSettings instSettings = instances.at(i)->getInstanceSettings();
-
-          /* animations */
-          PerInstanceAnimData animData{};
-          animData.firstAnimClipNum = instSettings.isFirstAnimClipNr;
-          animData.secondAnimClipNum = instSettings.isSecondAnimClipNr;
-          animData.firstClipReplayTimestamp = instSettings.isFirstClipAnimPlayTimePos;
-          animData.secondClipReplayTimestamp = instSettings.isSecondClipAnimPlayTimePos;
-          animData.blendFactor = instSettings.isAnimBlendFactor;
-
-          if (model->hasHeadMovementAnimationsMapped()) {
-            if (instSettings.isHeadLeftRightMove > 0.0f) {
-              animData.headLeftRightAnimClipNum = modSettings.msHeadMoveClipMappings[headMoveDirection::left];
-            } else {
-              animData.headLeftRightAnimClipNum = modSettings.msHeadMoveClipMappings[headMoveDirection::right];
-            }
-            if (instSettings.isHeadUpDownMove > 0.0f) {
-              animData.headUpDownAnimClipNum = modSettings.msHeadMoveClipMappings[headMoveDirection::up];
-            } else {
-              animData.headUpDownAnimClipNum = modSettings.msHeadMoveClipMappings[headMoveDirection::down];
-            }
-            animData.headLeftRightReplayTimestamp = std::fabs(instSettings.isHeadLeftRightMove) * model->getMaxClipDuration();
-            animData.headUpDownReplayTimestamp = std::fabs(instSettings.isHeadUpDownMove) * model->getMaxClipDuration();
-          }
-
-          mPerInstanceAnimData.at(i) = animData;
+          glm::vec2& selected = mSelectedInstance.at(instanceOffset + i);
 
           if (mRenderData.rdApplicationMode == appMode::edit) {
             if (currentSelectedInstance == instances.at(i)) {
-              mSelectedInstance.at(i).x = mRenderData.rdSelectedInstanceHighlightValue;
+              selected.x = mRenderData.rdSelectedInstanceHighlightValue;
             } else {
-              mSelectedInstance.at(i).x = 1.0f;
+              selected.x = 1.0f;
             }
 
             if (mMousePick) {
-              mSelectedInstance.at(i).y = static_cast<float>(instSettings.isInstanceIndexPosition);
+              selected.y = static_cast<float>(instSettings.isInstanceIndexPosition);
             }
           } else {
-            mSelectedInstance.at(i).x = 1.0f;
+            selected.x = 1.0f;
           }
 
           if (camSettings.csCamType == cameraType::firstPerson && cam->getInstanceToFollow() &&
               instSettings.isInstanceIndexPosition == cam->getInstanceToFollow()->getInstanceIndexPosition()) {
             firstPersonCamWorldPos = instSettings.isInstanceIndexPosition;
           }
-
-          instances.at(i)->updateAnimation(deltaTime);
-
-          /* get AABB and calculate 3D boundaries */
-          AABB instanceAABB = model->getAABB(instSettings);
-
-          glm::vec3 position = instanceAABB.getMinPos();
-          glm::vec3 size = glm::vec3(std::fabs(instanceAABB.getMaxPos().x - instanceAABB.getMinPos().x),
-                                     std::fabs(instanceAABB.getMaxPos().y - instanceAABB.getMinPos().y),
-                                     std::fabs(instanceAABB.getMaxPos().z - instanceAABB.getMinPos().z));
-
-          BoundingBox3D box{position, size};
-          instances.at(i)->setBoundingBox(box);
-
-          /* add instance to octree */
-          mOctree->add(instSettings.isInstanceIndexPosition);
-
-          /* use a glm::vec3 to transport all morph data */
-          mFaceAnimTimer.start();
-
-          glm::vec4 morphData = glm::vec4(0.0f);
-          if (instSettings.isFaceAnimType != faceAnimation::none)  {
-            morphData.x = instSettings.isFaceAnimWeight;
-            morphData.y = static_cast<int>(instSettings.isFaceAnimType) - 1;
-            morphData.z = model->getAnimMeshVertexSize();
-          }
-          mFaceAnimPerInstanceData.at(i) = morphData;
-
-          mRenderData.rdFaceAnimTime += mFaceAnimTimer.stop();
-
-          /* gravity and ground collisions */
-          mLevelCollisionTimer.start();
-
-          /* extend the AABB a bit below the feet to allow a better ground collision handling */
-          glm::vec3 instBoxPos = position - mRenderData.rdLevelCollisionAABBExtension;
-          glm::vec3 instBoxSize = size + mRenderData.rdLevelCollisionAABBExtension;
-          BoundingBox3D instanceBox{instBoxPos, instBoxSize};
-
-          std::vector<MeshTriangle> collidingTriangles = mTriangleOctree->query(instanceBox);
-          instances.at(i)->setCollidingTriangles(collidingTriangles);
-
-          /* set state to "instance on ground" if gravity is disabled */
-          bool instanceOnGround = true;
-          if (mRenderData.rdEnableSimpleGravity) {
-            glm::vec3 gravity = glm::vec3(0.0f, GRAVITY_CONSTANT * deltaTime, 0.0f);
-            glm::vec3 footPoint = instSettings.isWorldPosition;
-
-            instanceOnGround = false;
-            for (const auto& tri : collidingTriangles) {
-              /* check for slope */
-              bool isWalkable = false;
-              if (glm::dot(tri.normal, glm::vec3(0.0f, 1.0f, 0.0f)) >= std::cos(glm::radians(mRenderData.rdMaxLevelGroundSlopeAngle))) {
-                isWalkable = true;
-              }
-
-              if (isWalkable) {
-                std::optional<glm::vec3> result = Tools::rayTriangleIntersection(instSettings.isWorldPosition - gravity, glm::vec3(0.0f, 1.0f, 0.0f), tri);
-                if (result.has_value()) {
-                  footPoint = result.value();
-                  instances.at(i)->setWorldPosition(footPoint);
-                  instanceOnGround = true;
-                }
-              }
-            }
-          }
-          instances.at(i)->setInstanceOnGround(instanceOnGround);
-          instances.at(i)->applyGravity(deltaTime);
-          mRenderData.rdLevelCollisionTime += mLevelCollisionTimer.stop();
-
-          /* update instance speed and position */
-          instances.at(i)->updateInstanceSpeed(deltaTime);
-          instances.at(i)->updateInstancePosition(deltaTime);
-
-          mWorldPosMatrices.at(i) = instances.at(i)->getWorldTransformMatrix();
-
-          /* path update */
-          if (mRenderData.rdEnableNavigation && instSettings.isNavigationEnabled) {
-            mPathFindingTimer.start();
-            int pathTargetInstance = instSettings.isPathTargetInstance;
-
-            /* invalid target, reset */
-            if (pathTargetInstance >= mModelInstCamData.micAssimpInstances.size()) {
-              pathTargetInstance = -1;
-              instances.at(i)->setPathTargetInstanceId(pathTargetInstance);
-            }
-
-            int pathTargetInstanceTriIndex = -1;
-            glm::vec3 pathTargetWorldPos = glm::vec3(0.0f);
-            if (pathTargetInstance != -1) {
-              /* target instance is always valid here */
-              std::shared_ptr<AssimpInstance> targetInstance = mModelInstCamData.micAssimpInstances.at(pathTargetInstance);
-              pathTargetInstanceTriIndex = targetInstance->getCurrentGroundTriangleIndex();
-              pathTargetWorldPos = targetInstance->getWorldPosition();
-            }
-
-            /* do a path update only if both start and end triangle indices are valid and we or target changed its triangle */
-            if ((instSettings.isCurrentGroundTriangleIndex > -1 && pathTargetInstanceTriIndex > -1) &&
-                (instSettings.isCurrentGroundTriangleIndex != instSettings.isPathStartTriangleIndex ||
-                pathTargetInstanceTriIndex != instSettings.isPathTargetTriangleIndex)) {
-              instances.at(i)->setPathStartTriIndex(instSettings.isCurrentGroundTriangleIndex);
-              instances.at(i)->setPathTargetTriIndex(pathTargetInstanceTriIndex);
-
-              std::vector<int> pathToTarget = mPathFinder.findPath(instSettings.isCurrentGroundTriangleIndex, pathTargetInstanceTriIndex);
-
-              /* disable navigation if target is unreachable */
-              if (pathToTarget.empty()) {
-                instances.at(i)->setNavigationEnabled(false);
-                instances.at(i)->setPathTargetInstanceId(-1);
-              } else {
-                instances.at(i)->setPathToTarget(pathToTarget);
-              }
-            }
-
-            std::vector<int> pathToTarget = instances.at(i)->getPathToTarget();
-
-            /* remove first and last elements, they are the target centers of start and target triangles */
-            if (pathToTarget.size() > 1) {
-              pathToTarget.pop_back();
-            }
-            if (!pathToTarget.empty()) {
-              pathToTarget.erase(pathToTarget.begin());
-            }
-
-            /* navigate to target */
-            if (!pathToTarget.empty()) {
-              /* navigate to next triangle, not the one we may stand on (start triangle)*/
-              int nextTarget = pathToTarget.at(0);
-              glm::vec3 destPos = mPathFinder.getTriangleCenter(nextTarget);
-              instances.at(i)->rotateTo(destPos, deltaTime);
-            } else {
-              /* empty path means we have only the target itself left */
-              instances.at(i)->rotateTo(pathTargetWorldPos, deltaTime);
-            }
-
-            if (mRenderData.rdDrawInstancePaths && pathTargetInstance > -1) {
-              glm::vec3 pathColor = glm::vec3(0.4f, 1.0f, 0.4f);
-              glm::vec3 pathYOffset = glm::vec3(0.0f, 1.0f, 0.0f);
-
-              OGLLineVertex vert;
-              vert.color = pathColor;
-
-              vert.position = instSettings.isWorldPosition + pathYOffset;
-              mInstancePathMesh->vertices.emplace_back(vert);
-
-              if (!pathToTarget.empty()) {
-                vert.position = mPathFinder.getTriangleCenter(pathToTarget.at(0)) + pathYOffset;
-                mInstancePathMesh->vertices.emplace_back(vert);
-
-                std::shared_ptr<OGLLineMesh> pathMesh =
-                  mPathFinder.getAsLineMesh(pathToTarget, pathColor, pathYOffset);
-
-                mInstancePathMesh->vertices.insert(mInstancePathMesh->vertices.end(), pathMesh->vertices.begin(), pathMesh->vertices.end());
-
-                vert.position = mPathFinder.getTriangleCenter(pathToTarget.at(pathToTarget.size() - 1)) + pathYOffset;
-                mInstancePathMesh->vertices.emplace_back(vert);
-              }
-
-              vert.position = pathTargetWorldPos + pathYOffset;
-              mInstancePathMesh->vertices.emplace_back(vert);
-            }
-            mRenderData.rdPathFindingTime += mPathFindingTimer.stop();
-          }
-
-          /* neighbor triangles */
-          mLevelGroundNeighborUpdateTimer.start();
-          int groundTri = instSettings.isCurrentGroundTriangleIndex;
-          if (groundTri > -1) {
-            std::vector<int> neighborIndices = mPathFinder.getGroundTriangleNeighbors(groundTri);
-            instances.at(i)->setNeighborGroundTriangleIndices(neighborIndices);
-
-            std::shared_ptr<OGLLineMesh> neighborMesh =
-              mPathFinder.getAsTriangleMesh(neighborIndices, glm::vec3(1.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.8f), glm::vec3(0.0f, 0.01f, 0.0f));
-            mLevelGroundNeighborsMesh->vertices.insert(mLevelGroundNeighborsMesh->vertices.end(),
-              neighborMesh->vertices.begin(), neighborMesh->vertices.end());
-          }
-          mRenderData.rdLevelGroundNeighborUpdateTime += mLevelGroundNeighborUpdateTimer.stop();
         }
 
         size_t trsMatrixSize = numberOfBones * numberOfInstances * 3 * sizeof(glm::vec4);
@@ -3788,25 +3902,27 @@ bool OGLRenderer::draw(float deltaTime) {
         mRenderData.rdMatrixGenerateTime += mMatrixGenerateTimer.stop();
 
         /* upload world matrices */
-        mShaderModelRootMatrixBuffer.uploadSsboData(mWorldPosMatrices);
+        mShaderModelRootMatrixBuffer.uploadSsboData(worldPosMatrices);
 
         /* calculate TRS matrices from node transforms */
         if (model->hasHeadMovementAnimationsMapped()) {
-          mAssimpTransformHeadMoveComputeShader.use();
+          mAssimpTransformComputeShader.getVariant(shaderFeature::headMove).use();
         } else {
-          mAssimpTransformComputeShader.use();
+          mAssimpTransformComputeShader.getVariant().use();
         }
 
         mUploadToUBOTimer.start();
         model->bindAnimLookupBuffer(0);
-        mPerInstanceAnimDataBuffer.uploadSsboData(mPerInstanceAnimData, 1);
+        mPerInstanceAnimDataBuffer.uploadSsboData(packetModel.fpmPerInstanceAnimData, 1);
         mShaderTRSMatrixBuffer.bind(2);
 
         mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
         /* do the computation - in groups of 32 invocations */
+        mGpuTimer.start(gpuPass::transformCompute);
         glDispatchCompute(numberOfBones, std::ceil(numberOfInstances / 32.0f), 1);
         glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        mGpuTimer.stop(gpuPass::transformCompute);
 
         /* multiply every bone TRS matrix with its parent bones TRS matrices, until the root bone has been reached
          * also, multiply the bone TRS and the bone offset matrix */
@@ -3820,8 +3936,10 @@ bool OGLRenderer::draw(float deltaTime) {
         mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
         /* do the computation - in groups of 32 invocations */
+        mGpuTimer.start(gpuPass::matrixCompute);
         glDispatchCompute(numberOfBones, std::ceil(numberOfInstances / 32.0f), 1);
         glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+        mGpuTimer.stop(gpuPass::matrixCompute);
 
         std::shared_ptr<Camera> cam = mModelInstCamData.micCameras.at(mModelInstCamData.micSelectedCamera);
         CameraSettings camSettings = cam->getCameraSettings();
@@ -3836,7 +3954,7 @@ bool OGLRenderer::draw(float deltaTime) {
           /* get the bone matrix of the selected bone from the SSBO */
           glm::mat4 boneMatrix = mShaderBoneMatrixBuffer.getSsboDataMat4(selectedInstance * numberOfBones + selectedBone, 1).at(0);
 
-          cam->setBoneMatrix(mWorldPosMatrices.at(selectedInstance) * boneMatrix * offsetMatrix *
+          cam->setBoneMatrix(worldPosMatrices.at(selectedInstance) * boneMatrix * offsetMatrix *
             model->getInverseBoneOffsetMatrix(selectedBone));
 
           /* we need to update the camera and the view matrix plus upload the new view matrix  */
@@ -3847,15 +3965,16 @@ bool OGLRenderer::draw(float deltaTime) {
           mRenderData.rdMatrixGenerateTime += mMatrixGenerateTimer.stop();
 
           mUploadToUBOTimer.start();
-          std::vector<glm::mat4> matrixData;
-          matrixData.emplace_back(mViewMatrix);
-          matrixData.emplace_back(mProjectionMatrix);
-          mUniformBuffer.uploadUboData(matrixData, 0);
+          matrixData.resize(2);
+          matrixData.at(0) = mViewMatrix;
+          matrixData.at(1) = mProjectionMatrix;
+          mUniformBuffer.uploadUboData(matrixData.data(), matrixData.size(), 0);
           mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
         }
 
         /* inverse kinematics */
         if (mRenderData.rdEnableFeetIK) {
+          PROFILE_SCOPE("inverseKinematics");
           mIKTimer.start();
 
           /* read back all node positions for foot positions */
@@ -3881,7 +4000,7 @@ bool OGLRenderer::draw(float deltaTime) {
               /* extract foot position from world position matrix */
               int footNodeId = modSettings.msFootIKChainPair.at(foot).first;
 
-              glm::vec3 footWorldPos = Tools::extractGlobalPosition(mWorldPosMatrices.at(i) *
+              glm::vec3 footWorldPos = Tools::extractGlobalPosition(worldPosMatrices.at(i) *
                 mShaderBoneMatrices.at(i * numberOfBones + footNodeId) *
                 model->getInverseBoneOffsetMatrix(footNodeId));
               float footDistAboveGround = std::fabs(instSettings.isWorldPosition.y - footWorldPos.y);
@@ -3890,7 +4009,6 @@ bool OGLRenderer::draw(float deltaTime) {
               float instanceHeight = instanceAABB.getMaxPos().y - instanceAABB.getMinPos().y;
               float instanceHalfHeight = instanceHeight / 2.0f;
 
-              OGLLineVertex vert;
               glm::vec3 hitPoint = footWorldPos;
               for (const auto& tri : instSettings.isCollidingTriangles) {
                 std::optional<glm::vec3> result{};
@@ -3904,22 +4022,8 @@ bool OGLRenderer::draw(float deltaTime) {
                   hitPoint = result.value() + glm::vec3(0.0f, footDistAboveGround, 0.0f);
 
                   /* draw a cross onto the surface to mark the hit point */
-                  if (mRenderData.rdDrawIKDebugLines) {
-                    vert.color = glm::vec3(1.0f);
-
-                    vert.position = result.value() -
-                      normalRotMatrix * glm::vec3(-0.5f, 0.0f, 0.0f) + glm::vec3(0.0f, 0.01f, 0.0f);
-                    mIKFootPointMesh->vertices.push_back(vert);
-                    vert.position = result.value() -
-                      normalRotMatrix * glm::vec3(0.5f, 0.0f, 0.0f) + glm::vec3(0.0f, 0.01f, 0.0f);
-                    mIKFootPointMesh->vertices.push_back(vert);
-                    vert.position = result.value() -
-                      normalRotMatrix * glm::vec3(0.0f, 0.0f, 0.5f) + glm::vec3(0.0f, 0.01f, 0.0f);
-                    mIKFootPointMesh->vertices.push_back(vert);
-                    vert.position = result.value() -
-                      normalRotMatrix * glm::vec3(0.0f, 0.0f, -0.5f) + glm::vec3(0.0f, 0.01f, 0.0f);
-                    mIKFootPointMesh->vertices.push_back(vert);
-                  }
+                  mDebugDraw.addCross(debugDrawCategory::ikFootPoints, result.value() + glm::vec3(0.0f, 0.01f, 0.0f),
+                    0.5f, glm::vec3(1.0f), normalRotMatrix);
                 }
               }
 
@@ -3927,7 +4031,7 @@ bool OGLRenderer::draw(float deltaTime) {
               mIKWorldPositionsToSolve.clear();
 
               for (int nodeId : modSettings.msFootIKChainNodes[foot]) {
-                mIKWorldPositionsToSolve.emplace_back(mWorldPosMatrices.at(i) *
+                mIKWorldPositionsToSolve.emplace_back(worldPosMatrices.at(i) *
                   mShaderBoneMatrices.at(i * numberOfBones + nodeId) *
                   model->getInverseBoneOffsetMatrix(nodeId));
               }
@@ -3937,18 +4041,9 @@ bool OGLRenderer::draw(float deltaTime) {
                 mIKSolvedPositions.begin(), mIKSolvedPositions.end());
 
               /* draw a cross for every node in the node chain to mark the final position */
-              if (mRenderData.rdDrawIKDebugLines) {
+              if (mDebugDraw.isEnabled(debugDrawCategory::ikFootPoints)) {
                 for (const auto& position : mIKSolvedPositions) {
-                  vert.color = glm::vec3(0.1f, 0.6f, 0.8f);
-
-                  vert.position = position - glm::vec3(-0.5f, 0.0f, 0.0f);
-                  mIKFootPointMesh->vertices.push_back(vert);
-                  vert.position = position - glm::vec3(0.5f, 0.0f, 0.0f);
-                  mIKFootPointMesh->vertices.push_back(vert);
-                  vert.position = position - glm::vec3(0.0f, 0.0f, 0.5f);
-                  mIKFootPointMesh->vertices.push_back(vert);
-                  vert.position = position - glm::vec3(0.0f, 0.0f, -0.5f);
-                  mIKFootPointMesh->vertices.push_back(vert);
+                  mDebugDraw.addCross(debugDrawCategory::ikFootPoints, position, 0.5f, glm::vec3(0.1f, 0.6f, 0.8f));
                 }
               }
             }
@@ -3975,10 +4070,10 @@ bool OGLRenderer::draw(float deltaTime) {
                 int nodeId = modSettings.msFootIKChainNodes[foot].at(index);
                 int nextNodeId = modSettings.msFootIKChainNodes[foot].at(index - 1);
 
-                glm::vec3 position = Tools::extractGlobalPosition(mWorldPosMatrices.at(i) *
+                glm::vec3 position = Tools::extractGlobalPosition(worldPosMatrices.at(i) *
                   mShaderBoneMatrices.at(i * numberOfBones + nodeId) *
                   model->getInverseBoneOffsetMatrix(nodeId));
-                glm::vec3 nextPosition = Tools::extractGlobalPosition(mWorldPosMatrices.at(i) *
+                glm::vec3 nextPosition = Tools::extractGlobalPosition(worldPosMatrices.at(i) *
                   mShaderBoneMatrices.at(i * numberOfBones + nextNodeId) *
                   model->getInverseBoneOffsetMatrix(nextNodeId));
 
@@ -3988,7 +4083,7 @@ bool OGLRenderer::draw(float deltaTime) {
                   glm::normalize(mNewNodePositions.at(foot).at(newNodePosOffset - 1) - mNewNodePositions.at(foot).at(newNodePosOffset));
                 glm::quat nodeRotation = glm::rotation(toNext, toDesired);
 
-                glm::quat rotation = Tools::extractGlobalRotation(mWorldPosMatrices.at(i) *
+                glm::quat rotation = Tools::extractGlobalRotation(worldPosMatrices.at(i) *
                   mShaderBoneMatrices.at(i * numberOfBones + nodeId) *
                   model->getInverseBoneOffsetMatrix(nodeId));
                 glm::quat localRotation = rotation * nodeRotation * glm::conjugate(rotation);
@@ -4010,8 +4105,10 @@ bool OGLRenderer::draw(float deltaTime) {
               mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
               /* do the computation - in groups of 32 invocations */
+              mGpuTimer.start(gpuPass::matrixCompute);
               glDispatchCompute(numberOfBones, std::ceil(numberOfInstances / 32.0f), 1);
               glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+              mGpuTimer.stop(gpuPass::matrixCompute);
 
               /* read (new) bone positions */
               mDownloadFromUBOTimer.start();
@@ -4022,166 +4119,172 @@ bool OGLRenderer::draw(float deltaTime) {
           mRenderData.rdIKTime += mIKTimer.stop();
         }
 
-        /* now bind the final bone transforms to the vertex skinning shader */
+        /* now bind the final bone transforms to the vertex skinning shader or the pre-skinning compute shader */
+        shaderFeature skinningFeatures = shaderFeature::none;
         if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
-          mAssimpSkinningSelectionShader.use();
-        } else {
-          mAssimpSkinningShader.use();
+          skinningFeatures |= shaderFeature::selection;
         }
+        unsigned int preSkinningVertexCount = model->getPreSkinningVertexCount();
+        bool preSkinned = mRenderData.rdComputePreSkinning && preSkinningVertexCount > 0;
 
-        /* draw all meshes without morph anims first */
-        mUploadToUBOTimer.start();
-        mAssimpSkinningShader.setUniformValue(numberOfBones);
-        mShaderBoneMatrixBuffer.bind(1);
-        mShaderModelRootMatrixBuffer.bind(2);
-        mSelectedInstanceBuffer.uploadSsboData(mSelectedInstance, 3);
-        mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
+        /* the draws read the bone matrices of all models at once, keep a copy of this model's matrices */
+        if (!preSkinned || model->hasAnimMeshes()) {
+          mUploadToUBOTimer.start();
+          glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+          mDrawBoneMatrixBuffer.copyData(mShaderBoneMatrixBuffer, 0, boneMatrixOffset * sizeof(glm::mat4), bufferMatrixSize);
+          mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
+        }
 
-        model->drawInstancedNoMorphAnims(numberOfInstances);
+        std::copy(worldPosMatrices.begin(), worldPosMatrices.end(), mDrawWorldPosMatrices.begin() + instanceOffset);
+        for (size_t i = 0; i < numberOfInstances; ++i) {
+          mDrawInstanceOffsets.at(instanceOffset + i) = glm::ivec2(static_cast<int>(boneMatrixOffset + i * numberOfBones),
+            static_cast<int>(preSkinnedVertexOffset + i * preSkinningVertexCount));
+        }
 
-        /* and if the model has morph anims, draw them in a separate pass */
-        if (model->hasAnimMeshes()) {
-          mFaceAnimTimer.start();
+        if (preSkinned) {
+          /* skin the vertices once, all passes read the result with a trivial vertex shader */
+          size_t preSkinnedVertexSize = preSkinningVertexCount * numberOfInstances * sizeof(OGLSkinnedVertex);
+          mRenderData.rdMatricesSize += preSkinnedVertexSize;
 
-          if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
-            mAssimpSkinningMorphSelectionShader.use();
-          } else {
-            mAssimpSkinningMorphShader.use();
-          }
+          mAssimpPreSkinningComputeShader.use();
 
           mUploadToUBOTimer.start();
-          mAssimpSkinningMorphShader.setUniformValue(numberOfBones);
+          mAssimpPreSkinningComputeShader.setUniformValue(numberOfBones);
+          mAssimpPreSkinningComputeShader.setUniformValue(PRE_SKINNING_VERTEX_OFFSET_LOCATION,
+            static_cast<int>(preSkinnedVertexOffset));
+          model->bindPreSkinningVertexBuffer(0);
           mShaderBoneMatrixBuffer.bind(1);
           mShaderModelRootMatrixBuffer.bind(2);
-          mSelectedInstanceBuffer.bind(3);
-          model->bindMorphAnimBuffer(4);
-          mFaceAnimPerInstanceDataBuffer.uploadSsboData(mFaceAnimPerInstanceData, 5);
+          mPreSkinnedVertexBuffer.bind(3);
           mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
-          model->drawInstancedMorphAnims(numberOfInstances);
+          /* do the computation - in groups of 64 vertices */
+          mGpuTimer.start(gpuPass::preSkinning);
+          glDispatchCompute(std::ceil(preSkinningVertexCount / 64.0f), numberOfInstances, 1);
+          glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+          mGpuTimer.stop(gpuPass::preSkinning);
+
+          RenderCommand preSkinnedCommand{};
+          preSkinnedCommand.rcProgram = mAssimpPreSkinnedShader.getVariant(skinningFeatures).getProgram();
+          preSkinnedCommand.rcInstanceCount = numberOfInstances;
+          preSkinnedCommand.rcBaseInstance = instanceOffset;
+          preSkinnedCommand.rcSortKey = RenderQueue::createSortKey(renderPass::skinnedModels, preSkinnedCommand.rcProgram, 0, modelId);
+          model->submitInstancedPreSkinned(mRenderQueue, preSkinnedCommand);
+
+          preSkinnedVertexOffset += preSkinningVertexCount * numberOfInstances;
+        } else {
+          /* meshes without morph anims */
+          RenderCommand skinningCommand{};
+          skinningCommand.rcProgram = mAssimpSkinningShader.getVariant(skinningFeatures).getProgram();
+          skinningCommand.rcInstanceCount = numberOfInstances;
+          skinningCommand.rcBaseInstance = instanceOffset;
+          skinningCommand.rcSortKey = RenderQueue::createSortKey(renderPass::skinnedModels, skinningCommand.rcProgram, 0, modelId);
+          model->submitInstancedNoMorphAnims(mRenderQueue, skinningCommand);
+        }
+
+        /* and if the model has morph anims, draw them in a separate pass */
+        if (model->hasAnimMeshes()) {
+          mFaceAnimTimer.start();
+
+          const std::vector<glm::vec4>& faceAnimData = packetModel.fpmFaceAnimPerInstanceData;
+          std::copy(faceAnimData.begin(), faceAnimData.end(), mDrawFaceAnimData.begin() + instanceOffset);
+
+          RenderCommand morphCommand{};
+          morphCommand.rcProgram = mAssimpSkinningShader.getVariant(skinningFeatures | shaderFeature::morphAnim).getProgram();
+          morphCommand.rcInstanceCount = numberOfInstances;
+          morphCommand.rcBaseInstance = instanceOffset;
+          morphCommand.rcSortKey = RenderQueue::createSortKey(renderPass::morphModels, morphCommand.rcProgram, 0, modelId);
+          model->submitInstancedMorphAnims(mRenderQueue, morphCommand);
 
           mRenderData.rdFaceAnimTime += mFaceAnimTimer.stop();
         }
+
+        boneMatrixOffset += numberOfBones * numberOfInstances;
       } else {
         /* non-animated models */
 
+        const FramePacketModel& packetModel = packet.fpModels.at(modelId - 1);
+
         mMatrixGenerateTimer.start();
-        mWorldPosMatrices.resize(numberOfInstances);
-        mSelectedInstance.resize(numberOfInstances);
 
         for (size_t i = 0; i < numberOfInstances; ++i) {
           InstanceSettings instSettings = instances.at(i)->getInstanceSettings();
+          glm::vec2& selected = mSelectedInstance.at(instanceOffset + i);
 
           if (mRenderData.rdApplicationMode == appMode::edit) {
             if (currentSelectedInstance == instances.at(i)) {
-              mSelectedInstance.at(i).x = mRenderData.rdSelectedInstanceHighlightValue;
+              selected.x = mRenderData.rdSelectedInstanceHighlightValue;
             } else {
-              mSelectedInstance.at(i).x = 1.0f;
+              selected.x = 1.0f;
             }
 
             if (mMousePick) {
-              mSelectedInstance.at(i).y = static_cast<float>(instSettings.isInstanceIndexPosition);
+              selected.y = static_cast<float>(instSettings.isInstanceIndexPosition);
             }
           } else {
-            mSelectedInstance.at(i).x = 1.0f;
-          }
-
-          /* get AABB and calculate 3D boundaries */
-          AABB instanceAABB = model->getAABB(instSettings);
-
-          glm::vec3 position = instanceAABB.getMinPos();
-          glm::vec3 size = glm::vec3(std::fabs(instanceAABB.getMaxPos().x - instanceAABB.getMinPos().x),
-                                     std::fabs(instanceAABB.getMaxPos().y - instanceAABB.getMinPos().y),
-                                     std::fabs(instanceAABB.getMaxPos().z - instanceAABB.getMinPos().z));
-
-          BoundingBox3D box{position, size};
-          instances.at(i)->setBoundingBox(box);
-
-          /* add instance to octree */
-          mOctree->add(instSettings.isInstanceIndexPosition);
-
-          /* gravity and ground collisions */
-          mLevelCollisionTimer.start();
-
-          /* extend the AABB a bit below the feet to allow a better ground collision handling */
-          glm::vec3 instBoxPos = position - mRenderData.rdLevelCollisionAABBExtension;
-          glm::vec3 instBoxSize = size + mRenderData.rdLevelCollisionAABBExtension;
-          BoundingBox3D instanceBox{instBoxPos, instBoxSize};
-
-          std::vector<MeshTriangle> collidingTriangles = mTriangleOctree->query(instanceBox);
-          instances.at(i)->setCollidingTriangles(collidingTriangles);
-
-          /* set state to "instance on ground" if gravity is disabled */
-          bool instanceOnGround = true;
-          if (mRenderData.rdEnableSimpleGravity) {
-            glm::vec3 gravity = glm::vec3(0.0f, GRAVITY_CONSTANT * deltaTime, 0.0f);
-            glm::vec3 footPoint = instSettings.isWorldPosition;
-
-            instanceOnGround = false;
-            for (const auto& tri : collidingTriangles) {
-              /* check for slope */
-              bool isWalkable = false;
-              if (glm::dot(tri.normal, glm::vec3(0.0f, 1.0f, 0.0f)) >= std::cos(glm::radians(mRenderData.rdMaxLevelGroundSlopeAngle))) {
-                isWalkable = true;
-              }
-
-              if (isWalkable) {
-                std::optional<glm::vec3> result = Tools::rayTriangleIntersection(instSettings.isWorldPosition - gravity, glm::vec3(0.0f, 1.0f, 0.0f), tri);
-                if (result.has_value()) {
-                  footPoint = result.value();
-                  instances.at(i)->setWorldPosition(footPoint);
-                  instanceOnGround = true;
-                }
-              }
-            }
+            selected.x = 1.0f;
           }
-          instances.at(i)->setInstanceOnGround(instanceOnGround);
-          instances.at(i)->applyGravity(deltaTime);
-          mRenderData.rdLevelCollisionTime += mLevelCollisionTimer.stop();
-
-          instances.at(i)->updateInstancePosition(deltaTime);
-          mWorldPosMatrices.at(i) = instances.at(i)->getWorldTransformMatrix();
         }
 
+        const std::vector<glm::mat4>& worldPosMatrices = packetModel.fpmWorldPosMatrices;
+        std::copy(worldPosMatrices.begin(), worldPosMatrices.end(), mDrawWorldPosMatrices.begin() + instanceOffset);
+
         mRenderData.rdMatrixGenerateTime += mMatrixGenerateTimer.stop();
-        mRenderData.rdMatricesSize += mWorldPosMatrices.size() * sizeof(glm::mat4);
+        mRenderData.rdMatricesSize += worldPosMatrices.size() * sizeof(glm::mat4);
 
+        shaderFeature features = shaderFeature::none;
         if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
-          mAssimpSelectionShader.use();
-        } else {
-          mAssimpShader.use();
+          features |= shaderFeature::selection;
         }
 
-        mUploadToUBOTimer.start();
-        mShaderModelRootMatrixBuffer.uploadSsboData(mWorldPosMatrices, 1);
-        mSelectedInstanceBuffer.uploadSsboData(mSelectedInstance, 2);
-        mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
-
-        model->drawInstanced(numberOfInstances);
+        RenderCommand modelCommand{};
+        modelCommand.rcProgram = mAssimpShader.getVariant(features).getProgram();
+        modelCommand.rcInstanceCount = numberOfInstances;
+        modelCommand.rcBaseInstance = instanceOffset;
+        modelCommand.rcSortKey = RenderQueue::createSortKey(renderPass::staticModels, modelCommand.rcProgram, 0, modelId);
+        model->submitInstanced(mRenderQueue, modelCommand);
       }
 
-      /* remove instances that fell out of the level boundaries */
-      std::vector<int> outOfLevelInstances{};
+      instanceOffset += numberOfInstances;
+
+      /* remove instances that fell out of the level boundaries, after the draws used the instance offsets */
       for (size_t i = 0; i < numberOfInstances; ++i) {
         InstanceSettings instSettings = instances.at(i)->getInstanceSettings();
         if (instSettings.isWorldPosition.y < mRenderData.rdWorldStartPos.y - 50.0f) {
-          outOfLevelInstances.emplace_back(instSettings.isInstanceIndexPosition);
-        }
-      }
-
-      if (!outOfLevelInstances.empty()) {
-        for (int instanceId : outOfLevelInstances) {
-          Logger::log(1, "%s warning: instance id %i fell out of level boundaries, deleting\n", __FUNCTION__, instanceId);
-          deleteInstance(getInstanceById(instanceId));
+          mOutOfLevelInstances.emplace_back(instSettings.isInstanceIndexPosition);
         }
-        outOfLevelInstances.clear();
       }
     }
   }
 
+  /* one upload of the per-instance data of all models, then a single flush per pass */
+  mUploadToUBOTimer.start();
+  mDrawBoneMatrixBuffer.bind(1);
+  mDrawWorldPosMatrixBuffer.uploadSsboData(mDrawWorldPosMatrices, 2);
+  mSelectedInstanceBuffer.uploadSsboData(mSelectedInstance, 3);
+  mFaceAnimPerInstanceDataBuffer.uploadSsboData(mDrawFaceAnimData, 5);
+  mPreSkinnedVertexBuffer.bind(7);
+  mDrawInstanceOffsetBuffer.uploadSsboData(mDrawInstanceOffsets, 8);
+  mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
+
+  mGpuTimer.start(gpuPass::skinning);
+  mRenderQueue.flush(renderPass::skinnedModels);
+  mGpuTimer.stop(gpuPass::skinning);
+
+  mGpuTimer.start(gpuPass::morph);
+  mRenderQueue.flush(renderPass::morphModels);
+  mGpuTimer.stop(gpuPass::morph);
+
+  mGpuTimer.start(gpuPass::staticModels);
+  mRenderQueue.flush(renderPass::staticModels);
+  mGpuTimer.stop(gpuPass::staticModels);
+
+  for (int instanceId : mOutOfLevelInstances) {
+    Logger::log(1, "%s warning: instance id %i fell out of level boundaries, deleting\n", __FUNCTION__, instanceId);
+    deleteInstance(getInstanceById(instanceId));
+  }
+
   /* draw coord arrow, depending on edit mode */
-  mCoordArrowsLineIndexCount = 0;
-  mLineMesh->vertices.clear();
   if (mRenderData.rdApplicationMode == appMode::edit) {
     if (mModelInstCamData.micSelectedInstance > 0) {
       InstanceSettings instSettings = mModelInstCamData.micAssimpInstances.at(mModelInstCamData.micSelectedInstance)->getInstanceSettings();
@@ -4199,28 +4302,16 @@ bool OGLRenderer::draw(float deltaTime) {
           break;
       }
 
-      mCoordArrowsLineIndexCount += mCoordArrowsMesh.vertices.size();
       std::for_each(mCoordArrowsMesh.vertices.begin(), mCoordArrowsMesh.vertices.end(),
         [=](auto &n) {
           n.color /= 2.0f;
           n.position = glm::quat(glm::radians(instSettings.isWorldRotation)) * n.position;
           n.position += instSettings.isWorldPosition;
       });
-      mLineMesh->vertices.insert(mLineMesh->vertices.end(),
-                                 mCoordArrowsMesh.vertices.begin(), mCoordArrowsMesh.vertices.end());
+      mDebugDraw.addLines(debugDrawCategory::coordArrows, mCoordArrowsMesh.vertices);
     }
   }
 
-  /* draw the coordinate arrow WITH depth buffer */
-  if (mCoordArrowsLineIndexCount > 0) {
-    mUploadToVBOTimer.start();
-    mLineVertexBuffer.uploadData(*mLineMesh);
-    mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
-
-    mLineShader.use();
-    mLineVertexBuffer.bindAndDraw(GL_LINES, 0, mCoordArrowsLineIndexCount);
-  }
-
   if (mRenderData.rdApplicationMode == appMode::edit) {
     if (mMousePick) {
       /* wait until selection buffer has been filled */
@@ -4246,10 +4337,13 @@ bool OGLRenderer::draw(float deltaTime) {
   mRenderData.rdInteractionTime += mInteractionTimer.stop();
 
   /* check for collisions */
-  mCollisionCheckTimer.start();
-  checkForInstanceCollisions();
-  checkForBorderCollisions();
-  mRenderData.rdCollisionCheckTime += mCollisionCheckTimer.stop();
+  {
+    PROFILE_SCOPE("collisionCheck");
+    mCollisionCheckTimer.start();
+    checkForInstanceCollisions();
+    checkForBorderCollisions();
+    mRenderData.rdCollisionCheckTime += mCollisionCheckTimer.stop();
+  }
 
   mCollisionDebugDrawTimer.start();
   drawCollisionDebug();
@@ -4261,43 +4355,39 @@ bool OGLRenderer::draw(float deltaTime) {
     checkForLevelCollisions();
 
     if (mRenderData.rdDrawLevelAABB) {
-      drawLevelAABB();
+      submitLevelLines(mLevelAABBVertexBuffer, mLevelAABBMesh->vertices.size());
     }
 
     if (mRenderData.rdDrawLevelWireframe) {
-      drawLevelWireframe();
+      submitLevelLines(mLevelWireframeVertexBuffer, mLevelWireframeMesh->vertices.size());
     }
 
     if (mRenderData.rdDrawLevelOctree) {
-      drawLevelOctree();
+      submitLevelLines(mLevelOctreeVertexBuffer, mLevelOctreeMesh->vertices.size());
     }
 
-    if (mRenderData.rdDrawLevelCollisionTriangles) {
-      drawLevelCollisionTriangles();
-    }
     mRenderData.rdLevelCollisionTime += mLevelCollisionTimer.stop();
+  }
 
-    mLevelGroundNeighborUpdateTimer.start();
-    if (mRenderData.rdDrawNeighborTriangles) {
-      drawAdjacentDebugTriangles();
-    }
-    mRenderData.rdLevelGroundNeighborUpdateTime += mLevelGroundNeighborUpdateTimer.stop();
-
-    if (mRenderData.rdDrawGroundTriangles) {
-      drawGroundTriangles();
-    }
+  /* all debug lines of the frame, WITH depth buffer */
+  {
+    PROFILE_SCOPE("debugDraw");
+    RenderCommand lineCommand{};
+    lineCommand.rcProgram = mLineShader.getProgram();
+    lineCommand.rcSortKey = RenderQueue::createSortKey(renderPass::debugLines, lineCommand.rcProgram, 0, 0);
+    mDebugDraw.submit(mRenderQueue, lineCommand);
 
-    if (mRenderData.rdDrawInstancePaths) {
-      drawInstancePaths();
-    }
+    mGpuTimer.start(gpuPass::debugLines);
+    mRenderQueue.flush(renderPass::debugLines);
+    mGpuTimer.stop(gpuPass::debugLines);
+    mDebugDraw.endFrame();
   }
+  mRenderData.rdDebugDrawVertices = mDebugDraw.getLastVertexCount();
 
-  /* draw inverse kinematics debug lines */
-  mIKTimer.start();
-  if (mRenderData.rdDrawIKDebugLines) {
-    drawIKDebugLines();
+  /* transparent, drawn after all opaque geometry and lines */
+  if (mModelInstCamData.micLevels.size() > 1 && mRenderData.rdDrawGroundTriangles) {
+    drawGroundTriangles();
   }
-  mRenderData.rdIKTime += mIKTimer.stop();
 
   /* behavior update */
   mBehviorTimer.start();
@@ -4306,6 +4396,14 @@ bool OGLRenderer::draw(float deltaTime) {
 
   mFramebuffer.unbind();
 
+  RenderQueueStats renderQueueStats = mRenderQueue.getStats();
+  mRenderData.rdDrawCalls = renderQueueStats.rqsDrawCalls;
+  mRenderData.rdProgramChanges = renderQueueStats.rqsProgramChanges;
+  mRenderData.rdVertexArrayChanges = renderQueueStats.rqsVertexArrayChanges;
+  mRenderData.rdTextureChanges = renderQueueStats.rqsTextureChanges;
+  mRenderData.rdBufferChanges = renderQueueStats.rqsBufferChanges;
+  mRenderData.rdSkippedStateChanges = renderQueueStats.rqsSkippedChanges;
+
   /* blit color buffer to screen */
   /* XXX: enable sRGB ONLY for the final framebuffer draw */
   glEnable(GL_FRAMEBUFFER_SRGB);
@@ -4313,6 +4411,7 @@ bool OGLRenderer::draw(float deltaTime) {
   glDisable(GL_FRAMEBUFFER_SRGB);
 
   /* create user interface */
+  PROFILE_SCOPE("userInterface");
   mUIGenerateTimer.start();
   mUserInterface.createFrame(mRenderData);
 
@@ -4337,13 +4436,76 @@ bool OGLRenderer::draw(float deltaTime) {
   mRenderData.rdUIGenerateTime += mUIGenerateTimer.stop();
 
   mUIDrawTimer.start();
+  mGpuTimer.start(gpuPass::ui);
   mUserInterface.render();
+  mGpuTimer.stop(gpuPass::ui);
   mRenderData.rdUIDrawTime = mUIDrawTimer.stop();
 
+  mRenderData.rdFrameHeapAllocations = AllocationCounter::getAllocations() - frameStartAllocations;
+  MemoryTracker::endFrame();
+
+  /* results of the previous frame, shown in the next UI frame */
+  bool gpuTimesUpdated = mGpuTimer.endFrame();
+  for (unsigned int i = 0; i < static_cast<unsigned int>(gpuPass::NUM); ++i) {
+    gpuPass pass = static_cast<gpuPass>(i);
+    mRenderData.rdGpuPassTimes.at(i) = mGpuTimer.getPassTime(pass);
+    /* the name map is filled once in init(), the strings stay valid */
+    if (gpuTimesUpdated) {
+      Profiler::addCounter(mRenderData.rdGpuPassNameMap[pass].c_str(), mRenderData.rdGpuPassTimes.at(i));
+    }
+  }
+  mRenderData.rdGpuSkippedFrames = mGpuTimer.getSkippedFrames();
+
+  /* react only to new measurements, the skipped frames would repeat the old ones */
+  if (gpuTimesUpdated || !mRenderData.rdDynamicResolution) {
+    updateRenderScale();
+  }
+
   return true;
 }
 
+void OGLRenderer::updateRenderScale() {
+  if (!mRenderData.rdDynamicResolution) {
+    mFramebuffer.setRenderScale(mRenderData.rdRenderScale);
+    mRenderData.rdRenderScale = mFramebuffer.getRenderScale();
+    return;
+  }
+
+  /* compute dispatches and the UI do not depend on the render scale */
+  float fixedTime = mRenderData.rdGpuPassTimes.at(static_cast<size_t>(gpuPass::transformCompute)) +
+    mRenderData.rdGpuPassTimes.at(static_cast<size_t>(gpuPass::matrixCompute)) +
+    mRenderData.rdGpuPassTimes.at(static_cast<size_t>(gpuPass::preSkinning)) +
+    mRenderData.rdGpuPassTimes.at(static_cast<size_t>(gpuPass::ui));
+  float scaledTime = 0.0f;
+  for (const auto& time : mRenderData.rdGpuPassTimes) {
+    scaledTime += time;
+  }
+  scaledTime -= fixedTime;
+
+  if (scaledTime <= 0.0f) {
+    return;
+  }
+
+  float budget = std::max(mRenderData.rdTargetGpuFrameTime - fixedTime, 0.1f);
+  float currentScale = mFramebuffer.getRenderScale();
+
+  /* keep the scale while slightly below the budget to avoid toggling between two sizes */
+  if (scaledTime <= budget && scaledTime >= budget * 0.85f) {
+    return;
+  }
+
+  /* the scaled passes are fill-rate bound, their time follows the number of pixels */
+  float targetScale = currentScale * std::sqrt(budget / scaledTime);
+
+  /* move only part of the way, the measured times are one frame behind */
+  float newScale = currentScale + (targetScale - currentScale) * 0.25f;
+  mFramebuffer.setRenderScale(newScale);
+  mRenderData.rdRenderScale = mFramebuffer.getRenderScale();
+}
+
 void OGLRenderer::cleanup() {
+  finishSimulation();
+
   /* delete models and levels to destroy OpenGL objects */
   for (const auto& model : mModelInstCamData.micModelList) {
     model->cleanup();
@@ -4361,6 +4523,9 @@ void OGLRenderer::cleanup() {
     level->cleanup();
   }
 
+  /* all textures should be released by now */
+  TextureManager::cleanup();
+
   mShaderModelRootMatrixBuffer.cleanup();
   mShaderBoneMatrixBuffer.cleanup();
   mShaderTRSMatrixBuffer.cleanup();
@@ -4371,19 +4536,21 @@ void OGLRenderer::cleanup() {
   mBoundingSphereAdjustmentBuffer.cleanup();
   mFaceAnimPerInstanceDataBuffer.cleanup();
   mEmptyWorldPositionBuffer.cleanup();
+  mPreSkinnedVertexBuffer.cleanup();
+  mLevelMatrixBuffer.cleanup();
+  mDrawWorldPosMatrixBuffer.cleanup();
+  mDrawBoneMatrixBuffer.cleanup();
+  mDrawInstanceOffsetBuffer.cleanup();
 
-  mAssimpTransformHeadMoveComputeShader.cleanup();
   mAssimpTransformComputeShader.cleanup();
+  mAssimpPreSkinningComputeShader.cleanup();
   mAssimpMatrixComputeShader.cleanup();
   mAssimpBoundingBoxComputeShader.cleanup();
 
   mSkyboxShader.cleanup();
   mGroundMeshShader.cleanup();
   mAssimpLevelShader.cleanup();
-  mAssimpSkinningMorphSelectionShader.cleanup();
-  mAssimpSkinningSelectionShader.cleanup();
-  mAssimpSkinningMorphShader.cleanup();
-  mAssimpSelectionShader.cleanup();
+  mAssimpPreSkinnedShader.cleanup();
   mAssimpSkinningShader.cleanup();
   mAssimpShader.cleanup();
   mSphereShader.cleanup();
@@ -4392,7 +4559,8 @@ void OGLRenderer::cleanup() {
   mUserInterface.cleanup();
 
   mGroundMeshVertexBuffer.cleanup();
-  mIKLinesVertexBuffer.cleanup();
+  mDebugDraw.cleanup();
+  mGpuTimer.cleanup();
   mLevelWireframeVertexBuffer.cleanup();
   mLevelOctreeVertexBuffer.cleanup();
   mLevelAABBVertexBuffer.cleanup();
@@ -4403,4 +4571,7 @@ void OGLRenderer::cleanup() {
   mSkyboxBuffer.cleanup();
 
   mFramebuffer.cleanup();
+
+  /* anything still live here was not released by its owner */
+  MemoryTracker::logReport();
 }
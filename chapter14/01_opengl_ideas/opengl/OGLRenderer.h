@@ -5,6 +5,8 @@
 #include <map>
 #include <chrono>
 #include <random>
+#include <array>
+#include <future>
 
 #include <glm/glm.hpp>
 
@@ -12,10 +14,17 @@
 #include <GLFW/glfw3.h>
 
 #include "Timer.h"
+#include "GpuTimer.h"
+#include "FrameArena.h"
+#include "FramePacket.h"
+#include "ThreadPool.h"
 #include "Framebuffer.h"
 #include "LineVertexBuffer.h"
+#include "DebugDraw.h"
 #include "Texture.h"
 #include "Shader.h"
+#include "ShaderPermutations.h"
+#include "RenderQueue.h"
 #include "UniformBuffer.h"
 #include "ShaderStorageBuffer.h"
 #include "UserInterface.h"
@@ -54,6 +63,8 @@ class OGLRenderer {
     void setSize(unsigned int width, unsigned int height);
     void uploadAssimpData(OGLMesh vertexData);
     bool draw(float deltaTime);
+    void startSimulation(float deltaTime);
+    void finishSimulation();
     void handleKeyEvents(int key, int scancode, int action, int mods);
     void handleMouseButtonEvents(int button, int action, int mods);
     void handleMousePositionEvents(double xPos, double yPos);
@@ -124,19 +135,17 @@ class OGLRenderer {
     Timer mIKTimer{};
     Timer mLevelGroundNeighborUpdateTimer{};
     Timer mPathFindingTimer{};
+    GpuTimer mGpuTimer{};
 
     Shader mLineShader{};
     Shader mSphereShader{};
-    Shader mAssimpShader{};
-    Shader mAssimpSkinningShader{};
-    Shader mAssimpSkinningMorphShader{};
+    /* selection, morph anims and head movement are feature variants of the same source */
+    ShaderPermutations mAssimpShader{};
+    ShaderPermutations mAssimpSkinningShader{};
 
-    Shader mAssimpSelectionShader{};
-    Shader mAssimpSkinningSelectionShader{};
-    Shader mAssimpSkinningMorphSelectionShader{};
-
-    Shader mAssimpTransformComputeShader{};
-    Shader mAssimpTransformHeadMoveComputeShader{};
+    ShaderPermutations mAssimpTransformComputeShader{};
+    Shader mAssimpPreSkinningComputeShader{};
+    ShaderPermutations mAssimpPreSkinnedShader{};
     Shader mAssimpMatrixComputeShader{};
     Shader mAssimpBoundingBoxComputeShader{};
 
@@ -145,20 +154,45 @@ class OGLRenderer {
 
     Shader mSkyboxShader{};
 
+    /* level, model and debug line draws, one flush per pass */
+    RenderQueue mRenderQueue{};
+
     Framebuffer mFramebuffer{};
     LineVertexBuffer mLineVertexBuffer{};
     LineVertexBuffer mLevelAABBVertexBuffer{};
     LineVertexBuffer mLevelOctreeVertexBuffer{};
     LineVertexBuffer mLevelWireframeVertexBuffer{};
-    LineVertexBuffer mIKLinesVertexBuffer{};
+    /* all per-frame debug lines, one draw call */
+    DebugDraw mDebugDraw{};
+    /* scratch for path finder lines, keeps its capacity between instances */
+    std::vector<OGLLineVertex> mDebugLineVertices{};
+
+    /* temporaries of draw() and its helpers, reset at the start of the next frame */
+    FrameArena mFrameArena{};
     SimpleVertexBuffer mGroundMeshVertexBuffer{};
     UniformBuffer mUniformBuffer{};
     UserInterface mUserInterface{};
 
-    /* for animated and non-animated models */
+    /* world matrices of one model, input of the compute shaders */
     ShaderStorageBuffer mShaderModelRootMatrixBuffer{};
     std::vector<glm::mat4> mWorldPosMatrices{};
 
+    /* one matrix per level, indexed by the base instance of the level draws */
+    std::vector<glm::mat4> mLevelMatrices{};
+    ShaderStorageBuffer mLevelMatrixBuffer{};
+
+    /* per-instance data of all models, the base instance of a draw is the first instance of its model */
+    std::vector<glm::mat4> mDrawWorldPosMatrices{};
+    ShaderStorageBuffer mDrawWorldPosMatrixBuffer{};
+    /* bone matrices of all animated models, copied from mShaderBoneMatrixBuffer after each model */
+    ShaderStorageBuffer mDrawBoneMatrixBuffer{};
+    /* first bone matrix and first pre-skinned vertex of every instance */
+    std::vector<glm::ivec2> mDrawInstanceOffsets{};
+    ShaderStorageBuffer mDrawInstanceOffsetBuffer{};
+    std::vector<glm::vec4> mDrawFaceAnimData{};
+    /* deleted after the model passes have been drawn */
+    std::vector<int> mOutOfLevelInstances{};
+
     /* color hightlight for selection etc */
     std::vector<glm::vec2> mSelectedInstance{};
     ShaderStorageBuffer mSelectedInstanceBuffer{};
@@ -170,15 +204,16 @@ class OGLRenderer {
     ShaderStorageBuffer mEmptyBoneOffsetBuffer{};
     ShaderStorageBuffer mEmptyWorldPositionBuffer{};
     std::vector<glm::mat4> mShaderBoneMatrices{};
+    /* skinned once per frame, reused by every pass drawing the model */
+    ShaderStorageBuffer mPreSkinnedVertexBuffer{};
+    /* uniform location of the first skinned vertex of the model in the pre-skinning compute shader */
+    const int PRE_SKINNING_VERTEX_OFFSET_LOCATION = 1;
 
     /* x/y/z is shpere center, w is radius */
     ShaderStorageBuffer mBoundingSphereBuffer{};
     /* per-model-and-node adjustments for the spheres */
     ShaderStorageBuffer mBoundingSphereAdjustmentBuffer{};
 
-    std::vector<AABB> mPerInstanceAABB{};
-    std::shared_ptr<OGLLineMesh> mAABBMesh = nullptr;
-
     /* for compute shader */
     ShaderStorageBuffer mShaderTRSMatrixBuffer{};
 
@@ -187,15 +222,12 @@ class OGLRenderer {
     ScaleArrowsModel mScaleArrowsModel{};
 
     OGLLineMesh mCoordArrowsMesh{};
-    std::shared_ptr<OGLLineMesh> mLineMesh = nullptr;
 
     SphereModel mSphereModel{};
     SphereModel mCollidingSphereModel{};
     OGLLineMesh mSphereMesh{};
     OGLLineMesh mCollidingSphereMesh{};
 
-    unsigned int mCoordArrowsLineIndexCount = 0;
-
     bool mMouseLock = false;
     int mMouseXPos = 0;
     int mMouseYPos = 0;
@@ -264,7 +296,8 @@ class OGLRenderer {
     std::shared_ptr<BoundingBox3D> mWorldBoundaries = nullptr;
 
     void createAABBLookup(std::shared_ptr<AssimpModel> model);
-    void drawAABBs(std::vector<std::shared_ptr<AssimpInstance>> instances, glm::vec4 aabbColor);
+    void drawAABBs(std::vector<std::shared_ptr<AssimpInstance>> instances, glm::vec4 aabbColor,
+      debugDrawCategory category);
     void drawCollisionDebug();
     void drawSelectedBoundingSpheres();
     void drawCollidingBoundingSpheres();
@@ -284,6 +317,8 @@ class OGLRenderer {
     void findInteractionInstances();
     void drawInteractionDebug();
 
+    void updateRenderScale();
+
     std::shared_ptr<GraphEditor> mGraphEditor = nullptr;
     void editGraph(std::string graphName);
     std::shared_ptr<SingleInstanceBehavior> createEmptyGraph();
@@ -291,7 +326,6 @@ class OGLRenderer {
     std::shared_ptr<BehaviorManager> mBehaviorManager = nullptr;
     instanceNodeActionCallback mInstanceNodeActionCallbackFunction;
 
-    std::vector<glm::vec4> mFaceAnimPerInstanceData{};
     ShaderStorageBuffer mFaceAnimPerInstanceDataBuffer{};
 
     void generateLevelVertexData();
@@ -299,10 +333,8 @@ class OGLRenderer {
     void generateLevelOctree();
     void generateLevelWireframe();
 
-    void drawLevelAABB();
-    void drawLevelOctree();
-    void drawLevelWireframe();
-    void drawLevelCollisionTriangles();
+    /* AABB, octree and wireframe lines, drawn in the debug lines pass */
+    void submitLevelLines(LineVertexBuffer& lineBuffer, size_t vertexCount);
 
     void resetLevelData();
     void initTriangleOctree(int thresholdPerBox, int maxDepth);
@@ -315,25 +347,16 @@ class OGLRenderer {
     std::shared_ptr<OGLLineMesh> mLevelAABBMesh = nullptr;
     std::shared_ptr<OGLLineMesh> mLevelOctreeMesh = nullptr;
     std::shared_ptr<OGLLineMesh> mLevelWireframeMesh = nullptr;
-    std::shared_ptr<OGLLineMesh> mLevelCollidingTriangleMesh = nullptr;
 
     IKSolver mIKSolver{};
-    std::shared_ptr<OGLLineMesh> mIKFootPointMesh = nullptr;
     std::array<std::vector<glm::vec3>, 2> mNewNodePositions{};
     std::vector<glm::mat4> mIKWorldPositionsToSolve{};
     std::vector<glm::vec3> mIKSolvedPositions{};
     std::vector<TRSMatrixData> mTRSData{};
 
-    void drawIKDebugLines();
-
     PathFinder mPathFinder{};
     void generateGroundTriangleData();
-    std::shared_ptr<OGLLineMesh> mLevelGroundNeighborsMesh = nullptr;
-    std::shared_ptr<OGLLineMesh> mInstancePathMesh = nullptr;
-
-    void drawAdjacentDebugTriangles();
     void drawGroundTriangles();
-    void drawInstancePaths();
 
     std::vector<int> getNavTargets();
     std::random_device mRandomDevice{};
@@ -344,4 +367,17 @@ class OGLRenderer {
     Texture mSkyboxTexture{};
     SkyboxModel mSkyboxModel{};
     SkyboxBuffer mSkyboxBuffer{};
+
+    /* the render stage reads one packet while the worker thread simulates into the other.
+     * addDebugDraw is false when a packet is rebuilt, its debug lines have already been added */
+    void simulate(FramePacket& packet, float deltaTime, bool addDebugDraw);
+    bool isFramePacketCurrent(const FramePacket& packet);
+    std::array<FramePacket, 2> mFramePackets{};
+    unsigned int mRenderFramePacket = 0;
+    std::future<void> mSimulationResult{};
+    ThreadPool mSimulationThread{1};
+    Timer mSimulationTimer{};
+
+    /* shared by all model and level loads, avoids spawning threads per asset */
+    ThreadPool mTextureDecodePool{};
 };
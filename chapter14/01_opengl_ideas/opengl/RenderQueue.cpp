@@ -0,0 +1,148 @@
+#include <array>
+#include <cstddef>
+
+#include "RenderQueue.h"
+
+uint64_t RenderQueue::createSortKey(renderPass pass, uint32_t shader, uint32_t material, uint32_t model) {
+  return (static_cast<uint64_t>(pass) & 0xf) << 60 |
+    (static_cast<uint64_t>(shader) & 0xfff) << 48 |
+    (static_cast<uint64_t>(material) & 0xffffff) << 24 |
+    (static_cast<uint64_t>(model) & 0xffffff);
+}
+
+uint64_t RenderQueue::setSortKeyMaterial(uint64_t sortKey, uint32_t material) {
+  return (sortKey & ~(0xffffffULL << 24)) | (static_cast<uint64_t>(material) & 0xffffff) << 24;
+}
+
+void RenderQueue::submit(const RenderCommand& command) {
+  size_t pass = static_cast<size_t>(command.rcSortKey >> 60);
+  if (pass >= mPassCommands.size()) {
+    return;
+  }
+  mPassCommands.at(pass).emplace_back(command);
+}
+
+void RenderQueue::sortCommands(std::vector<RenderCommand>& commands) {
+  /* LSD radix sort with 8 bit digits, stable, so equal keys keep the submit order */
+  const size_t numCommands = commands.size();
+  mSortBuffer.resize(numCommands);
+
+  std::array<size_t, 256> offsets{};
+  for (int shift = 0; shift < 64; shift += 8) {
+    offsets.fill(0);
+    for (const auto& command : commands) {
+      ++offsets.at((command.rcSortKey >> shift) & 0xff);
+    }
+
+    /* all keys share this digit, nothing to move */
+    if (offsets.at((commands.at(0).rcSortKey >> shift) & 0xff) == numCommands) {
+      continue;
+    }
+
+    size_t sum = 0;
+    for (auto& offset : offsets) {
+      size_t count = offset;
+      offset = sum;
+      sum += count;
+    }
+
+    for (const auto& command : commands) {
+      mSortBuffer.at(offsets.at((command.rcSortKey >> shift) & 0xff)++) = command;
+    }
+    commands.swap(mSortBuffer);
+  }
+}
+
+void RenderQueue::flush(renderPass pass) {
+  std::vector<RenderCommand>& commands = mPassCommands.at(static_cast<size_t>(pass));
+  if (commands.empty()) {
+    return;
+  }
+
+  if (commands.size() > 1) {
+    sortCommands(commands);
+  }
+
+  /* other code changes the GL state between the flushes */
+  invalidateState();
+
+  for (const auto& command : commands) {
+    if (command.rcProgram != mBoundProgram) {
+      glUseProgram(command.rcProgram);
+      mBoundProgram = command.rcProgram;
+      ++mStats.rqsProgramChanges;
+    } else {
+      ++mStats.rqsSkippedChanges;
+    }
+
+    if (command.rcVertexArray != mBoundVertexArray) {
+      glBindVertexArray(command.rcVertexArray);
+      mBoundVertexArray = command.rcVertexArray;
+      ++mStats.rqsVertexArrayChanges;
+    } else {
+      ++mStats.rqsSkippedChanges;
+    }
+
+    if (command.rcTexture != 0) {
+      if (command.rcTexture != mBoundTexture) {
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, command.rcTexture);
+        mBoundTexture = command.rcTexture;
+        ++mStats.rqsTextureChanges;
+      } else {
+        ++mStats.rqsSkippedChanges;
+      }
+    }
+
+    for (const auto& storageBuffer : command.rcStorageBuffers) {
+      if (storageBuffer.rsbBuffer == 0) {
+        continue;
+      }
+
+      if (storageBuffer.rsbBinding >= MAX_TRACKED_BINDINGS) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, storageBuffer.rsbBinding, storageBuffer.rsbBuffer);
+        ++mStats.rqsBufferChanges;
+      } else if (storageBuffer.rsbBuffer != mBoundStorageBuffers.at(storageBuffer.rsbBinding)) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, storageBuffer.rsbBinding, storageBuffer.rsbBuffer);
+        mBoundStorageBuffers.at(storageBuffer.rsbBinding) = storageBuffer.rsbBuffer;
+        ++mStats.rqsBufferChanges;
+      } else {
+        ++mStats.rqsSkippedChanges;
+      }
+    }
+
+    for (const auto& uniform : command.rcUniforms) {
+      if (uniform.ruLocation > -1) {
+        glUniform1i(uniform.ruLocation, uniform.ruValue);
+      }
+    }
+
+    if (command.rcIndexCount > 0) {
+      glDrawElementsInstancedBaseInstance(command.rcMode, command.rcIndexCount, GL_UNSIGNED_INT, 0,
+        command.rcInstanceCount, command.rcBaseInstance);
+    } else {
+      glDrawArraysInstancedBaseInstance(command.rcMode, command.rcFirstVertex, command.rcVertexCount,
+        command.rcInstanceCount, command.rcBaseInstance);
+    }
+    ++mStats.rqsDrawCalls;
+  }
+
+  glBindVertexArray(0);
+  invalidateState();
+  commands.clear();
+}
+
+void RenderQueue::invalidateState() {
+  mBoundProgram = 0;
+  mBoundVertexArray = 0;
+  mBoundTexture = 0;
+  mBoundStorageBuffers.fill(0);
+}
+
+RenderQueueStats RenderQueue::getStats() {
+  return mStats;
+}
+
+void RenderQueue::resetStats() {
+  mStats = RenderQueueStats{};
+}
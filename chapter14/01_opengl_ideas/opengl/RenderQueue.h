@@ -0,0 +1,79 @@
+/* sorted draw commands, executed with redundant state changes removed */
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <glad/glad.h>
+
+#include "Enums.h"
+
+/* optional per-model SSBO, e.g. the material handles or the morph vertices */
+struct RenderStorageBuffer {
+  GLuint rsbBuffer = 0;
+  GLuint rsbBinding = 0;
+};
+
+/* optional per-draw int uniform, location -1 is unused */
+struct RenderUniform {
+  GLint ruLocation = -1;
+  GLint ruValue = 0;
+};
+
+struct RenderCommand {
+  uint64_t rcSortKey = 0;
+  GLuint rcProgram = 0;
+  GLuint rcVertexArray = 0;
+  GLenum rcMode = GL_TRIANGLES;
+  /* 0 if the shader fetches the texture via bindless handle */
+  GLuint rcTexture = 0;
+  /* non-indexed draw of rcVertexCount vertices if rcIndexCount is 0 */
+  GLsizei rcIndexCount = 0;
+  GLint rcFirstVertex = 0;
+  GLsizei rcVertexCount = 0;
+  GLsizei rcInstanceCount = 1;
+  /* first element of the per-instance data in the combined per-frame SSBOs */
+  GLuint rcBaseInstance = 0;
+  std::array<RenderStorageBuffer, 2> rcStorageBuffers{};
+  std::array<RenderUniform, 2> rcUniforms{};
+};
+
+struct RenderQueueStats {
+  unsigned int rqsDrawCalls = 0;
+  unsigned int rqsProgramChanges = 0;
+  unsigned int rqsVertexArrayChanges = 0;
+  unsigned int rqsTextureChanges = 0;
+  unsigned int rqsBufferChanges = 0;
+  unsigned int rqsSkippedChanges = 0;
+};
+
+class RenderQueue {
+  public:
+    /* from the top: pass 4 bits at 60, shader 12 bits at 48, material 24 bits at 24, model 24 bits at 0 */
+    static uint64_t createSortKey(renderPass pass, uint32_t shader, uint32_t material, uint32_t model);
+    static uint64_t setSortKeyMaterial(uint64_t sortKey, uint32_t material);
+
+    /* the pass bits of the sort key select the pass the command is drawn in */
+    void submit(const RenderCommand& command);
+    /* sorts and executes the commands of one pass, GL state is unknown afterwards */
+    void flush(renderPass pass);
+
+    RenderQueueStats getStats();
+    void resetStats();
+
+  private:
+    void sortCommands(std::vector<RenderCommand>& commands);
+    void invalidateState();
+
+    /* binding points above are bound for every command */
+    static constexpr unsigned int MAX_TRACKED_BINDINGS = 16;
+
+    std::array<std::vector<RenderCommand>, static_cast<size_t>(renderPass::NUM)> mPassCommands{};
+    std::vector<RenderCommand> mSortBuffer{};
+
+    GLuint mBoundProgram = 0;
+    GLuint mBoundVertexArray = 0;
+    GLuint mBoundTexture = 0;
+    std::array<GLuint, MAX_TRACKED_BINDINGS> mBoundStorageBuffers{};
+
+    RenderQueueStats mStats{};
+};
@@ -1,15 +1,23 @@
 #include <vector>
+#include <filesystem>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "Shader.h"
+#include "Hash.h"
 #include "Tools.h"
 #include "Logger.h"
 
-bool Shader::loadShaders(std::string vertexShaderFileName, std::string fragmentShaderFileName) {
+std::string Shader::mCacheDirectory = "shadercache";
+
+bool Shader::loadShaders(std::string vertexShaderFileName, std::string fragmentShaderFileName,
+    std::vector<std::string> defines) {
   Logger::log(1, "%s: loading vertex shader '%s' and fragment shader '%s'\n", __FUNCTION__, vertexShaderFileName.c_str(), fragmentShaderFileName.c_str());
 
-  if (!createShaderProgram(vertexShaderFileName, fragmentShaderFileName)) {
+  if (!createShaderProgram(vertexShaderFileName, fragmentShaderFileName, defines)) {
     Logger::log(1, "%s error: shader program creation failed\n", __FUNCTION__);
     return false;
   }
@@ -17,10 +25,10 @@ bool Shader::loadShaders(std::string vertexShaderFileName, std::string fragmentS
   return true;
 }
 
-bool Shader::loadComputeShader(std::string computeShaderFileName) {
+bool Shader::loadComputeShader(std::string computeShaderFileName, std::vector<std::string> defines) {
   Logger::log(1, "%s: loading compute shader '%s'\n", __FUNCTION__, computeShaderFileName.c_str());
 
-  if (!createComputeShaderProgram(computeShaderFileName)) {
+  if (!createComputeShaderProgram(computeShaderFileName, defines)) {
     Logger::log(1, "%s error: shader program creation failed\n", __FUNCTION__);
     return false;
   }
@@ -33,6 +41,10 @@ void Shader::use() {
   glUseProgram(mShaderProgram);
 }
 
+GLuint Shader::getProgram() {
+  return mShaderProgram;
+}
+
 bool Shader::getUniformLocation(std::string uniformName) {
   if (mShaderProgram > 0) {
     mUniformLocation = glGetUniformLocation(mShaderProgram, uniformName.c_str());
@@ -45,27 +57,51 @@ void Shader::setUniformValue(int value) {
   if (mShaderProgram > 0) {
     /* 0 is a valid location */
     if (mUniformLocation > -1) {
-      glUniform1i(mUniformLocation, value);
+      glProgramUniform1i(mShaderProgram, mUniformLocation, value);
     }
   }
 }
 
+void Shader::setUniformValue(GLint location, int value) {
+  if (mShaderProgram > 0) {
+    glProgramUniform1i(mShaderProgram, location, value);
+  }
+}
+
 void Shader::cleanup() {
   glDeleteProgram(mShaderProgram);
+  mShaderProgram = 0;
 }
 
-GLuint Shader::loadShader(std::string shaderFileName, GLuint shaderType) {
+std::string Shader::loadShaderSource(std::string shaderFileName, std::vector<std::string> defines) {
   std::string shaderAsText;
   shaderAsText = Tools::loadFileToString(shaderFileName);
   Logger::log(4, "%s: loaded shader file '%s', size %i\n", __FUNCTION__, shaderFileName.c_str(),shaderAsText.size());
 
-  const char* shaderSource = shaderAsText.c_str();
+  /* #version must stay the first statement */
+  if (!defines.empty()) {
+    std::string defineLines;
+    for (const auto& define : defines) {
+      defineLines += "#define " + define + "\n";
+    }
+    size_t versionEnd = shaderAsText.find('\n', shaderAsText.find("#version"));
+    if (versionEnd != std::string::npos) {
+      shaderAsText.insert(versionEnd + 1, defineLines);
+    }
+  }
+
+  return shaderAsText;
+}
+
+GLuint Shader::loadShader(std::string shaderFileName, std::string shaderSource, GLuint shaderType) {
+  const char* shaderText = shaderSource.c_str();
   GLuint shader = glCreateShader(shaderType);
-  glShaderSource(shader, 1, (const GLchar**) &shaderSource, 0);
+  glShaderSource(shader, 1, (const GLchar**) &shaderText, 0);
   glCompileShader(shader);
 
   if (!checkCompileStats(shaderFileName, shader)) {
     Logger::log(1, "%s error: compiling shader '%s' failed\n", __FUNCTION__, shaderFileName.c_str());
+    glDeleteShader(shader);
     return 0;
   }
 
@@ -73,16 +109,147 @@ GLuint Shader::loadShader(std::string shaderFileName, GLuint shaderType) {
   return shader;
 }
 
-bool Shader::createShaderProgram(std::string vertexShaderFileName, std::string fragmentShaderFileName) {
-  GLuint vertexShader = loadShader(vertexShaderFileName, GL_VERTEX_SHADER);
+uint64_t Shader::getProgramKey(std::vector<std::string> shaderSources) {
+  /* a driver update invalidates all binaries, so the driver strings are part of the key */
+  uint64_t programKey = Hash::hashData(nullptr, 0);
+  for (const GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+    const char* driverString = reinterpret_cast<const char*>(glGetString(name));
+    if (driverString) {
+      programKey = Hash::hashData(driverString, std::strlen(driverString), programKey);
+    }
+  }
+
+  for (const auto& source : shaderSources) {
+    programKey = Hash::hashData(source.data(), source.size(), programKey);
+  }
+  return programKey;
+}
+
+bool Shader::loadProgramBinary(uint64_t programKey) {
+  char keyString[17];
+  std::snprintf(keyString, sizeof(keyString), "%016llx", static_cast<unsigned long long>(programKey));
+  std::string binaryFileName = mCacheDirectory + "/" + keyString + ".bin";
+
+  std::ifstream inFile(binaryFileName, std::ios::binary | std::ios::ate);
+  if (!inFile.is_open()) {
+    return false;
+  }
+
+  std::streamsize fileSize = inFile.tellg();
+  size_t headerSize = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(GLenum);
+  if (fileSize <= static_cast<std::streamsize>(headerSize)) {
+    return false;
+  }
+  inFile.seekg(0, std::ios::beg);
+
+  uint32_t magic = 0;
+  uint64_t fileKey = 0;
+  GLenum binaryFormat = 0;
+  inFile.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  inFile.read(reinterpret_cast<char*>(&fileKey), sizeof(fileKey));
+  inFile.read(reinterpret_cast<char*>(&binaryFormat), sizeof(binaryFormat));
+  if (!inFile || magic != BINARY_MAGIC || fileKey != programKey) {
+    return false;
+  }
+
+  std::vector<char> binary(fileSize - headerSize);
+  if (!inFile.read(binary.data(), binary.size())) {
+    return false;
+  }
+
+  mShaderProgram = glCreateProgram();
+  glProgramBinary(mShaderProgram, binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+  /* the driver may reject a binary at any time, we compile from source then */
+  GLint isProgramLinked = GL_FALSE;
+  glGetProgramiv(mShaderProgram, GL_LINK_STATUS, &isProgramLinked);
+  if (!isProgramLinked) {
+    Logger::log(1, "%s: program binary '%s' rejected by driver\n", __FUNCTION__, binaryFileName.c_str());
+    glDeleteProgram(mShaderProgram);
+    mShaderProgram = 0;
+    return false;
+  }
+
+  Logger::log(1, "%s: shader program %#x loaded from binary '%s'\n", __FUNCTION__, mShaderProgram, binaryFileName.c_str());
+  return true;
+}
+
+void Shader::saveProgramBinary(uint64_t programKey) {
+  GLint binaryLength = 0;
+  glGetProgramiv(mShaderProgram, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+  if (binaryLength <= 0) {
+    return;
+  }
+
+  std::vector<char> binary(binaryLength);
+  GLenum binaryFormat = 0;
+  glGetProgramBinary(mShaderProgram, binaryLength, nullptr, &binaryFormat, binary.data());
+
+  std::error_code error;
+  std::filesystem::create_directories(mCacheDirectory, error);
+  if (error) {
+    Logger::log(1, "%s error: could not create shader cache directory '%s'\n", __FUNCTION__, mCacheDirectory.c_str());
+    return;
+  }
+
+  char keyString[17];
+  std::snprintf(keyString, sizeof(keyString), "%016llx", static_cast<unsigned long long>(programKey));
+  std::string binaryFileName = mCacheDirectory + "/" + keyString + ".bin";
+
+  /* a crash while writing must not leave a truncated binary behind, move the complete file into place */
+  std::string tempFileName = binaryFileName + ".tmp";
+  std::ofstream outFile(tempFileName, std::ios::binary | std::ios::trunc);
+  if (!outFile.is_open()) {
+    Logger::log(1, "%s error: could not open program binary '%s' for writing\n", __FUNCTION__, tempFileName.c_str());
+    return;
+  }
+
+  outFile.write(reinterpret_cast<const char*>(&BINARY_MAGIC), sizeof(BINARY_MAGIC));
+  outFile.write(reinterpret_cast<const char*>(&programKey), sizeof(programKey));
+  outFile.write(reinterpret_cast<const char*>(&binaryFormat), sizeof(binaryFormat));
+  outFile.write(binary.data(), binary.size());
+
+  outFile.close();
+  if (!outFile.good()) {
+    Logger::log(1, "%s error: could not write program binary '%s'\n", __FUNCTION__, tempFileName.c_str());
+    std::filesystem::remove(tempFileName, error);
+    return;
+  }
+
+  std::filesystem::rename(tempFileName, binaryFileName, error);
+  if (error) {
+    Logger::log(1, "%s error: could not rename program binary '%s' (%s)\n", __FUNCTION__, tempFileName.c_str(),
+      error.message().c_str());
+    std::filesystem::remove(tempFileName, error);
+    return;
+  }
+
+  Logger::log(1, "%s: saved program binary '%s' (%i bytes)\n", __FUNCTION__, binaryFileName.c_str(), binaryLength);
+}
+
+bool Shader::createShaderProgram(std::string vertexShaderFileName, std::string fragmentShaderFileName,
+    std::vector<std::string> defines) {
+  std::string vertexShaderSource = loadShaderSource(vertexShaderFileName, defines);
+  std::string fragmentShaderSource = loadShaderSource(fragmentShaderFileName, defines);
+  uint64_t programKey = getProgramKey({ vertexShaderSource, fragmentShaderSource });
+
+  if (loadProgramBinary(programKey)) {
+    /* bind UBO in shader, block bindings are not part of the binary */
+    GLint uboIndex = glGetUniformBlockIndex(mShaderProgram, "Matrices");
+    glUniformBlockBinding(mShaderProgram, uboIndex, 0);
+    return true;
+  }
+
+  GLuint vertexShader = loadShader(vertexShaderFileName, vertexShaderSource, GL_VERTEX_SHADER);
   if (!vertexShader) {
     Logger::log(1, "%s: loading of vertex shader '%s' failed\n", __FUNCTION__, vertexShaderFileName.c_str());
     return false;
   }
 
-  GLuint fragmentShader = loadShader(fragmentShaderFileName, GL_FRAGMENT_SHADER);
+  GLuint fragmentShader = loadShader(fragmentShaderFileName, fragmentShaderSource, GL_FRAGMENT_SHADER);
   if (!fragmentShader) {
     Logger::log(1, "%s: loading of fragment shader '%s' failed\n", __FUNCTION__, fragmentShaderFileName.c_str());
+    glDeleteShader(vertexShader);
     return false;
   }
 
@@ -91,6 +258,7 @@ bool Shader::createShaderProgram(std::string vertexShaderFileName, std::string f
   glAttachShader(mShaderProgram, vertexShader);
   glAttachShader(mShaderProgram, fragmentShader);
 
+  glProgramParameteri(mShaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
   glLinkProgram(mShaderProgram);
 
   if (!checkLinkStats(vertexShaderFileName, fragmentShaderFileName, mShaderProgram)) {
@@ -110,12 +278,21 @@ bool Shader::createShaderProgram(std::string vertexShaderFileName, std::string f
   glDeleteShader(vertexShader);
   glDeleteShader(fragmentShader);
 
+  saveProgramBinary(programKey);
+
   Logger::log(1, "%s: shader program %#x successfully compiled from vertex shader '%s' and fragment shader '%s'\n", __FUNCTION__, mShaderProgram, vertexShaderFileName.c_str(), fragmentShaderFileName.c_str());
   return true;
 }
 
-bool Shader::createComputeShaderProgram(std::string computeShaderName) {
-  GLuint computeShader = loadShader(computeShaderName, GL_COMPUTE_SHADER);
+bool Shader::createComputeShaderProgram(std::string computeShaderName, std::vector<std::string> defines) {
+  std::string computeShaderSource = loadShaderSource(computeShaderName, defines);
+  uint64_t programKey = getProgramKey({ computeShaderSource });
+
+  if (loadProgramBinary(programKey)) {
+    return true;
+  }
+
+  GLuint computeShader = loadShader(computeShaderName, computeShaderSource, GL_COMPUTE_SHADER);
   if (!computeShader) {
     Logger::log(1, "%s: loading of compute shader '%s' failed\n", __FUNCTION__, computeShaderName.c_str());
     return false;
@@ -125,6 +302,7 @@ bool Shader::createComputeShaderProgram(std::string computeShaderName) {
 
   glAttachShader(mShaderProgram, computeShader);
 
+  glProgramParameteri(mShaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
   glLinkProgram(mShaderProgram);
 
   if (!checkLinkStats(computeShaderName, mShaderProgram)) {
@@ -138,6 +316,8 @@ bool Shader::createComputeShaderProgram(std::string computeShaderName) {
   /* it is safe to delete the original shaders here */
   glDeleteShader(computeShader);
 
+  saveProgramBinary(programKey);
+
   Logger::log(1, "%s: shader program %#x successfully compiled from compute shader '%s'\n", __FUNCTION__, mShaderProgram, computeShaderName.c_str());
   return true;
 }
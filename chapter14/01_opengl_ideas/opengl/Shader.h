@@ -1,16 +1,24 @@
 #pragma once
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 class Shader {
   public:
-    bool loadShaders(std::string vertexShaderFileName, std::string fragmentShaderFileName);
-    bool loadComputeShader(std::string computeShaderFileName);
+    /* defines are inserted after the #version line of both shaders */
+    bool loadShaders(std::string vertexShaderFileName, std::string fragmentShaderFileName,
+      std::vector<std::string> defines = {});
+    bool loadComputeShader(std::string computeShaderFileName, std::vector<std::string> defines = {});
 
     void use();
+    GLuint getProgram();
     bool getUniformLocation(std::string uniformName);
+    /* no need to bind the program first */
     void setUniformValue(int value);
+    /* for uniforms with an explicit layout location */
+    void setUniformValue(GLint location, int value);
 
     void cleanup();
 
@@ -18,12 +26,22 @@ class Shader {
     GLuint mShaderProgram = 0;
     GLint mUniformLocation = -1;
 
-    bool createShaderProgram(std::string vertexShaderFileName, std::string fragmentShaderFileName);
-    bool createComputeShaderProgram(std::string computeShaderName);
+    bool createShaderProgram(std::string vertexShaderFileName, std::string fragmentShaderFileName,
+      std::vector<std::string> defines);
+    bool createComputeShaderProgram(std::string computeShaderName, std::vector<std::string> defines);
 
-    GLuint loadShader(std::string shaderFileName, GLuint shaderType);
+    std::string loadShaderSource(std::string shaderFileName, std::vector<std::string> defines);
+    GLuint loadShader(std::string shaderFileName, std::string shaderSource, GLuint shaderType);
+
+    /* linked programs are cached as driver binaries, keyed by source hash and driver string */
+    uint64_t getProgramKey(std::vector<std::string> shaderSources);
+    bool loadProgramBinary(uint64_t programKey);
+    void saveProgramBinary(uint64_t programKey);
 
     bool checkCompileStats(std::string shaderFileName, GLuint shader);
     bool checkLinkStats(std::string vertexShaderFileName, std::string fragmentShaderFileName, GLuint shaderProgram);
     bool checkLinkStats(std::string computeShaderFileName, GLuint shaderProgram);
+
+    static constexpr uint32_t BINARY_MAGIC = 0x31425053; // "SPB1"
+    static std::string mCacheDirectory;
 };
@@ -0,0 +1,73 @@
+#include "ShaderPermutations.h"
+#include "Logger.h"
+
+bool ShaderPermutations::loadShaders(std::string vertexShaderFileName, std::string fragmentShaderFileName,
+    std::vector<std::string> defines, std::string uniformName) {
+  mVertexShaderFileName = vertexShaderFileName;
+  mFragmentShaderFileName = fragmentShaderFileName;
+  mDefines = defines;
+  mUniformName = uniformName;
+
+  return createVariant(shaderFeature::none);
+}
+
+bool ShaderPermutations::loadComputeShader(std::string computeShaderFileName, std::vector<std::string> defines) {
+  mComputeShaderFileName = computeShaderFileName;
+  mDefines = defines;
+
+  return createVariant(shaderFeature::none);
+}
+
+Shader& ShaderPermutations::getVariant(shaderFeature features) {
+  if (mVariants.count(features) == 0) {
+    /* a failed variant stays in the map with an empty program, no retries every frame */
+    if (!createVariant(features)) {
+      Logger::log(1, "%s error: could not create shader variant %#x\n", __FUNCTION__, static_cast<int>(features));
+    }
+  }
+  return mVariants[features];
+}
+
+size_t ShaderPermutations::getNumVariants() {
+  return mVariants.size();
+}
+
+bool ShaderPermutations::createVariant(shaderFeature features) {
+  std::vector<std::string> defines = mDefines;
+  if ((features & shaderFeature::morphAnim) != shaderFeature::none) {
+    defines.emplace_back("MORPH_ANIM");
+  }
+  if ((features & shaderFeature::selection) != shaderFeature::none) {
+    defines.emplace_back("SELECTION");
+  }
+  if ((features & shaderFeature::headMove) != shaderFeature::none) {
+    defines.emplace_back("HEAD_MOVE");
+  }
+
+  Shader& shader = mVariants[features];
+  if (!mComputeShaderFileName.empty()) {
+    if (!shader.loadComputeShader(mComputeShaderFileName, defines)) {
+      return false;
+    }
+  } else {
+    if (!shader.loadShaders(mVertexShaderFileName, mFragmentShaderFileName, defines)) {
+      return false;
+    }
+  }
+
+  if (!mUniformName.empty() && !shader.getUniformLocation(mUniformName)) {
+    Logger::log(1, "%s error: could not find symbol '%s' in shader variant %#x\n", __FUNCTION__, mUniformName.c_str(),
+      static_cast<int>(features));
+    return false;
+  }
+
+  Logger::log(1, "%s: created shader variant %#x (%zu variants)\n", __FUNCTION__, static_cast<int>(features), mVariants.size());
+  return true;
+}
+
+void ShaderPermutations::cleanup() {
+  for (auto& variant : mVariants) {
+    variant.second.cleanup();
+  }
+  mVariants.clear();
+}
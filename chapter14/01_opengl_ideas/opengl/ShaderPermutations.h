@@ -0,0 +1,32 @@
+/* all feature variants of one shader source, compiled on first use */
+#pragma once
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Shader.h"
+#include "Enums.h"
+
+class ShaderPermutations {
+  public:
+    /* the base variant is compiled right away to catch errors in the shader source */
+    bool loadShaders(std::string vertexShaderFileName, std::string fragmentShaderFileName,
+      std::vector<std::string> defines = {}, std::string uniformName = "");
+    bool loadComputeShader(std::string computeShaderFileName, std::vector<std::string> defines = {});
+
+    Shader& getVariant(shaderFeature features = shaderFeature::none);
+    size_t getNumVariants();
+
+    void cleanup();
+
+  private:
+    bool createVariant(shaderFeature features);
+
+    std::string mVertexShaderFileName;
+    std::string mFragmentShaderFileName;
+    std::string mComputeShaderFileName;
+    std::vector<std::string> mDefines{};
+    std::string mUniformName;
+
+    std::unordered_map<shaderFeature, Shader> mVariants{};
+};
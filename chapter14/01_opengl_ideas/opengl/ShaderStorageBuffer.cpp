@@ -8,6 +8,16 @@ void ShaderStorageBuffer::init(size_t bufferSize) {
   glBindBuffer(GL_SHADER_STORAGE_BUFFER, mShaderStorageBuffer);
   glBufferData(GL_SHADER_STORAGE_BUFFER, mBufferSize, nullptr, GL_DYNAMIC_COPY);
   glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+  MemoryTracker::addGpuAllocation(mMemoryTag, mBufferSize);
+}
+
+void ShaderStorageBuffer::setMemoryTag(memoryTag tag) {
+  if (mShaderStorageBuffer != 0) {
+    MemoryTracker::removeGpuAllocation(mMemoryTag, mBufferSize);
+    MemoryTracker::addGpuAllocation(tag, mBufferSize);
+  }
+  mMemoryTag = tag;
 }
 
 void ShaderStorageBuffer::bind(int bindingPoint) {
@@ -20,6 +30,24 @@ void ShaderStorageBuffer::bind(int bindingPoint) {
   glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
 }
 
+void ShaderStorageBuffer::copyData(ShaderStorageBuffer& sourceBuffer, size_t sourceOffset, size_t targetOffset,
+    size_t size) {
+  if (size == 0) {
+    return;
+  }
+
+  if (targetOffset + size > mBufferSize || sourceOffset + size > sourceBuffer.getBufferSize()) {
+    Logger::log(1, "%s error: copy of %i bytes exceeds the buffer sizes\n", __FUNCTION__, size);
+    return;
+  }
+
+  glBindBuffer(GL_COPY_READ_BUFFER, sourceBuffer.getBufferId());
+  glBindBuffer(GL_COPY_WRITE_BUFFER, mShaderStorageBuffer);
+  glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset, targetOffset, size);
+  glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
 GLuint ShaderStorageBuffer::getBufferId() {
   return mShaderStorageBuffer;
 }
@@ -80,7 +108,12 @@ std::vector<TRSMatrixData> ShaderStorageBuffer::getSsboDataTRSMatrixData() {
 }
 
 void ShaderStorageBuffer::cleanup() {
+  if (mShaderStorageBuffer != 0) {
+    MemoryTracker::removeGpuAllocation(mMemoryTag, mBufferSize);
+  }
   glDeleteBuffers(1, &mShaderStorageBuffer);
+  mShaderStorageBuffer = 0;
+  mBufferSize = 0;
 }
 
 size_t ShaderStorageBuffer::getBufferSize() {
@@ -8,10 +8,13 @@
 #include "OGLRenderData.h"
 #include "AABB.h"
 #include "Logger.h"
+#include "MemoryTracker.h"
 
 class ShaderStorageBuffer {
   public:
     void init(size_t bufferSize);
+    /* GPU memory of the buffer is accounted to this tag, also after a resize */
+    void setMemoryTag(memoryTag tag);
 
     /* upload and bind */
     template <typename T>
@@ -83,6 +86,9 @@ class ShaderStorageBuffer {
       glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
     }
 
+    /* GPU side copy, the target must be large enough */
+    void copyData(ShaderStorageBuffer& sourceBuffer, size_t sourceOffset, size_t targetOffset, size_t size);
+
     void bind(int bindingPoint);
     GLuint getBufferId();
     size_t getBufferSize();
@@ -98,4 +104,5 @@ class ShaderStorageBuffer {
   private:
     size_t mBufferSize = 0;
     GLuint mShaderStorageBuffer = 0;
+    memoryTag mMemoryTag = memoryTag::rendererBuffers;
 };
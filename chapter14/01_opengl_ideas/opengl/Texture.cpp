@@ -4,41 +4,114 @@
 #include <vector>
 
 #include "Texture.h"
+#include "TextureCache.h"
+#include "Hash.h"
 #include "Logger.h"
+#include "MemoryTracker.h"
 
 bool Texture::loadTexture(std::string textureFilename, bool flipImage) {
   mTextureName = textureFilename;
+  if (!decodeTexture(textureFilename, flipImage)) {
+    return false;
+  }
+  return uploadTexture();
+}
 
-  stbi_set_flip_vertically_on_load(flipImage);
-  /* always load as RGBA */
-  unsigned char *textureData = stbi_load(textureFilename.c_str(), &mTexWidth, &mTexHeight, &mNumberOfChannels, STBI_rgb_alpha);
+void Texture::waitForDecoding() {
+  /* the job writes to this texture, it must not run after the texture is gone */
+  if (mDecodeResult.valid()) {
+    mDecodeResult.wait();
+  }
+}
 
-  if (!textureData) {
-    Logger::log(1, "%s error: could not load file '%s'\n", __FUNCTION__, mTextureName.c_str());
-    stbi_image_free(textureData);
+bool Texture::loadTexture(std::string textureName, aiTexel* textureData, int width, int height, bool flipImage) {
+  mTextureName = textureName;
+  if (!decodeTexture(textureName, textureData, width, height, flipImage)) {
     return false;
   }
+  return uploadTexture();
+}
 
-  glGenTextures(1, &mTexture);
-  glBindTexture(GL_TEXTURE_2D, mTexture);
+void Texture::loadTextureAsync(ThreadPool& pool, std::string textureFilename, bool flipImage) {
+  mTextureName = textureFilename;
+  mDecodeResult = pool.submit([this, textureFilename, flipImage]() {
+    return decodeTexture(textureFilename, flipImage);
+  });
+}
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+void Texture::loadTextureAsync(ThreadPool& pool, std::string textureName, aiTexel* textureData, int width, int height,
+    bool flipImage) {
+  mTextureName = textureName;
+  mDecodeResult = pool.submit([this, textureName, textureData, width, height, flipImage]() {
+    return decodeTexture(textureName, textureData, width, height, flipImage);
+  });
+}
 
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, mTexWidth, mTexHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, textureData);
+bool Texture::finishLoading() {
+  /* shared textures are finished by the first user */
+  if (mLoadingFinished) {
+    return mTexture != 0;
+  }
 
-  glGenerateMipmap(GL_TEXTURE_2D);
-  glBindTexture(GL_TEXTURE_2D, 0);
+  if (!mDecodeResult.valid()) {
+    Logger::log(1, "%s error: texture '%s' was not scheduled for loading\n", __FUNCTION__, mTextureName.c_str());
+    return false;
+  }
+
+  /* blocks until the worker thread has finished */
+  mLoadingFinished = true;
+  if (!mDecodeResult.get()) {
+    return false;
+  }
+  return uploadTexture();
+}
+
+bool Texture::decodeTexture(std::string textureFilename, bool flipImage) {
+  MEMORY_TAG_SCOPE(memoryTag::textures);
+  uint64_t nameHash = Hash::hashData(textureFilename.data(), textureFilename.size());
+  nameHash = Hash::hashData(&flipImage, sizeof(flipImage), nameHash);
+  std::string cacheFileName = TextureCache::getCacheFileName(nameHash);
+  uint64_t sourceKey = TextureCache::getFileKey(textureFilename, flipImage);
+
+  /* skip the image decoding if we have an up-to-date converted version */
+  if (sourceKey != 0 && TextureCache::loadFromCache(cacheFileName, sourceKey, mCacheData) &&
+      isFormatSupported(mCacheData.internalFormat)) {
+    Logger::log(1, "%s: texture '%s' loaded from cache file '%s'\n", __FUNCTION__, textureFilename.c_str(), cacheFileName.c_str());
+    return true;
+  }
 
+  /* the global flip flag is not thread safe, use the per-thread variant */
+  stbi_set_flip_vertically_on_load_thread(flipImage);
+  /* always load as RGBA */
+  int width = 0;
+  int height = 0;
+  int numberOfChannels = 0;
+  unsigned char *textureData = stbi_load(textureFilename.c_str(), &width, &height, &numberOfChannels, STBI_rgb_alpha);
+
+  if (!textureData) {
+    Logger::log(1, "%s error: could not load file '%s'\n", __FUNCTION__, textureFilename.c_str());
+    stbi_image_free(textureData);
+    return false;
+  }
+
+  bool converted = TextureCache::convertImage(textureData, width, height, numberOfChannels,
+    isCompressionSupported(), mCacheData);
   stbi_image_free(textureData);
 
-  Logger::log(1, "%s: texture '%s' loaded (%dx%d, %d channels)\n", __FUNCTION__, mTextureName.c_str(), mTexWidth, mTexHeight, mNumberOfChannels);
+  if (!converted) {
+    Logger::log(1, "%s error: could not convert texture '%s'\n", __FUNCTION__, textureFilename.c_str());
+    return false;
+  }
+
+  if (sourceKey != 0) {
+    TextureCache::saveToCache(cacheFileName, sourceKey, mCacheData);
+  }
+
   return true;
 }
 
-bool Texture::loadTexture(std::string textureName, aiTexel* textureData, int width, int height, bool flipImage) {
+bool Texture::decodeTexture(std::string textureName, aiTexel* textureData, int width, int height, bool flipImage) {
+  MEMORY_TAG_SCOPE(memoryTag::textures);
   if (!textureData) {
     Logger::log(1, "%s error: could not load texture '%s'\n", __FUNCTION__, textureName.c_str());
     return false;
@@ -46,37 +119,134 @@ bool Texture::loadTexture(std::string textureName, aiTexel* textureData, int wid
 
   Logger::log(1, "%s: texture file '%s' has width %i and height %i\n", __FUNCTION__, textureName.c_str(), width, height);
 
-  glGenTextures(1, &mTexture);
-  glBindTexture(GL_TEXTURE_2D, mTexture);
+  /* embedded textures have no usable name, identify them by content */
+  int dataSize = height == 0 ? width : width * height * sizeof(aiTexel);
+  uint64_t sourceKey = Hash::hashData(textureData, dataSize);
+  sourceKey = Hash::hashData(&flipImage, sizeof(flipImage), sourceKey);
+  std::string cacheFileName = TextureCache::getCacheFileName(sourceKey);
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  if (TextureCache::loadFromCache(cacheFileName, sourceKey, mCacheData) && isFormatSupported(mCacheData.internalFormat)) {
+    Logger::log(1, "%s: texture '%s' loaded from cache file '%s'\n", __FUNCTION__, textureName.c_str(), cacheFileName.c_str());
+    return true;
+  }
 
   /* allow to flip the image, similar to file loaded from disk */
-  stbi_set_flip_vertically_on_load(flipImage);
+  stbi_set_flip_vertically_on_load_thread(flipImage);
 
   /* we use stbi to detect the in-memory format, but always request RGBA */
+  int imageWidth = 0;
+  int imageHeight = 0;
+  int numberOfChannels = 0;
   unsigned char *data = nullptr;
   if (height == 0)   {
-    data = stbi_load_from_memory(reinterpret_cast<unsigned char*>(textureData), width, &mTexWidth, &mTexHeight, &mNumberOfChannels, STBI_rgb_alpha);
+    data = stbi_load_from_memory(reinterpret_cast<unsigned char*>(textureData), width, &imageWidth, &imageHeight, &numberOfChannels, STBI_rgb_alpha);
   }
   else   {
-    data = stbi_load_from_memory(reinterpret_cast<unsigned char*>(textureData), width * height, &mTexWidth, &mTexHeight, &mNumberOfChannels, STBI_rgb_alpha);
+    data = stbi_load_from_memory(reinterpret_cast<unsigned char*>(textureData), width * height, &imageWidth, &imageHeight, &numberOfChannels, STBI_rgb_alpha);
   }
 
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_SRGB8_ALPHA8, mTexWidth, mTexHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+  if (!data) {
+    Logger::log(1, "%s error: could not decode texture '%s'\n", __FUNCTION__, textureName.c_str());
+    return false;
+  }
 
+  bool converted = TextureCache::convertImage(data, imageWidth, imageHeight, numberOfChannels, isCompressionSupported(), mCacheData);
   stbi_image_free(data);
 
-  glGenerateMipmap(GL_TEXTURE_2D);
+  if (!converted) {
+    Logger::log(1, "%s error: could not convert texture '%s'\n", __FUNCTION__, textureName.c_str());
+    return false;
+  }
+
+  TextureCache::saveToCache(cacheFileName, sourceKey, mCacheData);
+
+  return true;
+}
+
+bool Texture::uploadTexture() {
+  const TextureCacheData& cacheData = mCacheData;
+  if (cacheData.mipLevels.empty()) {
+    Logger::log(1, "%s error: texture '%s' has no image data\n", __FUNCTION__, mTextureName.c_str());
+    return false;
+  }
+
+  mTexWidth = cacheData.width;
+  mTexHeight = cacheData.height;
+  mNumberOfChannels = cacheData.numberOfChannels;
+  mTextureFormat = cacheData.internalFormat;
+
+  glGenTextures(1, &mTexture);
+  glBindTexture(GL_TEXTURE_2D, mTexture);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(cacheData.mipLevels.size()) - 1);
+
+  /* mip levels are pre-built, no glGenerateMipmap() */
+  mTextureMemorySize = 0;
+  bool compressed = TextureCache::isCompressed(mTextureFormat);
+  for (size_t level = 0; level < cacheData.mipLevels.size(); ++level) {
+    const TextureMipLevel& mip = cacheData.mipLevels.at(level);
+    if (compressed) {
+      glCompressedTexImage2D(GL_TEXTURE_2D, level, mTextureFormat, mip.width, mip.height, 0, mip.data.size(), mip.data.data());
+    } else {
+      glTexImage2D(GL_TEXTURE_2D, level, mTextureFormat, mip.width, mip.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, mip.data.data());
+    }
+    mTextureMemorySize += mip.data.size();
+  }
+
   glBindTexture(GL_TEXTURE_2D, 0);
+  MemoryTracker::addGpuAllocation(memoryTag::textures, mTextureMemorySize);
+
+  Logger::log(1, "%s: texture '%s' loaded (%dx%d, %d channels, %zu mip levels, %s, %zu bytes)\n", __FUNCTION__,
+    mTextureName.c_str(), mTexWidth, mTexHeight, mNumberOfChannels, cacheData.mipLevels.size(),
+    compressed ? "compressed" : "uncompressed", mTextureMemorySize);
 
-  Logger::log(1, "%s: texture '%s' loaded (%dx%d, %d channels)\n", __FUNCTION__, textureName.c_str(), mTexWidth, mTexHeight, mNumberOfChannels);
+  /* image data is in GPU memory now */
+  mCacheData = TextureCacheData{};
   return true;
 }
 
+GLuint64 Texture::getBindlessHandle() {
+  if (mBindlessHandle == 0 && mTexture != 0) {
+    mBindlessHandle = glGetTextureHandleARB(mTexture);
+    glMakeTextureHandleResidentARB(mBindlessHandle);
+  }
+  return mBindlessHandle;
+}
+
+bool Texture::isBindlessSupported() {
+  return GLAD_GL_ARB_bindless_texture;
+}
+
+bool Texture::isCompressionSupported() {
+  return GLAD_GL_EXT_texture_compression_s3tc && GLAD_GL_EXT_texture_sRGB;
+}
+
+bool Texture::isFormatSupported(GLenum internalFormat) {
+  /* cache files may have been created on a machine with S3TC support */
+  return !TextureCache::isCompressed(internalFormat) || isCompressionSupported();
+}
+
+size_t Texture::getTextureMemorySize() {
+  return mTextureMemorySize;
+}
+
+std::string Texture::getTextureName() {
+  return mTextureName;
+}
+
+int Texture::getWidth() {
+  return mTexWidth;
+}
+
+int Texture::getHeight() {
+  return mTexHeight;
+}
+
 bool Texture::loadCubemapTexture(std::string textureFilename, bool flipImage) {
   mTextureName = textureFilename;
 
@@ -140,6 +310,8 @@ bool Texture::loadCubemapTexture(std::string textureFilename, bool flipImage) {
     }
     glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_SRGB8_ALPHA8, cubeFaceWidth, cubeFaceHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, subImage.data());
   }
+  mTextureMemorySize = subImage.size() * 6;
+  MemoryTracker::addGpuAllocation(memoryTag::textures, mTextureMemorySize);
 
   // nearest filter and clamp to edge for Cube Map
   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -157,7 +329,19 @@ bool Texture::loadCubemapTexture(std::string textureFilename, bool flipImage) {
 }
 
 void Texture::cleanup() {
+  if (mTexture != 0) {
+    MemoryTracker::removeGpuAllocation(memoryTag::textures, mTextureMemorySize);
+  }
+  if (mBindlessHandle != 0) {
+    glMakeTextureHandleNonResidentARB(mBindlessHandle);
+    mBindlessHandle = 0;
+  }
   glDeleteTextures(1, &mTexture);
+  mTexture = 0;
+}
+
+GLuint Texture::getTextureId() {
+  return mTexture;
 }
 
 void Texture::bind() {
@@ -1,15 +1,27 @@
 #pragma once
 #include <string>
+#include <future>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include <assimp/texture.h>
 
+#include "TextureCache.h"
+#include "ThreadPool.h"
+
 class Texture {
   public:
     bool loadTexture(std::string textureFilename, bool flipImage = true);
     bool loadTexture(std::string textureName, aiTexel* textureData, int width, int height, bool flipImage = true);
 
+    /* decodes the image on a worker thread, call finishLoading() on the GL thread to upload */
+    void loadTextureAsync(ThreadPool& pool, std::string textureFilename, bool flipImage = true);
+    void loadTextureAsync(ThreadPool& pool, std::string textureName, aiTexel* textureData, int width, int height,
+      bool flipImage = true);
+    bool finishLoading();
+    /* waits for the decode job without uploading, the texture can be released afterwards */
+    void waitForDecoding();
+
     bool loadCubemapTexture(std::string textureFilename, bool flipImage = true);
 
     void bind();
@@ -20,10 +32,36 @@ class Texture {
 
     void cleanup();
 
+    GLuint getTextureId();
+    size_t getTextureMemorySize();
+    std::string getTextureName();
+    int getWidth();
+    int getHeight();
+
+    /* creates the handle and makes it resident on first call */
+    GLuint64 getBindlessHandle();
+    static bool isBindlessSupported();
+
+    /* S3TC compression needs the sRGB variants too */
+    static bool isCompressionSupported();
+
   private:
+    /* no GL calls allowed in the decode functions */
+    bool decodeTexture(std::string textureFilename, bool flipImage);
+    bool decodeTexture(std::string textureName, aiTexel* textureData, int width, int height, bool flipImage);
+    bool uploadTexture();
+    static bool isFormatSupported(GLenum internalFormat);
+
     GLuint mTexture = 0;
+    GLuint64 mBindlessHandle = 0;
     int mTexWidth = 0;
     int mTexHeight = 0;
     int mNumberOfChannels = 0;
+    GLenum mTextureFormat = GL_SRGB8_ALPHA8;
+    size_t mTextureMemorySize = 0;
     std::string mTextureName;
+
+    TextureCacheData mCacheData{};
+    std::future<bool> mDecodeResult{};
+    bool mLoadingFinished = false;
 };
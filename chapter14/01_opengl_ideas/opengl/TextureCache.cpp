@@ -0,0 +1,293 @@
+#define STB_DXT_IMPLEMENTATION
+#include <stb_dxt.h>
+
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <functional>
+
+#include "TextureCache.h"
+#include "Hash.h"
+#include "Logger.h"
+
+std::string TextureCache::mCacheDirectory = "texcache";
+
+namespace {
+  /* textures are sRGB, mip levels must be filtered in linear space */
+  std::array<float, 256> createSrgbToLinearTable() {
+    std::array<float, 256> table{};
+    for (int i = 0; i < 256; ++i) {
+      float value = i / 255.0f;
+      table.at(i) = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+    return table;
+  }
+
+  unsigned char linearToSrgb(float value) {
+    value = std::clamp(value, 0.0f, 1.0f);
+    float srgb = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    return static_cast<unsigned char>(srgb * 255.0f + 0.5f);
+  }
+
+  template <typename T>
+  bool readValue(const std::vector<char>& buffer, size_t& offset, T& value) {
+    if (offset + sizeof(T) > buffer.size()) {
+      return false;
+    }
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  void writeValue(std::ofstream& outFile, const T& value) {
+    outFile.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+bool TextureCache::isCompressed(GLenum internalFormat) {
+  return internalFormat == GL_COMPRESSED_SRGB_S3TC_DXT1_EXT || internalFormat == GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+}
+
+void TextureCache::generateMipLevel(const TextureMipLevel& source, TextureMipLevel& dest) {
+  static const std::array<float, 256> srgbToLinear = createSrgbToLinearTable();
+
+  dest.width = std::max(1, source.width / 2);
+  dest.height = std::max(1, source.height / 2);
+  dest.data.resize(dest.width * dest.height * 4);
+
+  /* 2x2 box filter, clamped at the border for odd sizes */
+  for (int y = 0; y < dest.height; ++y) {
+    int y0 = std::min(y * 2, source.height - 1);
+    int y1 = std::min(y * 2 + 1, source.height - 1);
+    for (int x = 0; x < dest.width; ++x) {
+      int x0 = std::min(x * 2, source.width - 1);
+      int x1 = std::min(x * 2 + 1, source.width - 1);
+
+      const unsigned char* p00 = source.data.data() + (y0 * source.width + x0) * 4;
+      const unsigned char* p01 = source.data.data() + (y0 * source.width + x1) * 4;
+      const unsigned char* p10 = source.data.data() + (y1 * source.width + x0) * 4;
+      const unsigned char* p11 = source.data.data() + (y1 * source.width + x1) * 4;
+
+      unsigned char* target = dest.data.data() + (y * dest.width + x) * 4;
+      for (int c = 0; c < 3; ++c) {
+        float value = (srgbToLinear.at(p00[c]) + srgbToLinear.at(p01[c]) + srgbToLinear.at(p10[c]) +
+          srgbToLinear.at(p11[c])) * 0.25f;
+        target[c] = linearToSrgb(value);
+      }
+      target[3] = static_cast<unsigned char>((p00[3] + p01[3] + p10[3] + p11[3] + 2) / 4);
+    }
+  }
+}
+
+void TextureCache::compressMipLevel(const TextureMipLevel& source, bool hasAlpha, TextureMipLevel& dest) {
+  const int blockSize = hasAlpha ? 16 : 8;
+  const int blocksX = (source.width + 3) / 4;
+  const int blocksY = (source.height + 3) / 4;
+
+  dest.width = source.width;
+  dest.height = source.height;
+  dest.data.resize(blocksX * blocksY * blockSize);
+
+  unsigned char block[4 * 4 * 4];
+  for (int by = 0; by < blocksY; ++by) {
+    for (int bx = 0; bx < blocksX; ++bx) {
+      /* small mip levels do not fill the whole block, repeat the border pixels */
+      for (int y = 0; y < 4; ++y) {
+        int sourceY = std::min(by * 4 + y, source.height - 1);
+        for (int x = 0; x < 4; ++x) {
+          int sourceX = std::min(bx * 4 + x, source.width - 1);
+          std::memcpy(block + (y * 4 + x) * 4, source.data.data() + (sourceY * source.width + sourceX) * 4, 4);
+        }
+      }
+      stb_compress_dxt_block(dest.data.data() + (by * blocksX + bx) * blockSize, block, hasAlpha ? 1 : 0, STB_DXT_HIGHQUAL);
+    }
+  }
+}
+
+bool TextureCache::convertImage(const unsigned char* imageData, int width, int height, int numberOfChannels,
+    bool compress, TextureCacheData& cacheData) {
+  if (!imageData || width <= 0 || height <= 0) {
+    Logger::log(1, "%s error: invalid image data\n", __FUNCTION__);
+    return false;
+  }
+
+  cacheData.width = width;
+  cacheData.height = height;
+  cacheData.numberOfChannels = numberOfChannels;
+  cacheData.mipLevels.clear();
+
+  std::vector<TextureMipLevel> rgbaLevels{};
+  TextureMipLevel baseLevel{};
+  baseLevel.width = width;
+  baseLevel.height = height;
+  baseLevel.data.assign(imageData, imageData + width * height * 4);
+  rgbaLevels.emplace_back(std::move(baseLevel));
+
+  while (rgbaLevels.back().width > 1 || rgbaLevels.back().height > 1) {
+    TextureMipLevel nextLevel{};
+    generateMipLevel(rgbaLevels.back(), nextLevel);
+    rgbaLevels.emplace_back(std::move(nextLevel));
+  }
+
+  if (!compress) {
+    cacheData.internalFormat = GL_SRGB8_ALPHA8;
+    cacheData.mipLevels = std::move(rgbaLevels);
+    return true;
+  }
+
+  /* use BC3 only if the image really has transparent pixels */
+  bool hasAlpha = false;
+  const std::vector<unsigned char>& baseData = rgbaLevels.at(0).data;
+  for (size_t i = 3; i < baseData.size(); i += 4) {
+    if (baseData.at(i) != 255) {
+      hasAlpha = true;
+      break;
+    }
+  }
+
+  cacheData.internalFormat = hasAlpha ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_SRGB_S3TC_DXT1_EXT;
+  cacheData.mipLevels.resize(rgbaLevels.size());
+  for (size_t i = 0; i < rgbaLevels.size(); ++i) {
+    compressMipLevel(rgbaLevels.at(i), hasAlpha, cacheData.mipLevels.at(i));
+  }
+
+  return true;
+}
+
+bool TextureCache::loadFromCache(std::string cacheFileName, uint64_t sourceKey, TextureCacheData& cacheData) {
+  std::ifstream inFile(cacheFileName, std::ios::binary | std::ios::ate);
+  if (!inFile.is_open()) {
+    return false;
+  }
+
+  /* read the entire file at once */
+  std::streamsize fileSize = inFile.tellg();
+  inFile.seekg(0, std::ios::beg);
+  std::vector<char> buffer(fileSize);
+  if (!inFile.read(buffer.data(), fileSize)) {
+    Logger::log(1, "%s error: could not read cache file '%s'\n", __FUNCTION__, cacheFileName.c_str());
+    return false;
+  }
+  inFile.close();
+
+  size_t offset = 0;
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  uint64_t fileKey = 0;
+  uint32_t internalFormat = 0;
+  uint32_t mipLevelCount = 0;
+
+  if (!readValue(buffer, offset, magic) || !readValue(buffer, offset, version) || !readValue(buffer, offset, fileKey) ||
+      !readValue(buffer, offset, internalFormat) || !readValue(buffer, offset, cacheData.width) ||
+      !readValue(buffer, offset, cacheData.height) || !readValue(buffer, offset, cacheData.numberOfChannels) ||
+      !readValue(buffer, offset, mipLevelCount)) {
+    Logger::log(1, "%s error: cache file '%s' is truncated\n", __FUNCTION__, cacheFileName.c_str());
+    return false;
+  }
+
+  if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+    Logger::log(1, "%s: cache file '%s' has unknown format, ignoring\n", __FUNCTION__, cacheFileName.c_str());
+    return false;
+  }
+
+  if (fileKey != sourceKey) {
+    Logger::log(1, "%s: cache file '%s' is outdated\n", __FUNCTION__, cacheFileName.c_str());
+    return false;
+  }
+
+  cacheData.internalFormat = internalFormat;
+  cacheData.mipLevels.resize(mipLevelCount);
+  for (auto& level : cacheData.mipLevels) {
+    uint32_t dataSize = 0;
+    if (!readValue(buffer, offset, level.width) || !readValue(buffer, offset, level.height) ||
+        !readValue(buffer, offset, dataSize) || offset + dataSize > buffer.size()) {
+      Logger::log(1, "%s error: cache file '%s' is truncated\n", __FUNCTION__, cacheFileName.c_str());
+      return false;
+    }
+    level.data.assign(buffer.data() + offset, buffer.data() + offset + dataSize);
+    offset += dataSize;
+  }
+
+  return true;
+}
+
+bool TextureCache::saveToCache(std::string cacheFileName, uint64_t sourceKey, const TextureCacheData& cacheData) {
+  std::error_code error;
+  std::filesystem::create_directories(mCacheDirectory, error);
+  if (error) {
+    Logger::log(1, "%s error: could not create cache directory '%s' (%s)\n", __FUNCTION__, mCacheDirectory.c_str(),
+      error.message().c_str());
+    return false;
+  }
+
+  /* textures are decoded in parallel, write to a unique file and move it into place when done */
+  std::string tempFileName = cacheFileName + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+  std::ofstream outFile(tempFileName, std::ios::binary | std::ios::trunc);
+  if (!outFile.is_open()) {
+    Logger::log(1, "%s error: could not open cache file '%s' for writing\n", __FUNCTION__, tempFileName.c_str());
+    return false;
+  }
+
+  writeValue(outFile, CACHE_MAGIC);
+  writeValue(outFile, CACHE_VERSION);
+  writeValue(outFile, sourceKey);
+  writeValue(outFile, static_cast<uint32_t>(cacheData.internalFormat));
+  writeValue(outFile, cacheData.width);
+  writeValue(outFile, cacheData.height);
+  writeValue(outFile, cacheData.numberOfChannels);
+  writeValue(outFile, static_cast<uint32_t>(cacheData.mipLevels.size()));
+
+  for (const auto& level : cacheData.mipLevels) {
+    writeValue(outFile, level.width);
+    writeValue(outFile, level.height);
+    writeValue(outFile, static_cast<uint32_t>(level.data.size()));
+    outFile.write(reinterpret_cast<const char*>(level.data.data()), level.data.size());
+  }
+
+  outFile.close();
+  if (!outFile.good()) {
+    Logger::log(1, "%s error: could not write cache file '%s'\n", __FUNCTION__, tempFileName.c_str());
+    std::filesystem::remove(tempFileName, error);
+    return false;
+  }
+
+  std::filesystem::rename(tempFileName, cacheFileName, error);
+  if (error) {
+    Logger::log(1, "%s error: could not rename cache file '%s' (%s)\n", __FUNCTION__, tempFileName.c_str(),
+      error.message().c_str());
+    std::filesystem::remove(tempFileName, error);
+    return false;
+  }
+
+  return true;
+}
+
+uint64_t TextureCache::getFileKey(std::string fileName, bool flipImage) {
+  std::error_code error;
+  uintmax_t fileSize = std::filesystem::file_size(fileName, error);
+  if (error) {
+    return 0;
+  }
+  auto modificationTime = std::filesystem::last_write_time(fileName, error).time_since_epoch().count();
+  if (error) {
+    return 0;
+  }
+
+  uint64_t key = Hash::hashData(fileName.data(), fileName.size());
+  key = Hash::hashData(&fileSize, sizeof(fileSize), key);
+  key = Hash::hashData(&modificationTime, sizeof(modificationTime), key);
+  key = Hash::hashData(&flipImage, sizeof(flipImage), key);
+  return key;
+}
+
+std::string TextureCache::getCacheFileName(uint64_t nameHash) {
+  char hashString[17];
+  std::snprintf(hashString, sizeof(hashString), "%016llx", static_cast<unsigned long long>(nameHash));
+  return mCacheDirectory + "/" + hashString + ".tcache";
+}
@@ -0,0 +1,48 @@
+/* Texture cache, stores converted textures incl. all mip levels on disk */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <glad/glad.h>
+
+struct TextureMipLevel {
+  int width = 0;
+  int height = 0;
+  std::vector<unsigned char> data{};
+};
+
+struct TextureCacheData {
+  /* GL_COMPRESSED_SRGB_S3TC_DXT1_EXT, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT or GL_SRGB8_ALPHA8 */
+  GLenum internalFormat = GL_SRGB8_ALPHA8;
+  int width = 0;
+  int height = 0;
+  int numberOfChannels = 0;
+  std::vector<TextureMipLevel> mipLevels{};
+};
+
+class TextureCache {
+  public:
+    /* converts RGBA8 image data to a full mip chain, BC1 or BC3 compressed if requested */
+    static bool convertImage(const unsigned char* imageData, int width, int height, int numberOfChannels,
+      bool compress, TextureCacheData& cacheData);
+
+    /* reads a cache file with a single read, fails if the source key does not match */
+    static bool loadFromCache(std::string cacheFileName, uint64_t sourceKey, TextureCacheData& cacheData);
+    static bool saveToCache(std::string cacheFileName, uint64_t sourceKey, const TextureCacheData& cacheData);
+
+    /* key from file name, size and modification time, no need to read the file */
+    static uint64_t getFileKey(std::string fileName, bool flipImage);
+    static std::string getCacheFileName(uint64_t nameHash);
+
+    static bool isCompressed(GLenum internalFormat);
+
+  private:
+    static void generateMipLevel(const TextureMipLevel& source, TextureMipLevel& dest);
+    static void compressMipLevel(const TextureMipLevel& source, bool hasAlpha, TextureMipLevel& dest);
+
+    static constexpr uint32_t CACHE_MAGIC = 0x31435854; // "TXC1"
+    static constexpr uint32_t CACHE_VERSION = 1;
+
+    static std::string mCacheDirectory;
+};
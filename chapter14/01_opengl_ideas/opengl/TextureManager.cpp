@@ -0,0 +1,124 @@
+#include <filesystem>
+#include <algorithm>
+#include <cstdio>
+
+#include "TextureManager.h"
+#include "Hash.h"
+#include "Logger.h"
+
+std::unordered_map<std::string, TextureManager::TextureEntry> TextureManager::mTextures{};
+
+std::shared_ptr<Texture> TextureManager::acquireTexture(std::string key) {
+  auto iter = mTextures.find(key);
+  if (iter == mTextures.end()) {
+    return nullptr;
+  }
+
+  iter->second.teRefCount++;
+  Logger::log(1, "%s: reusing texture '%s' (%i references)\n", __FUNCTION__, key.c_str(), iter->second.teRefCount);
+  return iter->second.teTexture;
+}
+
+std::shared_ptr<Texture> TextureManager::getTexture(ThreadPool& pool, std::string textureFilename, bool flipImage) {
+  /* different relative paths may point to the same file */
+  std::error_code error;
+  std::string key = std::filesystem::weakly_canonical(textureFilename, error).generic_string();
+  if (error || key.empty()) {
+    key = textureFilename;
+  }
+  if (!flipImage) {
+    key += ":noflip";
+  }
+
+  std::shared_ptr<Texture> texture = acquireTexture(key);
+  if (texture) {
+    return texture;
+  }
+
+  texture = std::make_shared<Texture>();
+  texture->loadTextureAsync(pool, textureFilename, flipImage);
+  mTextures.insert({key, TextureEntry{texture, 1}});
+  return texture;
+}
+
+std::shared_ptr<Texture> TextureManager::getTexture(ThreadPool& pool, std::string textureName, aiTexel* textureData,
+    int width, int height, bool flipImage) {
+  if (!textureData) {
+    Logger::log(1, "%s error: embedded texture '%s' has no data\n", __FUNCTION__, textureName.c_str());
+    return nullptr;
+  }
+
+  /* embedded texture names are only unique inside a single file, use the content */
+  int dataSize = height == 0 ? width : width * height * sizeof(aiTexel);
+  uint64_t contentHash = Hash::hashData(textureData, dataSize);
+  contentHash = Hash::hashData(&flipImage, sizeof(flipImage), contentHash);
+
+  char hashString[17];
+  std::snprintf(hashString, sizeof(hashString), "%016llx", static_cast<unsigned long long>(contentHash));
+  std::string key = std::string("embedded:") + hashString;
+
+  std::shared_ptr<Texture> texture = acquireTexture(key);
+  if (texture) {
+    return texture;
+  }
+
+  texture = std::make_shared<Texture>();
+  texture->loadTextureAsync(pool, textureName, textureData, width, height, flipImage);
+  mTextures.insert({key, TextureEntry{texture, 1}});
+  return texture;
+}
+
+void TextureManager::releaseTexture(std::shared_ptr<Texture> texture) {
+  if (!texture) {
+    return;
+  }
+
+  auto iter = std::find_if(mTextures.begin(), mTextures.end(),
+    [texture](const auto& entry) { return entry.second.teTexture == texture; });
+  if (iter == mTextures.end()) {
+    Logger::log(1, "%s error: texture '%s' is not managed\n", __FUNCTION__, texture->getTextureName().c_str());
+    return;
+  }
+
+  iter->second.teRefCount--;
+  if (iter->second.teRefCount > 0) {
+    return;
+  }
+
+  Logger::log(1, "%s: deleting texture '%s', no references left\n", __FUNCTION__, iter->first.c_str());
+  iter->second.teTexture->cleanup();
+  mTextures.erase(iter);
+}
+
+std::vector<TextureInfo> TextureManager::getTextureInfo() {
+  std::vector<TextureInfo> textureInfo{};
+  for (const auto& entry : mTextures) {
+    TextureInfo info{};
+    info.tiName = entry.second.teTexture->getTextureName();
+    info.tiWidth = entry.second.teTexture->getWidth();
+    info.tiHeight = entry.second.teTexture->getHeight();
+    info.tiRefCount = entry.second.teRefCount;
+    info.tiMemorySize = entry.second.teTexture->getTextureMemorySize();
+    textureInfo.emplace_back(info);
+  }
+
+  std::sort(textureInfo.begin(), textureInfo.end(),
+    [](const TextureInfo& a, const TextureInfo& b) { return a.tiMemorySize > b.tiMemorySize; });
+  return textureInfo;
+}
+
+size_t TextureManager::getTotalMemorySize() {
+  size_t totalSize = 0;
+  for (const auto& entry : mTextures) {
+    totalSize += entry.second.teTexture->getTextureMemorySize();
+  }
+  return totalSize;
+}
+
+void TextureManager::cleanup() {
+  for (auto& entry : mTextures) {
+    Logger::log(1, "%s: texture '%s' still has %i references\n", __FUNCTION__, entry.first.c_str(), entry.second.teRefCount);
+    entry.second.teTexture->cleanup();
+  }
+  mTextures.clear();
+}
@@ -0,0 +1,48 @@
+/* process-wide texture registry, shares textures between models and levels */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+#include <assimp/texture.h>
+
+#include "Texture.h"
+#include "ThreadPool.h"
+
+struct TextureInfo {
+  std::string tiName;
+  int tiWidth = 0;
+  int tiHeight = 0;
+  unsigned int tiRefCount = 0;
+  size_t tiMemorySize = 0;
+};
+
+/* not thread safe, must be called from the GL thread only */
+class TextureManager {
+  public:
+    /* returns the shared texture, decoding is scheduled only for the first request */
+    static std::shared_ptr<Texture> getTexture(ThreadPool& pool, std::string textureFilename, bool flipImage = true);
+    static std::shared_ptr<Texture> getTexture(ThreadPool& pool, std::string textureName, aiTexel* textureData,
+      int width, int height, bool flipImage = true);
+
+    /* decrements the reference count, the GL texture is deleted with the last reference */
+    static void releaseTexture(std::shared_ptr<Texture> texture);
+
+    static std::vector<TextureInfo> getTextureInfo();
+    static size_t getTotalMemorySize();
+
+    /* removes all remaining textures, regardless of their reference count */
+    static void cleanup();
+
+  private:
+    struct TextureEntry {
+      std::shared_ptr<Texture> teTexture = nullptr;
+      unsigned int teRefCount = 0;
+    };
+
+    static std::shared_ptr<Texture> acquireTexture(std::string key);
+
+    static std::unordered_map<std::string, TextureEntry> mTextures;
+};
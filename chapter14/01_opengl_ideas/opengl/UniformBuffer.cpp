@@ -11,13 +11,13 @@ void UniformBuffer::init(size_t bufferSize) {
   glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
 
-void UniformBuffer::uploadUboData(std::vector<glm::mat4> bufferData, int bindingPoint) {
-  if (bufferData.empty()) {
+void UniformBuffer::uploadUboData(const glm::mat4* bufferData, size_t count, int bindingPoint) {
+  if (count == 0) {
     return;
   }
-  size_t bufferSize = bufferData.size() * sizeof(glm::mat4);
+  size_t bufferSize = count * sizeof(glm::mat4);
   glBindBuffer(GL_UNIFORM_BUFFER, mUboBuffer);
-  glBufferSubData(GL_UNIFORM_BUFFER, 0, bufferSize, bufferData.data());
+  glBufferSubData(GL_UNIFORM_BUFFER, 0, bufferSize, bufferData);
   glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, mUboBuffer, 0, bufferSize);
   glBindBuffer(GL_UNIFORM_BUFFER, 0);
 }
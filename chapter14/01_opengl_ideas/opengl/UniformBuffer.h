@@ -7,7 +7,7 @@
 class UniformBuffer {
   public:
     void init(size_t bufferSize);
-    void uploadUboData(std::vector<glm::mat4> bufferData, int bindingPoint);
+    void uploadUboData(const glm::mat4* bufferData, size_t count, int bindingPoint);
     void cleanup();
 
   private:
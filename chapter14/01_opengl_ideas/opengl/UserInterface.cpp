@@ -26,6 +26,8 @@
 #include "Logger.h"
 #include "BoundingBox3D.h"
 #include "Tools.h"
+#include "TextureManager.h"
+#include "MemoryTracker.h"
 
 void UserInterface::init(OGLRenderData &renderData) {
   IMGUI_CHECKVERSION();
@@ -580,6 +582,17 @@ void UserInterface::createSettingsWindow(OGLRenderData& renderData, ModelInstanc
 
     ImGui::Text("Instance Matrix Size:  %8.2f %2s", memoryUsage, unit.c_str());
 
+    std::vector<TextureInfo> textureInfo = TextureManager::getTextureInfo();
+    size_t textureMemory = TextureManager::getTotalMemorySize();
+    ImGui::Text("Texture Memory:        %8.2f MB", textureMemory / (1024.0f * 1024.0f));
+    if (ImGui::TreeNode("Textures", "Textures (%zu)", textureInfo.size())) {
+      for (const auto& info : textureInfo) {
+        ImGui::Text("%8.2f KB %4ix%-4i refs %2i  %s", info.tiMemorySize / 1024.0f, info.tiWidth, info.tiHeight,
+          info.tiRefCount, info.tiName.c_str());
+      }
+      ImGui::TreePop();
+    }
+
     std::string windowDims = std::to_string(renderData.rdWidth) + "x" + std::to_string(renderData.rdHeight);
     ImGui::Text("Window Dimensions:      %10s", windowDims.c_str());
 
@@ -587,6 +600,84 @@ void UserInterface::createSettingsWindow(OGLRenderData& renderData, ModelInstanc
     ImGui::Text("ImGui Window Position:  %10s", imgWindowPos.c_str());
   }
 
+  if (ImGui::CollapsingHeader("Rendering")) {
+    ImGui::Text("Compute Pre-Skinning:");
+    ImGui::SameLine();
+    ImGui::Checkbox("##ComputePreSkinning", &renderData.rdComputePreSkinning);
+
+    ImGui::Text("Pipelined Simulation:");
+    ImGui::SameLine();
+    ImGui::Checkbox("##PipelinedSimulation", &renderData.rdPipelinedSimulation);
+
+    ImGui::Text("Dynamic Resolution:  ");
+    ImGui::SameLine();
+    ImGui::Checkbox("##DynamicResolution", &renderData.rdDynamicResolution);
+
+    if (renderData.rdDynamicResolution) {
+      ImGui::Text("Target GPU Time:  ");
+      ImGui::SameLine();
+      ImGui::SliderFloat("##TargetGpuFrameTime", &renderData.rdTargetGpuFrameTime, 4.0f, 50.0f, "%.1f ms", flags);
+      ImGui::Text("Render Scale:           %9.0f%%", renderData.rdRenderScale * 100.0f);
+    } else {
+      ImGui::Text("Render Scale:     ");
+      ImGui::SameLine();
+      ImGui::SliderFloat("##RenderScale", &renderData.rdRenderScale, 0.5f, 1.0f, "%.2f", flags);
+    }
+
+    ImGui::Text("Draw Calls:             %10i", renderData.rdDrawCalls);
+    ImGui::Text("Program Changes:        %10i", renderData.rdProgramChanges);
+    ImGui::Text("Vertex Array Changes:   %10i", renderData.rdVertexArrayChanges);
+    ImGui::Text("Texture Changes:        %10i", renderData.rdTextureChanges);
+    ImGui::Text("Buffer Changes:         %10i", renderData.rdBufferChanges);
+    ImGui::Text("Skipped State Changes:  %10i", renderData.rdSkippedStateChanges);
+    ImGui::Text("Debug Draw Vertices:    %10i", renderData.rdDebugDrawVertices);
+    ImGui::Text("Heap Allocations:       %10i", renderData.rdFrameHeapAllocations);
+    if (ImGui::IsItemHovered()) {
+      ImGui::BeginTooltip();
+      ImGui::Text("operator new calls of all threads during the last frame");
+      ImGui::EndTooltip();
+    }
+    ImGui::Text("Frame Arena:  %7zu of %7zu KiB", renderData.rdFrameArenaBytes / 1024, renderData.rdFrameArenaCapacity / 1024);
+  }
+
+  if (ImGui::CollapsingHeader("Memory")) {
+    if (!MemoryTracker::isCpuTrackingEnabled()) {
+      ImGui::Text("CPU columns need the MEMORY_TAG_HOOK build option");
+    }
+
+    if (ImGui::BeginTable("##MemoryTags", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+        ImGuiTableFlags_SizingFixedFit)) {
+      ImGui::TableSetupColumn("Tag");
+      ImGui::TableSetupColumn("CPU KiB");
+      ImGui::TableSetupColumn("CPU Peak");
+      ImGui::TableSetupColumn("Allocs/Frame");
+      ImGui::TableSetupColumn("GPU KiB");
+      ImGui::TableSetupColumn("GPU Peak");
+      ImGui::TableHeadersRow();
+
+      for (int i = 0; i < static_cast<int>(memoryTag::NUM); ++i) {
+        memoryTag tag = static_cast<memoryTag>(i);
+        MemoryTagStats cpuStats = MemoryTracker::getCpuStats(tag);
+        MemoryTagStats gpuStats = MemoryTracker::getGpuStats(tag);
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Text("%s", MemoryTracker::getTagName(tag).c_str());
+        ImGui::TableNextColumn();
+        ImGui::Text("%10zu", cpuStats.mtsLiveBytes / 1024);
+        ImGui::TableNextColumn();
+        ImGui::Text("%10zu", cpuStats.mtsPeakBytes / 1024);
+        ImGui::TableNextColumn();
+        ImGui::Text("%8llu", static_cast<unsigned long long>(cpuStats.mtsFrameAllocations));
+        ImGui::TableNextColumn();
+        ImGui::Text("%10zu", gpuStats.mtsLiveBytes / 1024);
+        ImGui::TableNextColumn();
+        ImGui::Text("%10zu", gpuStats.mtsPeakBytes / 1024);
+      }
+      ImGui::EndTable();
+    }
+  }
+
   if (ImGui::CollapsingHeader("Timers")) {
     ImGui::Text("Frame Time:              %10.4f ms", renderData.rdFrameTime);
 
@@ -886,6 +977,21 @@ void UserInterface::createSettingsWindow(OGLRenderData& renderData, ModelInstanc
         pathFindingOverlay.c_str(), 0.0f, std::numeric_limits<float>::max(), ImVec2(0, 80));
       ImGui::EndTooltip();
     }
+
+    /* runs on the worker thread while the previous frame is presented, if pipelined */
+    ImGui::Text("Simulation:              %10.4f ms", renderData.rdSimulationTime);
+
+    /* GPU times are measured with timestamp queries and lag one frame behind */
+    ImGui::Separator();
+    float gpuFrameTime = 0.0f;
+    for (int i = 0; i < static_cast<int>(gpuPass::NUM); ++i) {
+      gpuPass pass = static_cast<gpuPass>(i);
+      float passTime = renderData.rdGpuPassTimes.at(i);
+      gpuFrameTime += passTime;
+      ImGui::Text("GPU %-20s %10.4f ms", (renderData.rdGpuPassNameMap[pass] + ":").c_str(), passTime);
+    }
+    ImGui::Text("GPU Frame Time:          %10.4f ms", gpuFrameTime);
+    ImGui::Text("GPU Skipped Frames:      %10u", renderData.rdGpuSkippedFrames);
   }
 
   if (ImGui::CollapsingHeader("Music & Sound")) {
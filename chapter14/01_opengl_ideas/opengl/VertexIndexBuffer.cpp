@@ -31,7 +31,18 @@ void VertexIndexBuffer::init() {
   Logger::log(1, "%s: VAO and VBOs initialized\n", __FUNCTION__);
 }
 
+void VertexIndexBuffer::setMemoryTag(memoryTag tag) {
+  if (mBufferSize > 0) {
+    MemoryTracker::removeGpuAllocation(mMemoryTag, mBufferSize);
+    MemoryTracker::addGpuAllocation(tag, mBufferSize);
+  }
+  mMemoryTag = tag;
+}
+
 void VertexIndexBuffer::cleanup() {
+  MemoryTracker::removeGpuAllocation(mMemoryTag, mBufferSize);
+  mBufferSize = 0;
+
   glDeleteBuffers(1, &mIndexVBO);
   glDeleteBuffers(1, &mVertexVBO);
   glDeleteVertexArrays(1, &mVAO);
@@ -50,6 +61,15 @@ void VertexIndexBuffer::uploadData(std::vector<OGLVertex> vertexData, std::vecto
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mIndexVBO);
   glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), &indices.at(0), GL_DYNAMIC_DRAW);
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  /* glBufferData() replaces the old storage */
+  MemoryTracker::removeGpuAllocation(mMemoryTag, mBufferSize);
+  mBufferSize = vertexData.size() * sizeof(OGLVertex) + indices.size() * sizeof(uint32_t);
+  MemoryTracker::addGpuAllocation(mMemoryTag, mBufferSize);
+}
+
+GLuint VertexIndexBuffer::getVertexArray() {
+  return mVAO;
 }
 
 void VertexIndexBuffer::bind() {
@@ -80,12 +100,12 @@ void VertexIndexBuffer::bindAndDrawIndirect(GLuint mode, unsigned int num) {
   unbind();
 }
 
-void VertexIndexBuffer::drawIndirectInstanced(GLuint mode, unsigned int num, int instanceCount) {
-  glDrawElementsInstanced(mode, num, GL_UNSIGNED_INT, 0, instanceCount);
+void VertexIndexBuffer::drawIndirectInstanced(GLuint mode, unsigned int num, int instanceCount, unsigned int baseInstance) {
+  glDrawElementsInstancedBaseInstance(mode, num, GL_UNSIGNED_INT, 0, instanceCount, baseInstance);
 }
 
-void VertexIndexBuffer::bindAndDrawIndirectInstanced(GLuint mode, unsigned int num, int instanceCount) {
+void VertexIndexBuffer::bindAndDrawIndirectInstanced(GLuint mode, unsigned int num, int instanceCount, unsigned int baseInstance) {
   bind();
-  drawIndirectInstanced(mode, num, instanceCount);
+  drawIndirectInstanced(mode, num, instanceCount, baseInstance);
   unbind();
 }
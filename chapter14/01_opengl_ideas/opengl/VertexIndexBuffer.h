@@ -7,22 +7,27 @@
 #include <GLFW/glfw3.h>
 
 #include "OGLRenderData.h"
+#include "MemoryTracker.h"
 
 class VertexIndexBuffer {
   public:
     void init();
     void uploadData(std::vector<OGLVertex> vertexData, std::vector<uint32_t> indices);
+    void setMemoryTag(memoryTag tag);
 
     void bind();
     void unbind();
 
     void draw(GLuint mode, unsigned int start, unsigned int num);
     void drawIndirect(GLuint mode, unsigned int num);
-    void drawIndirectInstanced(GLuint mode, unsigned int num, int instanceCount);
+    /* base instance does not change gl_InstanceID, shaders can use gl_BaseInstance as extra parameter */
+    void drawIndirectInstanced(GLuint mode, unsigned int num, int instanceCount, unsigned int baseInstance = 0);
 
     void bindAndDraw(GLuint mode, unsigned int start, unsigned int num);
     void bindAndDrawIndirect(GLuint mode, unsigned int num);
-    void bindAndDrawIndirectInstanced(GLuint mode, unsigned int num, int instanceCount);
+    void bindAndDrawIndirectInstanced(GLuint mode, unsigned int num, int instanceCount, unsigned int baseInstance = 0);
+
+    GLuint getVertexArray();
 
     void cleanup();
 
@@ -30,4 +35,7 @@ class VertexIndexBuffer {
     GLuint mVAO = 0;
     GLuint mVertexVBO = 0;
     GLuint mIndexVBO = 0;
+
+    size_t mBufferSize = 0;
+    memoryTag mMemoryTag = memoryTag::modelGeometry;
 };
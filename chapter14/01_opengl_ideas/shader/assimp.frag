@@ -1,11 +1,32 @@
 #version 460 core
+/* feature flags: SELECTION, BINDLESS_TEXTURES */
+#ifdef BINDLESS_TEXTURES
+#extension GL_ARB_bindless_texture : require
+#endif
 layout (location = 0) in vec4 color;
 layout (location = 1) in vec4 normal;
 layout (location = 2) in vec2 texCoord;
+#ifdef SELECTION
+layout (location = 3) flat in float selectInfo;
+#endif
 
 layout (location = 0) out vec4 FragColor;
+#ifdef SELECTION
+layout (location = 1) out float SelectedInstance;
+#endif
 
+#ifdef BINDLESS_TEXTURES
+/* set per draw by the render queue */
+layout (location = 1) uniform int aMaterialId;
+
+layout (std430, binding = 6) readonly restrict buffer MaterialTextures {
+  uvec2 materialTex[];
+};
+#define DIFFUSE_TEX sampler2D(materialTex[aMaterialId])
+#else
 uniform sampler2D tex;
+#define DIFFUSE_TEX tex
+#endif
 
 layout (std140, binding = 0) uniform Matrices {
   mat4 view;
@@ -29,7 +50,10 @@ void main() {
   float fogAmount = 1.0 - clamp(exp(-pow(fogDensity * fogDistance, 2.0)), 0.0, 1.0);
   vec4 fogColor = 0.25 * vec4(vec3(lightColor), 1.0);
 
-  FragColor = mix(vec4(min(ambient + diffuse, vec3(1.0)), 1.0) * texture(tex, texCoord) * color, fogColor * color, fogAmount);
+  FragColor = mix(vec4(min(ambient + diffuse, vec3(1.0)), 1.0) * texture(DIFFUSE_TEX, texCoord) * color, fogColor * color, fogAmount);
 
+#ifdef SELECTION
+  /* fill the second color attachment with the ID of our model */
+  SelectedInstance = selectInfo;
+#endif
 }
-
@@ -1,4 +1,5 @@
 #version 460 core
+/* feature flags: SELECTION */
 layout (location = 0) in vec4 aPos; // last float is uv.x
 layout (location = 1) in vec4 aColor;
 layout (location = 2) in vec4 aNormal; // last float is uv.y
@@ -8,6 +9,9 @@ layout (location = 4) in vec4 aBoneWeight; // ignored
 layout (location = 0) out vec4 color;
 layout (location = 1) out vec4 normal;
 layout (location = 2) out vec2 texCoord;
+#ifdef SELECTION
+layout (location = 3) out float selectInfo;
+#endif
 
 layout (std140, binding = 0) uniform Matrices {
   mat4 view;
@@ -17,24 +21,31 @@ layout (std140, binding = 0) uniform Matrices {
   float fogDensity;
 };
 
-layout (std430, binding = 1) readonly restrict buffer WorldPosMatrices {
+/* per-instance data of all models, the base instance is the first instance of the model */
+layout (std430, binding = 2) readonly restrict buffer WorldPosMatrices {
   mat4 worldPosMat[];
 };
 
-layout (std430, binding = 2) readonly restrict buffer InstanceSelected {
+layout (std430, binding = 3) readonly restrict buffer InstanceSelected {
   vec2 selected[];
 };
 
 void main() {
-  mat4 modelMat = worldPosMat[gl_InstanceID];
+  int instance = gl_BaseInstance + gl_InstanceID;
+  mat4 modelMat = worldPosMat[instance];
   gl_Position = projection * view * modelMat * vec4(aPos.x, aPos.y, aPos.z, 1.0);
 
-  color = aColor * selected[gl_InstanceID].x;
+  color = aColor * selected[instance].x;
   /* draw the instance always on top when highlighted, helps to find it better */
-  if (selected[gl_InstanceID].x != 1.0f) {
+  if (selected[instance].x != 1.0f) {
     gl_Position.z -= 1.0f;
   }
 
   normal = transpose(inverse(modelMat)) * vec4(aNormal.x, aNormal.y, aNormal.z, 1.0);
   texCoord = vec2(aPos.w, aNormal.w);
+
+#ifdef SELECTION
+  /* we need screen width (y -> x) and vertex id only (z -> y) */
+  selectInfo = selected[instance].y;
+#endif
 }
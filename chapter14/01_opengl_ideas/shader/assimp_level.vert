@@ -17,11 +17,13 @@ layout (std140, binding = 0) uniform Matrices {
   float fogDensity;
 };
 
-layout (std430, binding = 1) readonly restrict buffer WorldTransformMatrix {
-  mat4 worldTransformMat;
+/* one matrix per level, the base instance is the level index */
+layout (std430, binding = 1) readonly restrict buffer WorldTransformMatrices {
+  mat4 worldTransformMats[];
 };
 
 void main() {
+  mat4 worldTransformMat = worldTransformMats[gl_BaseInstance];
   gl_Position = projection * view * worldTransformMat * vec4(aPos.x, aPos.y, aPos.z, 1.0);
   color = aColor;
 
@@ -0,0 +1,60 @@
+#version 460 core
+/* feature flags: SELECTION */
+layout (location = 0) out vec4 color;
+layout (location = 1) out vec4 normal;
+layout (location = 2) out vec2 texCoord;
+#ifdef SELECTION
+layout (location = 3) out float selectInfo;
+#endif
+
+layout (std140, binding = 0) uniform Matrices {
+  mat4 view;
+  mat4 projection;
+  vec4 lightPos;
+  vec4 lightColor;
+  float fogDensity;
+};
+
+struct SkinnedVertex {
+  vec4 position; // world space, last float is uv.x
+  vec4 color;
+  vec4 normal; // world space, last float is uv.y
+};
+
+layout (std430, binding = 3) readonly restrict buffer InstanceSelected {
+  vec2 selected[];
+};
+
+/* written by the pre-skinning compute shader */
+layout (std430, binding = 7) readonly restrict buffer SkinnedVertices {
+  SkinnedVertex skinnedVertices[];
+};
+
+/* y is the first skinned vertex of the instance */
+layout (std430, binding = 8) readonly restrict buffer InstanceOffsets {
+  ivec2 instanceOffsets[];
+};
+
+/* start of the current mesh inside the skinned vertices of an instance */
+layout (location = 0) uniform int aMeshOffset;
+
+void main() {
+  int instance = gl_BaseInstance + gl_InstanceID;
+  SkinnedVertex vertex = skinnedVertices[instanceOffsets[instance].y + aMeshOffset + gl_VertexID];
+
+  gl_Position = projection * view * vec4(vertex.position.xyz, 1.0);
+
+  color = vertex.color * selected[instance].x;
+  /* draw the instance always on top when highlighted, helps to find it better */
+  if (selected[instance].x != 1.0f) {
+    gl_Position.z -= 1.0f;
+  }
+
+  normal = vec4(vertex.normal.xyz, 1.0);
+  texCoord = vec2(vertex.position.w, vertex.normal.w);
+
+#ifdef SELECTION
+  /* we need vertex id only (z -> y) */
+  selectInfo = selected[instance].y;
+#endif
+}
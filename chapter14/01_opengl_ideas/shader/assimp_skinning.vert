@@ -1,4 +1,5 @@
 #version 460 core
+/* feature flags: MORPH_ANIM, SELECTION */
 layout (location = 0) in vec4 aPos; // last float is uv.x :)
 layout (location = 1) in vec4 aColor;
 layout (location = 2) in vec4 aNormal; // last float is uv.y
@@ -8,6 +9,9 @@ layout (location = 4) in vec4 aBoneWeight;
 layout (location = 0) out vec4 color;
 layout (location = 1) out vec4 normal;
 layout (location = 2) out vec2 texCoord;
+#ifdef SELECTION
+layout (location = 3) out float selectInfo;
+#endif
 
 layout (std140, binding = 0) uniform Matrices {
   mat4 view;
@@ -17,6 +21,14 @@ layout (std140, binding = 0) uniform Matrices {
   float fogDensity;
 };
 
+#ifdef MORPH_ANIM
+struct MorphVertex {
+  vec4 position;
+  vec4 normal;
+};
+#endif
+
+/* per-instance data of all models, the base instance is the first instance of the model */
 layout (std430, binding = 1) readonly restrict buffer BoneMatrices {
   mat4 boneMat[];
 };
@@ -29,11 +41,24 @@ layout (std430, binding = 3) readonly restrict buffer InstanceSelected {
   vec2 selected[];
 };
 
-uniform int aModelStride;
+#ifdef MORPH_ANIM
+layout (std430, binding = 4) readonly restrict buffer AnimMorphBuffer {
+  MorphVertex morphVertices[];
+};
+
+layout (std430, binding = 5) readonly restrict buffer AnimMorphData {
+  vec4 vertsPerMorphAnim[];
+};
+#endif
 
-void main() {
+/* x is the first bone matrix of the instance */
+layout (std430, binding = 8) readonly restrict buffer InstanceOffsets {
+  ivec2 instanceOffsets[];
+};
 
-  int modelStride = gl_InstanceID * aModelStride;
+void main() {
+  int instance = gl_BaseInstance + gl_InstanceID;
+  int modelStride = instanceOffsets[instance].x;
 
   mat4 skinMat =
     aBoneWeight.x * boneMat[aBoneNum.x + modelStride] +
@@ -41,16 +66,38 @@ void main() {
     aBoneWeight.z * boneMat[aBoneNum.z + modelStride] +
     aBoneWeight.w * boneMat[aBoneNum.w + modelStride];
 
-  mat4 worldPosSkinMat = worldPos[gl_InstanceID] * skinMat;
+  mat4 worldPosSkinMat = worldPos[instance] * skinMat;
+
+#ifdef MORPH_ANIM
+  /* y and z data contain the offset into the morph anim buffer */
+  int morphAnimIndex = int(vertsPerMorphAnim[instance].y * vertsPerMorphAnim[instance].z);
 
+  vec4 origVertex = vec4(aPos.x, aPos.y, aPos.z, 1.0);
+  vec4 morphVertex = vec4(morphVertices[gl_VertexID + morphAnimIndex].position.xyz, 1.0);
+
+  gl_Position = projection * view * worldPosSkinMat * mix(origVertex, morphVertex, vertsPerMorphAnim[instance].x);
+#else
   gl_Position = projection * view * worldPosSkinMat * vec4(aPos.x, aPos.y, aPos.z, 1.0);
+#endif
 
-  color = aColor * selected[gl_InstanceID].x;
+  color = aColor * selected[instance].x;
   /* draw the instance always on top when highlighted, helps to find it better */
-  if (selected[gl_InstanceID].x != 1.0f) {
+  if (selected[instance].x != 1.0f) {
     gl_Position.z -= 1.0f;
   }
 
+#ifdef MORPH_ANIM
+  vec4 origNormal = vec4(aNormal.x, aNormal.y, aNormal.z, 1.0);
+  vec4 morphNormal = vec4(morphVertices[gl_VertexID + morphAnimIndex].normal.xyz, 1.0);
+  normal = transpose(inverse(worldPosSkinMat)) * mix(origNormal, morphNormal, vertsPerMorphAnim[instance].x);
+#else
   normal = transpose(inverse(worldPosSkinMat)) * vec4(aNormal.x, aNormal.y, aNormal.z, 1.0);
+#endif
+
   texCoord = vec2(aPos.w, aNormal.w);
+
+#ifdef SELECTION
+  /* we need vertex id only (z -> y) */
+  selectInfo = selected[instance].y;
+#endif
 }
@@ -3,9 +3,6 @@
 #include <limits>
 
 AABB::AABB() {
-  mAabbMesh = std::make_shared<OGLLineMesh>();
-  mAabbMesh->vertices.resize(24);
-
   clear();
 }
 
@@ -55,43 +52,47 @@ void AABB::setExtents(glm::vec3 minPos, glm::vec3 maxPos) {
 }
 
 std::shared_ptr<OGLLineMesh> AABB::getAABBLines(glm::vec3 color) {
-  mAabbMesh->vertices.at(0) = {{mMinPos.x, mMinPos.y, mMinPos.z}, color};
-  mAabbMesh->vertices.at(1) = {{mMaxPos.x, mMinPos.y, mMinPos.z}, color};
+  /* created on request only, AABBs are copied around a lot in the collision code */
+  std::shared_ptr<OGLLineMesh> aabbMesh = std::make_shared<OGLLineMesh>();
+  aabbMesh->vertices.resize(24);
+
+  aabbMesh->vertices.at(0) = {{mMinPos.x, mMinPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(1) = {{mMaxPos.x, mMinPos.y, mMinPos.z}, color};
 
-  mAabbMesh->vertices.at(2) = {{mMinPos.x, mMinPos.y, mMinPos.z}, color};
-  mAabbMesh->vertices.at(3) = {{mMinPos.x, mMaxPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(2) = {{mMinPos.x, mMinPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(3) = {{mMinPos.x, mMaxPos.y, mMinPos.z}, color};
 
-  mAabbMesh->vertices.at(4) = {{mMaxPos.x, mMaxPos.y, mMinPos.z}, color};
-  mAabbMesh->vertices.at(5) = {{mMaxPos.x, mMinPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(4) = {{mMaxPos.x, mMaxPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(5) = {{mMaxPos.x, mMinPos.y, mMinPos.z}, color};
 
-  mAabbMesh->vertices.at(6) = {{mMaxPos.x, mMaxPos.y, mMinPos.z}, color};
-  mAabbMesh->vertices.at(7) = {{mMinPos.x, mMaxPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(6) = {{mMaxPos.x, mMaxPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(7) = {{mMinPos.x, mMaxPos.y, mMinPos.z}, color};
 
 
-  mAabbMesh->vertices.at(8) = {{mMinPos.x, mMinPos.y, mMaxPos.z}, color};
-  mAabbMesh->vertices.at(9) = {{mMaxPos.x, mMinPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(8) = {{mMinPos.x, mMinPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(9) = {{mMaxPos.x, mMinPos.y, mMaxPos.z}, color};
 
-  mAabbMesh->vertices.at(10) = {{mMinPos.x, mMinPos.y, mMaxPos.z}, color};
-  mAabbMesh->vertices.at(11) = {{mMinPos.x, mMaxPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(10) = {{mMinPos.x, mMinPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(11) = {{mMinPos.x, mMaxPos.y, mMaxPos.z}, color};
 
-  mAabbMesh->vertices.at(12) = {{mMaxPos.x, mMaxPos.y, mMaxPos.z}, color};
-  mAabbMesh->vertices.at(13) = {{mMaxPos.x, mMinPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(12) = {{mMaxPos.x, mMaxPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(13) = {{mMaxPos.x, mMinPos.y, mMaxPos.z}, color};
 
-  mAabbMesh->vertices.at(14) = {{mMaxPos.x, mMaxPos.y, mMaxPos.z}, color};
-  mAabbMesh->vertices.at(15) = {{mMinPos.x, mMaxPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(14) = {{mMaxPos.x, mMaxPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(15) = {{mMinPos.x, mMaxPos.y, mMaxPos.z}, color};
 
 
-  mAabbMesh->vertices.at(16) = {{mMinPos.x, mMinPos.y, mMinPos.z}, color};
-  mAabbMesh->vertices.at(17) = {{mMinPos.x, mMinPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(16) = {{mMinPos.x, mMinPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(17) = {{mMinPos.x, mMinPos.y, mMaxPos.z}, color};
 
-  mAabbMesh->vertices.at(18) = {{mMaxPos.x, mMinPos.y, mMinPos.z}, color};
-  mAabbMesh->vertices.at(19) = {{mMaxPos.x, mMinPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(18) = {{mMaxPos.x, mMinPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(19) = {{mMaxPos.x, mMinPos.y, mMaxPos.z}, color};
 
-  mAabbMesh->vertices.at(20) = {{mMinPos.x, mMaxPos.y, mMinPos.z}, color};
-  mAabbMesh->vertices.at(21) = {{mMinPos.x, mMaxPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(20) = {{mMinPos.x, mMaxPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(21) = {{mMinPos.x, mMaxPos.y, mMaxPos.z}, color};
 
-  mAabbMesh->vertices.at(22) = {{mMaxPos.x, mMaxPos.y, mMinPos.z}, color};
-  mAabbMesh->vertices.at(23) = {{mMaxPos.x, mMaxPos.y, mMaxPos.z}, color};
+  aabbMesh->vertices.at(22) = {{mMaxPos.x, mMaxPos.y, mMinPos.z}, color};
+  aabbMesh->vertices.at(23) = {{mMaxPos.x, mMaxPos.y, mMaxPos.z}, color};
 
-  return mAabbMesh;
+  return aabbMesh;
 }
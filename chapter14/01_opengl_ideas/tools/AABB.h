@@ -27,6 +27,4 @@ class AABB {
   private:
     glm::vec3 mMinPos;
     glm::vec3 mMaxPos;
-
-    std::shared_ptr<OGLLineMesh> mAabbMesh = nullptr;
 };
@@ -0,0 +1,72 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.h"
+#include "MemoryTracker.h"
+
+namespace {
+  std::atomic<uint64_t> allocations = 0;
+  std::atomic<uint64_t> allocatedBytes = 0;
+
+#ifdef ENABLE_MEMORY_TAG_HOOK
+  /* stored in front of every allocation, keeps the alignment of malloc() */
+  struct alignas(std::max_align_t) AllocationHeader {
+    size_t size;
+    memoryTag tag;
+  };
+#endif
+}
+
+uint64_t AllocationCounter::getAllocations() {
+  return allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::getAllocatedBytes() {
+  return allocatedBytes.load(std::memory_order_relaxed);
+}
+
+/* define DISABLE_ALLOCATION_COUNTER to keep the default operator new, the counters stay at zero then */
+#ifndef DISABLE_ALLOCATION_COUNTER
+/* array, nothrow and sized versions end up here or in the matching operator delete */
+void* operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+#ifdef ENABLE_MEMORY_TAG_HOOK
+  AllocationHeader* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+  if (!header) {
+    throw std::bad_alloc();
+  }
+  header->size = size;
+  header->tag = MemoryTracker::getThreadTag();
+  MemoryTracker::addCpuAllocation(header->tag, size);
+  return header + 1;
+#else
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (!pointer) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+#endif
+}
+
+void operator delete(void* pointer) noexcept {
+#ifdef ENABLE_MEMORY_TAG_HOOK
+  if (!pointer) {
+    return;
+  }
+  /* the tag of the allocation, not the current one of the thread */
+  AllocationHeader* header = static_cast<AllocationHeader*>(pointer) - 1;
+  MemoryTracker::removeCpuAllocation(header->tag, header->size);
+  std::free(header);
+#else
+  std::free(pointer);
+#endif
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  operator delete(pointer);
+}
+#endif
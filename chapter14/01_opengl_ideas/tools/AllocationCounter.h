@@ -0,0 +1,10 @@
+/* counts the heap allocations of the whole application via a replaced global operator new */
+#pragma once
+#include <cstdint>
+
+class AllocationCounter {
+  public:
+    /* both only ever increase, take the difference of two calls */
+    static uint64_t getAllocations();
+    static uint64_t getAllocatedBytes();
+};
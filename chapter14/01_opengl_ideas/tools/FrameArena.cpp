@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "FrameArena.h"
+#include "Logger.h"
+
+bool FrameArena::init(size_t capacity) {
+  if (capacity == 0) {
+    Logger::log(1, "%s error: arena capacity must not be zero\n", __FUNCTION__);
+    return false;
+  }
+
+  mBuffer.resize(capacity);
+  mOffset = 0;
+  mOverflowBytes = 0;
+
+  Logger::log(1, "%s: frame arena with %i bytes initialized\n", __FUNCTION__, capacity);
+  return true;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+  std::uintptr_t bufferStart = reinterpret_cast<std::uintptr_t>(mBuffer.data());
+  std::uintptr_t alignedStart = (bufferStart + mOffset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+  size_t alignedOffset = alignedStart - bufferStart;
+
+  if (alignedOffset + bytes <= mBuffer.size()) {
+    mOffset = alignedOffset + bytes;
+    return mBuffer.data() + alignedOffset;
+  }
+
+  /* arena is full, fall back to the heap for the rest of the frame */
+  mOverflowBytes += bytes;
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void* pointer, size_t bytes, size_t alignment) {
+  /* arena memory is released by reset() only */
+  std::byte* bytePointer = static_cast<std::byte*>(pointer);
+  if (bytePointer >= mBuffer.data() && bytePointer < mBuffer.data() + mBuffer.size()) {
+    return;
+  }
+
+  std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+void FrameArena::reset() {
+  mLastFrameBytes = mOffset + mOverflowBytes;
+  mOffset = 0;
+
+  if (mOverflowBytes > 0) {
+    size_t newCapacity = std::max(mBuffer.size() * 2, mLastFrameBytes);
+    Logger::log(1, "%s: %i bytes did not fit, resizing frame arena from %i to %i bytes\n", __FUNCTION__,
+      mOverflowBytes, mBuffer.size(), newCapacity);
+    mOverflowBytes = 0;
+
+    /* nothing lives in the old buffer anymore */
+    mBuffer = std::vector<std::byte>(newCapacity);
+  }
+}
+
+size_t FrameArena::getLastFrameBytes() {
+  return mLastFrameBytes;
+}
+
+size_t FrameArena::getCapacity() {
+  return mBuffer.size();
+}
@@ -0,0 +1,32 @@
+/* linear allocator for per-frame temporaries, use with std::pmr containers */
+#pragma once
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+/* not thread safe. draw() on the main thread and the pipelined simulate() on the worker thread
+ * take turns: the worker is started after draw() and joined before the next draw() resets the arena */
+class FrameArena : public std::pmr::memory_resource {
+  public:
+    bool init(size_t capacity = DEFAULT_CAPACITY);
+
+    /* frees everything at once, no container using the arena may be alive anymore */
+    void reset();
+
+    size_t getLastFrameBytes();
+    size_t getCapacity();
+
+    static constexpr size_t DEFAULT_CAPACITY = 1024 * 1024;
+
+  private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    std::vector<std::byte> mBuffer{};
+    size_t mOffset = 0;
+
+    /* bytes that did not fit, served by the heap and freed by the containers */
+    size_t mOverflowBytes = 0;
+    size_t mLastFrameBytes = 0;
+};
@@ -0,0 +1,10 @@
+/* non-cryptographic hashing, used for cache keys */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+class Hash {
+  public:
+    /* 64bit FNV-1a, pass the previous result as seed to hash several blocks */
+    static uint64_t hashData(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ULL);
+};
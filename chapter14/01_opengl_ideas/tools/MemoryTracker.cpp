@@ -0,0 +1,138 @@
+#include <array>
+#include <atomic>
+
+#include "MemoryTracker.h"
+#include "Logger.h"
+
+namespace {
+  /* constant initialized, operator new may run before any other static constructor */
+  struct MemoryTagCounters {
+    std::atomic<size_t> liveBytes = 0;
+    std::atomic<size_t> peakBytes = 0;
+    std::atomic<uint64_t> allocations = 0;
+    uint64_t lastFrameAllocations = 0;
+    uint64_t frameAllocations = 0;
+  };
+
+  std::array<MemoryTagCounters, static_cast<size_t>(memoryTag::NUM)> cpuCounters{};
+  std::array<MemoryTagCounters, static_cast<size_t>(memoryTag::NUM)> gpuCounters{};
+
+  thread_local memoryTag currentThreadTag = memoryTag::untagged;
+
+  void addAllocation(MemoryTagCounters& counters, size_t bytes) {
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    size_t liveBytes = counters.liveBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    size_t peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    while (liveBytes > peakBytes &&
+        !counters.peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed)) {
+    }
+  }
+
+  MemoryTagStats getStats(const MemoryTagCounters& counters) {
+    MemoryTagStats stats{};
+    stats.mtsLiveBytes = counters.liveBytes.load(std::memory_order_relaxed);
+    stats.mtsPeakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.mtsAllocations = counters.allocations.load(std::memory_order_relaxed);
+    stats.mtsFrameAllocations = counters.frameAllocations;
+    return stats;
+  }
+}
+
+void MemoryTracker::addCpuAllocation(memoryTag tag, size_t bytes) {
+  addAllocation(cpuCounters[static_cast<size_t>(tag)], bytes);
+}
+
+void MemoryTracker::removeCpuAllocation(memoryTag tag, size_t bytes) {
+  cpuCounters[static_cast<size_t>(tag)].liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::addGpuAllocation(memoryTag tag, size_t bytes) {
+  addAllocation(gpuCounters[static_cast<size_t>(tag)], bytes);
+}
+
+void MemoryTracker::removeGpuAllocation(memoryTag tag, size_t bytes) {
+  gpuCounters[static_cast<size_t>(tag)].liveBytes.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+memoryTag MemoryTracker::getThreadTag() {
+  return currentThreadTag;
+}
+
+void MemoryTracker::setThreadTag(memoryTag tag) {
+  currentThreadTag = tag;
+}
+
+bool MemoryTracker::isCpuTrackingEnabled() {
+#if defined(ENABLE_MEMORY_TAG_HOOK) && !defined(DISABLE_ALLOCATION_COUNTER)
+  return true;
+#else
+  return false;
+#endif
+}
+
+void MemoryTracker::endFrame() {
+  for (auto* counterArray : { &cpuCounters, &gpuCounters }) {
+    for (auto& counters : *counterArray) {
+      uint64_t allocations = counters.allocations.load(std::memory_order_relaxed);
+      counters.frameAllocations = allocations - counters.lastFrameAllocations;
+      counters.lastFrameAllocations = allocations;
+    }
+  }
+}
+
+MemoryTagStats MemoryTracker::getCpuStats(memoryTag tag) {
+  return getStats(cpuCounters.at(static_cast<size_t>(tag)));
+}
+
+MemoryTagStats MemoryTracker::getGpuStats(memoryTag tag) {
+  return getStats(gpuCounters.at(static_cast<size_t>(tag)));
+}
+
+std::string MemoryTracker::getTagName(memoryTag tag) {
+  switch (tag) {
+    case memoryTag::untagged:
+      return "Untagged";
+    case memoryTag::modelGeometry:
+      return "Model Geometry";
+    case memoryTag::levelGeometry:
+      return "Level Geometry";
+    case memoryTag::animationLookup:
+      return "Animation Lookup";
+    case memoryTag::aabbLookup:
+      return "AABB Lookup";
+    case memoryTag::morphAnimation:
+      return "Morph Animation";
+    case memoryTag::materials:
+      return "Materials";
+    case memoryTag::textures:
+      return "Textures";
+    case memoryTag::octree:
+      return "Octree";
+    case memoryTag::navigation:
+      return "Navigation";
+    case memoryTag::undoStack:
+      return "Undo Stack";
+    case memoryTag::rendererBuffers:
+      return "Renderer Buffers";
+    default:
+      return "Unknown";
+  }
+}
+
+void MemoryTracker::logReport() {
+  Logger::log(1, "%s: %-18s %14s %14s %12s %14s %14s\n", __FUNCTION__, "tag", "CPU live", "CPU peak", "CPU allocs",
+    "GPU live", "GPU peak");
+  for (size_t i = 0; i < static_cast<size_t>(memoryTag::NUM); ++i) {
+    memoryTag tag = static_cast<memoryTag>(i);
+    MemoryTagStats cpuStats = getCpuStats(tag);
+    MemoryTagStats gpuStats = getGpuStats(tag);
+    Logger::log(1, "%s: %-18s %14zu %14zu %12llu %14zu %14zu\n", __FUNCTION__, getTagName(tag).c_str(),
+      cpuStats.mtsLiveBytes, cpuStats.mtsPeakBytes, static_cast<unsigned long long>(cpuStats.mtsAllocations),
+      gpuStats.mtsLiveBytes, gpuStats.mtsPeakBytes);
+  }
+
+  if (!isCpuTrackingEnabled()) {
+    Logger::log(1, "%s: CPU columns need the MEMORY_TAG_HOOK build option\n", __FUNCTION__);
+  }
+}
@@ -0,0 +1,64 @@
+/* tagged CPU and GPU memory accounting */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Enums.h"
+
+struct MemoryTagStats {
+  size_t mtsLiveBytes = 0;
+  size_t mtsPeakBytes = 0;
+  uint64_t mtsAllocations = 0;
+  /* allocations between the last two endFrame() calls */
+  uint64_t mtsFrameAllocations = 0;
+};
+
+class MemoryTracker {
+  public:
+    /* called by the global operator new hook, must not allocate */
+    static void addCpuAllocation(memoryTag tag, size_t bytes);
+    static void removeCpuAllocation(memoryTag tag, size_t bytes);
+
+    /* GL buffers and textures report their own sizes */
+    static void addGpuAllocation(memoryTag tag, size_t bytes);
+    static void removeGpuAllocation(memoryTag tag, size_t bytes);
+
+    /* heap allocations of the current thread go to this tag */
+    static memoryTag getThreadTag();
+    static void setThreadTag(memoryTag tag);
+
+    /* false if the build has no operator new hook, all CPU stats stay at zero then */
+    static bool isCpuTrackingEnabled();
+
+    /* call once per frame on the main thread */
+    static void endFrame();
+
+    static MemoryTagStats getCpuStats(memoryTag tag);
+    static MemoryTagStats getGpuStats(memoryTag tag);
+    static std::string getTagName(memoryTag tag);
+
+    /* writes all tags to the log, for runs without UI */
+    static void logReport();
+};
+
+class MemoryTagScope {
+  public:
+    explicit MemoryTagScope(memoryTag tag) : mPreviousTag(MemoryTracker::getThreadTag()) {
+      MemoryTracker::setThreadTag(tag);
+    }
+
+    ~MemoryTagScope() {
+      MemoryTracker::setThreadTag(mPreviousTag);
+    }
+
+    MemoryTagScope(const MemoryTagScope&) = delete;
+    MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+  private:
+    memoryTag mPreviousTag;
+};
+
+#define MEMORY_TAG_CONCAT_IMPL(a, b) a##b
+#define MEMORY_TAG_CONCAT(a, b) MEMORY_TAG_CONCAT_IMPL(a, b)
+#define MEMORY_TAG_SCOPE(tag) MemoryTagScope MEMORY_TAG_CONCAT(memoryTagScope, __LINE__)(tag)
@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <cmath>
+
+#include "MeshOptimizer.h"
+
+/* scoring values from Tom Forsyth, "Linear-Speed Vertex Cache Optimisation" */
+float MeshOptimizer::forsythVertexScore(int cachePosition, unsigned int remainingValence) {
+  if (remainingValence == 0) {
+    /* no triangle needs this vertex anymore */
+    return -1.0f;
+  }
+
+  const float cacheDecayPower = 1.5f;
+  const float lastTriScore = 0.75f;
+  const float valenceBoostScale = 2.0f;
+  const float valenceBoostPower = 0.5f;
+
+  float score = 0.0f;
+  if (cachePosition >= 0) {
+    if (cachePosition < 3) {
+      /* vertex was used in the last triangle, fixed score to avoid strips */
+      score = lastTriScore;
+    } else {
+      const float scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+      score = std::pow(1.0f - (cachePosition - 3) * scaler, cacheDecayPower);
+    }
+  }
+
+  /* boost vertices with only a few triangles left to get rid of lone triangles */
+  score += valenceBoostScale * std::pow(static_cast<float>(remainingValence), -valenceBoostPower);
+  return score;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, unsigned int vertexCount) {
+  const size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0 || vertexCount == 0) {
+    return;
+  }
+
+  /* vertex => triangle adjacency, stored as one flat array with offsets */
+  std::vector<unsigned int> valence(vertexCount, 0);
+  for (const auto& index : indices) {
+    valence.at(index)++;
+  }
+
+  std::vector<unsigned int> adjacencyOffset(vertexCount + 1, 0);
+  for (unsigned int i = 0; i < vertexCount; ++i) {
+    adjacencyOffset.at(i + 1) = adjacencyOffset.at(i) + valence.at(i);
+  }
+
+  std::vector<unsigned int> adjacency(indices.size());
+  std::vector<unsigned int> fillCount(vertexCount, 0);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    unsigned int vertex = indices.at(i);
+    adjacency.at(adjacencyOffset.at(vertex) + fillCount.at(vertex)++) = static_cast<unsigned int>(i / 3);
+  }
+
+  std::vector<int> cachePosition(vertexCount, -1);
+  std::vector<float> vertexScore(vertexCount);
+  for (unsigned int i = 0; i < vertexCount; ++i) {
+    vertexScore.at(i) = forsythVertexScore(-1, valence.at(i));
+  }
+
+  std::vector<float> triangleScore(triangleCount);
+  std::vector<bool> triangleEmitted(triangleCount, false);
+  for (size_t i = 0; i < triangleCount; ++i) {
+    triangleScore.at(i) = vertexScore.at(indices.at(i * 3)) + vertexScore.at(indices.at(i * 3 + 1)) +
+      vertexScore.at(indices.at(i * 3 + 2));
+  }
+
+  std::vector<uint32_t> newIndices;
+  newIndices.reserve(indices.size());
+
+  std::vector<int> cache;
+  cache.reserve(FORSYTH_CACHE_SIZE + 3);
+  std::vector<int> newCache;
+  newCache.reserve(FORSYTH_CACHE_SIZE + 3);
+
+  int bestTriangle = static_cast<int>(std::distance(triangleScore.begin(),
+    std::max_element(triangleScore.begin(), triangleScore.end())));
+  size_t searchCursor = 0;
+
+  for (size_t emitted = 0; emitted < triangleCount; ++emitted) {
+    if (bestTriangle < 0) {
+      /* cache ran dry, continue with the next unused triangle in source order */
+      while (triangleEmitted.at(searchCursor)) {
+        ++searchCursor;
+      }
+      bestTriangle = static_cast<int>(searchCursor);
+    }
+
+    triangleEmitted.at(bestTriangle) = true;
+    newCache.clear();
+
+    for (unsigned int corner = 0; corner < 3; ++corner) {
+      unsigned int vertex = indices.at(bestTriangle * 3 + corner);
+      newIndices.push_back(vertex);
+
+      /* remove the triangle from the adjacency list of the vertex */
+      unsigned int begin = adjacencyOffset.at(vertex);
+      unsigned int end = begin + valence.at(vertex);
+      for (unsigned int j = begin; j < end; ++j) {
+        if (adjacency.at(j) == static_cast<unsigned int>(bestTriangle)) {
+          std::swap(adjacency.at(j), adjacency.at(end - 1));
+          valence.at(vertex)--;
+          break;
+        }
+      }
+
+      if (std::find(newCache.begin(), newCache.end(), static_cast<int>(vertex)) == newCache.end()) {
+        newCache.push_back(static_cast<int>(vertex));
+      }
+    }
+
+    /* LRU cache: vertices of the emitted triangle first, followed by the remaining old entries */
+    for (const auto& vertex : cache) {
+      if (std::find(newCache.begin(), newCache.end(), vertex) == newCache.end()) {
+        newCache.push_back(vertex);
+      }
+    }
+
+    /* vertices falling out of the cache lose their cache position */
+    for (size_t i = FORSYTH_CACHE_SIZE; i < newCache.size(); ++i) {
+      cachePosition.at(newCache.at(i)) = -1;
+      vertexScore.at(newCache.at(i)) = forsythVertexScore(-1, valence.at(newCache.at(i)));
+    }
+    if (newCache.size() > FORSYTH_CACHE_SIZE) {
+      newCache.resize(FORSYTH_CACHE_SIZE);
+    }
+
+    for (size_t i = 0; i < newCache.size(); ++i) {
+      int vertex = newCache.at(i);
+      cachePosition.at(vertex) = static_cast<int>(i);
+      vertexScore.at(vertex) = forsythVertexScore(static_cast<int>(i), valence.at(vertex));
+    }
+
+    /* update the scores of all triangles touching a cached vertex and find the next best one */
+    bestTriangle = -1;
+    float bestScore = -1.0f;
+    for (const auto& vertex : newCache) {
+      unsigned int begin = adjacencyOffset.at(vertex);
+      unsigned int end = begin + valence.at(vertex);
+      for (unsigned int j = begin; j < end; ++j) {
+        unsigned int triangle = adjacency.at(j);
+        float score = vertexScore.at(indices.at(triangle * 3)) + vertexScore.at(indices.at(triangle * 3 + 1)) +
+          vertexScore.at(indices.at(triangle * 3 + 2));
+        triangleScore.at(triangle) = score;
+        if (score > bestScore) {
+          bestScore = score;
+          bestTriangle = static_cast<int>(triangle);
+        }
+      }
+    }
+
+    cache.swap(newCache);
+  }
+
+  indices.swap(newIndices);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold) {
+  const size_t triangleCount = indices.size() / 3;
+  const unsigned int vertexCount = static_cast<unsigned int>(positions.size());
+  if (triangleCount == 0 || vertexCount == 0) {
+    return;
+  }
+
+  VertexCacheStats originalStats = analyzeVertexCache(indices, vertexCount);
+
+  /* split into clusters at "hard boundaries", i.e. triangles where all three vertices miss the cache */
+  std::vector<size_t> clusterStart{};
+  std::vector<unsigned int> cacheTimestamp(vertexCount, 0);
+  unsigned int timestamp = VERTEX_CACHE_SIM_SIZE + 1;
+  for (size_t i = 0; i < triangleCount; ++i) {
+    unsigned int misses = 0;
+    for (unsigned int corner = 0; corner < 3; ++corner) {
+      unsigned int vertex = indices.at(i * 3 + corner);
+      if (timestamp - cacheTimestamp.at(vertex) > VERTEX_CACHE_SIM_SIZE) {
+        cacheTimestamp.at(vertex) = timestamp++;
+        ++misses;
+      }
+    }
+    if (misses == 3 || i == 0) {
+      clusterStart.push_back(i);
+    }
+  }
+  clusterStart.push_back(triangleCount);
+
+  const size_t clusterCount = clusterStart.size() - 1;
+  if (clusterCount < 2) {
+    return;
+  }
+
+  /* area weighted centroid and normal per cluster */
+  glm::vec3 meshCenter = glm::vec3(0.0f);
+  float meshArea = 0.0f;
+  std::vector<glm::vec3> clusterCenter(clusterCount, glm::vec3(0.0f));
+  std::vector<glm::vec3> clusterNormal(clusterCount, glm::vec3(0.0f));
+  std::vector<float> clusterArea(clusterCount, 0.0f);
+
+  for (size_t cluster = 0; cluster < clusterCount; ++cluster) {
+    for (size_t i = clusterStart.at(cluster); i < clusterStart.at(cluster + 1); ++i) {
+      const glm::vec3& p0 = positions.at(indices.at(i * 3));
+      const glm::vec3& p1 = positions.at(indices.at(i * 3 + 1));
+      const glm::vec3& p2 = positions.at(indices.at(i * 3 + 2));
+
+      glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+      float area = glm::length(normal);
+      glm::vec3 center = (p0 + p1 + p2) / 3.0f;
+
+      clusterCenter.at(cluster) += center * area;
+      clusterNormal.at(cluster) += normal;
+      clusterArea.at(cluster) += area;
+    }
+
+    meshCenter += clusterCenter.at(cluster);
+    meshArea += clusterArea.at(cluster);
+
+    if (clusterArea.at(cluster) > 0.0f) {
+      clusterCenter.at(cluster) /= clusterArea.at(cluster);
+    }
+    float normalLength = glm::length(clusterNormal.at(cluster));
+    if (normalLength > 0.0f) {
+      clusterNormal.at(cluster) /= normalLength;
+    }
+  }
+
+  if (meshArea > 0.0f) {
+    meshCenter /= meshArea;
+  }
+
+  /* clusters facing away from the mesh center occlude the inner ones, draw them first */
+  std::vector<float> sortMetric(clusterCount);
+  for (size_t cluster = 0; cluster < clusterCount; ++cluster) {
+    sortMetric.at(cluster) = glm::dot(clusterCenter.at(cluster) - meshCenter, clusterNormal.at(cluster));
+  }
+
+  std::vector<size_t> clusterOrder(clusterCount);
+  std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+  std::stable_sort(clusterOrder.begin(), clusterOrder.end(),
+    [&](size_t a, size_t b) { return sortMetric.at(a) > sortMetric.at(b); });
+
+  std::vector<uint32_t> newIndices;
+  newIndices.reserve(indices.size());
+  for (const auto& cluster : clusterOrder) {
+    newIndices.insert(newIndices.end(), indices.begin() + clusterStart.at(cluster) * 3,
+      indices.begin() + clusterStart.at(cluster + 1) * 3);
+  }
+
+  VertexCacheStats newStats = analyzeVertexCache(newIndices, vertexCount);
+  if (newStats.acmr > originalStats.acmr * threshold) {
+    return;
+  }
+
+  indices.swap(newIndices);
+}
+
+std::vector<uint32_t> MeshOptimizer::optimizeVertexFetchRemap(std::vector<uint32_t>& indices, unsigned int vertexCount) {
+  const uint32_t unused = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> remap(vertexCount, unused);
+
+  uint32_t nextVertex = 0;
+  for (auto& index : indices) {
+    if (remap.at(index) == unused) {
+      remap.at(index) = nextVertex++;
+    }
+    index = remap.at(index);
+  }
+
+  /* keep unreferenced vertices at the end, vertex count stays the same */
+  for (auto& entry : remap) {
+    if (entry == unused) {
+      entry = nextVertex++;
+    }
+  }
+
+  return remap;
+}
+
+VertexCacheStats MeshOptimizer::analyzeVertexCache(const std::vector<uint32_t>& indices, unsigned int vertexCount,
+    unsigned int cacheSize) {
+  VertexCacheStats stats{};
+  const size_t triangleCount = indices.size() / 3;
+  if (triangleCount == 0 || vertexCount == 0) {
+    return stats;
+  }
+
+  /* FIFO cache simulation via insertion timestamps */
+  std::vector<unsigned int> cacheTimestamp(vertexCount, 0);
+  std::vector<bool> vertexUsed(vertexCount, false);
+  unsigned int timestamp = cacheSize + 1;
+  unsigned int misses = 0;
+  unsigned int usedVertices = 0;
+
+  for (const auto& index : indices) {
+    if (timestamp - cacheTimestamp.at(index) > cacheSize) {
+      cacheTimestamp.at(index) = timestamp++;
+      ++misses;
+    }
+    if (!vertexUsed.at(index)) {
+      vertexUsed.at(index) = true;
+      ++usedVertices;
+    }
+  }
+
+  stats.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount);
+  stats.atvr = static_cast<float>(misses) / static_cast<float>(usedVertices);
+  return stats;
+}
@@ -0,0 +1,50 @@
+/* Mesh optimizer, reorders triangles and vertices after import */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+struct VertexCacheStats {
+  /* average cache miss ratio, transformed vertices per triangle */
+  float acmr = 0.0f;
+  /* average transform to vertex ratio, 1.0 is optimal */
+  float atvr = 0.0f;
+};
+
+class MeshOptimizer {
+  public:
+    /* Forsyth linear-speed vertex cache optimization, rewrites index order only */
+    static void optimizeVertexCache(std::vector<uint32_t>& indices, unsigned int vertexCount);
+
+    /* sort cache-friendly clusters by view-independent overdraw metric, keeps old order if ACMR gets worse than threshold */
+    static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold = 1.05f);
+
+    /* renumber vertices in order of first use, returns remap table (old index => new index) */
+    static std::vector<uint32_t> optimizeVertexFetchRemap(std::vector<uint32_t>& indices, unsigned int vertexCount);
+
+    /* simulates a FIFO post-transform cache */
+    static VertexCacheStats analyzeVertexCache(const std::vector<uint32_t>& indices, unsigned int vertexCount,
+      unsigned int cacheSize = VERTEX_CACHE_SIM_SIZE);
+
+    /* moves vertices to their new positions, usable for mesh and morph vertices */
+    template <typename T>
+    static void remapVertexBuffer(std::vector<T>& vertices, const std::vector<uint32_t>& remap) {
+      if (vertices.size() != remap.size()) {
+        return;
+      }
+      std::vector<T> remappedVertices(vertices.size());
+      for (size_t i = 0; i < vertices.size(); ++i) {
+        remappedVertices.at(remap.at(i)) = vertices.at(i);
+      }
+      vertices.swap(remappedVertices);
+    }
+
+  private:
+    /* typical size of the post-transform cache on current GPUs */
+    static const unsigned int VERTEX_CACHE_SIM_SIZE = 16;
+
+    /* LRU cache size used for the Forsyth scoring */
+    static const int FORSYTH_CACHE_SIZE = 32;
+    static float forsythVertexScore(int cachePosition, unsigned int remainingValence);
+};
@@ -3,8 +3,10 @@
 #include <queue>
 
 #include "Logger.h"
+#include "MemoryTracker.h"
 
 void PathFinder::generateGroundTriangles(OGLRenderData& renderData, std::shared_ptr<TriangleOctree> octree, BoundingBox3D worldbox) {
+  MEMORY_TAG_SCOPE(memoryTag::navigation);
   mNavTriangles.clear();
 
   mLevelGroundMesh = std::make_shared<OGLLineMesh>();
@@ -237,68 +239,38 @@ glm::vec3 PathFinder::getTriangleCenter(int index) {
 }
 
 
-std::shared_ptr<OGLLineMesh> PathFinder::getAsLineMesh(std::vector<int> indices, glm::vec3 color, glm::vec3 offset) {
-  std::shared_ptr<OGLLineMesh> pointMesh = std::make_shared<OGLLineMesh>();
-
+void PathFinder::getPathLines(const std::vector<int>& indices, glm::vec3 color, glm::vec3 offset,
+    std::vector<OGLLineVertex>& lineVertices) {
   /* we need at least two vertices to draw a line */
   if (indices.size() < 2) {
-    return pointMesh;
+    return;
   }
 
-  OGLLineVertex vert{};
-  vert.color = color;
-
   for (int i = 0; i < indices.size() - 1; ++i) {
-    if (mNavTriangles.count(indices.at(i)) == 0 || mNavTriangles.count(indices.at(i + 1)) == 0) {
+    const auto startTri = mNavTriangles.find(indices.at(i));
+    const auto endTri = mNavTriangles.find(indices.at(i + 1));
+    if (startTri == mNavTriangles.end() || endTri == mNavTriangles.end()) {
       continue;
     }
 
-    NavTriangle tri = mNavTriangles.at(indices.at(i));
-    vert.position = tri.center + tri.normal * offset;
-    pointMesh->vertices.emplace_back(vert);
-
-    tri = mNavTriangles.at(indices.at(i + 1));
-    vert.position = tri.center + tri.normal * offset;
-    pointMesh->vertices.emplace_back(vert);
+    lineVertices.emplace_back(startTri->second.center + startTri->second.normal * offset, color);
+    lineVertices.emplace_back(endTri->second.center + endTri->second.normal * offset, color);
   }
-
-  return pointMesh;
 }
 
-std::shared_ptr<OGLLineMesh> PathFinder::getAsTriangleMesh(std::vector<int> indices, glm::vec3 color, glm::vec3 normalColor, glm::vec3 offset) {
-  std::shared_ptr<OGLLineMesh> pointMesh = std::make_shared<OGLLineMesh>();
-
-  OGLLineVertex vert;
-  OGLLineVertex normalVert;
-
+void PathFinder::getTriangleLines(const std::vector<int>& indices, glm::vec3 color, glm::vec3 normalColor,
+    glm::vec3 offset, std::vector<OGLLineVertex>& lineVertices) {
   for (const auto index : indices) {
-    NavTriangle tri = mNavTriangles.at(index);
+    const NavTriangle& tri = mNavTriangles.at(index);
 
-    vert.color = color;
     /* move wireframe overdraw a bit above the planes */
-    vert.position = tri.points.at(0) + tri.normal * offset;
-    pointMesh->vertices.push_back(vert);
-    vert.position = tri.points.at(1) + tri.normal * offset;
-    pointMesh->vertices.push_back(vert);
-
-    vert.position = tri.points.at(1) + tri.normal * offset;
-    pointMesh->vertices.push_back(vert);
-    vert.position = tri.points.at(2) + tri.normal * offset;
-    pointMesh->vertices.push_back(vert);
-
-    vert.position = tri.points.at(2) + tri.normal * offset;
-    pointMesh->vertices.push_back(vert);
-    vert.position = tri.points.at(0) + tri.normal * offset;
-    pointMesh->vertices.push_back(vert);
+    for (int j = 0; j < 3; ++j) {
+      lineVertices.emplace_back(tri.points.at(j) + tri.normal * offset, color);
+      lineVertices.emplace_back(tri.points.at((j + 1) % 3) + tri.normal * offset, color);
+    }
 
     /* draw normal vector in the middle of the triangle */
-    normalVert.color = normalColor;
-    glm::vec3 normalPos = tri.center;
-    normalVert.position = normalPos;
-    pointMesh->vertices.push_back(normalVert);
-    normalVert.position = normalPos + tri.normal;
-    pointMesh->vertices.push_back(normalVert);
+    lineVertices.emplace_back(tri.center, normalColor);
+    lineVertices.emplace_back(tri.center + tri.normal, normalColor);
   }
-
-  return pointMesh;
 }
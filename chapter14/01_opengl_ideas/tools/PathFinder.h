@@ -1,6 +1,5 @@
 #pragma once
 
-#include <vector>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -37,8 +36,11 @@ class PathFinder {
     glm::vec3 getTriangleCenter(int index);
 
     std::shared_ptr<OGLLineMesh> getGroundLevelMesh();
-    std::shared_ptr<OGLLineMesh> getAsLineMesh(std::vector<int> indices, glm::vec3 color, glm::vec3 offset);
-    std::shared_ptr<OGLLineMesh> getAsTriangleMesh(std::vector<int> indices, glm::vec3 color, glm::vec3 normalColor, glm::vec3 offset);
+    /* both append GL_LINES vertex pairs, the caller feeds them to the debug drawer */
+    void getPathLines(const std::vector<int>& indices, glm::vec3 color, glm::vec3 offset,
+      std::vector<OGLLineVertex>& lineVertices);
+    void getTriangleLines(const std::vector<int>& indices, glm::vec3 color, glm::vec3 normalColor, glm::vec3 offset,
+      std::vector<OGLLineVertex>& lineVertices);
 
   private:
     std::unordered_map<int, NavTriangle> mNavTriangles{};
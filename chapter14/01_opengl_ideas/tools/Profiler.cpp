@@ -0,0 +1,225 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+#include "Profiler.h"
+#include "Logger.h"
+
+std::atomic<bool> Profiler::mEnabled = false;
+std::atomic<uint32_t> Profiler::mFrame = 0;
+uint32_t Profiler::mTraceEndFrame = 0;
+unsigned int Profiler::mTraceFrames = 0;
+
+std::mutex Profiler::mBufferMutex;
+std::vector<std::unique_ptr<ProfilerThreadBuffer>> Profiler::mThreadBuffers{};
+
+std::vector<ProfilerCounter> Profiler::mCounters{};
+uint64_t Profiler::mCounterWriteIndex = 0;
+
+namespace {
+  const std::chrono::steady_clock::time_point profilerStartTime = std::chrono::steady_clock::now();
+
+  /* hands the buffer back when the thread exits, new threads reuse it */
+  struct ProfilerThreadBufferHolder {
+    ProfilerThreadBuffer* buffer = nullptr;
+    std::mutex* bufferMutex = nullptr;
+
+    ~ProfilerThreadBufferHolder() {
+      if (buffer) {
+        std::lock_guard<std::mutex> lock(*bufferMutex);
+        buffer->ptbInUse = false;
+      }
+    }
+  };
+  thread_local ProfilerThreadBufferHolder threadBufferHolder{};
+
+  std::string escapeJson(const char* text) {
+    std::string escaped;
+    for (const char* c = text; *c != '\0'; ++c) {
+      if (*c == '"' || *c == '\\') {
+        escaped += '\\';
+      }
+      escaped += *c;
+    }
+    return escaped;
+  }
+}
+
+void Profiler::setEnabled(bool enabled) {
+  mEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t Profiler::getTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - profilerStartTime).count();
+}
+
+uint32_t Profiler::getFrame() {
+  return mFrame.load(std::memory_order_relaxed);
+}
+
+void Profiler::beginFrame() {
+  uint32_t frame = mFrame.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  if (mTraceFrames > 0 && frame >= mTraceEndFrame) {
+    writeChromeTrace("trace_frame_" + std::to_string(frame) + ".json", mTraceFrames);
+    mTraceFrames = 0;
+    setEnabled(false);
+  }
+}
+
+void Profiler::requestTrace(unsigned int numFrames) {
+  if (numFrames == 0) {
+    return;
+  }
+
+  mTraceFrames = numFrames;
+  mTraceEndFrame = getFrame() + numFrames + 1;
+  setEnabled(true);
+  Logger::log(1, "%s: recording %i frames for Chrome trace\n", __FUNCTION__, numFrames);
+}
+
+ProfilerThreadBuffer* Profiler::getThreadBuffer() {
+  if (threadBufferHolder.buffer) {
+    return threadBufferHolder.buffer;
+  }
+
+  std::lock_guard<std::mutex> lock(mBufferMutex);
+  ProfilerThreadBuffer* buffer = nullptr;
+  for (const auto& threadBuffer : mThreadBuffers) {
+    if (!threadBuffer->ptbInUse) {
+      buffer = threadBuffer.get();
+      break;
+    }
+  }
+
+  if (!buffer) {
+    mThreadBuffers.emplace_back(std::make_unique<ProfilerThreadBuffer>());
+    buffer = mThreadBuffers.back().get();
+    buffer->ptbZones.resize(ZONES_PER_THREAD);
+    buffer->ptbThreadId = mThreadBuffers.size();
+    buffer->ptbThreadName = "thread " + std::to_string(buffer->ptbThreadId);
+  }
+
+  buffer->ptbInUse = true;
+  buffer->ptbDepth = 0;
+  threadBufferHolder.buffer = buffer;
+  threadBufferHolder.bufferMutex = &mBufferMutex;
+  return buffer;
+}
+
+void Profiler::setThreadName(std::string name) {
+  ProfilerThreadBuffer* buffer = getThreadBuffer();
+  std::lock_guard<std::mutex> lock(mBufferMutex);
+  buffer->ptbThreadName = name;
+}
+
+void Profiler::beginZone() {
+  ++getThreadBuffer()->ptbDepth;
+}
+
+void Profiler::endZone(const char* name, uint64_t startTime) {
+  uint64_t endTime = getTime();
+  ProfilerThreadBuffer* buffer = getThreadBuffer();
+  --buffer->ptbDepth;
+
+  /* single writer per buffer, publishing the index is enough */
+  uint64_t index = buffer->ptbWriteIndex.load(std::memory_order_relaxed);
+  ProfilerZone& zone = buffer->ptbZones[index & (ZONES_PER_THREAD - 1)];
+  zone.pzName = name;
+  zone.pzStartTime = startTime;
+  zone.pzDuration = endTime - startTime;
+  zone.pzFrame = getFrame();
+  zone.pzDepth = buffer->ptbDepth;
+  buffer->ptbWriteIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::addCounter(const char* name, float value) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  /* same thread as writeChromeTrace(), no locking needed */
+  if (mCounters.empty()) {
+    mCounters.resize(MAX_COUNTERS);
+  }
+
+  ProfilerCounter& counter = mCounters[mCounterWriteIndex & (MAX_COUNTERS - 1)];
+  counter.pcName = name;
+  counter.pcTime = getTime();
+  counter.pcValue = value;
+  counter.pcFrame = getFrame();
+  ++mCounterWriteIndex;
+}
+
+bool Profiler::writeChromeTrace(std::string fileName, unsigned int numFrames) {
+  uint32_t currentFrame = getFrame();
+
+  FILE* traceFile = std::fopen(fileName.c_str(), "w");
+  if (!traceFile) {
+    Logger::log(1, "%s error: could not open trace file '%s'\n", __FUNCTION__, fileName.c_str());
+    return false;
+  }
+
+  std::fprintf(traceFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  unsigned int numZones = 0;
+  bool firstEvent = true;
+
+  std::lock_guard<std::mutex> lock(mBufferMutex);
+  std::vector<ProfilerZone> zones;
+  for (const auto& buffer : mThreadBuffers) {
+    std::fprintf(traceFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+      firstEvent ? "" : ",\n", buffer->ptbThreadId, escapeJson(buffer->ptbThreadName.c_str()).c_str());
+    firstEvent = false;
+
+    /* seqlock-style read: the owner thread keeps writing while we copy the plain zone structs, so a
+     * copied zone may be torn. Re-reading the write index afterwards tells which slots were (or are
+     * being) overwritten meanwhile, those copies are dropped */
+    uint64_t endIndex = buffer->ptbWriteIndex.load(std::memory_order_acquire);
+    uint64_t startIndex = endIndex > ZONES_PER_THREAD ? endIndex - ZONES_PER_THREAD : 0;
+    zones.resize(endIndex - startIndex);
+    for (uint64_t i = startIndex; i < endIndex; ++i) {
+      zones.at(i - startIndex) = buffer->ptbZones[i & (ZONES_PER_THREAD - 1)];
+    }
+
+    /* keeps the copy above from being reordered after the second index load */
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t newEndIndex = buffer->ptbWriteIndex.load(std::memory_order_relaxed);
+
+    /* slot newEndIndex may be in the middle of a write, its previous zone is lost too */
+    uint64_t firstValidIndex = newEndIndex + 1 > ZONES_PER_THREAD ? newEndIndex + 1 - ZONES_PER_THREAD : 0;
+
+    for (uint64_t i = std::max(startIndex, firstValidIndex); i < endIndex; ++i) {
+      const ProfilerZone& zone = zones.at(i - startIndex);
+      if (zone.pzFrame + numFrames < currentFrame) {
+        continue;
+      }
+
+      std::fprintf(traceFile, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+        "\"args\":{\"frame\":%u,\"depth\":%u}}",
+        escapeJson(zone.pzName).c_str(), buffer->ptbThreadId, zone.pzStartTime / 1000.0, zone.pzDuration / 1000.0,
+        zone.pzFrame, zone.pzDepth);
+      ++numZones;
+    }
+  }
+
+  unsigned int numCounters = 0;
+  uint64_t firstCounterIndex = mCounterWriteIndex > MAX_COUNTERS ? mCounterWriteIndex - MAX_COUNTERS : 0;
+  for (uint64_t i = firstCounterIndex; i < mCounterWriteIndex; ++i) {
+    const ProfilerCounter& counter = mCounters[i & (MAX_COUNTERS - 1)];
+    if (counter.pcFrame + numFrames < currentFrame) {
+      continue;
+    }
+
+    std::fprintf(traceFile, "%s{\"name\":\"%s\",\"ph\":\"C\",\"pid\":1,\"ts\":%.3f,\"args\":{\"ms\":%.4f}}",
+      firstEvent ? "" : ",\n", escapeJson(counter.pcName).c_str(), counter.pcTime / 1000.0, counter.pcValue);
+    firstEvent = false;
+    ++numCounters;
+  }
+
+  std::fprintf(traceFile, "\n]}\n");
+  std::fclose(traceFile);
+
+  Logger::log(1, "%s: wrote %i zones and %i counters of the last %i frames to '%s'\n", __FUNCTION__, numZones,
+    numCounters, numFrames, fileName.c_str());
+  return true;
+}
@@ -0,0 +1,116 @@
+/* hierarchical CPU zone profiler, writes Chrome trace JSON (chrome://tracing or ui.perfetto.dev) */
+#pragma once
+#include <atomic>
+#include <vector>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+
+struct ProfilerZone {
+  /* must be a string literal or otherwise outlive the profiler */
+  const char* pzName = nullptr;
+  uint64_t pzStartTime = 0;
+  uint64_t pzDuration = 0;
+  uint32_t pzFrame = 0;
+  uint32_t pzDepth = 0;
+};
+
+/* a sampled value, shown as a counter track in the trace */
+struct ProfilerCounter {
+  /* must be a string literal or otherwise outlive the profiler */
+  const char* pcName = nullptr;
+  uint64_t pcTime = 0;
+  float pcValue = 0.0f;
+  uint32_t pcFrame = 0;
+};
+
+/* one per thread, written only by its owner thread */
+struct ProfilerThreadBuffer {
+  std::vector<ProfilerZone> ptbZones{};
+  std::atomic<uint64_t> ptbWriteIndex = 0;
+  uint32_t ptbThreadId = 0;
+  std::string ptbThreadName{};
+  uint32_t ptbDepth = 0;
+  bool ptbInUse = false;
+};
+
+class Profiler {
+  public:
+    static bool isEnabled() {
+      return mEnabled.load(std::memory_order_relaxed);
+    }
+    static void setEnabled(bool enabled);
+
+    /* call once per frame on the main thread, also writes pending traces */
+    static void beginFrame();
+    static uint32_t getFrame();
+
+    /* nanoseconds since the profiler was loaded */
+    static uint64_t getTime();
+    static void beginZone();
+    static void endZone(const char* name, uint64_t startTime);
+    static void setThreadName(std::string name);
+    /* main thread only, e.g. GPU pass times */
+    static void addCounter(const char* name, float value);
+
+    /* writes the zones of the last numFrames frames of all threads */
+    static bool writeChromeTrace(std::string fileName, unsigned int numFrames);
+    /* records the next numFrames frames, then writes the trace and stops recording */
+    static void requestTrace(unsigned int numFrames);
+
+    static constexpr unsigned int DEFAULT_TRACE_FRAMES = 300;
+
+  private:
+    static ProfilerThreadBuffer* getThreadBuffer();
+
+    /* power of two, zones of older frames are overwritten */
+    static constexpr uint64_t ZONES_PER_THREAD = 16384;
+    static constexpr uint64_t MAX_COUNTERS = 16384;
+
+    static std::atomic<bool> mEnabled;
+    static std::atomic<uint32_t> mFrame;
+    static uint32_t mTraceEndFrame;
+    static unsigned int mTraceFrames;
+
+    static std::mutex mBufferMutex;
+    static std::vector<std::unique_ptr<ProfilerThreadBuffer>> mThreadBuffers;
+
+    static std::vector<ProfilerCounter> mCounters;
+    static uint64_t mCounterWriteIndex;
+};
+
+class ProfilerScope {
+  public:
+    explicit ProfilerScope(const char* name) {
+      if (Profiler::isEnabled()) {
+        mName = name;
+        Profiler::beginZone();
+        mStartTime = Profiler::getTime();
+      }
+    }
+
+    ~ProfilerScope() {
+      if (mName) {
+        Profiler::endZone(mName, mStartTime);
+      }
+    }
+
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+  private:
+    const char* mName = nullptr;
+    uint64_t mStartTime = 0;
+};
+
+/* define DISABLE_PROFILER to compile the zones out completely */
+#ifdef DISABLE_PROFILER
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#else
+#define PROFILER_CONCAT_IMPL(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_IMPL(a, b)
+#define PROFILE_SCOPE(name) ProfilerScope PROFILER_CONCAT(profilerScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#endif
@@ -0,0 +1,51 @@
+#include "ThreadPool.h"
+#include "Logger.h"
+#include "Profiler.h"
+
+ThreadPool::ThreadPool(unsigned int numThreads) {
+  if (numThreads == 0) {
+    /* hardware_concurrency() may return 0 if unknown */
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    numThreads = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+  }
+
+  for (unsigned int i = 0; i < numThreads; ++i) {
+    mThreads.emplace_back(&ThreadPool::workerLoop, this);
+  }
+  Logger::log(2, "%s: started %i worker threads\n", __FUNCTION__, numThreads);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mShutdown = true;
+  }
+  mCondition.notify_all();
+
+  /* remaining jobs are still executed before the workers exit */
+  for (auto& thread : mThreads) {
+    thread.join();
+  }
+}
+
+unsigned int ThreadPool::getNumThreads() {
+  return mThreads.size();
+}
+
+void ThreadPool::workerLoop() {
+  Profiler::setThreadName("pool worker");
+  while (true) {
+    std::function<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mMutex);
+      mCondition.wait(lock, [this]() { return mShutdown || !mJobs.empty(); });
+      if (mShutdown && mJobs.empty()) {
+        return;
+      }
+      job = std::move(mJobs.front());
+      mJobs.pop();
+    }
+    PROFILE_SCOPE("poolJob");
+    job();
+  }
+}
@@ -1,6 +1,7 @@
 #include "Window.h"
 #include "Logger.h"
 #include "ModelInstanceCamData.h"
+#include "Profiler.h"
 
 bool Window::init(unsigned int width, unsigned int height, std::string title) {
   if (!glfwInit()) {
@@ -128,15 +129,33 @@ void Window::mainLoop() {
   float deltaTime = 0.0f;
 
   while (true) {
+    Profiler::beginFrame();
+    PROFILE_SCOPE("frame");
+
     if (!mRenderer->draw(deltaTime)) {
       break;
     }
 
+    /* the next simulation step runs while the driver presents this frame */
+    mRenderer->startSimulation(deltaTime);
+
     /* swap buffers */
-    glfwSwapBuffers(mWindow);
+    {
+      PROFILE_SCOPE("swapBuffers");
+      glfwSwapBuffers(mWindow);
+    }
+
+    /* event callbacks change instances, the simulation must be done before */
+    {
+      PROFILE_SCOPE("finishSimulation");
+      mRenderer->finishSimulation();
+    }
 
     /* poll events in a loop */
-    glfwPollEvents();
+    {
+      PROFILE_SCOPE("pollEvents");
+      glfwPollEvents();
+    }
 
     /* calculate the time we needed for the current frame, feed it to the next draw() call */
     loopEndTime =  std::chrono::steady_clock::now();
@@ -1,14 +1,22 @@
 #include <memory>
 #include <string>
+#include <cstdlib>
 
 #include "Window.h"
 #include "Logger.h"
 
 int main(int argc, char *argv[]) {
+  /* "--frames-in-flight 3" trades one frame of latency for more CPU/GPU overlap */
+  unsigned int framesInFlight = 2;
+  for (int i = 1; i < argc - 1; ++i) {
+    if (std::string(argv[i]) == "--frames-in-flight") {
+      framesInFlight = std::strtoul(argv[i + 1], nullptr, 10);
+    }
+  }
 
   std::unique_ptr<Window> w = std::make_unique<Window>();
 
-  if (!w->init(1280, 720, "Vulkan Renderer - Collecting Ideas")) {
+  if (!w->init(1280, 720, "Vulkan Renderer - Collecting Ideas", framesInFlight)) {
     Logger::log(1, "%s error: Window init error\n", __FUNCTION__);
     return -1;
   }
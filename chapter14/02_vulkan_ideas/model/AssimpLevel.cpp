@@ -158,7 +158,7 @@ void AssimpLevel::processNode(VkRenderData &renderData, std::shared_ptr<AssimpNo
   }
 }
 
-void AssimpLevel::draw(VkRenderData &renderData) {
+void AssimpLevel::draw(VkRenderData &renderData, VkCommandBuffer commandBuffer) {
   for (unsigned int i = 0; i < mLevelMeshes.size(); ++i) {
     VkMesh& mesh = mLevelMeshes.at(i);
 
@@ -172,18 +172,20 @@ void AssimpLevel::draw(VkRenderData &renderData) {
       }
     }
 
+    /* the global texture array is bound by the renderer, select the slot only */
+    VkTexturePushConstants textureData{};
     if (diffuseTex.image != VK_NULL_HANDLE) {
-      vkCmdBindDescriptorSets(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-        renderData.rdAssimpLevelPipelineLayout, 0, 1, &diffuseTex.descriptorSet, 0, nullptr);
+      textureData.pkTextureIndex = diffuseTex.textureIndex;
     } else {
-      vkCmdBindDescriptorSets(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-        renderData.rdAssimpLevelPipelineLayout, 0, 1, &mPlaceholderTexture.descriptorSet, 0, nullptr);
+      textureData.pkTextureIndex = mPlaceholderTexture.textureIndex;
     }
+    vkCmdPushConstants(commandBuffer, renderData.rdAssimpLevelPipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
+      static_cast<uint32_t>(sizeof(VkPushConstants)), static_cast<uint32_t>(sizeof(VkTexturePushConstants)), &textureData);
 
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(renderData.rdCommandBuffer, 0, 1, &mVertexBuffers.at(i).buffer, &offset);
-    vkCmdBindIndexBuffer(renderData.rdCommandBuffer, mIndexBuffers.at(i).buffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(renderData.rdCommandBuffer, static_cast<uint32_t>(mesh.indices.size()), 1, 0, 0, 0);
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mVertexBuffers.at(i).buffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, mIndexBuffers.at(i).buffer, 0, VK_INDEX_TYPE_UINT32);
+    vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(mesh.indices.size()), 1, 0, 0, 0);
   }
 }
 
@@ -213,6 +215,14 @@ unsigned int AssimpLevel::getTriangleCount() {
   return mTriangleCount;
 }
 
+void AssimpLevel::setUploadBatch(uint64_t batchId) {
+  mUploadBatch = batchId;
+}
+
+uint64_t AssimpLevel::getUploadBatch() {
+  return mUploadBatch;
+}
+
 void AssimpLevel::cleanup(VkRenderData &renderData) {
   for (auto buffer : mVertexBuffers) {
     VertexBuffer::cleanup(renderData, buffer);
@@ -25,9 +25,13 @@ class AssimpLevel {
   public:
     bool loadLevel(VkRenderData &renderData, std::string levelFilename, unsigned int extraImportFlags = 0);
 
-    void draw(VkRenderData &renderData);
+    void draw(VkRenderData &renderData, VkCommandBuffer commandBuffer);
     unsigned int getTriangleCount();
 
+    /* vertex, index and texture data are uploaded in the background, see UploadManager */
+    void setUploadBatch(uint64_t batchId);
+    uint64_t getUploadBatch();
+
     void updateLevelRootMatrix();
     glm::mat4 getWorldTransformMatrix();
     glm::mat4 getNormalTransformMatrix();
@@ -51,6 +55,7 @@ private:
 
     unsigned int mTriangleCount = 0;
     unsigned int mVertexCount = 0;
+    uint64_t mUploadBatch = 0;
 
     glm::mat4 mLocalTranslationMatrix = glm::mat4(1.0f);
     glm::mat4 mLocalRotationMatrix = glm::mat4(1.0f);
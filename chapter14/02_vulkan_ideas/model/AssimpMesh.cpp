@@ -2,6 +2,7 @@
 
 #include "Logger.h"
 #include "Tools.h"
+#include "MeshOptimizer.h"
 
 bool AssimpMesh::processMesh(VkRenderData &renderData, aiMesh* mesh, const aiScene* scene, std::string assetDirectory,
     std::unordered_map<std::string, VkTextureData> &textures) {
@@ -187,9 +188,44 @@ bool AssimpMesh::processMesh(VkRenderData &renderData, aiMesh* mesh, const aiSce
     }
   }
 
+  optimizeMesh();
+
   return true;
 }
 
+void AssimpMesh::optimizeMesh() {
+  if (mMesh.indices.empty()) {
+    return;
+  }
+
+  Timer optimizeTimer{};
+  optimizeTimer.start();
+
+  VertexCacheStats oldStats = MeshOptimizer::analyzeVertexCache(mMesh.indices, mVertexCount);
+
+  /* triangle order first, the vertex fetch remap must see the final index order */
+  MeshOptimizer::optimizeVertexCache(mMesh.indices, mVertexCount);
+
+  std::vector<glm::vec3> positions{};
+  positions.reserve(mMesh.vertices.size());
+  for (const auto& vertex : mMesh.vertices) {
+    positions.emplace_back(glm::vec3(vertex.position));
+  }
+  MeshOptimizer::optimizeOverdraw(mMesh.indices, positions);
+
+  std::vector<uint32_t> remap = MeshOptimizer::optimizeVertexFetchRemap(mMesh.indices, mVertexCount);
+  MeshOptimizer::remapVertexBuffer(mMesh.vertices, remap);
+  /* morph vertices are matched by index, move them too */
+  for (auto& morphMesh : mMesh.morphMeshes) {
+    MeshOptimizer::remapVertexBuffer(morphMesh.morphVertices, remap);
+  }
+
+  VertexCacheStats newStats = MeshOptimizer::analyzeVertexCache(mMesh.indices, mVertexCount);
+
+  Logger::log(1, "%s: -- mesh '%s' optimized in %4.2f ms, ACMR %4.3f => %4.3f, ATVR %4.3f => %4.3f\n", __FUNCTION__,
+    mMeshName.c_str(), optimizeTimer.stop(), oldStats.acmr, newStats.acmr, oldStats.atvr, newStats.atvr);
+}
+
 std::vector<uint32_t> AssimpMesh::getIndices() {
   return mMesh.indices;
 }
@@ -11,6 +11,7 @@
 #include "VkRenderData.h"
 #include "Texture.h"
 #include "AssimpBone.h"
+#include "Timer.h"
 
 class AssimpMesh {
   public:
@@ -26,6 +27,9 @@ class AssimpMesh {
     std::vector<std::shared_ptr<AssimpBone>> getBoneList();
 
   private:
+    /* reorders indices and vertices for better GPU cache usage */
+    void optimizeMesh();
+
     std::string mMeshName;
     unsigned int mTriangleCount = 0;
     unsigned int mVertexCount = 0;
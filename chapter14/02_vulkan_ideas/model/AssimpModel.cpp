@@ -556,7 +556,7 @@ void AssimpModel::updateBoundingSphereAdjustments(VkRenderData& renderData) {
   updateBoundingSphereDescriptorSet(renderData);
 }
 
-void AssimpModel::draw(VkRenderData &renderData, bool selectionModeActive) {
+void AssimpModel::draw(VkRenderData &renderData, VkCommandBuffer commandBuffer, bool selectionModeActive) {
   for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
     VkMesh& mesh = mModelMeshes.at(i);
 
@@ -586,48 +586,53 @@ void AssimpModel::draw(VkRenderData &renderData, bool selectionModeActive) {
       }
     }
 
+    /* the global texture array is bound by the renderer, select the slot only */
+    VkTexturePushConstants textureData{};
     if (diffuseTex.image != VK_NULL_HANDLE) {
-      vkCmdBindDescriptorSets(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-        renderLayout, 0, 1, &diffuseTex.descriptorSet, 0, nullptr);
+      textureData.pkTextureIndex = diffuseTex.textureIndex;
     } else {
-      vkCmdBindDescriptorSets(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-        renderLayout, 0, 1, &mPlaceholderTexture.descriptorSet, 0, nullptr);
+      textureData.pkTextureIndex = mPlaceholderTexture.textureIndex;
     }
+    vkCmdPushConstants(commandBuffer, renderLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
+      static_cast<uint32_t>(sizeof(VkPushConstants)), static_cast<uint32_t>(sizeof(VkTexturePushConstants)), &textureData);
 
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(renderData.rdCommandBuffer, 0, 1, &mVertexBuffers.at(i).buffer, &offset);
-    vkCmdBindIndexBuffer(renderData.rdCommandBuffer, mIndexBuffers.at(i).buffer, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(renderData.rdCommandBuffer, static_cast<uint32_t>(mesh.indices.size()), 1, 0, 0, 0);
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mVertexBuffers.at(i).buffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, mIndexBuffers.at(i).buffer, 0, VK_INDEX_TYPE_UINT32);
+    vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(mesh.indices.size()), 1, 0, 0, 0);
   }
 }
 
-void AssimpModel::drawInstanced(VkRenderData &renderData, uint32_t instanceCount, bool selectionModeActive) {
+void AssimpModel::drawInstanced(VkRenderData &renderData, VkCommandBuffer commandBuffer, uint32_t instanceCount,
+    bool selectionModeActive) {
   for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
-    drawInstanced(renderData, i, instanceCount, selectionModeActive, false);
+    drawInstanced(renderData, commandBuffer, i, instanceCount, selectionModeActive, false);
   }
 }
 
-void AssimpModel::drawInstancedNoMorphAnims(VkRenderData &renderData, uint32_t instanceCount, bool selectionModeActive) {
+void AssimpModel::drawInstancedNoMorphAnims(VkRenderData &renderData, VkCommandBuffer commandBuffer, uint32_t instanceCount,
+    bool selectionModeActive) {
   for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
     /* skip meshes with morph animations */
     if (!mModelMeshes.at(i).morphMeshes.empty()) {
       continue;
     }
-    drawInstanced(renderData, i, instanceCount, selectionModeActive, false);
+    drawInstanced(renderData, commandBuffer, i, instanceCount, selectionModeActive, false);
   }
 }
 
-void AssimpModel::drawInstancedMorphAnims(VkRenderData &renderData, uint32_t instanceCount, bool selectionModeActive) {
+void AssimpModel::drawInstancedMorphAnims(VkRenderData &renderData, VkCommandBuffer commandBuffer, uint32_t instanceCount,
+    bool selectionModeActive) {
   for (unsigned int i = 0; i < mModelMeshes.size(); ++i) {
     /* draw only meshes with morph animations */
     if (mModelMeshes.at(i).morphMeshes.empty()) {
       continue;
     }
-    drawInstanced(renderData, i, instanceCount, selectionModeActive, true);
+    drawInstanced(renderData, commandBuffer, i, instanceCount, selectionModeActive, true);
   }
 }
 
-void AssimpModel::drawInstanced(VkRenderData &renderData, int bufferIndex,
+void AssimpModel::drawInstanced(VkRenderData &renderData, VkCommandBuffer commandBuffer, int bufferIndex,
     uint32_t instanceCount, bool selectionModeActive, bool drawMorphMeshes) {
   VkMesh& mesh = mModelMeshes.at(bufferIndex);
   // find diffuse texture by name
@@ -664,28 +669,39 @@ void AssimpModel::drawInstanced(VkRenderData &renderData, int bufferIndex,
     }
   }
 
+  /* the global texture array is bound by the renderer, select the slot only */
+  VkTexturePushConstants textureData{};
   if (diffuseTex.image != VK_NULL_HANDLE) {
-    vkCmdBindDescriptorSets(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      renderLayout, 0, 1, &diffuseTex.descriptorSet, 0, nullptr);
+    textureData.pkTextureIndex = diffuseTex.textureIndex;
   } else {
-    vkCmdBindDescriptorSets(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      renderLayout, 0, 1, &mPlaceholderTexture.descriptorSet, 0, nullptr);
+    textureData.pkTextureIndex = mPlaceholderTexture.textureIndex;
   }
+  vkCmdPushConstants(commandBuffer, renderLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
+    static_cast<uint32_t>(sizeof(VkPushConstants)), static_cast<uint32_t>(sizeof(VkTexturePushConstants)), &textureData);
+
   if (drawMorphMeshes) {
-    vkCmdBindDescriptorSets(renderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
       renderLayout, 2, 1, &mMorphAnimPerModelDescriptorSet, 0, nullptr);
   }
 
   VkDeviceSize offset = 0;
-  vkCmdBindVertexBuffers(renderData.rdCommandBuffer, 0, 1, &mVertexBuffers.at(bufferIndex).buffer, &offset);
-  vkCmdBindIndexBuffer(renderData.rdCommandBuffer, mIndexBuffers.at(bufferIndex).buffer, 0, VK_INDEX_TYPE_UINT32);
-  vkCmdDrawIndexed(renderData.rdCommandBuffer, static_cast<uint32_t>(mesh.indices.size()), instanceCount, 0, 0, 0);
+  vkCmdBindVertexBuffers(commandBuffer, 0, 1, &mVertexBuffers.at(bufferIndex).buffer, &offset);
+  vkCmdBindIndexBuffer(commandBuffer, mIndexBuffers.at(bufferIndex).buffer, 0, VK_INDEX_TYPE_UINT32);
+  vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(mesh.indices.size()), instanceCount, 0, 0, 0);
 }
 
 unsigned int AssimpModel::getTriangleCount() {
   return mTriangleCount;
 }
 
+void AssimpModel::setUploadBatch(uint64_t batchId) {
+  mUploadBatch = batchId;
+}
+
+uint64_t AssimpModel::getUploadBatch() {
+  return mUploadBatch;
+}
+
 void AssimpModel::cleanup(VkRenderData &renderData) {
   vkFreeDescriptorSets(renderData.rdVkbDevice.device, renderData.rdDescriptorPool, 1, &mTransformPerModelDescriptorSet);
   vkFreeDescriptorSets(renderData.rdVkbDevice.device, renderData.rdDescriptorPool, 1, &mMatrixMultPerModelDescriptorSet);
@@ -27,12 +27,18 @@ class AssimpModel {
     bool loadModel(VkRenderData &renderData, std::string modelFilename, unsigned int extraImportFlags = 0);
     glm::mat4 getRootTranformationMatrix();
 
-    void draw(VkRenderData &renderData, bool selectionModeActive);
-    void drawInstanced(VkRenderData &renderData, uint32_t instanceCount, bool selectionModeActive);
-    void drawInstancedNoMorphAnims(VkRenderData &renderData, uint32_t instanceCount, bool selectionModeActive);
-    void drawInstancedMorphAnims(VkRenderData &renderData, uint32_t instanceCount, bool selectionModeActive);
+    void draw(VkRenderData &renderData, VkCommandBuffer commandBuffer, bool selectionModeActive);
+    void drawInstanced(VkRenderData &renderData, VkCommandBuffer commandBuffer, uint32_t instanceCount, bool selectionModeActive);
+    void drawInstancedNoMorphAnims(VkRenderData &renderData, VkCommandBuffer commandBuffer, uint32_t instanceCount,
+      bool selectionModeActive);
+    void drawInstancedMorphAnims(VkRenderData &renderData, VkCommandBuffer commandBuffer, uint32_t instanceCount,
+      bool selectionModeActive);
     unsigned int getTriangleCount();
 
+    /* vertex, index and texture data are uploaded in the background, see UploadManager */
+    void setUploadBatch(uint64_t batchId);
+    uint64_t getUploadBatch();
+
     std::string getModelFileName();
     std::string getModelFileNamePath();
 
@@ -85,12 +91,14 @@ class AssimpModel {
 private:
     void processNode(VkRenderData &renderData, std::shared_ptr<AssimpNode> node, aiNode* aNode, const aiScene* scene, std::string assetDirectory);
     void createNodeList(std::shared_ptr<AssimpNode> node, std::shared_ptr<AssimpNode> newNode, std::vector<std::shared_ptr<AssimpNode>> &list);
-    void drawInstanced(VkRenderData &renderData, int bufferIndex, uint32_t instanceCount, bool selectionModeActive, bool drawMorphMeshes);
+    void drawInstanced(VkRenderData &renderData, VkCommandBuffer commandBuffer, int bufferIndex, uint32_t instanceCount,
+      bool selectionModeActive, bool drawMorphMeshes);
 
     bool createDescriptorSet(VkRenderData &renderData);
 
     unsigned int mTriangleCount = 0;
     unsigned int mVertexCount = 0;
+    uint64_t mUploadBatch = 0;
 
     float mMaxClipDuration = 0.0f;
 
@@ -1,11 +1,17 @@
 #version 460 core
+#extension GL_EXT_nonuniform_qualifier : require
 layout (location = 0) in vec4 color;
 layout (location = 1) in vec4 normal;
 layout (location = 2) in vec2 texCoord;
 
 layout (location = 0) out vec4 FragColor;
 
-layout (set = 0, binding = 0) uniform sampler2D tex;
+/* global texture array, the slot is pushed per mesh after the vertex push constants */
+layout (set = 0, binding = 0) uniform sampler2D textures[];
+
+layout (push_constant) uniform TextureIndex {
+  layout (offset = 12) uint textureIndex;
+};
 
 layout (std140, set = 1, binding = 0) uniform Matrices {
   mat4 view;
@@ -29,5 +35,5 @@ void main() {
   float fogAmount = 1.0 - clamp(exp(-pow(fogDensity * fogDistance, 2.0)), 0.0, 1.0);
   vec4 fogColor = 0.25 * vec4(vec3(lightColor), 1.0);
 
-  FragColor = mix(vec4(min(ambient + diffuse, vec3(1.0)), 1.0) * texture(tex, texCoord) * color, fogColor * color, fogAmount);
+  FragColor = mix(vec4(min(ambient + diffuse, vec3(1.0)), 1.0) * texture(textures[textureIndex], texCoord) * color, fogColor * color, fogAmount);
 }
@@ -0,0 +1,48 @@
+/* simple thread pool, runs jobs on a fixed number of worker threads */
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <type_traits>
+
+class ThreadPool {
+  public:
+    /* zero threads means one thread per hardware thread, minus the main thread */
+    explicit ThreadPool(unsigned int numThreads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    template <typename F>
+    std::future<std::invoke_result_t<F>> submit(F&& job) {
+      using ResultType = std::invoke_result_t<F>;
+
+      /* std::function needs a copyable target, packaged_task is move-only */
+      auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(job));
+      std::future<ResultType> result = task->get_future();
+      {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mJobs.emplace([task]() { (*task)(); });
+      }
+      mCondition.notify_one();
+      return result;
+    }
+
+    unsigned int getNumThreads();
+
+  private:
+    void workerLoop();
+
+    std::vector<std::thread> mThreads{};
+    std::queue<std::function<void()>> mJobs{};
+    std::mutex mMutex;
+    std::condition_variable mCondition;
+    bool mShutdown = false;
+};
@@ -2,11 +2,12 @@
 #include <Logger.h>
 #include <VkBootstrap.h>
 
-bool CommandBuffer::init(VkRenderData renderData, VkCommandPool pool, VkCommandBuffer& commandBuffer) {
+bool CommandBuffer::init(VkRenderData renderData, VkCommandPool pool, VkCommandBuffer& commandBuffer,
+    VkCommandBufferLevel level) {
   VkCommandBufferAllocateInfo allocInfo{};
   allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
   allocInfo.commandPool = pool;
-  allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+  allocInfo.level = level;
   allocInfo.commandBufferCount = 1;
 
   VkResult result = vkAllocateCommandBuffers(renderData.rdVkbDevice.device, &allocInfo, &commandBuffer);
@@ -49,6 +50,26 @@ bool CommandBuffer::beginSingleShot(VkCommandBuffer& commandBuffer) {
   return true;
 }
 
+bool CommandBuffer::beginSecondary(VkCommandBuffer& commandBuffer, VkRenderPass renderPass, VkFramebuffer framebuffer) {
+  VkCommandBufferInheritanceInfo inheritanceInfo{};
+  inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+  inheritanceInfo.renderPass = renderPass;
+  inheritanceInfo.subpass = 0;
+  inheritanceInfo.framebuffer = framebuffer;
+
+  VkCommandBufferBeginInfo cmdBeginInfo{};
+  cmdBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  cmdBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+  cmdBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+  VkResult result = vkBeginCommandBuffer(commandBuffer, &cmdBeginInfo);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not begin secondary command buffer (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+  return true;
+}
+
 bool CommandBuffer::end(VkCommandBuffer& commandBuffer) {
   VkResult result = vkEndCommandBuffer(commandBuffer);
   if (result != VK_SUCCESS) {
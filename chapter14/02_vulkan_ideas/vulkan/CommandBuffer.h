@@ -5,11 +5,14 @@
 
 class CommandBuffer {
   public:
-    static bool init(VkRenderData renderData, VkCommandPool pool, VkCommandBuffer &commandBuffer);
+    static bool init(VkRenderData renderData, VkCommandPool pool, VkCommandBuffer &commandBuffer,
+      VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
     static bool reset(VkCommandBuffer &commandBuffer, VkCommandBufferResetFlags flags = 0);
     static bool begin(VkCommandBuffer &commandBuffer, VkCommandBufferBeginInfo &beginInfo);
     static bool beginSingleShot(VkCommandBuffer &commandBuffer);
+    /* secondary buffer, executed inside the given render pass */
+    static bool beginSecondary(VkCommandBuffer &commandBuffer, VkRenderPass renderPass, VkFramebuffer framebuffer);
     static bool end(VkCommandBuffer &commandBuffer);
 
     static VkCommandBuffer createSingleShotBuffer(VkRenderData renderData, VkCommandPool pool);
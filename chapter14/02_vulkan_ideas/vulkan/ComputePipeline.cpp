@@ -26,7 +26,7 @@ bool ComputePipeline::init(VkRenderData& renderData, VkPipelineLayout& pipelineL
   pipelineCreateInfo.layout = pipelineLayout;
   pipelineCreateInfo.stage = computeStageInfo;
 
-  VkResult result = vkCreateComputePipelines(renderData.rdVkbDevice.device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &pipeline);
+  VkResult result = vkCreateComputePipelines(renderData.rdVkbDevice.device, renderData.rdPipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline);
   if (result != VK_SUCCESS) {
     Logger::log(1, "%s error: could not create compute pipeline (error: %i)\n", __FUNCTION__, result);
     Shader::cleanup(renderData.rdVkbDevice.device, computeModule);
@@ -0,0 +1,46 @@
+#include "DescriptorCache.h"
+
+void DescriptorCache::updateDescriptorSets(VkRenderData &renderData, std::vector<VkWriteDescriptorSet> &writeDescriptorSets) {
+  std::vector<VkWriteDescriptorSet> changedWrites{};
+
+  for (const auto& write : writeDescriptorSets) {
+    /* images and arrays are written as before */
+    if (write.pBufferInfo == nullptr || write.descriptorCount != 1) {
+      changedWrites.emplace_back(write);
+      continue;
+    }
+
+    std::pair<VkDescriptorSet, uint32_t> binding = std::make_pair(write.dstSet, write.dstBinding);
+    auto cachedBinding = renderData.rdDescriptorBufferCache.find(binding);
+    if (cachedBinding != renderData.rdDescriptorBufferCache.end() && cachedBinding->second == write.pBufferInfo->buffer) {
+      ++renderData.rdDescriptorWritesSkipped;
+      continue;
+    }
+
+    renderData.rdDescriptorBufferCache[binding] = write.pBufferInfo->buffer;
+    changedWrites.emplace_back(write);
+  }
+
+  if (changedWrites.empty()) {
+    return;
+  }
+
+  renderData.rdDescriptorWrites += static_cast<unsigned int>(changedWrites.size());
+  vkUpdateDescriptorSets(renderData.rdVkbDevice.device, static_cast<uint32_t>(changedWrites.size()),
+    changedWrites.data(), 0, nullptr);
+}
+
+void DescriptorCache::removeBuffer(VkRenderData &renderData, VkBuffer buffer) {
+  /* the driver may hand out the same handle for the next buffer */
+  for (auto iter = renderData.rdDescriptorBufferCache.begin(); iter != renderData.rdDescriptorBufferCache.end(); ) {
+    if (iter->second == buffer) {
+      iter = renderData.rdDescriptorBufferCache.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+void DescriptorCache::cleanup(VkRenderData &renderData) {
+  renderData.rdDescriptorBufferCache.clear();
+}
@@ -0,0 +1,17 @@
+/* Vulkan descriptor write cache, only changed buffer bindings are written */
+#pragma once
+
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class DescriptorCache {
+  public:
+    /* drops all buffer writes whose binding already points to the same buffer */
+    static void updateDescriptorSets(VkRenderData &renderData, std::vector<VkWriteDescriptorSet> &writeDescriptorSets);
+    /* forget all bindings of a buffer that is about to be destroyed */
+    static void removeBuffer(VkRenderData &renderData, VkBuffer buffer);
+
+    static void cleanup(VkRenderData &renderData);
+};
@@ -218,3 +218,19 @@ inline timeOfDay operator+(timeOfDay A, int num) {
   A = static_cast<timeOfDay>(n);
   return A;
 }
+
+/* GPU timed sections of a frame */
+enum class gpuPass : uint8_t {
+  level = 0,
+  transformCompute,
+  matrixCompute,
+  sphereTransformCompute,
+  sphereMatrixCompute,
+  boundingSphereCompute,
+  ikCompute,
+  models,
+  selection,
+  debugLines,
+  ui,
+  NUM
+};
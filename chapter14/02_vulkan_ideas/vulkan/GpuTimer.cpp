@@ -0,0 +1,160 @@
+#include <algorithm>
+
+#include "GpuTimer.h"
+#include "Logger.h"
+
+bool GpuTimer::init(VkRenderData &renderData) {
+  mOpenIntervals.fill(-1);
+  mPassTimes.fill(0.0f);
+
+  /* graphics and compute passes are timed, both queues must write timestamps */
+  std::vector<VkQueueFamilyProperties> queueFamilies = renderData.rdVkbPhysicalDevice.get_queue_families();
+  uint32_t computeQueueFamily = renderData.rdGraphicsQueueFamily;
+  auto computeQueueIndexRet = renderData.rdVkbDevice.get_queue_index(vkb::QueueType::compute);
+  if (computeQueueIndexRet.has_value()) {
+    computeQueueFamily = computeQueueIndexRet.value();
+  }
+
+  uint32_t validBits = std::min(queueFamilies.at(renderData.rdGraphicsQueueFamily).timestampValidBits,
+    queueFamilies.at(computeQueueFamily).timestampValidBits);
+  mTimestampPeriod = renderData.rdVkbPhysicalDevice.properties.limits.timestampPeriod;
+  if (validBits == 0 || mTimestampPeriod == 0.0f) {
+    Logger::log(1, "%s error: timestamp queries not supported\n", __FUNCTION__);
+    return false;
+  }
+  mTimestampMask = validBits >= 64 ? UINT64_MAX : (uint64_t(1) << validBits) - 1;
+
+  mFrames.resize(renderData.rdFramesInFlight);
+  for (auto& frame : mFrames) {
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = MAX_INTERVALS * 2;
+
+    VkResult result = vkCreateQueryPool(renderData.rdVkbDevice.device, &queryPoolInfo, nullptr, &frame.gtfQueryPool);
+    if (result != VK_SUCCESS) {
+      Logger::log(1, "%s error: could not create timestamp query pool (error: %i)\n", __FUNCTION__, result);
+      return false;
+    }
+    frame.gtfIntervalPasses.resize(MAX_INTERVALS);
+    frame.gtfUsedIntervals = 0;
+  }
+  mAvailable = true;
+
+  Logger::log(1, "%s: GPU timer with %i bit timestamps initialized\n", __FUNCTION__, validBits);
+  return true;
+}
+
+void GpuTimer::start(VkRenderData &renderData, VkCommandBuffer &commandBuffer, gpuPass pass) {
+  /* the query pool of the current frame may still be in use by the GPU outside of the frame */
+  if (!mAvailable || !mFrameActive) {
+    return;
+  }
+
+  unsigned int passIndex = static_cast<unsigned int>(pass);
+  if (mOpenIntervals.at(passIndex) != -1) {
+    Logger::log(1, "%s error: GPU timer for pass %i already running\n", __FUNCTION__, passIndex);
+    return;
+  }
+
+  GpuTimerFrame& frame = mFrames.at(renderData.rdCurrentFrame);
+  /* the pool has a fixed size, silently drop the intervals that do not fit */
+  if (frame.gtfUsedIntervals == MAX_INTERVALS) {
+    return;
+  }
+  unsigned int interval = frame.gtfUsedIntervals++;
+
+  frame.gtfIntervalPasses.at(interval) = pass;
+  mOpenIntervals.at(passIndex) = interval;
+
+  /* queries must be reset before every use, the reset is recorded in the same command buffer */
+  vkCmdResetQueryPool(commandBuffer, frame.gtfQueryPool, interval * 2, 2);
+  vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frame.gtfQueryPool, interval * 2);
+}
+
+void GpuTimer::stop(VkRenderData &renderData, VkCommandBuffer &commandBuffer, gpuPass pass) {
+  if (!mAvailable) {
+    return;
+  }
+
+  unsigned int passIndex = static_cast<unsigned int>(pass);
+  int interval = mOpenIntervals.at(passIndex);
+  if (interval == -1) {
+    return;
+  }
+
+  vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+    mFrames.at(renderData.rdCurrentFrame).gtfQueryPool, interval * 2 + 1);
+  mOpenIntervals.at(passIndex) = -1;
+}
+
+bool GpuTimer::collectFrame(VkRenderData &renderData, GpuTimerFrame& frame) {
+  /* value and availability for every query, an interval whose command buffer was not submitted stays unavailable */
+  std::vector<uint64_t> queryResults(frame.gtfUsedIntervals * 2 * 2);
+  VkResult result = vkGetQueryPoolResults(renderData.rdVkbDevice.device, frame.gtfQueryPool, 0, frame.gtfUsedIntervals * 2,
+    queryResults.size() * sizeof(uint64_t), queryResults.data(), 2 * sizeof(uint64_t),
+    VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+  if (result != VK_SUCCESS && result != VK_NOT_READY) {
+    Logger::log(1, "%s error: could not get timestamp query results (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+
+  for (unsigned int i = 0; i < frame.gtfUsedIntervals * 2; ++i) {
+    if (queryResults.at(i * 2 + 1) == 0) {
+      return false;
+    }
+  }
+
+  mPassTimes.fill(0.0f);
+  for (unsigned int i = 0; i < frame.gtfUsedIntervals; ++i) {
+    uint64_t startTime = queryResults.at(i * 4);
+    uint64_t stopTime = queryResults.at(i * 4 + 2);
+    uint64_t ticks = (stopTime - startTime) & mTimestampMask;
+
+    mPassTimes.at(static_cast<unsigned int>(frame.gtfIntervalPasses.at(i))) += ticks * mTimestampPeriod / 1000000.0f;
+  }
+
+  return true;
+}
+
+void GpuTimer::beginFrame(VkRenderData &renderData) {
+  if (!mAvailable) {
+    return;
+  }
+
+  for (unsigned int i = 0; i < NUM_PASSES; ++i) {
+    if (mOpenIntervals.at(i) != -1) {
+      Logger::log(1, "%s error: GPU timer for pass %i still running at frame start\n", __FUNCTION__, i);
+      mOpenIntervals.at(i) = -1;
+    }
+  }
+
+  GpuTimerFrame& frame = mFrames.at(renderData.rdCurrentFrame);
+  if (frame.gtfUsedIntervals > 0 && !collectFrame(renderData, frame)) {
+    /* keep the older times */
+    ++mSkippedFrames;
+  }
+  frame.gtfUsedIntervals = 0;
+  mFrameActive = true;
+}
+
+void GpuTimer::endFrame() {
+  mFrameActive = false;
+}
+
+float GpuTimer::getPassTime(gpuPass pass) {
+  return mPassTimes.at(static_cast<unsigned int>(pass));
+}
+
+unsigned int GpuTimer::getSkippedFrames() {
+  return mSkippedFrames;
+}
+
+void GpuTimer::cleanup(VkRenderData &renderData) {
+  for (auto& frame : mFrames) {
+    vkDestroyQueryPool(renderData.rdVkbDevice.device, frame.gtfQueryPool, nullptr);
+  }
+  mFrames.clear();
+  mAvailable = false;
+  mFrameActive = false;
+}
@@ -0,0 +1,53 @@
+/* GPU pass timing with timestamp queries, results are read when the frame in flight is used again */
+#pragma once
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+#include "Enums.h"
+
+class GpuTimer {
+  public:
+    bool init(VkRenderData &renderData);
+
+    /* a pass can be started and stopped several times per frame, the times add up.
+     * must be recorded outside of a render pass, ignored outside of beginFrame()/endFrame() */
+    void start(VkRenderData &renderData, VkCommandBuffer &commandBuffer, gpuPass pass);
+    void stop(VkRenderData &renderData, VkCommandBuffer &commandBuffer, gpuPass pass);
+    /* collects the current frame in flight, the fences of the frame must have been waited for */
+    void beginFrame(VkRenderData &renderData);
+    /* the frame has been submitted, commands recorded outside the frame (e.g. model loading) are not timed */
+    void endFrame();
+
+    /* milliseconds of the last finished frame */
+    float getPassTime(gpuPass pass);
+    unsigned int getSkippedFrames();
+
+    void cleanup(VkRenderData &renderData);
+
+  private:
+    struct GpuTimerFrame {
+      /* two timestamps per interval */
+      VkQueryPool gtfQueryPool = VK_NULL_HANDLE;
+      std::vector<gpuPass> gtfIntervalPasses{};
+      unsigned int gtfUsedIntervals = 0;
+    };
+
+    static constexpr unsigned int MAX_INTERVALS = 1024;
+    static constexpr unsigned int NUM_PASSES = static_cast<unsigned int>(gpuPass::NUM);
+
+    bool collectFrame(VkRenderData &renderData, GpuTimerFrame& frame);
+
+    std::vector<GpuTimerFrame> mFrames{};
+
+    std::array<int, NUM_PASSES> mOpenIntervals{};
+    std::array<float, NUM_PASSES> mPassTimes{};
+    unsigned int mSkippedFrames = 0;
+    bool mFrameActive = false;
+
+    uint64_t mTimestampMask = 0;
+    float mTimestampPeriod = 0.0f;
+    bool mAvailable = false;
+};
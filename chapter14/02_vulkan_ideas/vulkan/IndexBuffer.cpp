@@ -1,7 +1,6 @@
-#include <cstring>
-
 #include "IndexBuffer.h"
-#include "CommandBuffer.h"
+#include "StagingBuffer.h"
+#include "UploadManager.h"
 #include "Logger.h"
 
 bool IndexBuffer::init(VkRenderData &renderData, VkIndexBufferData &bufferData,
@@ -23,21 +22,6 @@ bool IndexBuffer::init(VkRenderData &renderData, VkIndexBufferData &bufferData,
     return false;
   }
 
-  /* staging buffer for copy */
-  VkBufferCreateInfo stagingBufferInfo{};
-  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  stagingBufferInfo.size = bufferSize;;
-  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-  VmaAllocationCreateInfo stagingAllocInfo{};
-  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-  result = vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo,
-      &bufferData.stagingBuffer, &bufferData.stagingBufferAlloc, nullptr);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate index staging buffer via VMA (error: %i)\n", __FUNCTION__, result);
-    return false;
-  }
   bufferData.bufferSize = bufferSize;
   return true;
 }
@@ -56,50 +40,17 @@ bool IndexBuffer::uploadData(VkRenderData& renderData, VkIndexBufferData& buffer
     bufferData.bufferSize = indexDataSize;
   }
 
-  /* copy data to staging buffer */
-  void* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, bufferData.stagingBufferAlloc, &data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map index buffer memory (error: %i)\n", __FUNCTION__, result);
-    return false;
-  }
-  std::memcpy(data, vertexData.indices.data(), indexDataSize);
-  vmaUnmapMemory(renderData.rdAllocator, bufferData.stagingBufferAlloc);
-  vmaFlushAllocation(renderData.rdAllocator, bufferData.stagingBufferAlloc, 0, indexDataSize);
-
-  VkBufferMemoryBarrier indexBufferBarrier{};
-  indexBufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-  indexBufferBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
-  indexBufferBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-  indexBufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  indexBufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  indexBufferBarrier.buffer = bufferData.stagingBuffer;
-  indexBufferBarrier.offset = 0;
-  indexBufferBarrier.size = bufferData.bufferSize;
-
-  VkBufferCopy stagingBufferCopy{};
-  stagingBufferCopy.srcOffset = 0;
-  stagingBufferCopy.dstOffset = 0;
-  stagingBufferCopy.size = bufferData.bufferSize;
-
-  /* trigger data transfer via command buffer */
-  VkCommandBuffer commandBuffer = CommandBuffer::createSingleShotBuffer(renderData, renderData.rdCommandPool);
-
-  vkCmdCopyBuffer(commandBuffer, bufferData.stagingBuffer,
-                  bufferData.buffer, 1, &stagingBufferCopy);
-  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                       VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1, &indexBufferBarrier, 0, nullptr);
-
-  if (!CommandBuffer::submitSingleShotBuffer(renderData, renderData.rdCommandPool, commandBuffer, renderData.rdGraphicsQueue)) {
-    return false;
+  /* model and level meshes are copied in the background while a batch is open */
+  if (UploadManager::isBatchActive(renderData)) {
+    return UploadManager::uploadBuffer(renderData, bufferData.buffer, vertexData.indices.data(), indexDataSize);
   }
 
-  return true;
+  /* copy via the staging ring, submitted with the frame */
+  return StagingBuffer::upload(renderData, bufferData.buffer, vertexData.indices.data(), indexDataSize);
 }
 
 void IndexBuffer::cleanup(VkRenderData &renderData, VkIndexBufferData &bufferData) {
-  vmaDestroyBuffer(renderData.rdAllocator, bufferData.stagingBuffer,
-    bufferData.stagingBufferAlloc);
+  StagingBuffer::removePendingCopies(renderData, bufferData.buffer);
   vmaDestroyBuffer(renderData.rdAllocator, bufferData.buffer,
     bufferData.bufferAlloc);
 }
@@ -0,0 +1,118 @@
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+#include "PipelineCache.h"
+#include "Logger.h"
+
+bool PipelineCache::isCacheDataValid(VkRenderData &renderData, const std::vector<char>& cacheData) {
+  if (cacheData.size() < sizeof(VkPipelineCacheHeaderVersionOne)) {
+    Logger::log(1, "%s: pipeline cache data too small (%i bytes)\n", __FUNCTION__, cacheData.size());
+    return false;
+  }
+
+  VkPipelineCacheHeaderVersionOne cacheHeader{};
+  std::memcpy(&cacheHeader, cacheData.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+
+  /* data from another driver or GPU would be rejected (or worse) by the driver */
+  const VkPhysicalDeviceProperties& props = renderData.rdVkbPhysicalDevice.properties;
+  if (cacheHeader.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE ||
+      cacheHeader.vendorID != props.vendorID ||
+      cacheHeader.deviceID != props.deviceID ||
+      std::memcmp(cacheHeader.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+    Logger::log(1, "%s: pipeline cache was created by a different device or driver\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+bool PipelineCache::init(VkRenderData &renderData, std::string cacheFileName) {
+  std::vector<char> cacheData{};
+
+  std::ifstream inFile(cacheFileName, std::ios::binary | std::ios::ate);
+  if (inFile.is_open()) {
+    size_t fileSize = static_cast<size_t>(inFile.tellg());
+    inFile.seekg(0, std::ios::beg);
+
+    CacheFileHeader fileHeader{};
+    if (fileSize > sizeof(CacheFileHeader) && inFile.read(reinterpret_cast<char*>(&fileHeader), sizeof(CacheFileHeader)) &&
+        fileHeader.magic == mCacheFileMagic && fileHeader.version == mCacheFileVersion) {
+      cacheData.resize(fileSize - sizeof(CacheFileHeader));
+      if (!inFile.read(cacheData.data(), cacheData.size()) || !isCacheDataValid(renderData, cacheData)) {
+        cacheData.clear();
+      } else {
+        renderData.rdPipelineUncachedCreateTime = fileHeader.uncachedCreateTime;
+      }
+    } else {
+      Logger::log(1, "%s: ignoring pipeline cache file '%s' with unknown format\n", __FUNCTION__, cacheFileName.c_str());
+    }
+    inFile.close();
+  } else {
+    Logger::log(1, "%s: no pipeline cache file '%s' found, pipelines will be compiled\n", __FUNCTION__, cacheFileName.c_str());
+  }
+
+  VkPipelineCacheCreateInfo cacheInfo{};
+  cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  cacheInfo.initialDataSize = cacheData.size();
+  cacheInfo.pInitialData = cacheData.empty() ? nullptr : cacheData.data();
+
+  VkResult result = vkCreatePipelineCache(renderData.rdVkbDevice.device, &cacheInfo, nullptr, &renderData.rdPipelineCache);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create pipeline cache (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+
+  renderData.rdPipelineCacheLoaded = !cacheData.empty();
+  if (renderData.rdPipelineCacheLoaded) {
+    Logger::log(1, "%s: loaded %i bytes of pipeline cache data from '%s'\n", __FUNCTION__, cacheData.size(), cacheFileName.c_str());
+  }
+  return true;
+}
+
+bool PipelineCache::save(VkRenderData &renderData, std::string cacheFileName) {
+  if (renderData.rdPipelineCache == VK_NULL_HANDLE) {
+    return false;
+  }
+
+  size_t dataSize = 0;
+  VkResult result = vkGetPipelineCacheData(renderData.rdVkbDevice.device, renderData.rdPipelineCache, &dataSize, nullptr);
+  if (result != VK_SUCCESS || dataSize == 0) {
+    Logger::log(1, "%s error: could not get pipeline cache size (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+
+  std::vector<char> cacheData(dataSize);
+  result = vkGetPipelineCacheData(renderData.rdVkbDevice.device, renderData.rdPipelineCache, &dataSize, cacheData.data());
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not get pipeline cache data (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+
+  CacheFileHeader fileHeader{};
+  fileHeader.magic = mCacheFileMagic;
+  fileHeader.version = mCacheFileVersion;
+  fileHeader.uncachedCreateTime = renderData.rdPipelineUncachedCreateTime;
+
+  std::ofstream outFile(cacheFileName, std::ios::binary | std::ios::trunc);
+  if (!outFile.is_open()) {
+    Logger::log(1, "%s error: could not open pipeline cache file '%s' for writing\n", __FUNCTION__, cacheFileName.c_str());
+    return false;
+  }
+
+  outFile.write(reinterpret_cast<const char*>(&fileHeader), sizeof(CacheFileHeader));
+  outFile.write(cacheData.data(), dataSize);
+  outFile.close();
+
+  if (outFile.fail()) {
+    Logger::log(1, "%s error: could not write pipeline cache file '%s'\n", __FUNCTION__, cacheFileName.c_str());
+    return false;
+  }
+
+  Logger::log(1, "%s: saved %i bytes of pipeline cache data to '%s'\n", __FUNCTION__, dataSize, cacheFileName.c_str());
+  return true;
+}
+
+void PipelineCache::cleanup(VkRenderData &renderData) {
+  vkDestroyPipelineCache(renderData.rdVkbDevice.device, renderData.rdPipelineCache, nullptr);
+  renderData.rdPipelineCache = VK_NULL_HANDLE;
+}
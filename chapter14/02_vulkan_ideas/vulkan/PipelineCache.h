@@ -0,0 +1,28 @@
+/* Vulkan pipeline cache, stored on disk between runs */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class PipelineCache {
+  public:
+    static bool init(VkRenderData &renderData, std::string cacheFileName);
+    static bool save(VkRenderData &renderData, std::string cacheFileName);
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static bool isCacheDataValid(VkRenderData &renderData, const std::vector<char>& cacheData);
+
+    /* own file header in front of the driver data */
+    static const uint32_t mCacheFileMagic = 0x43504b56; // "VKPC"
+    static const uint32_t mCacheFileVersion = 1;
+    struct CacheFileHeader {
+      uint32_t magic;
+      uint32_t version;
+      /* pipeline creation time of the last run without a valid cache */
+      float uncachedCreateTime;
+    };
+};
@@ -1,5 +1,7 @@
+#include <cstring>
+#include <algorithm>
+
 #include "SelectionFramebuffer.h"
-#include "CommandBuffer.h"
 #include "Logger.h"
 
 bool SelectionFramebuffer::init(VkRenderData &renderData) {
@@ -27,39 +29,37 @@ bool SelectionFramebuffer::init(VkRenderData &renderData) {
   return true;
 }
 
-float SelectionFramebuffer::getPixelValueFromPos(VkRenderData& renderData, unsigned int xPos, unsigned int yPos) {
-  /* random default value to detect errors */
-  float pixelColor = -444.0f;
-
-  VkImage readbackImage;
-  VmaAllocation readbackImageAlloc;
-
-  /* create local image */
-  VkImageCreateInfo imageInfo{};
-  imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-  imageInfo.imageType = VK_IMAGE_TYPE_2D;
-  imageInfo.extent.width = renderData.rdVkbSwapchain.extent.width;
-  imageInfo.extent.height = renderData.rdVkbSwapchain.extent.height;
-  imageInfo.extent.depth = 1;
-  imageInfo.mipLevels = 1;
-  imageInfo.arrayLayers = 1;
-  imageInfo.format = VK_FORMAT_R32_SFLOAT;
-  imageInfo.tiling = VK_IMAGE_TILING_LINEAR;
-  imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-  imageInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-  imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-
-  VmaAllocationCreateInfo imageAllocInfo{};
-  imageAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-  imageAllocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-
-  VkResult result = vmaCreateImage(renderData.rdAllocator, &imageInfo, &imageAllocInfo, &readbackImage,  &readbackImageAlloc, nullptr);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate read back image image via VMA (error: %i)\n", __FUNCTION__, result);
-    return pixelColor;
+bool SelectionFramebuffer::initReadbackBuffers(VkRenderData &renderData) {
+  for (auto& frameData : renderData.rdPerFrameData) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = sizeof(float);
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+    VmaAllocationCreateInfo vmaAllocInfo{};
+    vmaAllocInfo.usage = VMA_MEMORY_USAGE_GPU_TO_CPU;
+    vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+    VmaAllocationInfo allocInfo{};
+    VkResult result = vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo,
+      &frameData.pfSelectionReadback.buffer, &frameData.pfSelectionReadback.bufferAlloc, &allocInfo);
+    if (result != VK_SUCCESS) {
+      Logger::log(1, "%s error: could not allocate selection readback buffer via VMA (error: %i)\n", __FUNCTION__, result);
+      return false;
+    }
+
+    frameData.pfSelectionReadback.mappedData = allocInfo.pMappedData;
+    frameData.pfSelectionReadback.pending = false;
   }
+  return true;
+}
 
-  VkCommandBuffer readbackCommandBuffer = CommandBuffer::createSingleShotBuffer(renderData, renderData.rdCommandPool);
+void SelectionFramebuffer::recordPixelReadback(VkRenderData &renderData, VkCommandBuffer &commandBuffer, int xPos, int yPos) {
+  VkReadbackBufferData& readback = renderData.rdPerFrameData.at(renderData.rdCurrentFrame).pfSelectionReadback;
+
+  /* mouse may be released outside of the window */
+  xPos = std::clamp(xPos, 0, static_cast<int>(renderData.rdVkbSwapchain.extent.width) - 1);
+  yPos = std::clamp(yPos, 0, static_cast<int>(renderData.rdVkbSwapchain.extent.height) - 1);
 
   VkImageSubresourceRange layoutTransferRange{};
   layoutTransferRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -68,87 +68,80 @@ float SelectionFramebuffer::getPixelValueFromPos(VkRenderData& renderData, unsig
   layoutTransferRange.baseArrayLayer = 0;
   layoutTransferRange.layerCount = 1;
 
-  /* transition destination (local) image to transfer destination layout */
-  VkImageMemoryBarrier layoutTransferBarrier{};
-  layoutTransferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  layoutTransferBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-  layoutTransferBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  layoutTransferBarrier.image = readbackImage;
-  layoutTransferBarrier.subresourceRange = layoutTransferRange;
-  layoutTransferBarrier.srcAccessMask = 0;
-  layoutTransferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-  /* transition source (selection) image to transfer source optimal layout */
+  /* transition selection image to transfer source optimal layout after the selection render pass */
   VkImageMemoryBarrier srcLayoutTransferBarrier{};
   srcLayoutTransferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
   srcLayoutTransferBarrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
   srcLayoutTransferBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+  srcLayoutTransferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  srcLayoutTransferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
   srcLayoutTransferBarrier.image = renderData.rdSelectionImage;
   srcLayoutTransferBarrier.subresourceRange = layoutTransferRange;
-  srcLayoutTransferBarrier.srcAccessMask = 0;
-  srcLayoutTransferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-  /* copy selection image to local image */
-  VkImageCopy imageCopyRegion{};
-  imageCopyRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  imageCopyRegion.srcSubresource.layerCount = 1;
-  imageCopyRegion.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  imageCopyRegion.dstSubresource.layerCount = 1;
-  imageCopyRegion.extent.width = renderData.rdVkbSwapchain.extent.width;
-  imageCopyRegion.extent.height = renderData.rdVkbSwapchain.extent.height;
-  imageCopyRegion.extent.depth = 1;
-
-  /* transition destination (local) image to general layout to allow mapping */
-  VkImageMemoryBarrier destLayoutTransferBarrier{};
-  destLayoutTransferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  destLayoutTransferBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  destLayoutTransferBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
-  destLayoutTransferBarrier.image = readbackImage;
-  destLayoutTransferBarrier.subresourceRange = layoutTransferRange;
-  destLayoutTransferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-  destLayoutTransferBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
-
-  vkCmdPipelineBarrier(readbackCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-    0, 0, nullptr, 0, nullptr, 1, &layoutTransferBarrier);
-  vkCmdPipelineBarrier(readbackCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+  srcLayoutTransferBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+  srcLayoutTransferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
     0, 0, nullptr, 0, nullptr, 1, &srcLayoutTransferBarrier);
-  vkCmdCopyImage(readbackCommandBuffer, renderData.rdSelectionImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-    readbackImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageCopyRegion);
-  vkCmdPipelineBarrier(readbackCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
-    0, 0, nullptr, 0, nullptr, 1, &destLayoutTransferBarrier);
 
-  bool commandResult = CommandBuffer::submitSingleShotBuffer(renderData, renderData.rdCommandPool,
-    readbackCommandBuffer, renderData.rdGraphicsQueue);
+  /* copy only the pixel below the mouse */
+  VkBufferImageCopy pixelCopyRegion{};
+  pixelCopyRegion.bufferOffset = 0;
+  pixelCopyRegion.bufferRowLength = 0;
+  pixelCopyRegion.bufferImageHeight = 0;
+  pixelCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  pixelCopyRegion.imageSubresource.mipLevel = 0;
+  pixelCopyRegion.imageSubresource.baseArrayLayer = 0;
+  pixelCopyRegion.imageSubresource.layerCount = 1;
+  pixelCopyRegion.imageOffset = { xPos, yPos, 0 };
+  pixelCopyRegion.imageExtent = { 1, 1, 1 };
+
+  vkCmdCopyImageToBuffer(commandBuffer, renderData.rdSelectionImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+    readback.buffer, 1, &pixelCopyRegion);
+
+  /* make the copy visible on the host and give the image back to the render pass */
+  VkBufferMemoryBarrier hostReadBarrier{};
+  hostReadBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+  hostReadBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  hostReadBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+  hostReadBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  hostReadBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  hostReadBarrier.buffer = readback.buffer;
+  hostReadBarrier.offset = 0;
+  hostReadBarrier.size = VK_WHOLE_SIZE;
+
+  VkImageMemoryBarrier dstLayoutTransferBarrier = srcLayoutTransferBarrier;
+  dstLayoutTransferBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+  dstLayoutTransferBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+  dstLayoutTransferBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  dstLayoutTransferBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+    0, 0, nullptr, 1, &hostReadBarrier, 0, nullptr);
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+    0, 0, nullptr, 0, nullptr, 1, &dstLayoutTransferBarrier);
+
+  readback.pending = true;
+}
 
-  if (!commandResult) {
-    Logger::log(1, "%s error: could not submit readback transfer commands\n", __FUNCTION__);
-    return pixelColor;
+bool SelectionFramebuffer::getReadbackPixelValue(VkRenderData &renderData, float &pixelValue) {
+  VkReadbackBufferData& readback = renderData.rdPerFrameData.at(renderData.rdCurrentFrame).pfSelectionReadback;
+  if (!readback.pending) {
+    return false;
   }
 
-  /* get image layout */
-  VkImageSubresource subResource{};
-  subResource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  VkSubresourceLayout subResourceLayout{};
+  /* the render fence of the frame has been waited for, the copy is done */
+  vmaInvalidateAllocation(renderData.rdAllocator, readback.bufferAlloc, 0, VK_WHOLE_SIZE);
+  std::memcpy(&pixelValue, readback.mappedData, sizeof(float));
+  readback.pending = false;
 
-  vkGetImageSubresourceLayout(renderData.rdVkbDevice.device, readbackImage, &subResource, &subResourceLayout);
+  return true;
+}
 
-  /* map and read data */
-  const float* data;
-  result = vmaMapMemory(renderData.rdAllocator, readbackImageAlloc, (void**)&data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map readback image memory (error: %i)\n", __FUNCTION__, result);
-    return pixelColor;
+void SelectionFramebuffer::cleanupReadbackBuffers(VkRenderData &renderData) {
+  for (auto& frameData : renderData.rdPerFrameData) {
+    vmaDestroyBuffer(renderData.rdAllocator, frameData.pfSelectionReadback.buffer, frameData.pfSelectionReadback.bufferAlloc);
+    frameData.pfSelectionReadback = {};
   }
-
-  data += yPos * subResourceLayout.rowPitch / sizeof(float) + xPos;
-  pixelColor = *data;
-
-  vmaUnmapMemory(renderData.rdAllocator, readbackImageAlloc);
-
-  /* destroy local image, no longer needed */
-  vmaDestroyImage(renderData.rdAllocator, readbackImage, readbackImageAlloc);
-
-  return pixelColor;
 }
 
 void SelectionFramebuffer::cleanup(VkRenderData &renderData) {
@@ -9,6 +9,13 @@
 class SelectionFramebuffer {
   public:
     static bool init(VkRenderData &renderData);
-    static float getPixelValueFromPos(VkRenderData &renderData, unsigned int xPos, unsigned int yPos);
     static void cleanup(VkRenderData &renderData);
+
+    /* one small readback buffer per frame in flight, independent of the swapchain size */
+    static bool initReadbackBuffers(VkRenderData &renderData);
+    /* copies the pixel into the readback buffer of the current frame */
+    static void recordPixelReadback(VkRenderData &renderData, VkCommandBuffer &commandBuffer, int xPos, int yPos);
+    /* returns false if no pick was recorded when the current frame was used last time */
+    static bool getReadbackPixelValue(VkRenderData &renderData, float &pixelValue);
+    static void cleanupReadbackBuffers(VkRenderData &renderData);
 };
@@ -1,6 +1,8 @@
 #include "ShaderStorageBuffer.h"
+#include "DescriptorCache.h"
 #include "Logger.h"
 
+#include <algorithm>
 #include <VkBootstrap.h>
 
 bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData, size_t bufferSize) {
@@ -14,16 +16,20 @@ bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferDa
   bufferInfo.size = bufferSize;
   bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
 
+  /* stays mapped for the lifetime of the buffer */
   VmaAllocationCreateInfo vmaAllocInfo{};
   vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+  vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
+  VmaAllocationInfo allocInfo{};
   VkResult result = vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo,
-    &SSBOData.buffer, &SSBOData.bufferAlloc, nullptr);
+    &SSBOData.buffer, &SSBOData.bufferAlloc, &allocInfo);
   if (result != VK_SUCCESS) {
     Logger::log(1, "%s error: could not allocate SSBO via VMA (error: %i)\n", __FUNCTION__, result);
     return false;
   }
 
+  SSBOData.mappedData = allocInfo.pMappedData;
   SSBOData.bufferSize = bufferSize;
   Logger::log(1, "%s: created SSBO of size %i\n", __FUNCTION__, bufferSize);
     return true;
@@ -32,24 +38,25 @@ bool ShaderStorageBuffer::init(VkRenderData& renderData, VkShaderStorageBufferDa
 bool ShaderStorageBuffer::checkForResize(VkRenderData& renderData, VkShaderStorageBufferData& SSBOData, size_t bufferSize) {
   if (bufferSize > SSBOData.bufferSize) {
     Logger::log(1, "%s: resize SSBO %p from %i to %i bytes\n", __FUNCTION__, SSBOData.buffer, SSBOData.bufferSize, bufferSize);
-    cleanup(renderData, SSBOData);
-    init(renderData, SSBOData, bufferSize);
+    retire(renderData, SSBOData);
+    init(renderData, SSBOData, getGrowSize(SSBOData, bufferSize));
     return true;
   }
   return false;
 }
 
+size_t ShaderStorageBuffer::getGrowSize(VkShaderStorageBufferData& SSBOData, size_t bufferSize) {
+  /* grow by half of the old size to avoid a resize (and descriptor update) for every new instance */
+  return std::max(bufferSize, SSBOData.bufferSize + SSBOData.bufferSize / 2);
+}
+
 glm::mat4 ShaderStorageBuffer::getSsboDataMat4(VkRenderData& renderData, VkShaderStorageBufferData& SSBOData, size_t offset) {
   glm::mat4 resultMatrix = glm::mat4(1.0f);
 
-  glm::mat4* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, SSBOData.bufferAlloc, (void**)&data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map SSBO memory (error: %i)\n", __FUNCTION__, result);
-    return resultMatrix;
-  }
+  /* make GPU writes visible on the host */
+  vmaInvalidateAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, VK_WHOLE_SIZE);
+  glm::mat4* data = static_cast<glm::mat4*>(SSBOData.mappedData);
   std::memcpy(&resultMatrix, data + offset, sizeof(glm::mat4));
-  vmaUnmapMemory(renderData.rdAllocator, SSBOData.bufferAlloc);
 
   return resultMatrix;
 }
@@ -57,15 +64,11 @@ glm::mat4 ShaderStorageBuffer::getSsboDataMat4(VkRenderData& renderData, VkShade
 std::vector<glm::mat4> ShaderStorageBuffer::getSsboDataMat4(VkRenderData& renderData, VkShaderStorageBufferData& SSBOData) {
   std::vector<glm::mat4> resultMatrices{};
 
-  glm::mat4* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, SSBOData.bufferAlloc, (void**)&data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map SSBO memory (error: %i)\n", __FUNCTION__, result);
-    return resultMatrices;
-  }
+  /* make GPU writes visible on the host */
+  vmaInvalidateAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, VK_WHOLE_SIZE);
+  glm::mat4* data = static_cast<glm::mat4*>(SSBOData.mappedData);
   resultMatrices.resize(SSBOData.bufferSize / sizeof(glm::mat4));
   std::memcpy(resultMatrices.data(), data, SSBOData.bufferSize);
-  vmaUnmapMemory(renderData.rdAllocator, SSBOData.bufferAlloc);
 
   return resultMatrices;
 }
@@ -74,16 +77,11 @@ std::vector<glm::mat4> ShaderStorageBuffer::getSsboDataMat4(VkRenderData& render
     size_t offset, int numberOfElements) {
   std::vector<glm::mat4> resultMatrices{};
 
-  glm::mat4* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, SSBOData.bufferAlloc, (void**)&data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map SSBO memory (error: %i)\n", __FUNCTION__, result);
-    return resultMatrices;
-  }
-
+  /* make GPU writes visible on the host */
+  vmaInvalidateAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, VK_WHOLE_SIZE);
+  glm::mat4* data = static_cast<glm::mat4*>(SSBOData.mappedData);
   resultMatrices.resize(numberOfElements);
   std::memcpy(resultMatrices.data(), data + offset, numberOfElements * sizeof(glm::mat4));
-  vmaUnmapMemory(renderData.rdAllocator, SSBOData.bufferAlloc);
 
   return resultMatrices;
 }
@@ -91,15 +89,11 @@ std::vector<glm::mat4> ShaderStorageBuffer::getSsboDataMat4(VkRenderData& render
 std::vector<glm::vec4> ShaderStorageBuffer::getSsboDataVec4(VkRenderData& renderData, VkShaderStorageBufferData& SSBOData, int numberOfElements) {
   std::vector<glm::vec4> resultVec{};
 
-  glm::vec4* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, SSBOData.bufferAlloc, (void**)&data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map SSBO memory (error: %i)\n", __FUNCTION__, result);
-    return resultVec;
-  }
+  /* make GPU writes visible on the host */
+  vmaInvalidateAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, VK_WHOLE_SIZE);
+  glm::vec4* data = static_cast<glm::vec4*>(SSBOData.mappedData);
   resultVec.resize(numberOfElements);
   std::memcpy(resultVec.data(), data, numberOfElements * sizeof(glm::vec4));
-  vmaUnmapMemory(renderData.rdAllocator, SSBOData.bufferAlloc);
 
   return resultVec;
 }
@@ -107,15 +101,11 @@ std::vector<glm::vec4> ShaderStorageBuffer::getSsboDataVec4(VkRenderData& render
 std::vector<TRSMatrixData> ShaderStorageBuffer::getSsboDataTRSMatrixData(VkRenderData& renderData, VkShaderStorageBufferData& SSBOData) {
   std::vector<TRSMatrixData> resultVec{};
 
-  TRSMatrixData* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, SSBOData.bufferAlloc, (void**)&data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map SSBO memory (error: %i)\n", __FUNCTION__, result);
-    return resultVec;
-  }
+  /* make GPU writes visible on the host */
+  vmaInvalidateAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, VK_WHOLE_SIZE);
+  TRSMatrixData* data = static_cast<TRSMatrixData*>(SSBOData.mappedData);
   resultVec.resize(SSBOData.bufferSize / sizeof(TRSMatrixData));
   std::memcpy(resultVec.data(), data, SSBOData.bufferSize);
-  vmaUnmapMemory(renderData.rdAllocator, SSBOData.bufferAlloc);
 
   return resultVec;
 }
@@ -124,26 +114,51 @@ std::vector<TRSMatrixData> ShaderStorageBuffer::getSsboDataTRSMatrixData(VkRende
     size_t offset, int numberOfElements) {
   std::vector<TRSMatrixData> resultVec{};
 
-  TRSMatrixData* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, SSBOData.bufferAlloc, (void**)&data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map SSBO memory (error: %i)\n", __FUNCTION__, result);
-    return resultVec;
-  }
-
+  /* make GPU writes visible on the host */
+  vmaInvalidateAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, VK_WHOLE_SIZE);
+  TRSMatrixData* data = static_cast<TRSMatrixData*>(SSBOData.mappedData);
   resultVec.resize(numberOfElements);
   std::memcpy(resultVec.data(), data + offset, numberOfElements * sizeof(TRSMatrixData));
-  vmaUnmapMemory(renderData.rdAllocator, SSBOData.bufferAlloc);
 
   return resultVec;
 }
 
 void ShaderStorageBuffer::cleanup(VkRenderData& renderData, VkShaderStorageBufferData &SSBOData) {
-  VkResult result = vkQueueWaitIdle(renderData.rdGraphicsQueue);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s fatal error: could not wait for device idle (error: %i)\n", __FUNCTION__, result);
-  }
+  DescriptorCache::removeBuffer(renderData, SSBOData.buffer);
   vmaDestroyBuffer(renderData.rdAllocator, SSBOData.buffer, SSBOData.bufferAlloc);
+  SSBOData.buffer = VK_NULL_HANDLE;
+  SSBOData.bufferAlloc = nullptr;
+  SSBOData.mappedData = nullptr;
+}
+
+void ShaderStorageBuffer::retire(VkRenderData& renderData, VkShaderStorageBufferData& SSBOData) {
+  /* the fence of the current frame was waited for, no other frame uses a per-frame buffer */
+  if (SSBOData.perFrameBuffer) {
+    cleanup(renderData, SSBOData);
+    return;
+  }
+
+  /* every frame in flight may still read a shared buffer, wait for one fence of each */
+  DescriptorCache::removeBuffer(renderData, SSBOData.buffer);
+  renderData.rdPendingBufferDeletions.emplace_back(
+    VkPendingBufferDeletion{ SSBOData.buffer, SSBOData.bufferAlloc, renderData.rdFramesInFlight });
+  SSBOData.buffer = VK_NULL_HANDLE;
+  SSBOData.bufferAlloc = nullptr;
+  SSBOData.mappedData = nullptr;
+}
+
+void ShaderStorageBuffer::destroyPendingBuffers(VkRenderData& renderData, bool forceAll) {
+  for (auto& deletion : renderData.rdPendingBufferDeletions) {
+    if (forceAll || --deletion.framesLeft == 0) {
+      vmaDestroyBuffer(renderData.rdAllocator, deletion.buffer, deletion.bufferAlloc);
+      deletion.buffer = VK_NULL_HANDLE;
+    }
+  }
+
+  renderData.rdPendingBufferDeletions.erase(std::remove_if(renderData.rdPendingBufferDeletions.begin(),
+    renderData.rdPendingBufferDeletions.end(), [](const VkPendingBufferDeletion& deletion) {
+      return deletion.buffer == VK_NULL_HANDLE; }),
+    renderData.rdPendingBufferDeletions.end());
 }
 
 size_t ShaderStorageBuffer::getBufferSize(VkShaderStorageBufferData& SSBOData) {
@@ -24,20 +24,13 @@ class ShaderStorageBuffer {
       size_t bufferSize = bufferData.size() * sizeof(T);
       if (bufferSize > SSBOData.bufferSize) {
         Logger::log(1, "%s: resize SSBO %p from %i to %i bytes\n", __FUNCTION__, SSBOData.buffer, SSBOData.bufferSize, bufferSize);
-        cleanup(renderData, SSBOData);
-        init(renderData, SSBOData, bufferSize);
+        retire(renderData, SSBOData);
+        init(renderData, SSBOData, getGrowSize(SSBOData, bufferSize));
         bufferResized = true;
       }
 
-      void* data;
-      VkResult result = vmaMapMemory(renderData.rdAllocator, SSBOData.bufferAlloc, &data);
-      if (result != VK_SUCCESS) {
-        Logger::log(1, "%s error: could not map SSBO memory (error: %i)\n", __FUNCTION__, result);
-        return false;
-      }
-      std::memcpy(data, bufferData.data(), bufferSize);
-      vmaUnmapMemory(renderData.rdAllocator, SSBOData.bufferAlloc);
-      vmaFlushAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, SSBOData.bufferSize);
+      std::memcpy(SSBOData.mappedData, bufferData.data(), bufferSize);
+      vmaFlushAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, bufferSize);
 
       return bufferResized;
     }
@@ -55,15 +48,9 @@ class ShaderStorageBuffer {
         return;
       }
 
-      T* data;
-      VkResult result = vmaMapMemory(renderData.rdAllocator, SSBOData.bufferAlloc, (void**)&data);
-      if (result != VK_SUCCESS) {
-        Logger::log(1, "%s error: could not map SSBO memory (error: %i)\n", __FUNCTION__, result);
-        return;
-      }
+      T* data = static_cast<T*>(SSBOData.mappedData);
       std::memcpy(data + offset, bufferData.data() + offset, bufferSize - offset * sizeof(T));
-      vmaUnmapMemory(renderData.rdAllocator, SSBOData.bufferAlloc);
-      vmaFlushAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, 0, SSBOData.bufferSize);
+      vmaFlushAllocation(renderData.rdAllocator, SSBOData.bufferAlloc, offset * sizeof(T), bufferSize - offset * sizeof(T));
     }
 
     static bool checkForResize(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData,
@@ -80,5 +67,13 @@ class ShaderStorageBuffer {
     static std::vector<TRSMatrixData> getSsboDataTRSMatrixData(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData,
       size_t offset, int numberOfElements);
 
+    /* destroys the buffer at once, the GPU must not use it anymore */
     static void cleanup(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData);
+    /* call after waiting for the fence of the next frame, forceAll only after the device is idle */
+    static void destroyPendingBuffers(VkRenderData &renderData, bool forceAll = false);
+
+  private:
+    /* resize helper, shared buffers may still be read by other frames in flight */
+    static void retire(VkRenderData &renderData, VkShaderStorageBufferData &SSBOData);
+    static size_t getGrowSize(VkShaderStorageBufferData &SSBOData, size_t bufferSize);
 };
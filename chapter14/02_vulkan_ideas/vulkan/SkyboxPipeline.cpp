@@ -137,7 +137,7 @@ bool SkyboxPipeline::init(VkRenderData& renderData, VkPipelineLayout& pipelineLa
   pipelineCreateInfo.subpass = 0;
   pipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-  VkResult result = vkCreateGraphicsPipelines(renderData.rdVkbDevice.device, VK_NULL_HANDLE, 1, &pipelineCreateInfo, nullptr, &pipeline);
+  VkResult result = vkCreateGraphicsPipelines(renderData.rdVkbDevice.device, renderData.rdPipelineCache, 1, &pipelineCreateInfo, nullptr, &pipeline);
   if (result != VK_SUCCESS) {
     Logger::log(1, "%s error: could not create rendering pipeline (error: %i)\n", __FUNCTION__, result);
     Shader::cleanup(renderData.rdVkbDevice.device, vertexModule);
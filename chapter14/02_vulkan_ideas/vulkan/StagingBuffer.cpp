@@ -0,0 +1,182 @@
+#include <cstring>
+#include <algorithm>
+
+#include "StagingBuffer.h"
+#include "CommandBuffer.h"
+#include "Logger.h"
+
+bool StagingBuffer::createRingBuffer(VkRenderData &renderData, VkStagingBufferData &stagingData, size_t bufferSize) {
+  VkBufferCreateInfo bufferInfo{};
+  bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  bufferInfo.size = bufferSize;
+  bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+  VmaAllocationCreateInfo vmaAllocInfo{};
+  vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+  vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  VmaAllocationInfo allocInfo{};
+  VkResult result = vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo,
+    &stagingData.buffer, &stagingData.bufferAlloc, &allocInfo);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate staging buffer via VMA (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+
+  stagingData.mappedData = allocInfo.pMappedData;
+  stagingData.bufferSize = bufferSize;
+  stagingData.offset = 0;
+  Logger::log(1, "%s: created staging ring of size %i\n", __FUNCTION__, bufferSize);
+  return true;
+}
+
+bool StagingBuffer::init(VkRenderData &renderData, size_t bufferSize) {
+  for (auto& frameData : renderData.rdPerFrameData) {
+    if (!createRingBuffer(renderData, frameData.pfStagingBuffer, bufferSize)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool StagingBuffer::upload(VkRenderData &renderData, VkBuffer dstBuffer, const void* data, size_t dataSize) {
+  if (dataSize == 0) {
+    return true;
+  }
+
+  VkStagingBufferData& stagingData = renderData.rdPerFrameData.at(renderData.rdCurrentFrame).pfStagingBuffer;
+
+  /* outside of a frame, the last submit of the current frame may still read the ring */
+  if (!renderData.rdDeferUploads && renderData.rdRenderFence != VK_NULL_HANDLE) {
+    VkResult result = vkWaitForFences(renderData.rdVkbDevice.device, 1, &renderData.rdRenderFence, VK_TRUE, UINT64_MAX);
+    if (result != VK_SUCCESS) {
+      Logger::log(1, "%s error: waiting for render fence failed (error: %i)\n", __FUNCTION__, result);
+      return false;
+    }
+    stagingData.offset = 0;
+  }
+
+  /* 16 byte alignment is enough for all vertex and index formats */
+  size_t copyOffset = (stagingData.offset + 15) & ~static_cast<size_t>(15);
+  if (copyOffset + dataSize > stagingData.bufferSize) {
+    /* ring is full, push out the queued copies and start over */
+    if (!flush(renderData)) {
+      return false;
+    }
+    copyOffset = 0;
+
+    if (dataSize > stagingData.bufferSize) {
+      size_t newSize = stagingData.bufferSize;
+      while (newSize < dataSize) {
+        newSize *= 2;
+      }
+      Logger::log(1, "%s: resize staging ring from %i to %i bytes\n", __FUNCTION__, stagingData.bufferSize, newSize);
+      vmaDestroyBuffer(renderData.rdAllocator, stagingData.buffer, stagingData.bufferAlloc);
+      if (!createRingBuffer(renderData, stagingData, newSize)) {
+        return false;
+      }
+    }
+  }
+
+  std::memcpy(static_cast<char*>(stagingData.mappedData) + copyOffset, data, dataSize);
+  vmaFlushAllocation(renderData.rdAllocator, stagingData.bufferAlloc, copyOffset, dataSize);
+
+  VkStagingCopy copy{};
+  copy.dstBuffer = dstBuffer;
+  copy.region.srcOffset = copyOffset;
+  copy.region.dstOffset = 0;
+  copy.region.size = dataSize;
+  stagingData.pendingCopies.emplace_back(copy);
+  stagingData.offset = copyOffset + dataSize;
+
+  if (!renderData.rdDeferUploads) {
+    return flush(renderData);
+  }
+  return true;
+}
+
+void StagingBuffer::removePendingCopies(VkRenderData &renderData, VkBuffer dstBuffer) {
+  if (renderData.rdPerFrameData.empty()) {
+    return;
+  }
+
+  std::vector<VkStagingCopy>& pendingCopies = renderData.rdPerFrameData.at(renderData.rdCurrentFrame).pfStagingBuffer.pendingCopies;
+  pendingCopies.erase(std::remove_if(pendingCopies.begin(), pendingCopies.end(),
+    [dstBuffer](const VkStagingCopy& copy) { return copy.dstBuffer == dstBuffer; }), pendingCopies.end());
+}
+
+void StagingBuffer::recordCopyCommands(VkCommandBuffer &commandBuffer, VkStagingBufferData &stagingData) {
+  for (const auto& copy : stagingData.pendingCopies) {
+    vkCmdCopyBuffer(commandBuffer, stagingData.buffer, copy.dstBuffer, 1, &copy.region);
+  }
+
+  /* one barrier for all copies */
+  VkMemoryBarrier copyBarrier{};
+  copyBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+  copyBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  copyBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+    VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &copyBarrier, 0, nullptr, 0, nullptr);
+
+  stagingData.pendingCopies.clear();
+}
+
+void StagingBuffer::beginFrame(VkRenderData &renderData) {
+  /* the frame fence has been waited for, the whole ring is free again */
+  renderData.rdPerFrameData.at(renderData.rdCurrentFrame).pfStagingBuffer.offset = 0;
+  renderData.rdDeferUploads = true;
+}
+
+bool StagingBuffer::recordFrameCopies(VkRenderData &renderData, VkCommandBuffer &commandBuffer) {
+  renderData.rdDeferUploads = false;
+
+  VkStagingBufferData& stagingData = renderData.rdPerFrameData.at(renderData.rdCurrentFrame).pfStagingBuffer;
+  if (stagingData.pendingCopies.empty()) {
+    return false;
+  }
+
+  if (!CommandBuffer::reset(commandBuffer, 0)) {
+    Logger::log(1, "%s error: failed to reset upload command buffer\n", __FUNCTION__);
+    return false;
+  }
+
+  if (!CommandBuffer::beginSingleShot(commandBuffer)) {
+    Logger::log(1, "%s error: failed to begin upload command buffer\n", __FUNCTION__);
+    return false;
+  }
+
+  recordCopyCommands(commandBuffer, stagingData);
+
+  if (!CommandBuffer::end(commandBuffer)) {
+    Logger::log(1, "%s error: failed to end upload command buffer\n", __FUNCTION__);
+    return false;
+  }
+
+  return true;
+}
+
+bool StagingBuffer::flush(VkRenderData &renderData) {
+  VkStagingBufferData& stagingData = renderData.rdPerFrameData.at(renderData.rdCurrentFrame).pfStagingBuffer;
+  if (stagingData.pendingCopies.empty()) {
+    stagingData.offset = 0;
+    return true;
+  }
+
+  VkCommandBuffer commandBuffer = CommandBuffer::createSingleShotBuffer(renderData, renderData.rdCommandPool);
+  recordCopyCommands(commandBuffer, stagingData);
+
+  if (!CommandBuffer::submitSingleShotBuffer(renderData, renderData.rdCommandPool, commandBuffer, renderData.rdGraphicsQueue)) {
+    return false;
+  }
+
+  stagingData.offset = 0;
+  return true;
+}
+
+void StagingBuffer::cleanup(VkRenderData &renderData) {
+  for (auto& frameData : renderData.rdPerFrameData) {
+    vmaDestroyBuffer(renderData.rdAllocator, frameData.pfStagingBuffer.buffer, frameData.pfStagingBuffer.bufferAlloc);
+    frameData.pfStagingBuffer.pendingCopies.clear();
+  }
+}
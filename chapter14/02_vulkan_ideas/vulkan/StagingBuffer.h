@@ -0,0 +1,30 @@
+/* Vulkan staging ring, one per frame in flight */
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include "VkRenderData.h"
+
+class StagingBuffer {
+  public:
+    static bool init(VkRenderData &renderData, size_t bufferSize = 1024 * 1024);
+
+    /* copies the data into the ring and queues a copy to the destination buffer */
+    static bool upload(VkRenderData &renderData, VkBuffer dstBuffer, const void* data, size_t dataSize);
+    /* drop queued copies to a buffer that is about to be destroyed */
+    static void removePendingCopies(VkRenderData &renderData, VkBuffer dstBuffer);
+
+    /* start to collect the copies of the current frame */
+    static void beginFrame(VkRenderData &renderData);
+    /* records all queued copies of the frame, returns false if there is nothing to submit */
+    static bool recordFrameCopies(VkRenderData &renderData, VkCommandBuffer &commandBuffer);
+
+    /* submit queued copies now and wait for them */
+    static bool flush(VkRenderData &renderData);
+
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static bool createRingBuffer(VkRenderData &renderData, VkStagingBufferData &stagingData, size_t bufferSize);
+    static void recordCopyCommands(VkCommandBuffer &commandBuffer, VkStagingBufferData &stagingData);
+};
@@ -11,23 +11,25 @@ bool SyncObjects::init(VkRenderData &renderData) {
   VkSemaphoreCreateInfo semaphoreInfo{};
   semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-  if (vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &renderData.rdPresentSemaphore) != VK_SUCCESS ||
-      vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &renderData.rdRenderSemaphore) != VK_SUCCESS ||
-      vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &renderData.rdComputeSemaphore) != VK_SUCCESS ||
-      vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &renderData.rdGraphicSemaphore) != VK_SUCCESS ||
-      vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &renderData.rdRenderFence) != VK_SUCCESS ||
-      vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &renderData.rdComputeFence) != VK_SUCCESS) {
-    Logger::log(1, "%s error: failed to init sync objects\n", __FUNCTION__);
-    return false;
+  for (auto& frameData : renderData.rdPerFrameData) {
+    if (vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &frameData.pfPresentSemaphore) != VK_SUCCESS ||
+        vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &frameData.pfRenderSemaphore) != VK_SUCCESS ||
+        vkCreateSemaphore(renderData.rdVkbDevice.device, &semaphoreInfo, nullptr, &frameData.pfComputeSemaphore) != VK_SUCCESS ||
+        vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &frameData.pfRenderFence) != VK_SUCCESS ||
+        vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &frameData.pfComputeFence) != VK_SUCCESS) {
+      Logger::log(1, "%s error: failed to init sync objects\n", __FUNCTION__);
+      return false;
+    }
   }
   return true;
 }
 
 void SyncObjects::cleanup(VkRenderData &renderData) {
-  vkDestroySemaphore(renderData.rdVkbDevice.device, renderData.rdPresentSemaphore, nullptr);
-  vkDestroySemaphore(renderData.rdVkbDevice.device, renderData.rdRenderSemaphore, nullptr);
-  vkDestroySemaphore(renderData.rdVkbDevice.device, renderData.rdComputeSemaphore, nullptr);
-  vkDestroySemaphore(renderData.rdVkbDevice.device, renderData.rdGraphicSemaphore, nullptr);
-  vkDestroyFence(renderData.rdVkbDevice.device, renderData.rdRenderFence, nullptr);
-  vkDestroyFence(renderData.rdVkbDevice.device, renderData.rdComputeFence, nullptr);
+  for (auto& frameData : renderData.rdPerFrameData) {
+    vkDestroySemaphore(renderData.rdVkbDevice.device, frameData.pfPresentSemaphore, nullptr);
+    vkDestroySemaphore(renderData.rdVkbDevice.device, frameData.pfRenderSemaphore, nullptr);
+    vkDestroySemaphore(renderData.rdVkbDevice.device, frameData.pfComputeSemaphore, nullptr);
+    vkDestroyFence(renderData.rdVkbDevice.device, frameData.pfRenderFence, nullptr);
+    vkDestroyFence(renderData.rdVkbDevice.device, frameData.pfComputeFence, nullptr);
+  }
 }
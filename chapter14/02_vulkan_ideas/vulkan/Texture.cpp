@@ -3,6 +3,7 @@
 #include <stb_image.h>
 
 #include "CommandBuffer.h"
+#include "UploadManager.h"
 #include "Texture.h"
 #include "Logger.h"
 
@@ -174,152 +175,17 @@ bool Texture::uploadToGPU(VkRenderData& renderData, VkTextureData& texData, VkTe
     return false;
   }
 
-  /* upload */
-  VkCommandBuffer uploadCommandBuffer = CommandBuffer::createSingleShotBuffer(renderData, renderData.rdCommandPool);
-
-  VkImageSubresourceRange stagingBufferRange{};
-  stagingBufferRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  stagingBufferRange.baseMipLevel = 0;
-  stagingBufferRange.levelCount = mipmapLevels;
-  stagingBufferRange.baseArrayLayer = 0;
-  stagingBufferRange.layerCount = 1;
-
-  /* 1st barrier, undefined to transfer optimal */
-  VkImageMemoryBarrier stagingBufferTransferBarrier{};
-  stagingBufferTransferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  stagingBufferTransferBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-  stagingBufferTransferBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  stagingBufferTransferBarrier.image = texData.image;
-  stagingBufferTransferBarrier.subresourceRange = stagingBufferRange;
-  stagingBufferTransferBarrier.srcAccessMask = 0;
-  stagingBufferTransferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-  VkExtent3D textureExtent{};
-  textureExtent.width = width;
-  textureExtent.height = height;
-  textureExtent.depth = 1;
-
-  VkBufferImageCopy stagingBufferCopy{};
-  stagingBufferCopy.bufferOffset = 0;
-  stagingBufferCopy.bufferRowLength = 0;
-  stagingBufferCopy.bufferImageHeight = 0;
-  stagingBufferCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-  stagingBufferCopy.imageSubresource.mipLevel = 0;
-  stagingBufferCopy.imageSubresource.baseArrayLayer = 0;
-  stagingBufferCopy.imageSubresource.layerCount = 1;
-  stagingBufferCopy.imageExtent = textureExtent;
-
-  /* 2nd barrier, transfer optimal to shader optimal */
-  VkImageMemoryBarrier stagingBufferShaderBarrier{};
-  stagingBufferShaderBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  stagingBufferShaderBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-  if (mipmapLevels > 1) {
-    /* VkCmdBlit() requires the original image to be in TRANSFER_DST_OPTIMAL format */
-    stagingBufferShaderBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  /* upload, model and level textures are copied in the background while a batch is open */
+  if (UploadManager::isBatchActive(renderData)) {
+    if (!UploadManager::uploadImage(renderData, texData.image, stagingData.stagingBuffer, stagingData.stagingBufferAlloc,
+        width, height, mipmapLevels)) {
+      Logger::log(1, "%s error: could not queue texture transfer\n", __FUNCTION__);
+      return false;
+    }
   } else {
-    stagingBufferShaderBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-  }
-  stagingBufferShaderBarrier.image = texData.image;
-  stagingBufferShaderBarrier.subresourceRange = stagingBufferRange;
-  stagingBufferShaderBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-  stagingBufferShaderBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-  vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferTransferBarrier);
-  vkCmdCopyBufferToImage(uploadCommandBuffer, stagingData.stagingBuffer, texData.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingBufferCopy);
-  vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferShaderBarrier);
-
-  /* generate mipmap blit commands */
-  if (generateMipmaps) {
-    VkImageSubresourceRange blitRange{};
-    blitRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    blitRange.baseMipLevel = 0;
-    blitRange.levelCount = 1;
-    blitRange.baseArrayLayer = 0;
-    blitRange.layerCount = 1;
-
-    /* 1st barrier, we need to transfer to src optimal for the blit */
-    VkImageMemoryBarrier firstBarrier{};
-    firstBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    firstBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    firstBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-    firstBarrier.image = texData.image;
-    firstBarrier.subresourceRange = blitRange;
-    firstBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    firstBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-
-    /* 2nd barrier -> transfer to shader optimal */
-    VkImageMemoryBarrier secondBarrier{};
-    secondBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    secondBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-    secondBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    secondBarrier.image = texData.image;
-    secondBarrier.subresourceRange = blitRange;
-    secondBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-    secondBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-    VkImageBlit mipBlit{};
-    mipBlit.srcOffsets[0] = { 0, 0, 0 };
-    mipBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    mipBlit.srcSubresource.baseArrayLayer = 0;
-    mipBlit.srcSubresource.layerCount = 1;
-
-    mipBlit.dstOffsets[0] = { 0, 0, 0 };
-    mipBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    mipBlit.dstSubresource.baseArrayLayer = 0;
-    mipBlit.dstSubresource.layerCount = 1;
-
-    int32_t mipWidth = width;
-    int32_t mipHeight = height;
-    for (int i = 1; i < mipmapLevels; ++i) {
-      mipBlit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
-      mipBlit.srcSubresource.mipLevel = i - 1;
-
-      mipBlit.dstOffsets[1] = { mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1 };
-      mipBlit.dstSubresource.mipLevel = i;
-
-      firstBarrier.subresourceRange.baseMipLevel = i -1;
-      vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &firstBarrier);
-
-      vkCmdBlitImage(uploadCommandBuffer,
-                     texData.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                     texData.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                     1, &mipBlit, VK_FILTER_LINEAR);
-
-      secondBarrier.subresourceRange.baseMipLevel = i -1;
-      vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &secondBarrier);
-
-      if (mipWidth > 1) {
-        mipWidth /= 2;
-      }
-      if (mipHeight > 1) {
-        mipHeight /= 2;
-      }
-
-      Logger::log(1, "%s: created level %i with width %i and height %i\n", __FUNCTION__, i, mipWidth, mipHeight);
+    if (!submitUpload(renderData, texData, stagingData, width, height, generateMipmaps, mipmapLevels)) {
+      return false;
     }
-
-    VkImageMemoryBarrier lastBarrier{};
-    lastBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    lastBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    lastBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    lastBarrier.image = texData.image;
-    lastBarrier.subresourceRange = blitRange;
-    lastBarrier.subresourceRange.baseMipLevel = mipmapLevels - 1;
-    lastBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    lastBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-    vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &lastBarrier);
-  }
-
-  bool commandResult = CommandBuffer::submitSingleShotBuffer(renderData, renderData.rdCommandPool, uploadCommandBuffer, renderData.rdGraphicsQueue);
-  vmaDestroyBuffer(renderData.rdAllocator, stagingData.stagingBuffer, stagingData.stagingBufferAlloc);
-
-  if (!commandResult) {
-    Logger::log(1, "%s error: could not submit texture transfer commands\n", __FUNCTION__);
-    return false;
   }
 
   /* image view and sampler */
@@ -374,15 +240,14 @@ bool Texture::uploadToGPU(VkRenderData& renderData, VkTextureData& texData, VkTe
     return false;
   }
 
-  VkDescriptorSetAllocateInfo descriptorAllocateInfo{};
-  descriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-  descriptorAllocateInfo.descriptorPool = renderData.rdDescriptorPool;
-  descriptorAllocateInfo.descriptorSetCount = 1;
-  descriptorAllocateInfo.pSetLayouts = &renderData.rdAssimpTextureDescriptorLayout;
-
-  result = vkAllocateDescriptorSets(renderData.rdVkbDevice.device, &descriptorAllocateInfo, &texData.descriptorSet);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate descriptor set (error: %i)\n", __FUNCTION__, result);
+  /* no own descriptor set, the texture gets a slot in the global texture array */
+  if (!renderData.rdFreeGlobalTextureIndices.empty()) {
+    texData.textureIndex = renderData.rdFreeGlobalTextureIndices.back();
+    renderData.rdFreeGlobalTextureIndices.pop_back();
+  } else if (renderData.rdNextGlobalTextureIndex < renderData.rdMaxGlobalTextures) {
+    texData.textureIndex = renderData.rdNextGlobalTextureIndex++;
+  } else {
+    Logger::log(1, "%s error: global texture array is full (%i textures)\n", __FUNCTION__, renderData.rdMaxGlobalTextures);
     return false;
   }
 
@@ -391,11 +256,13 @@ bool Texture::uploadToGPU(VkRenderData& renderData, VkTextureData& texData, VkTe
   descriptorImageInfo.imageView = texData.imageView;
   descriptorImageInfo.sampler = texData.sampler;
 
+  /* update-after-bind, the slot is unused by the frames in flight */
   VkWriteDescriptorSet writeDescriptorSet{};
   writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
   writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-  writeDescriptorSet.dstSet = texData.descriptorSet;
+  writeDescriptorSet.dstSet = renderData.rdGlobalTextureDescriptorSet;
   writeDescriptorSet.dstBinding = 0;
+  writeDescriptorSet.dstArrayElement = texData.textureIndex;
   writeDescriptorSet.descriptorCount = 1;
   writeDescriptorSet.pImageInfo = &descriptorImageInfo;
 
@@ -675,8 +542,169 @@ bool Texture::uploadCubemapToGPU(VkRenderData& renderData, VkTextureData& texDat
   return true;
 }
 
+bool Texture::submitUpload(VkRenderData &renderData, VkTextureData &texData, VkTextureStagingBuffer &stagingData,
+    uint32_t width, uint32_t height, bool generateMipmaps, uint32_t mipmapLevels) {
+  VkCommandBuffer uploadCommandBuffer = CommandBuffer::createSingleShotBuffer(renderData, renderData.rdCommandPool);
+
+  VkImageSubresourceRange stagingBufferRange{};
+  stagingBufferRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  stagingBufferRange.baseMipLevel = 0;
+  stagingBufferRange.levelCount = mipmapLevels;
+  stagingBufferRange.baseArrayLayer = 0;
+  stagingBufferRange.layerCount = 1;
+
+  /* 1st barrier, undefined to transfer optimal */
+  VkImageMemoryBarrier stagingBufferTransferBarrier{};
+  stagingBufferTransferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  stagingBufferTransferBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  stagingBufferTransferBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  stagingBufferTransferBarrier.image = texData.image;
+  stagingBufferTransferBarrier.subresourceRange = stagingBufferRange;
+  stagingBufferTransferBarrier.srcAccessMask = 0;
+  stagingBufferTransferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  VkExtent3D textureExtent{};
+  textureExtent.width = width;
+  textureExtent.height = height;
+  textureExtent.depth = 1;
+
+  VkBufferImageCopy stagingBufferCopy{};
+  stagingBufferCopy.bufferOffset = 0;
+  stagingBufferCopy.bufferRowLength = 0;
+  stagingBufferCopy.bufferImageHeight = 0;
+  stagingBufferCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  stagingBufferCopy.imageSubresource.mipLevel = 0;
+  stagingBufferCopy.imageSubresource.baseArrayLayer = 0;
+  stagingBufferCopy.imageSubresource.layerCount = 1;
+  stagingBufferCopy.imageExtent = textureExtent;
+
+  /* 2nd barrier, transfer optimal to shader optimal */
+  VkImageMemoryBarrier stagingBufferShaderBarrier{};
+  stagingBufferShaderBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  stagingBufferShaderBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  if (mipmapLevels > 1) {
+    /* VkCmdBlit() requires the original image to be in TRANSFER_DST_OPTIMAL format */
+    stagingBufferShaderBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  } else {
+    stagingBufferShaderBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  }
+  stagingBufferShaderBarrier.image = texData.image;
+  stagingBufferShaderBarrier.subresourceRange = stagingBufferRange;
+  stagingBufferShaderBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  stagingBufferShaderBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferTransferBarrier);
+  vkCmdCopyBufferToImage(uploadCommandBuffer, stagingData.stagingBuffer, texData.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &stagingBufferCopy);
+  vkCmdPipelineBarrier(uploadCommandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &stagingBufferShaderBarrier);
+
+  /* generate mipmap blit commands */
+  if (generateMipmaps) {
+    recordMipmapGeneration(uploadCommandBuffer, texData.image, width, height, mipmapLevels);
+  }
+
+  bool commandResult = CommandBuffer::submitSingleShotBuffer(renderData, renderData.rdCommandPool, uploadCommandBuffer, renderData.rdGraphicsQueue);
+  vmaDestroyBuffer(renderData.rdAllocator, stagingData.stagingBuffer, stagingData.stagingBufferAlloc);
+
+  if (!commandResult) {
+    Logger::log(1, "%s error: could not submit texture transfer commands\n", __FUNCTION__);
+    return false;
+  }
+
+  return true;
+}
+
+void Texture::recordMipmapGeneration(VkCommandBuffer commandBuffer, VkImage image, uint32_t width, uint32_t height,
+    uint32_t mipmapLevels) {
+  VkImageSubresourceRange blitRange{};
+  blitRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  blitRange.baseMipLevel = 0;
+  blitRange.levelCount = 1;
+  blitRange.baseArrayLayer = 0;
+  blitRange.layerCount = 1;
+
+  /* 1st barrier, we need to transfer to src optimal for the blit */
+  VkImageMemoryBarrier firstBarrier{};
+  firstBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  firstBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  firstBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+  firstBarrier.image = image;
+  firstBarrier.subresourceRange = blitRange;
+  firstBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  firstBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+  /* 2nd barrier -> transfer to shader optimal */
+  VkImageMemoryBarrier secondBarrier{};
+  secondBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  secondBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+  secondBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  secondBarrier.image = image;
+  secondBarrier.subresourceRange = blitRange;
+  secondBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+  secondBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  VkImageBlit mipBlit{};
+  mipBlit.srcOffsets[0] = { 0, 0, 0 };
+  mipBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  mipBlit.srcSubresource.baseArrayLayer = 0;
+  mipBlit.srcSubresource.layerCount = 1;
+
+  mipBlit.dstOffsets[0] = { 0, 0, 0 };
+  mipBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  mipBlit.dstSubresource.baseArrayLayer = 0;
+  mipBlit.dstSubresource.layerCount = 1;
+
+  int32_t mipWidth = width;
+  int32_t mipHeight = height;
+  for (int i = 1; i < mipmapLevels; ++i) {
+    mipBlit.srcOffsets[1] = { mipWidth, mipHeight, 1 };
+    mipBlit.srcSubresource.mipLevel = i - 1;
+
+    mipBlit.dstOffsets[1] = { mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1 };
+    mipBlit.dstSubresource.mipLevel = i;
+
+    firstBarrier.subresourceRange.baseMipLevel = i -1;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       0, 0, nullptr, 0, nullptr, 1, &firstBarrier);
+
+    vkCmdBlitImage(commandBuffer,
+                   image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                   image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                   1, &mipBlit, VK_FILTER_LINEAR);
+
+    secondBarrier.subresourceRange.baseMipLevel = i -1;
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       0, 0, nullptr, 0, nullptr, 1, &secondBarrier);
+
+    if (mipWidth > 1) {
+      mipWidth /= 2;
+    }
+    if (mipHeight > 1) {
+      mipHeight /= 2;
+    }
+
+    Logger::log(1, "%s: created level %i with width %i and height %i\n", __FUNCTION__, i, mipWidth, mipHeight);
+  }
+
+  VkImageMemoryBarrier lastBarrier{};
+  lastBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  lastBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  lastBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  lastBarrier.image = image;
+  lastBarrier.subresourceRange = blitRange;
+  lastBarrier.subresourceRange.baseMipLevel = mipmapLevels - 1;
+  lastBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+  lastBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       0, 0, nullptr, 0, nullptr, 1, &lastBarrier);
+}
+
 void Texture::cleanup(VkRenderData &renderData, VkTextureData &texData) {
-  vkFreeDescriptorSets(renderData.rdVkbDevice.device, renderData.rdDescriptorPool, 1, &texData.descriptorSet);
+  if (texData.descriptorSet != VK_NULL_HANDLE) {
+    vkFreeDescriptorSets(renderData.rdVkbDevice.device, renderData.rdDescriptorPool, 1, &texData.descriptorSet);
+  } else {
+    renderData.rdFreeGlobalTextureIndices.emplace_back(texData.textureIndex);
+  }
   vkDestroySampler(renderData.rdVkbDevice.device, texData.sampler, nullptr);
   vkDestroyImageView(renderData.rdVkbDevice.device, texData.imageView, nullptr);
   vmaDestroyImage(renderData.rdAllocator, texData.image, texData.imageAlloc);
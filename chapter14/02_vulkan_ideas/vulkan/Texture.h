@@ -24,11 +24,17 @@ class Texture {
     static bool loadCubemapTexture(VkRenderData &renderData, VkTextureData &texData,  std::string textureFilename,
       bool flipImage = false);
 
+    /* expects all levels in TRANSFER_DST_OPTIMAL, leaves them in SHADER_READ_ONLY_OPTIMAL */
+    static void recordMipmapGeneration(VkCommandBuffer commandBuffer, VkImage image, uint32_t width, uint32_t height,
+      uint32_t mipmapLevels);
+
     static void cleanup(VkRenderData &renderData, VkTextureData &texData);
 
   private:
     static bool uploadToGPU(VkRenderData &renderData, VkTextureData &texData, VkTextureStagingBuffer &stagingData,
       uint32_t width, uint32_t height, bool generateMipmaps, uint32_t mipmapLevels);
+    static bool submitUpload(VkRenderData &renderData, VkTextureData &texData, VkTextureStagingBuffer &stagingData,
+      uint32_t width, uint32_t height, bool generateMipmaps, uint32_t mipmapLevels);
     static bool uploadCubemapToGPU(VkRenderData &renderData, VkTextureData &texData, VkTextureStagingBuffer &stagingData,
       uint32_t width, uint32_t height);
 };
@@ -1,4 +1,5 @@
 #include "UniformBuffer.h"
+#include "DescriptorCache.h"
 #include "Logger.h"
 
 #include <VkBootstrap.h>
@@ -9,31 +10,30 @@ bool UniformBuffer::init(VkRenderData& renderData, VkUniformBufferData &uboData)
   bufferInfo.size = sizeof(VkUploadMatrices);
   bufferInfo.usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
 
+  /* stays mapped for the lifetime of the buffer */
   VmaAllocationCreateInfo vmaAllocInfo{};
   vmaAllocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+  vmaAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
 
-  VkResult result = vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo, &uboData.buffer, &uboData.bufferAlloc, nullptr);
+  VmaAllocationInfo allocInfo{};
+  VkResult result = vmaCreateBuffer(renderData.rdAllocator, &bufferInfo, &vmaAllocInfo, &uboData.buffer, &uboData.bufferAlloc, &allocInfo);
   if (result != VK_SUCCESS) {
     Logger::log(1, "%s error: could not allocate uniform buffer via VMA (error: %i)\n", __FUNCTION__, result);
     return false;
   }
 
+  uboData.mappedData = allocInfo.pMappedData;
+  uboData.bufferSize = sizeof(VkUploadMatrices);
+
   return true;
 }
 
 void UniformBuffer::uploadData(VkRenderData &renderData, VkUniformBufferData &uboData, VkUploadMatrices matrices) {
-  void* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, uboData.bufferAlloc, &data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map uniform buffer memory (error: %i)\n", __FUNCTION__, result);
-    return;
-  }
-  std::memcpy(data, &matrices, sizeof(VkUploadMatrices));
-  vmaUnmapMemory(renderData.rdAllocator, uboData.bufferAlloc);
+  std::memcpy(uboData.mappedData, &matrices, sizeof(VkUploadMatrices));
   vmaFlushAllocation(renderData.rdAllocator, uboData.bufferAlloc, 0, uboData.bufferSize);
-
 }
 
 void UniformBuffer::cleanup(VkRenderData& renderData, VkUniformBufferData &uboData) {
+  DescriptorCache::removeBuffer(renderData, uboData.buffer);
   vmaDestroyBuffer(renderData.rdAllocator, uboData.buffer, uboData.bufferAlloc);
 }
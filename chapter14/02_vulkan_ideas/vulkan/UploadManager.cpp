@@ -0,0 +1,353 @@
+#include <cstring>
+
+#include "UploadManager.h"
+#include "CommandPool.h"
+#include "CommandBuffer.h"
+#include "Texture.h"
+#include "Logger.h"
+
+bool UploadManager::init(VkRenderData &renderData) {
+  /* use graphics queue if we have no separate transfer queue */
+  vkb::QueueType transferQueue = renderData.rdHasDedicatedTransferQueue ? vkb::QueueType::transfer : vkb::QueueType::graphics;
+  if (!CommandPool::init(renderData, transferQueue, renderData.rdTransferCommandPool)) {
+    Logger::log(1, "%s error: could not create transfer command pool\n", __FUNCTION__);
+    return false;
+  }
+  return true;
+}
+
+bool UploadManager::beginBatch(VkRenderData &renderData) {
+  if (renderData.rdUploadBatchActive) {
+    Logger::log(1, "%s error: upload batch %i is still open\n", __FUNCTION__, renderData.rdActiveUploadBatch.id);
+    return false;
+  }
+
+  VkUploadBatch batch{};
+  batch.id = renderData.rdNextUploadBatch;
+
+  if (!CommandBuffer::init(renderData, renderData.rdTransferCommandPool, batch.commandBuffer)) {
+    Logger::log(1, "%s error: could not create upload command buffer\n", __FUNCTION__);
+    return false;
+  }
+
+  VkFenceCreateInfo fenceInfo{};
+  fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+  VkResult result = vkCreateFence(renderData.rdVkbDevice.device, &fenceInfo, nullptr, &batch.fence);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not create upload fence (error: %i)\n", __FUNCTION__, result);
+    CommandBuffer::cleanup(renderData, renderData.rdTransferCommandPool, batch.commandBuffer);
+    return false;
+  }
+
+  if (!CommandBuffer::beginSingleShot(batch.commandBuffer)) {
+    Logger::log(1, "%s error: could not begin upload command buffer\n", __FUNCTION__);
+    freeBatch(renderData, batch);
+    return false;
+  }
+
+  ++renderData.rdNextUploadBatch;
+  renderData.rdActiveUploadBatch = batch;
+  renderData.rdUploadBatchActive = true;
+  return true;
+}
+
+bool UploadManager::isBatchActive(VkRenderData &renderData) {
+  return renderData.rdUploadBatchActive;
+}
+
+bool UploadManager::uploadBuffer(VkRenderData &renderData, VkBuffer dstBuffer, const void* data, size_t dataSize) {
+  if (dataSize == 0) {
+    return true;
+  }
+
+  VkUploadBatch& batch = renderData.rdActiveUploadBatch;
+
+  VkBufferCreateInfo stagingBufferInfo{};
+  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+  stagingBufferInfo.size = dataSize;
+  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+
+  VmaAllocationCreateInfo stagingAllocInfo{};
+  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
+  stagingAllocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+  VkBuffer stagingBuffer;
+  VmaAllocation stagingBufferAlloc;
+  VmaAllocationInfo allocInfo{};
+
+  VkResult result = vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo,
+    &stagingBuffer, &stagingBufferAlloc, &allocInfo);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not allocate upload staging buffer via VMA (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+
+  std::memcpy(allocInfo.pMappedData, data, dataSize);
+  vmaFlushAllocation(renderData.rdAllocator, stagingBufferAlloc, 0, dataSize);
+
+  batch.stagingBuffers.emplace_back(stagingBuffer);
+  batch.stagingBufferAllocs.emplace_back(stagingBufferAlloc);
+  batch.dstBuffers.emplace_back(dstBuffer);
+
+  VkBufferCopy copyRegion{};
+  copyRegion.srcOffset = 0;
+  copyRegion.dstOffset = 0;
+  copyRegion.size = dataSize;
+  vkCmdCopyBuffer(batch.commandBuffer, stagingBuffer, dstBuffer, 1, &copyRegion);
+
+  /* release half of the queue ownership transfer, the acquire is recorded on the graphics queue */
+  if (renderData.rdHasDedicatedTransferQueue) {
+    VkBufferMemoryBarrier releaseBarrier{};
+    releaseBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    releaseBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    releaseBarrier.dstAccessMask = 0;
+    releaseBarrier.srcQueueFamilyIndex = renderData.rdTransferQueueFamily;
+    releaseBarrier.dstQueueFamilyIndex = renderData.rdGraphicsQueueFamily;
+    releaseBarrier.buffer = dstBuffer;
+    releaseBarrier.offset = 0;
+    releaseBarrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(batch.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+      0, 0, nullptr, 1, &releaseBarrier, 0, nullptr);
+  }
+
+  return true;
+}
+
+bool UploadManager::uploadImage(VkRenderData &renderData, VkImage dstImage, VkBuffer stagingBuffer,
+    VmaAllocation stagingBufferAlloc, uint32_t width, uint32_t height, uint32_t mipmapLevels) {
+  VkUploadBatch& batch = renderData.rdActiveUploadBatch;
+
+  batch.stagingBuffers.emplace_back(stagingBuffer);
+  batch.stagingBufferAllocs.emplace_back(stagingBufferAlloc);
+  batch.dstImages.emplace_back(VkUploadImage{dstImage, width, height, mipmapLevels});
+
+  VkImageSubresourceRange imageRange{};
+  imageRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  imageRange.baseMipLevel = 0;
+  imageRange.levelCount = mipmapLevels;
+  imageRange.baseArrayLayer = 0;
+  imageRange.layerCount = 1;
+
+  /* undefined to transfer optimal */
+  VkImageMemoryBarrier transferBarrier{};
+  transferBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  transferBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+  transferBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+  transferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  transferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  transferBarrier.image = dstImage;
+  transferBarrier.subresourceRange = imageRange;
+  transferBarrier.srcAccessMask = 0;
+  transferBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  VkBufferImageCopy imageCopy{};
+  imageCopy.bufferOffset = 0;
+  imageCopy.bufferRowLength = 0;
+  imageCopy.bufferImageHeight = 0;
+  imageCopy.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  imageCopy.imageSubresource.mipLevel = 0;
+  imageCopy.imageSubresource.baseArrayLayer = 0;
+  imageCopy.imageSubresource.layerCount = 1;
+  imageCopy.imageExtent = { width, height, 1 };
+
+  vkCmdPipelineBarrier(batch.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+    0, 0, nullptr, 0, nullptr, 1, &transferBarrier);
+  vkCmdCopyBufferToImage(batch.commandBuffer, stagingBuffer, dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageCopy);
+
+  /* release must use the same layouts as the acquire, vkCmdBlitImage() is not available on transfer queues */
+  if (renderData.rdHasDedicatedTransferQueue) {
+    VkImageMemoryBarrier releaseBarrier{};
+    releaseBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    releaseBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    releaseBarrier.newLayout = mipmapLevels > 1 ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    releaseBarrier.srcQueueFamilyIndex = renderData.rdTransferQueueFamily;
+    releaseBarrier.dstQueueFamilyIndex = renderData.rdGraphicsQueueFamily;
+    releaseBarrier.image = dstImage;
+    releaseBarrier.subresourceRange = imageRange;
+    releaseBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    releaseBarrier.dstAccessMask = 0;
+
+    vkCmdPipelineBarrier(batch.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+      0, 0, nullptr, 0, nullptr, 1, &releaseBarrier);
+  }
+
+  return true;
+}
+
+bool UploadManager::submitBatch(VkRenderData &renderData, uint64_t &batchId) {
+  if (!renderData.rdUploadBatchActive) {
+    Logger::log(1, "%s error: no upload batch open\n", __FUNCTION__);
+    return false;
+  }
+  renderData.rdUploadBatchActive = false;
+
+  VkUploadBatch batch = renderData.rdActiveUploadBatch;
+  renderData.rdActiveUploadBatch = {};
+
+  if (!CommandBuffer::end(batch.commandBuffer)) {
+    Logger::log(1, "%s error: could not end upload command buffer\n", __FUNCTION__);
+    freeBatch(renderData, batch);
+    return false;
+  }
+
+  VkSubmitInfo submitInfo{};
+  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+  submitInfo.commandBufferCount = 1;
+  submitInfo.pCommandBuffers = &batch.commandBuffer;
+
+  /* no wait here, the fence is polled once per frame */
+  VkResult result = vkQueueSubmit(renderData.rdTransferQueue, 1, &submitInfo, batch.fence);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not submit upload batch %i (error: %i)\n", __FUNCTION__, batch.id, result);
+    freeBatch(renderData, batch);
+    return false;
+  }
+
+  Logger::log(1, "%s: submitted upload batch %i with %i buffers and %i images\n", __FUNCTION__, batch.id,
+    batch.dstBuffers.size(), batch.dstImages.size());
+
+  batchId = batch.id;
+  renderData.rdSubmittedUploadBatches.emplace_back(batch);
+  return true;
+}
+
+void UploadManager::recordAcquireBarriers(VkRenderData &renderData, VkCommandBuffer &commandBuffer, VkUploadBatch &batch) {
+  /* without a dedicated queue this is a plain barrier, the copies ran on the graphics queue */
+  bool ownershipTransfer = renderData.rdHasDedicatedTransferQueue;
+  uint32_t srcQueueFamily = ownershipTransfer ? renderData.rdTransferQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+  uint32_t dstQueueFamily = ownershipTransfer ? renderData.rdGraphicsQueueFamily : VK_QUEUE_FAMILY_IGNORED;
+  VkAccessFlags srcAccessMask = ownershipTransfer ? 0 : VK_ACCESS_TRANSFER_WRITE_BIT;
+  VkPipelineStageFlags srcStageMask = ownershipTransfer ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+  std::vector<VkBufferMemoryBarrier> bufferBarriers{};
+  for (const auto& buffer : batch.dstBuffers) {
+    VkBufferMemoryBarrier acquireBarrier{};
+    acquireBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    acquireBarrier.srcAccessMask = srcAccessMask;
+    acquireBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT;
+    acquireBarrier.srcQueueFamilyIndex = srcQueueFamily;
+    acquireBarrier.dstQueueFamilyIndex = dstQueueFamily;
+    acquireBarrier.buffer = buffer;
+    acquireBarrier.offset = 0;
+    acquireBarrier.size = VK_WHOLE_SIZE;
+    bufferBarriers.emplace_back(acquireBarrier);
+  }
+
+  std::vector<VkImageMemoryBarrier> imageBarriers{};
+  for (const auto& image : batch.dstImages) {
+    VkImageMemoryBarrier acquireBarrier{};
+    acquireBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    acquireBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    acquireBarrier.srcQueueFamilyIndex = srcQueueFamily;
+    acquireBarrier.dstQueueFamilyIndex = dstQueueFamily;
+    acquireBarrier.image = image.image;
+    acquireBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    acquireBarrier.subresourceRange.baseMipLevel = 0;
+    acquireBarrier.subresourceRange.levelCount = image.mipmapLevels;
+    acquireBarrier.subresourceRange.baseArrayLayer = 0;
+    acquireBarrier.subresourceRange.layerCount = 1;
+    acquireBarrier.srcAccessMask = srcAccessMask;
+
+    /* the mip levels are created by blits on the graphics queue */
+    if (image.mipmapLevels > 1) {
+      acquireBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+      acquireBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    } else {
+      acquireBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+      acquireBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+    }
+    imageBarriers.emplace_back(acquireBarrier);
+  }
+
+  if (bufferBarriers.empty() && imageBarriers.empty()) {
+    return;
+  }
+
+  vkCmdPipelineBarrier(commandBuffer, srcStageMask,
+    VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+    0, nullptr,
+    static_cast<uint32_t>(bufferBarriers.size()), bufferBarriers.data(),
+    static_cast<uint32_t>(imageBarriers.size()), imageBarriers.data());
+
+  for (const auto& image : batch.dstImages) {
+    if (image.mipmapLevels > 1) {
+      Texture::recordMipmapGeneration(commandBuffer, image.image, image.width, image.height, image.mipmapLevels);
+    }
+  }
+}
+
+bool UploadManager::recordFinishedBatches(VkRenderData &renderData, VkCommandBuffer &commandBuffer) {
+  bool hasCommands = false;
+
+  /* batches are handed over in submission order, the finished batch id only grows */
+  auto batchIter = renderData.rdSubmittedUploadBatches.begin();
+  while (batchIter != renderData.rdSubmittedUploadBatches.end()) {
+    VkResult result = vkGetFenceStatus(renderData.rdVkbDevice.device, batchIter->fence);
+    if (result == VK_NOT_READY) {
+      break;
+    }
+    if (result != VK_SUCCESS) {
+      Logger::log(1, "%s error: could not get status of upload batch %i (error: %i)\n", __FUNCTION__, batchIter->id, result);
+      break;
+    }
+
+    if (!hasCommands) {
+      if (!CommandBuffer::reset(commandBuffer, 0)) {
+        Logger::log(1, "%s error: failed to reset acquire command buffer\n", __FUNCTION__);
+        return false;
+      }
+
+      if (!CommandBuffer::beginSingleShot(commandBuffer)) {
+        Logger::log(1, "%s error: failed to begin acquire command buffer\n", __FUNCTION__);
+        return false;
+      }
+      hasCommands = true;
+    }
+
+    recordAcquireBarriers(renderData, commandBuffer, *batchIter);
+    renderData.rdFinishedUploadBatch = batchIter->id;
+    Logger::log(1, "%s: upload batch %i finished\n", __FUNCTION__, batchIter->id);
+
+    freeBatch(renderData, *batchIter);
+    batchIter = renderData.rdSubmittedUploadBatches.erase(batchIter);
+  }
+
+  if (hasCommands && !CommandBuffer::end(commandBuffer)) {
+    Logger::log(1, "%s error: failed to end acquire command buffer\n", __FUNCTION__);
+    return false;
+  }
+
+  return hasCommands;
+}
+
+bool UploadManager::isBatchFinished(VkRenderData &renderData, uint64_t batchId) {
+  return batchId <= renderData.rdFinishedUploadBatch;
+}
+
+void UploadManager::freeBatch(VkRenderData &renderData, VkUploadBatch &batch) {
+  for (unsigned int i = 0; i < batch.stagingBuffers.size(); ++i) {
+    vmaDestroyBuffer(renderData.rdAllocator, batch.stagingBuffers.at(i), batch.stagingBufferAllocs.at(i));
+  }
+  batch.stagingBuffers.clear();
+  batch.stagingBufferAllocs.clear();
+
+  CommandBuffer::cleanup(renderData, renderData.rdTransferCommandPool, batch.commandBuffer);
+  vkDestroyFence(renderData.rdVkbDevice.device, batch.fence, nullptr);
+}
+
+void UploadManager::cleanup(VkRenderData &renderData) {
+  /* device is idle here, pending acquires are not needed anymore */
+  for (auto& batch : renderData.rdSubmittedUploadBatches) {
+    freeBatch(renderData, batch);
+  }
+  renderData.rdSubmittedUploadBatches.clear();
+
+  if (renderData.rdUploadBatchActive) {
+    freeBatch(renderData, renderData.rdActiveUploadBatch);
+    renderData.rdUploadBatchActive = false;
+  }
+
+  CommandPool::cleanup(renderData, renderData.rdTransferCommandPool);
+}
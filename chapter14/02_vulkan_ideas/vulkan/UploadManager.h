@@ -0,0 +1,36 @@
+/* Vulkan background uploads for models, levels and their textures */
+#pragma once
+
+#include <cstdint>
+#include <vulkan/vulkan.h>
+#include <vk_mem_alloc.h>
+
+#include "VkRenderData.h"
+
+class UploadManager {
+  public:
+    static bool init(VkRenderData &renderData);
+
+    /* collect all following vertex, index and texture uploads into one batch */
+    static bool beginBatch(VkRenderData &renderData);
+    static bool isBatchActive(VkRenderData &renderData);
+
+    static bool uploadBuffer(VkRenderData &renderData, VkBuffer dstBuffer, const void* data, size_t dataSize);
+    /* takes over the staging buffer, it will be destroyed when the batch has finished */
+    static bool uploadImage(VkRenderData &renderData, VkImage dstImage, VkBuffer stagingBuffer,
+      VmaAllocation stagingBufferAlloc, uint32_t width, uint32_t height, uint32_t mipmapLevels);
+
+    /* submits the batch without waiting for it */
+    static bool submitBatch(VkRenderData &renderData, uint64_t &batchId);
+
+    /* hands all finished batches over to the graphics queue, returns false if there is nothing to submit */
+    static bool recordFinishedBatches(VkRenderData &renderData, VkCommandBuffer &commandBuffer);
+    /* resources of the batch can be used by commands recorded from now on */
+    static bool isBatchFinished(VkRenderData &renderData, uint64_t batchId);
+
+    static void cleanup(VkRenderData &renderData);
+
+  private:
+    static void recordAcquireBarriers(VkRenderData &renderData, VkCommandBuffer &commandBuffer, VkUploadBatch &batch);
+    static void freeBatch(VkRenderData &renderData, VkUploadBatch &batch);
+};
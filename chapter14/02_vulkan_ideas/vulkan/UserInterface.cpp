@@ -626,6 +626,17 @@ void UserInterface::createSettingsWindow(VkRenderData& renderData, ModelInstance
 
     std::string windowDims = std::to_string(renderData.rdWidth) + "x" + std::to_string(renderData.rdHeight);
     ImGui::Text("Window Dimensions:      %10s", windowDims.c_str());
+    ImGui::Text("Frames in Flight:       %10i", renderData.rdFramesInFlight);
+    ImGui::Text("Command Record Jobs:    %10i", renderData.rdRecordJobs);
+    ImGui::Text("Transfer Queue:         %10s", renderData.rdHasDedicatedTransferQueue ? "dedicated" : "shared");
+    ImGui::Text("Pending Upload Batches: %10i", renderData.rdSubmittedUploadBatches.size());
+    ImGui::Text("Descriptor Writes:      %10i (%i skipped)", renderData.rdDescriptorWrites,
+      renderData.rdDescriptorWritesSkipped);
+    ImGui::Text("Pipeline Creation:      %10.2f ms (%s)", renderData.rdPipelineCreateTime,
+      renderData.rdPipelineCacheLoaded ? "cached" : "uncached");
+    if (renderData.rdPipelineCacheLoaded) {
+      ImGui::Text("Pipeline Cache Saved:   %10.2f ms", renderData.rdPipelineUncachedCreateTime - renderData.rdPipelineCreateTime);
+    }
 
     std::string imgWindowPos = std::to_string(static_cast<int>(ImGui::GetWindowPos().x)) + "/" + std::to_string(static_cast<int>(ImGui::GetWindowPos().y));
     ImGui::Text("ImGui Window Position:  %10s", imgWindowPos.c_str());
@@ -930,6 +941,19 @@ void UserInterface::createSettingsWindow(VkRenderData& renderData, ModelInstance
         pathFindingOverlay.c_str(), 0.0f, std::numeric_limits<float>::max(), ImVec2(0, 80));
       ImGui::EndTooltip();
     }
+
+    ImGui::Text("Command Recording:       %10.4f ms", renderData.rdCommandRecordTime);
+
+    /* GPU times are measured with timestamp queries and lag one frame in flight behind */
+    ImGui::Separator();
+    float gpuFrameTime = 0.0f;
+    for (int i = 0; i < static_cast<int>(gpuPass::NUM); ++i) {
+      gpuPass pass = static_cast<gpuPass>(i);
+      float passTime = renderData.rdGpuPassTimes.at(i);
+      gpuFrameTime += passTime;
+      ImGui::Text("GPU %-20s %10.4f ms", (renderData.rdGpuPassNameMap[pass] + ":").c_str(), passTime);
+    }
+    ImGui::Text("GPU Frame Time:          %10.4f ms", gpuFrameTime);
   }
 
   if (ImGui::CollapsingHeader("Music & Sound")) {
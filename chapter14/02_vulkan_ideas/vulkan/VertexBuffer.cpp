@@ -1,7 +1,6 @@
-#include <cstring>
-
 #include "VertexBuffer.h"
-#include "CommandBuffer.h"
+#include "StagingBuffer.h"
+#include "UploadManager.h"
 #include "Logger.h"
 
 bool VertexBuffer::init(VkRenderData &renderData, VkVertexBufferData &vertexBufferData,
@@ -28,22 +27,6 @@ bool VertexBuffer::init(VkRenderData &renderData, VkVertexBufferData &vertexBuff
     return false;
   }
 
-  /* staging buffer for copy */
-  VkBufferCreateInfo stagingBufferInfo{};
-  stagingBufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-  stagingBufferInfo.size = bufferSize;;
-  stagingBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-
-  VmaAllocationCreateInfo stagingAllocInfo{};
-  stagingAllocInfo.usage = VMA_MEMORY_USAGE_CPU_ONLY;
-
-  result = vmaCreateBuffer(renderData.rdAllocator, &stagingBufferInfo, &stagingAllocInfo,
-    &vertexBufferData.stagingBuffer, &vertexBufferData.stagingBufferAlloc, nullptr);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not allocate vertex staging buffer via VMA (error: %i)\n",
-      __FUNCTION__, result);
-    return false;
-  }
   vertexBufferData.bufferSize = bufferSize;
   return true;
 }
@@ -65,19 +48,13 @@ bool VertexBuffer::uploadData(VkRenderData& renderData, VkVertexBufferData &vert
     vertexBufferData.bufferSize = vertexDataSize;
   }
 
-  /* copy data to staging buffer */
-  void* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc, &data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map memory (error: %i)\n", __FUNCTION__, result);
-    return false;
+  /* model and level meshes are copied in the background while a batch is open */
+  if (UploadManager::isBatchActive(renderData)) {
+    return UploadManager::uploadBuffer(renderData, vertexBufferData.buffer, vertexData.vertices.data(), vertexDataSize);
   }
-  std::memcpy(data, vertexData.vertices.data(), vertexDataSize);
-  vmaUnmapMemory(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc);
-  vmaFlushAllocation(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc, 0, vertexDataSize);
 
-  /* trigger upload */
-  return uploadToGPU(renderData, vertexBufferData);
+  /* copy via the staging ring, submitted with the frame */
+  return StagingBuffer::upload(renderData, vertexBufferData.buffer, vertexData.vertices.data(), vertexDataSize);
 }
 
 bool VertexBuffer::uploadData(VkRenderData& renderData, VkVertexBufferData &vertexBufferData,
@@ -97,19 +74,8 @@ bool VertexBuffer::uploadData(VkRenderData& renderData, VkVertexBufferData &vert
     vertexBufferData.bufferSize = vertexDataSize;
   }
 
-  /* copy data to staging buffer */
-  void* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc, &data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map memory (error: %i)\n", __FUNCTION__, result);
-    return false;
-  }
-  std::memcpy(data, vertexData.vertices.data(), vertexDataSize);
-  vmaUnmapMemory(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc);
-  vmaFlushAllocation(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc, 0, vertexDataSize);
-
-  /* trigger upload */
-  return uploadToGPU(renderData, vertexBufferData);
+  /* copy via the staging ring, submitted with the frame */
+  return StagingBuffer::upload(renderData, vertexBufferData.buffer, vertexData.vertices.data(), vertexDataSize);
 }
 
 bool VertexBuffer::uploadData(VkRenderData& renderData, VkVertexBufferData &vertexBufferData,
@@ -129,19 +95,8 @@ bool VertexBuffer::uploadData(VkRenderData& renderData, VkVertexBufferData &vert
     vertexBufferData.bufferSize = vertexDataSize;
   }
 
-  /* copy data to staging buffer */
-  void* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc, &data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map memory (error: %i)\n", __FUNCTION__, result);
-    return false;
-  }
-  std::memcpy(data, vertexData.vertices.data(), vertexDataSize);
-  vmaUnmapMemory(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc);
-  vmaFlushAllocation(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc, 0, vertexDataSize);
-
-  /* trigger upload */
-  return uploadToGPU(renderData, vertexBufferData);
+  /* copy via the staging ring, submitted with the frame */
+  return StagingBuffer::upload(renderData, vertexBufferData.buffer, vertexData.vertices.data(), vertexDataSize);
 }
 
 bool VertexBuffer::uploadData(VkRenderData& renderData, VkVertexBufferData &vertexBufferData,
@@ -161,53 +116,11 @@ bool VertexBuffer::uploadData(VkRenderData& renderData, VkVertexBufferData &vert
     vertexBufferData.bufferSize = vertexDataSize;
   }
 
-  /* copy data to staging buffer */
-  void* data;
-  VkResult result = vmaMapMemory(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc, &data);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: could not map memory (error: %i)\n", __FUNCTION__, result);
-    return false;
-  }
-  std::memcpy(data, vertexData.data(), vertexDataSize);
-  vmaUnmapMemory(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc);
-  vmaFlushAllocation(renderData.rdAllocator, vertexBufferData.stagingBufferAlloc, 0, vertexDataSize);
-
-  /* trigger upload */
-  return uploadToGPU(renderData, vertexBufferData);
-}
-
-bool VertexBuffer::uploadToGPU(VkRenderData &renderData, VkVertexBufferData &vertexBufferData) {
-  VkBufferMemoryBarrier vertexBufferBarrier{};
-  vertexBufferBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-  vertexBufferBarrier.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
-  vertexBufferBarrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-  vertexBufferBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  vertexBufferBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  vertexBufferBarrier.buffer = vertexBufferData.stagingBuffer;
-  vertexBufferBarrier.offset = 0;
-  vertexBufferBarrier.size = vertexBufferData.bufferSize;
-
-  VkBufferCopy stagingBufferCopy{};
-  stagingBufferCopy.srcOffset = 0;
-  stagingBufferCopy.dstOffset = 0;
-  stagingBufferCopy.size = vertexBufferData.bufferSize;
-
-  /* trigger data transfer via command buffer */
-  VkCommandBuffer commandBuffer = CommandBuffer::createSingleShotBuffer(renderData, renderData.rdCommandPool);
-
-  vkCmdCopyBuffer(commandBuffer, vertexBufferData.stagingBuffer,
-   vertexBufferData.buffer, 1, &stagingBufferCopy);
-  vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
-    VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1, &vertexBufferBarrier, 0, nullptr);
-
-  if (!CommandBuffer::submitSingleShotBuffer(renderData, renderData.rdCommandPool, commandBuffer, renderData.rdGraphicsQueue)) {
-    return false;
-  }
-
-  return true;
+  /* copy via the staging ring, submitted with the frame */
+  return StagingBuffer::upload(renderData, vertexBufferData.buffer, vertexData.data(), vertexDataSize);
 }
 
 void VertexBuffer::cleanup(VkRenderData &renderData, VkVertexBufferData &vertexBufferData) {
-  vmaDestroyBuffer(renderData.rdAllocator, vertexBufferData.stagingBuffer, vertexBufferData.stagingBufferAlloc);
+  StagingBuffer::removePendingCopies(renderData, vertexBufferData.buffer);
   vmaDestroyBuffer(renderData.rdAllocator, vertexBufferData.buffer, vertexBufferData.bufferAlloc);
 }
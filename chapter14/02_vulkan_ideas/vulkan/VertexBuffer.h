@@ -21,7 +21,4 @@ class VertexBuffer {
       std::vector<glm::vec3> vetrexData);
 
     static void cleanup(VkRenderData &renderData, VkVertexBufferData &vertexBufferData);
-
-  private:
-    static bool uploadToGPU(VkRenderData &renderData, VkVertexBufferData &vertexBufferData);
 };
@@ -117,6 +117,9 @@ struct VkTextureData {
   VkSampler sampler = VK_NULL_HANDLE;
   VmaAllocation imageAlloc = nullptr;
 
+  /* slot of 2D textures in the global texture array */
+  uint32_t textureIndex = 0;
+  /* own descriptor set, cubemaps only */
   VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
 };
 
@@ -125,30 +128,84 @@ struct VkVertexBufferData {
   void* data = nullptr;
   VkBuffer buffer = VK_NULL_HANDLE;
   VmaAllocation bufferAlloc = VK_NULL_HANDLE;
-  VkBuffer stagingBuffer = VK_NULL_HANDLE;
-  VmaAllocation stagingBufferAlloc = VK_NULL_HANDLE;
 };
 
 struct VkIndexBufferData {
   size_t bufferSize = 0;
   VkBuffer buffer = VK_NULL_HANDLE;
   VmaAllocation bufferAlloc = nullptr;
-  VkBuffer stagingBuffer = VK_NULL_HANDLE;
-  VmaAllocation stagingBufferAlloc = nullptr;
+};
+
+/* copy from the staging ring into a device local buffer */
+struct VkStagingCopy {
+  VkBuffer dstBuffer = VK_NULL_HANDLE;
+  VkBufferCopy region{};
+};
+
+struct VkStagingBufferData {
+  size_t bufferSize = 0;
+  size_t offset = 0;
+  VkBuffer buffer = VK_NULL_HANDLE;
+  VmaAllocation bufferAlloc = nullptr;
+  void* mappedData = nullptr;
+
+  std::vector<VkStagingCopy> pendingCopies{};
+};
+
+/* host-visible copy target, read after the fence of the frame has signaled */
+struct VkReadbackBufferData {
+  VkBuffer buffer = VK_NULL_HANDLE;
+  VmaAllocation bufferAlloc = nullptr;
+  void* mappedData = nullptr;
+  bool pending = false;
+};
+
+/* image copied by an upload batch, waiting for mip generation on the graphics queue */
+struct VkUploadImage {
+  VkImage image = VK_NULL_HANDLE;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t mipmapLevels = 1;
+};
+
+/* model, level and texture uploads submitted together to the transfer queue */
+struct VkUploadBatch {
+  uint64_t id = 0;
+  VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+  VkFence fence = VK_NULL_HANDLE;
+
+  std::vector<VkBuffer> stagingBuffers{};
+  std::vector<VmaAllocation> stagingBufferAllocs{};
+
+  std::vector<VkBuffer> dstBuffers{};
+  std::vector<VkUploadImage> dstImages{};
 };
 
 struct VkUniformBufferData {
   size_t bufferSize = 0;
   VkBuffer buffer = VK_NULL_HANDLE;
   VmaAllocation bufferAlloc = nullptr;
+  /* persistently mapped, written directly */
+  void* mappedData = nullptr;
 
   VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
 };
 
+/* old SSBO of a resize, destroyed when no frame in flight can read it anymore */
+struct VkPendingBufferDeletion {
+  VkBuffer buffer = VK_NULL_HANDLE;
+  VmaAllocation bufferAlloc = nullptr;
+  unsigned int framesLeft = 0;
+};
+
 struct VkShaderStorageBufferData {
   size_t bufferSize = 0;
   VkBuffer buffer = VK_NULL_HANDLE;
   VmaAllocation bufferAlloc = nullptr;
+  /* persistently mapped, written and read directly */
+  void* mappedData = nullptr;
+  /* one buffer per frame in flight, the frame fence guards it and a resize may destroy it at once */
+  bool perFrameBuffer = false;
 
   VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
 };
@@ -159,10 +216,58 @@ struct VkPushConstants {
   uint32_t pkSkinMatOffset;
 };
 
+/* fragment shader range, placed after the vertex shader push constants */
+struct VkTexturePushConstants {
+  uint32_t pkTextureIndex;
+};
+
 struct VkComputePushConstants {
   uint32_t pkModelOffset;
   uint32_t pkInstanceOffset;
 };
+/* all Vulkan objects used once for every frame in flight */
+struct VkPerFrameData {
+  VkCommandBuffer pfCommandBuffer = VK_NULL_HANDLE;
+  VkCommandBuffer pfImGuiCommandBuffer = VK_NULL_HANDLE;
+  VkCommandBuffer pfLineCommandBuffer = VK_NULL_HANDLE;
+  VkCommandBuffer pfComputeCommandBuffer = VK_NULL_HANDLE;
+  VkCommandBuffer pfUploadCommandBuffer = VK_NULL_HANDLE;
+  VkCommandBuffer pfAcquireCommandBuffer = VK_NULL_HANDLE;
+
+  /* vertex and index uploads of this frame, copied in front of the graphics commands */
+  VkStagingBufferData pfStagingBuffer{};
+
+  /* selected instance id of a mouse pick in this frame */
+  VkReadbackBufferData pfSelectionReadback{};
+
+  /* one pool per recording job, every job records a level and a model secondary buffer */
+  std::vector<VkCommandPool> pfRecordCommandPools{};
+  std::vector<VkCommandBuffer> pfLevelCommandBuffers{};
+  std::vector<VkCommandBuffer> pfModelCommandBuffers{};
+
+  VkSemaphore pfPresentSemaphore = VK_NULL_HANDLE;
+  VkSemaphore pfRenderSemaphore = VK_NULL_HANDLE;
+  VkSemaphore pfComputeSemaphore = VK_NULL_HANDLE;
+  VkFence pfRenderFence = VK_NULL_HANDLE;
+  VkFence pfComputeFence = VK_NULL_HANDLE;
+
+  /* descriptor sets referencing the per-frame UBO and SSBOs */
+  VkDescriptorSet pfAssimpDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpSkinningDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpComputeTransformDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpComputeMatrixMultDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpSelectionDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpSkinningSelectionDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpSkinningMorphDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpSkinningMorphSelectionDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpComputeBoundingSpheresDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfAssimpLevelDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfLineDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfSphereDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfGroundMeshDescriptorSet = VK_NULL_HANDLE;
+  VkDescriptorSet pfSkyboxDescriptorSet = VK_NULL_HANDLE;
+};
+
 struct VkRenderData {
   GLFWwindow *rdWindow = nullptr;
 
@@ -190,6 +295,11 @@ struct VkRenderData {
   float rdIKTime = 0.0f;
   float rdLevelGroundNeighborUpdateTime = 0.0f;
   float rdPathFindingTime = 0.0f;
+  float rdCommandRecordTime = 0.0f;
+
+  /* GPU execution time per pass, read when the frame in flight is used again */
+  std::array<float, static_cast<size_t>(gpuPass::NUM)> rdGpuPassTimes{};
+  std::unordered_map<gpuPass, std::string> rdGpuPassNameMap{};
 
   int rdMoveForward = 0;
   int rdMoveRight = 0;
@@ -304,6 +414,10 @@ struct VkRenderData {
   VkQueue rdGraphicsQueue = VK_NULL_HANDLE;
   VkQueue rdPresentQueue = VK_NULL_HANDLE;
   VkQueue rdComputeQueue = VK_NULL_HANDLE;
+  VkQueue rdTransferQueue = VK_NULL_HANDLE;
+  bool rdHasDedicatedTransferQueue = false;
+  uint32_t rdGraphicsQueueFamily = 0;
+  uint32_t rdTransferQueueFamily = 0;
 
   VkImage rdDepthImage = VK_NULL_HANDLE;
   VkImageView rdDepthImageView = VK_NULL_HANDLE;
@@ -353,16 +467,52 @@ struct VkRenderData {
   VkPipeline rdGroundMeshPipeline = VK_NULL_HANDLE;
   VkPipeline rdSkyboxPipeline = VK_NULL_HANDLE;
 
+  /* shared by all pipelines, loaded from and saved to disk */
+  VkPipelineCache rdPipelineCache = VK_NULL_HANDLE;
+  bool rdPipelineCacheLoaded = false;
+  float rdPipelineCreateTime = 0.0f;
+  float rdPipelineUncachedCreateTime = 0.0f;
+
   VkCommandPool rdCommandPool = VK_NULL_HANDLE;
   VkCommandPool rdComputeCommandPool = VK_NULL_HANDLE;
+
+  /* between 2 and 3, set from the command line by VkRenderer::init() */
+  unsigned int rdFramesInFlight = 2;
+  unsigned int rdCurrentFrame = 0;
+  std::vector<VkPerFrameData> rdPerFrameData{};
+
+  /* number of parallel jobs recording the level and model secondary command buffers */
+  unsigned int rdRecordJobs = 1;
+
+  /* set while a frame is recorded, staging ring copies are then submitted with the frame */
+  bool rdDeferUploads = false;
+
+  /* background uploads, batches up to rdFinishedUploadBatch can be drawn */
+  VkCommandPool rdTransferCommandPool = VK_NULL_HANDLE;
+  bool rdUploadBatchActive = false;
+  VkUploadBatch rdActiveUploadBatch{};
+  std::vector<VkUploadBatch> rdSubmittedUploadBatches{};
+  uint64_t rdNextUploadBatch = 1;
+  uint64_t rdFinishedUploadBatch = 0;
+
+  /* buffer currently written to each binding of a descriptor set, unchanged writes are skipped */
+  std::map<std::pair<VkDescriptorSet, uint32_t>, VkBuffer> rdDescriptorBufferCache{};
+  unsigned int rdDescriptorWrites = 0;
+  unsigned int rdDescriptorWritesSkipped = 0;
+
+  /* shared SSBOs replaced by a resize, see ShaderStorageBuffer::destroyPendingBuffers() */
+  std::vector<VkPendingBufferDeletion> rdPendingBufferDeletions{};
+
+  /* handles of the frame currently recorded, copied from rdPerFrameData */
   VkCommandBuffer rdCommandBuffer = VK_NULL_HANDLE;
   VkCommandBuffer rdImGuiCommandBuffer = VK_NULL_HANDLE;
   VkCommandBuffer rdLineCommandBuffer = VK_NULL_HANDLE;
   VkCommandBuffer rdComputeCommandBuffer = VK_NULL_HANDLE;
+  VkCommandBuffer rdUploadCommandBuffer = VK_NULL_HANDLE;
+  VkCommandBuffer rdAcquireCommandBuffer = VK_NULL_HANDLE;
 
   VkSemaphore rdPresentSemaphore = VK_NULL_HANDLE;
   VkSemaphore rdRenderSemaphore = VK_NULL_HANDLE;
-  VkSemaphore rdGraphicSemaphore = VK_NULL_HANDLE;
   VkSemaphore rdComputeSemaphore = VK_NULL_HANDLE;
   VkSemaphore rdCollisionSemaphore = VK_NULL_HANDLE;
   VkFence rdRenderFence = VK_NULL_HANDLE;
@@ -372,6 +522,7 @@ struct VkRenderData {
   VkDescriptorSetLayout rdAssimpDescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdAssimpSkinningDescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdAssimpTextureDescriptorLayout = VK_NULL_HANDLE;
+  VkDescriptorSetLayout rdGlobalTextureDescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdAssimpComputeTransformDescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdAssimpComputeTransformPerModelDescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdAssimpComputeMatrixMultDescriptorLayout = VK_NULL_HANDLE;
@@ -389,6 +540,7 @@ struct VkRenderData {
   VkDescriptorSetLayout rdGroundMeshDescriptorLayout = VK_NULL_HANDLE;
   VkDescriptorSetLayout rdSkyboxDescriptorLayout = VK_NULL_HANDLE;
 
+  /* sets also present in VkPerFrameData point to the current frame */
   VkDescriptorSet rdAssimpDescriptorSet = VK_NULL_HANDLE;
   VkDescriptorSet rdAssimpSkinningDescriptorSet = VK_NULL_HANDLE;
   VkDescriptorSet rdAssimpComputeTransformDescriptorSet = VK_NULL_HANDLE;
@@ -407,6 +559,13 @@ struct VkRenderData {
   VkDescriptorSet rdGroundMeshDescriptorSet = VK_NULL_HANDLE;
   VkDescriptorSet rdSkyboxDescriptorSet = VK_NULL_HANDLE;
 
+  /* bindless 2D textures, freed slots are reused before the array grows */
+  VkDescriptorSet rdGlobalTextureDescriptorSet = VK_NULL_HANDLE;
+  uint32_t rdMaxGlobalTextures = 4096;
+  uint32_t rdNextGlobalTextureIndex = 0;
+  std::vector<uint32_t> rdFreeGlobalTextureIndices{};
+
   VkDescriptorPool rdDescriptorPool = VK_NULL_HANDLE;
+  VkDescriptorPool rdGlobalTextureDescriptorPool = VK_NULL_HANDLE;
   VkDescriptorPool rdImguiDescriptorPool = VK_NULL_HANDLE;
 };
@@ -19,11 +19,15 @@
 #include "CommandPool.h"
 #include "CommandBuffer.h"
 #include "SyncObjects.h"
+#include "StagingBuffer.h"
+#include "UploadManager.h"
+#include "DescriptorCache.h"
 #include "Renderpass.h"
 #include "SecondaryRenderpass.h"
 #include "SelectionRenderpass.h"
 
 #include "PipelineLayout.h"
+#include "PipelineCache.h"
 #include "SkinningPipeline.h"
 #include "ComputePipeline.h"
 #include "LinePipeline.h"
@@ -41,7 +45,7 @@ VkRenderer::VkRenderer(GLFWwindow *window) {
   mRenderData.rdWindow = window;
 }
 
-bool VkRenderer::init(unsigned int width, unsigned int height) {
+bool VkRenderer::init(unsigned int width, unsigned int height, unsigned int framesInFlight) {
   /* randomize rand() and randomization for std::shuffle in navigation */
   std::srand(static_cast<int>(time(nullptr)));
   unsigned int seed = mRandomDevice();
@@ -51,6 +55,18 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
   mRenderData.mAppModeMap[appMode::edit] = "Edit";
   mRenderData.mAppModeMap[appMode::view] = "View";
 
+  mRenderData.rdGpuPassNameMap[gpuPass::level] = "Skybox and Level";
+  mRenderData.rdGpuPassNameMap[gpuPass::transformCompute] = "Transform Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::matrixCompute] = "Matrix Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::sphereTransformCompute] = "Sphere Transform Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::sphereMatrixCompute] = "Sphere Matrix Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::boundingSphereCompute] = "Bounding Sphere Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::ikCompute] = "IK Compute";
+  mRenderData.rdGpuPassNameMap[gpuPass::models] = "Models";
+  mRenderData.rdGpuPassNameMap[gpuPass::selection] = "Models (Selection)";
+  mRenderData.rdGpuPassNameMap[gpuPass::debugLines] = "Debug Lines";
+  mRenderData.rdGpuPassNameMap[gpuPass::ui] = "User Interface";
+
   /* save orig window title, add current mode */
   mOrigWindowTitle = mModelInstCamData.micGetWindowTitleFunction();
   setModeInWindowTitle();
@@ -89,6 +105,15 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  /* clamp to the supported range, every frame in flight gets its own set of per-frame objects */
+  mRenderData.rdFramesInFlight = std::clamp(framesInFlight, 2u, 3u);
+  mRenderData.rdPerFrameData.resize(mRenderData.rdFramesInFlight);
+  Logger::log(1, "%s: using %i frames in flight\n", __FUNCTION__, mRenderData.rdFramesInFlight);
+
+  /* every recording job needs its own command pool, pools must not be shared between threads */
+  mRenderData.rdRecordJobs = std::min(mRecordThreadPool.getNumThreads(), mMaxRecordJobs);
+  Logger::log(1, "%s: recording secondary command buffers with %i jobs\n", __FUNCTION__, mRenderData.rdRecordJobs);
+
   if (!createCommandPools()) {
     return false;
   }
@@ -97,6 +122,29 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
+  /* must be done BEFORE descriptor sets, selectFrame() copies all per-frame handles */
+  if (!createSyncObjects()) {
+    return false;
+  }
+
+  /* must be done BEFORE the first vertex or index buffer upload */
+  if (!StagingBuffer::init(mRenderData)) {
+    return false;
+  }
+
+  if (!UploadManager::init(mRenderData)) {
+    return false;
+  }
+
+  if (!SelectionFramebuffer::initReadbackBuffers(mRenderData)) {
+    return false;
+  }
+
+  /* not fatal, the GPU pass times just stay at zero */
+  if (!mGpuTimer.init(mRenderData)) {
+    Logger::log(1, "%s: GPU timer not available\n", __FUNCTION__);
+  }
+
   if (!createVertexBuffers()) {
     return false;
   }
@@ -129,15 +177,26 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
     return false;
   }
 
-  if (!createPipelines()) {
+  /* a missing or outdated cache file is not an error, we start with an empty cache */
+  if (!PipelineCache::init(mRenderData, mPipelineCacheFileName)) {
     return false;
   }
 
-  if (!createFramebuffer()) {
+  mPipelineCreateTimer.start();
+  if (!createPipelines()) {
     return false;
   }
+  mRenderData.rdPipelineCreateTime = mPipelineCreateTimer.stop();
 
-  if (!createSyncObjects()) {
+  if (mRenderData.rdPipelineCacheLoaded) {
+    Logger::log(1, "%s: pipelines created in %4.2f ms using the pipeline cache, saved %4.2f ms\n", __FUNCTION__,
+      mRenderData.rdPipelineCreateTime, mRenderData.rdPipelineUncachedCreateTime - mRenderData.rdPipelineCreateTime);
+  } else {
+    mRenderData.rdPipelineUncachedCreateTime = mRenderData.rdPipelineCreateTime;
+    Logger::log(1, "%s: pipelines created in %4.2f ms without pipeline cache\n", __FUNCTION__, mRenderData.rdPipelineCreateTime);
+  }
+
+  if (!createFramebuffer()) {
     return false;
   }
 
@@ -331,18 +390,6 @@ bool VkRenderer::init(unsigned int width, unsigned int height) {
   mGraphEditor = std::make_shared<GraphEditor>();
   Logger::log(1, "%s: graph editor initialized\n", __FUNCTION__);
 
-  /* signal graphics semaphore before doing anything else to be able to run compute submit */
-  VkSubmitInfo submitInfo{};
-  submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-  submitInfo.signalSemaphoreCount = 1;
-  submitInfo.pSignalSemaphores = &mRenderData.rdGraphicSemaphore;
-
-  VkResult result = vkQueueSubmit(mRenderData.rdGraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: failed to submit initial semaphore (%i)\n", __FUNCTION__, result);
-    return false;
-  }
-
   /* try to load the default configuration file */
   if (loadConfigFile(mDefaultConfigFileName)) {
     Logger::log(1, "%s: loaded default config file '%s'\n", __FUNCTION__, mDefaultConfigFileName.c_str());
@@ -813,10 +860,19 @@ bool VkRenderer::deviceInit() {
   VkPhysicalDeviceFeatures requiredFeatures{};
   requiredFeatures.samplerAnisotropy = VK_TRUE;
 
+  /* bindless textures: one global, partially bound texture array, updated while in use */
+  VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures{};
+  descriptorIndexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+  descriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+  descriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+  descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+
   /* just get the first available device */
   vkb::PhysicalDeviceSelector physicalDevSel{mRenderData.rdVkbInstance};
   auto firstPysicalDevSelRet = physicalDevSel
     .set_surface(mSurface)
+    .add_required_extension(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)
+    .add_required_extension_features(descriptorIndexingFeatures)
     .set_required_features(requiredFeatures)
     .select();
 
@@ -848,6 +904,21 @@ bool VkRenderer::deviceInit() {
   mMinSSBOOffsetAlignment = std::max(minSSBOOffsetAlignment, sizeof(glm::mat4));
   Logger::log(1, "%s: SSBO offset has been adjusted to %i bytes\n", __FUNCTION__, mMinSSBOOffsetAlignment);
 
+  /* the global texture array must fit into the update-after-bind limits */
+  VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProperties{};
+  descriptorIndexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+  VkPhysicalDeviceProperties2 physProperties{};
+  physProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+  physProperties.pNext = &descriptorIndexingProperties;
+  vkGetPhysicalDeviceProperties2(mRenderData.rdVkbPhysicalDevice.physical_device, &physProperties);
+
+  mRenderData.rdMaxGlobalTextures = std::min({ mRenderData.rdMaxGlobalTextures,
+    descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+    descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers,
+    descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+    descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSamplers });
+  Logger::log(1, "%s: global texture array has %i slots\n", __FUNCTION__, mRenderData.rdMaxGlobalTextures);
+
   vkb::DeviceBuilder devBuilder{mRenderData.rdVkbPhysicalDevice};
   auto devBuilderRet = devBuilder.build();
   if (!devBuilderRet) {
@@ -885,6 +956,21 @@ bool VkRenderer::getQueues() {
     mHasDedicatedComputeQueue = true;
   }
 
+  /* model and level uploads run on a separate transfer queue if available */
+  mRenderData.rdGraphicsQueueFamily = mRenderData.rdVkbDevice.get_queue_index(vkb::QueueType::graphics).value();
+  auto transferQueueRet = mRenderData.rdVkbDevice.get_queue(vkb::QueueType::transfer);
+  if (!transferQueueRet.has_value()) {
+    Logger::log(1, "%s: using shared graphics/transfer queue\n", __FUNCTION__);
+    mRenderData.rdTransferQueue = mRenderData.rdGraphicsQueue;
+    mRenderData.rdTransferQueueFamily = mRenderData.rdGraphicsQueueFamily;
+    mRenderData.rdHasDedicatedTransferQueue = false;
+  } else {
+    Logger::log(1, "%s: using separate transfer queue\n", __FUNCTION__);
+    mRenderData.rdTransferQueue = transferQueueRet.value();
+    mRenderData.rdTransferQueueFamily = mRenderData.rdVkbDevice.get_queue_index(vkb::QueueType::transfer).value();
+    mRenderData.rdHasDedicatedTransferQueue = true;
+  }
+
   return true;
 }
 
@@ -912,6 +998,23 @@ bool VkRenderer::createDescriptorPool() {
     return false;
   }
 
+  /* separate pool for the global texture array, update-after-bind sets need a flagged pool */
+  VkDescriptorPoolSize globalTexturePoolSize{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, mRenderData.rdMaxGlobalTextures };
+
+  VkDescriptorPoolCreateInfo globalTexturePoolInfo{};
+  globalTexturePoolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  globalTexturePoolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+  globalTexturePoolInfo.maxSets = 1;
+  globalTexturePoolInfo.poolSizeCount = 1;
+  globalTexturePoolInfo.pPoolSizes = &globalTexturePoolSize;
+
+  result = vkCreateDescriptorPool(mRenderData.rdVkbDevice.device, &globalTexturePoolInfo, nullptr,
+    &mRenderData.rdGlobalTextureDescriptorPool);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not init global texture descriptor pool (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+
   return true;
 }
 
@@ -919,7 +1022,7 @@ bool VkRenderer::createDescriptorLayouts() {
   VkResult result;
 
   {
-    /* texture */
+    /* single texture, only used by the skybox cubemap */
     VkDescriptorSetLayoutBinding assimpTextureBind{};
     assimpTextureBind.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     assimpTextureBind.binding = 0;
@@ -942,6 +1045,39 @@ bool VkRenderer::createDescriptorLayouts() {
     }
   }
 
+  {
+    /* global texture array, indexed by the texture index push constant */
+    VkDescriptorSetLayoutBinding globalTextureBind{};
+    globalTextureBind.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    globalTextureBind.binding = 0;
+    globalTextureBind.descriptorCount = mRenderData.rdMaxGlobalTextures;
+    globalTextureBind.pImmutableSamplers = nullptr;
+    globalTextureBind.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    /* unused slots stay empty, new textures are written while older frames are still in flight */
+    VkDescriptorBindingFlagsEXT globalTextureBindFlags =
+      VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT globalTextureBindFlagsInfo{};
+    globalTextureBindFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    globalTextureBindFlagsInfo.bindingCount = 1;
+    globalTextureBindFlagsInfo.pBindingFlags = &globalTextureBindFlags;
+
+    VkDescriptorSetLayoutCreateInfo globalTextureCreateInfo{};
+    globalTextureCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    globalTextureCreateInfo.pNext = &globalTextureBindFlagsInfo;
+    globalTextureCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    globalTextureCreateInfo.bindingCount = 1;
+    globalTextureCreateInfo.pBindings = &globalTextureBind;
+
+    result = vkCreateDescriptorSetLayout(mRenderData.rdVkbDevice.device, &globalTextureCreateInfo,
+      nullptr, &mRenderData.rdGlobalTextureDescriptorLayout);
+    if (result != VK_SUCCESS) {
+      Logger::log(1, "%s error: could not create global texture descriptor set layout (error: %i)\n", __FUNCTION__, result);
+      return false;
+    }
+  }
+
   {
     /* non-animated shader */
     VkDescriptorSetLayoutBinding assimpUboBind{};
@@ -1573,146 +1709,244 @@ bool VkRenderer::createDescriptorLayouts() {
 
 bool VkRenderer::createDescriptorSets() {
   {
-    /* non-animated models */
-    VkDescriptorSetAllocateInfo descriptorAllocateInfo{};
-    descriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    descriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    descriptorAllocateInfo.descriptorSetCount = 1;
-    descriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &descriptorAllocateInfo,
-        &mRenderData.rdAssimpDescriptorSet);
-     if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp descriptor set (error: %i)\n", __FUNCTION__, result);
+    /* global texture array, shared by all frames */
+    VkDescriptorSetAllocateInfo globalTextureAllocateInfo{};
+    globalTextureAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    globalTextureAllocateInfo.descriptorPool = mRenderData.rdGlobalTextureDescriptorPool;
+    globalTextureAllocateInfo.descriptorSetCount = 1;
+    globalTextureAllocateInfo.pSetLayouts = &mRenderData.rdGlobalTextureDescriptorLayout;
+
+    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &globalTextureAllocateInfo,
+      &mRenderData.rdGlobalTextureDescriptorSet);
+    if (result != VK_SUCCESS) {
+      Logger::log(1, "%s error: could not allocate global texture descriptor set (error: %i)\n", __FUNCTION__, result);
       return false;
     }
   }
 
-  {
-    /* animated models */
-    VkDescriptorSetAllocateInfo skinningDescriptorAllocateInfo{};
-    skinningDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    skinningDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    skinningDescriptorAllocateInfo.descriptorSetCount = 1;
-    skinningDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSkinningDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skinningDescriptorAllocateInfo,
-      &mRenderData.rdAssimpSkinningDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp Skinning descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
+  for (auto& frameData : mRenderData.rdPerFrameData) {
+    {
+      /* non-animated models */
+      VkDescriptorSetAllocateInfo descriptorAllocateInfo{};
+      descriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      descriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      descriptorAllocateInfo.descriptorSetCount = 1;
+      descriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &descriptorAllocateInfo,
+          &frameData.pfAssimpDescriptorSet);
+       if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
     }
-  }
 
-  {
-    /* selection, non-animated models */
-    VkDescriptorSetAllocateInfo selectionDescriptorAllocateInfo{};
-    selectionDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    selectionDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    selectionDescriptorAllocateInfo.descriptorSetCount = 1;
-    selectionDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSelectionDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &selectionDescriptorAllocateInfo,
-      &mRenderData.rdAssimpSelectionDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp selection descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
+    {
+      /* animated models */
+      VkDescriptorSetAllocateInfo skinningDescriptorAllocateInfo{};
+      skinningDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      skinningDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      skinningDescriptorAllocateInfo.descriptorSetCount = 1;
+      skinningDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSkinningDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skinningDescriptorAllocateInfo,
+        &frameData.pfAssimpSkinningDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp Skinning descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
     }
-  }
 
-  {
-    /* selection, animated models */
-    VkDescriptorSetAllocateInfo skinningSelectionDescriptorAllocateInfo{};
-    skinningSelectionDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    skinningSelectionDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    skinningSelectionDescriptorAllocateInfo.descriptorSetCount = 1;
-    skinningSelectionDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSkinningSelectionDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skinningSelectionDescriptorAllocateInfo,
-      &mRenderData.rdAssimpSkinningSelectionDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp skinning selection descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
+    {
+      /* selection, non-animated models */
+      VkDescriptorSetAllocateInfo selectionDescriptorAllocateInfo{};
+      selectionDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      selectionDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      selectionDescriptorAllocateInfo.descriptorSetCount = 1;
+      selectionDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSelectionDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &selectionDescriptorAllocateInfo,
+        &frameData.pfAssimpSelectionDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp selection descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
     }
-  }
 
-  {
-    /* animated and morphed models */
-    VkDescriptorSetAllocateInfo skinningMorphDescriptorAllocateInfo{};
-    skinningMorphDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    skinningMorphDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    skinningMorphDescriptorAllocateInfo.descriptorSetCount = 1;
-    skinningMorphDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSkinningMorphDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skinningMorphDescriptorAllocateInfo,
-      &mRenderData.rdAssimpSkinningMorphDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp morph skinning descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
+    {
+      /* selection, animated models */
+      VkDescriptorSetAllocateInfo skinningSelectionDescriptorAllocateInfo{};
+      skinningSelectionDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      skinningSelectionDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      skinningSelectionDescriptorAllocateInfo.descriptorSetCount = 1;
+      skinningSelectionDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSkinningSelectionDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skinningSelectionDescriptorAllocateInfo,
+        &frameData.pfAssimpSkinningSelectionDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp skinning selection descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
     }
-  }
 
-  {
-    /* selection, animated and morphed models */
-    VkDescriptorSetAllocateInfo skinningMorphSelectionDescriptorAllocateInfo{};
-    skinningMorphSelectionDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    skinningMorphSelectionDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    skinningMorphSelectionDescriptorAllocateInfo.descriptorSetCount = 1;
-    skinningMorphSelectionDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSkinningMorphSelectionDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skinningMorphSelectionDescriptorAllocateInfo,
-      &mRenderData.rdAssimpSkinningMorphSelectionDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp morph skinning selection descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
+    {
+      /* animated and morphed models */
+      VkDescriptorSetAllocateInfo skinningMorphDescriptorAllocateInfo{};
+      skinningMorphDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      skinningMorphDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      skinningMorphDescriptorAllocateInfo.descriptorSetCount = 1;
+      skinningMorphDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSkinningMorphDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skinningMorphDescriptorAllocateInfo,
+        &frameData.pfAssimpSkinningMorphDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp morph skinning descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
     }
-  }
 
-  {
-    /* level */
-    VkDescriptorSetAllocateInfo levelDescriptorAllocateInfo{};
-    levelDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    levelDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    levelDescriptorAllocateInfo.descriptorSetCount = 1;
-    levelDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpLevelDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &levelDescriptorAllocateInfo,
-      &mRenderData.rdAssimpLevelDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp Level descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
+    {
+      /* selection, animated and morphed models */
+      VkDescriptorSetAllocateInfo skinningMorphSelectionDescriptorAllocateInfo{};
+      skinningMorphSelectionDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      skinningMorphSelectionDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      skinningMorphSelectionDescriptorAllocateInfo.descriptorSetCount = 1;
+      skinningMorphSelectionDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpSkinningMorphSelectionDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skinningMorphSelectionDescriptorAllocateInfo,
+        &frameData.pfAssimpSkinningMorphSelectionDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp morph skinning selection descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
     }
-  }
 
-  {
-    /* ground-mesh drawing */
-    VkDescriptorSetAllocateInfo lineAllocateInfo{};
-    lineAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    lineAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    lineAllocateInfo.descriptorSetCount = 1;
-    lineAllocateInfo.pSetLayouts = &mRenderData.rdGroundMeshDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &lineAllocateInfo,
-      &mRenderData.rdGroundMeshDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp ground-mesh drawing descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
+    {
+      /* level */
+      VkDescriptorSetAllocateInfo levelDescriptorAllocateInfo{};
+      levelDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      levelDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      levelDescriptorAllocateInfo.descriptorSetCount = 1;
+      levelDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpLevelDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &levelDescriptorAllocateInfo,
+        &frameData.pfAssimpLevelDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp Level descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
     }
-  }
 
-  {
-    /* compute transform. global data */
-    VkDescriptorSetAllocateInfo computeTransformDescriptorAllocateInfo{};
-    computeTransformDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    computeTransformDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    computeTransformDescriptorAllocateInfo.descriptorSetCount = 1;
-    computeTransformDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpComputeTransformDescriptorLayout;
+    {
+      /* ground-mesh drawing */
+      VkDescriptorSetAllocateInfo lineAllocateInfo{};
+      lineAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      lineAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      lineAllocateInfo.descriptorSetCount = 1;
+      lineAllocateInfo.pSetLayouts = &mRenderData.rdGroundMeshDescriptorLayout;
 
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &computeTransformDescriptorAllocateInfo,
-      &mRenderData.rdAssimpComputeTransformDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp Transform Compute descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &lineAllocateInfo,
+        &frameData.pfGroundMeshDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp ground-mesh drawing descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
+    }
+
+    {
+      /* compute transform. global data */
+      VkDescriptorSetAllocateInfo computeTransformDescriptorAllocateInfo{};
+      computeTransformDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      computeTransformDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      computeTransformDescriptorAllocateInfo.descriptorSetCount = 1;
+      computeTransformDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpComputeTransformDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &computeTransformDescriptorAllocateInfo,
+        &frameData.pfAssimpComputeTransformDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp Transform Compute descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
+    }
+
+    {
+      /* matrix multiplication, global data */
+      VkDescriptorSetAllocateInfo computeMatrixMultDescriptorAllocateInfo{};
+      computeMatrixMultDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      computeMatrixMultDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      computeMatrixMultDescriptorAllocateInfo.descriptorSetCount = 1;
+      computeMatrixMultDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpComputeMatrixMultDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &computeMatrixMultDescriptorAllocateInfo,
+        &frameData.pfAssimpComputeMatrixMultDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp Matrix Mult Compute descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
+    }
+
+    {
+      /* line-drawing */
+      VkDescriptorSetAllocateInfo lineAllocateInfo{};
+      lineAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      lineAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      lineAllocateInfo.descriptorSetCount = 1;
+      lineAllocateInfo.pSetLayouts = &mRenderData.rdLineDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &lineAllocateInfo,
+        &frameData.pfLineDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp line-drawing descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
+    }
+
+    {
+      /* bounding spheres, written by the sphere compute and read by the line pass of this frame */
+      VkDescriptorSetAllocateInfo computeBoundingSpheresDescriptorAllocateInfo{};
+      computeBoundingSpheresDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      computeBoundingSpheresDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      computeBoundingSpheresDescriptorAllocateInfo.descriptorSetCount = 1;
+      computeBoundingSpheresDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpComputeBoundingSpheresDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &computeBoundingSpheresDescriptorAllocateInfo,
+        &frameData.pfAssimpComputeBoundingSpheresDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp Bounding Sphere Compute descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
+    }
+
+    {
+      /* sphere-drawing */
+      VkDescriptorSetAllocateInfo sphereAllocateInfo{};
+      sphereAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      sphereAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      sphereAllocateInfo.descriptorSetCount = 1;
+      sphereAllocateInfo.pSetLayouts = &mRenderData.rdSphereDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &sphereAllocateInfo,
+        &frameData.pfSphereDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp bounding sphere-drawing descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
+    }
+
+    {
+      /* skybox */
+      VkDescriptorSetAllocateInfo skyboxAllocateInfo{};
+      skyboxAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+      skyboxAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
+      skyboxAllocateInfo.descriptorSetCount = 1;
+      skyboxAllocateInfo.pSetLayouts = &mRenderData.rdSkyboxDescriptorLayout;
+
+      VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skyboxAllocateInfo,
+        &frameData.pfSkyboxDescriptorSet);
+      if (result != VK_SUCCESS) {
+        Logger::log(1, "%s error: could not allocate Assimp skybox descriptor set (error: %i)\n", __FUNCTION__, result);
+        return false;
+      }
     }
   }
 
@@ -1732,22 +1966,6 @@ bool VkRenderer::createDescriptorSets() {
     }
   }
 
-  {
-    /* matrix multiplication, global data */
-    VkDescriptorSetAllocateInfo computeMatrixMultDescriptorAllocateInfo{};
-    computeMatrixMultDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    computeMatrixMultDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    computeMatrixMultDescriptorAllocateInfo.descriptorSetCount = 1;
-    computeMatrixMultDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpComputeMatrixMultDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &computeMatrixMultDescriptorAllocateInfo,
-      &mRenderData.rdAssimpComputeMatrixMultDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp Matrix Mult Compute descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
-    }
-  }
-
   {
     /* matrix multiplication bounding spheres, global data */
     VkDescriptorSetAllocateInfo computeMatrixMultDescriptorAllocateInfo{};
@@ -1781,73 +1999,15 @@ bool VkRenderer::createDescriptorSets() {
     }
   }
 
-  {
-    /* bounding spheres, global data */
-    VkDescriptorSetAllocateInfo computeBoundingSpheresDescriptorAllocateInfo{};
-    computeBoundingSpheresDescriptorAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    computeBoundingSpheresDescriptorAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    computeBoundingSpheresDescriptorAllocateInfo.descriptorSetCount = 1;
-    computeBoundingSpheresDescriptorAllocateInfo.pSetLayouts = &mRenderData.rdAssimpComputeBoundingSpheresDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &computeBoundingSpheresDescriptorAllocateInfo,
-      &mRenderData.rdAssimpComputeBoundingSpheresDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp Bounding Sphere Compute descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
-    }
-  }
-
-  {
-    /* line-drawing */
-    VkDescriptorSetAllocateInfo lineAllocateInfo{};
-    lineAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    lineAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    lineAllocateInfo.descriptorSetCount = 1;
-    lineAllocateInfo.pSetLayouts = &mRenderData.rdLineDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &lineAllocateInfo,
-      &mRenderData.rdLineDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp line-drawing descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
-    }
-  }
-
-  {
-    /* sphere-drawing */
-    VkDescriptorSetAllocateInfo sphereAllocateInfo{};
-    sphereAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    sphereAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    sphereAllocateInfo.descriptorSetCount = 1;
-    sphereAllocateInfo.pSetLayouts = &mRenderData.rdSphereDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &sphereAllocateInfo,
-      &mRenderData.rdSphereDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp bounding sphere-drawing descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
-    }
-  }
-
-  {
-    /* skybox */
-    VkDescriptorSetAllocateInfo skyboxAllocateInfo{};
-    skyboxAllocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    skyboxAllocateInfo.descriptorPool = mRenderData.rdDescriptorPool;
-    skyboxAllocateInfo.descriptorSetCount = 1;
-    skyboxAllocateInfo.pSetLayouts = &mRenderData.rdSkyboxDescriptorLayout;
-
-    VkResult result = vkAllocateDescriptorSets(mRenderData.rdVkbDevice.device, &skyboxAllocateInfo,
-      &mRenderData.rdSkyboxDescriptorSet);
-    if (result != VK_SUCCESS) {
-      Logger::log(1, "%s error: could not allocate Assimp skybox descriptor set (error: %i)\n", __FUNCTION__, result);
-      return false;
-    }
+  /* fill the per-frame descriptor sets of all frames in flight */
+  for (unsigned int i = 0; i < mRenderData.rdFramesInFlight; ++i) {
+    selectFrame(i);
+    updateDescriptorSets();
+    updateComputeDescriptorSets();
+    updateLevelDescriptorSets();
   }
+  selectFrame(0);
 
-  updateDescriptorSets();
-  updateComputeDescriptorSets();
-  updateLevelDescriptorSets();
   updateSphereComputeDescriptorSets();
   updateIKComputeDescriptorSets();
 
@@ -1860,17 +2020,17 @@ void VkRenderer::updateDescriptorSets() {
   {
     /* non-animated shader */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo worldPosInfo{};
-    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.buffer;
+    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     worldPosInfo.offset = 0;
     worldPosInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo selectionInfo{};
-    selectionInfo.buffer = mSelectedInstanceBuffer.buffer;
+    selectionInfo.buffer = mSelectedInstanceBuffer.at(mRenderData.rdCurrentFrame).buffer;
     selectionInfo.offset = 0;
     selectionInfo.range = VK_WHOLE_SIZE;
 
@@ -1901,29 +2061,28 @@ void VkRenderer::updateDescriptorSets() {
     std::vector<VkWriteDescriptorSet> writeDescriptorSets =
        { matrixWriteDescriptorSet, posWriteDescriptorSet, selectionWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(writeDescriptorSets.size()),
-       writeDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, writeDescriptorSets);
   }
 
   {
     /* animated shader */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo boneMatrixInfo{};
-    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.buffer;
+    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     boneMatrixInfo.offset = 0;
     boneMatrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo worldPosInfo{};
-    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.buffer;
+    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     worldPosInfo.offset = 0;
     worldPosInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo selectionInfo{};
-    selectionInfo.buffer = mSelectedInstanceBuffer.buffer;
+    selectionInfo.buffer = mSelectedInstanceBuffer.at(mRenderData.rdCurrentFrame).buffer;
     selectionInfo.offset = 0;
     selectionInfo.range = VK_WHOLE_SIZE;
 
@@ -1962,24 +2121,23 @@ void VkRenderer::updateDescriptorSets() {
     std::vector<VkWriteDescriptorSet> skinningWriteDescriptorSets =
       { matrixWriteDescriptorSet, boneMatrixWriteDescriptorSet, posWriteDescriptorSet, selectionWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(skinningWriteDescriptorSets.size()),
-       skinningWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, skinningWriteDescriptorSets);
   }
 
   {
     /* selection shader, non-animated  */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo worldPosInfo{};
-    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.buffer;
+    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     worldPosInfo.offset = 0;
     worldPosInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo selectionInfo{};
-    selectionInfo.buffer = mSelectedInstanceBuffer.buffer;
+    selectionInfo.buffer = mSelectedInstanceBuffer.at(mRenderData.rdCurrentFrame).buffer;
     selectionInfo.offset = 0;
     selectionInfo.range = VK_WHOLE_SIZE;
 
@@ -2010,29 +2168,28 @@ void VkRenderer::updateDescriptorSets() {
     std::vector<VkWriteDescriptorSet> selectionWriteDescriptorSets =
       { matrixWriteDescriptorSet, posWriteDescriptorSet, selectionWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(selectionWriteDescriptorSets.size()),
-       selectionWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, selectionWriteDescriptorSets);
   }
 
   {
     /* selection shader, animated  */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo boneMatrixInfo{};
-    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.buffer;
+    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     boneMatrixInfo.offset = 0;
     boneMatrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo worldPosInfo{};
-    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.buffer;
+    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     worldPosInfo.offset = 0;
     worldPosInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo selectionInfo{};
-    selectionInfo.buffer = mSelectedInstanceBuffer.buffer;
+    selectionInfo.buffer = mSelectedInstanceBuffer.at(mRenderData.rdCurrentFrame).buffer;
     selectionInfo.offset = 0;
     selectionInfo.range = VK_WHOLE_SIZE;
 
@@ -2072,34 +2229,33 @@ void VkRenderer::updateDescriptorSets() {
       { matrixWriteDescriptorSet, boneMatrixWriteDescriptorSet,
         posWriteDescriptorSet, selectionWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(skinningSelectionWriteDescriptorSets.size()),
-       skinningSelectionWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, skinningSelectionWriteDescriptorSets);
   }
 
   {
     /* animated plus morph shader */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo boneMatrixInfo{};
-    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.buffer;
+    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     boneMatrixInfo.offset = 0;
     boneMatrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo worldPosInfo{};
-    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.buffer;
+    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     worldPosInfo.offset = 0;
     worldPosInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo selectionInfo{};
-    selectionInfo.buffer = mSelectedInstanceBuffer.buffer;
+    selectionInfo.buffer = mSelectedInstanceBuffer.at(mRenderData.rdCurrentFrame).buffer;
     selectionInfo.offset = 0;
     selectionInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo faceAnimInfo{};
-    faceAnimInfo.buffer = mFaceAnimPerInstanceDataBuffer.buffer;
+    faceAnimInfo.buffer = mFaceAnimPerInstanceDataBuffer.at(mRenderData.rdCurrentFrame).buffer;
     faceAnimInfo.offset = 0;
     faceAnimInfo.range = VK_WHOLE_SIZE;
 
@@ -2147,34 +2303,33 @@ void VkRenderer::updateDescriptorSets() {
       { matrixWriteDescriptorSet, boneMatrixWriteDescriptorSet,
         posWriteDescriptorSet, selectionWriteDescriptorSet, faceAnimWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(skinningWriteDescriptorSets.size()),
-       skinningWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, skinningWriteDescriptorSets);
   }
 
   {
     /* selection shader, animated plus morph */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo boneMatrixInfo{};
-    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.buffer;
+    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     boneMatrixInfo.offset = 0;
     boneMatrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo worldPosInfo{};
-    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.buffer;
+    worldPosInfo.buffer = mShaderModelRootMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     worldPosInfo.offset = 0;
     worldPosInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo selectionInfo{};
-    selectionInfo.buffer = mSelectedInstanceBuffer.buffer;
+    selectionInfo.buffer = mSelectedInstanceBuffer.at(mRenderData.rdCurrentFrame).buffer;
     selectionInfo.offset = 0;
     selectionInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo faceAnimInfo{};
-    faceAnimInfo.buffer = mFaceAnimPerInstanceDataBuffer.buffer;
+    faceAnimInfo.buffer = mFaceAnimPerInstanceDataBuffer.at(mRenderData.rdCurrentFrame).buffer;
     faceAnimInfo.offset = 0;
     faceAnimInfo.range = VK_WHOLE_SIZE;
 
@@ -2222,14 +2377,13 @@ void VkRenderer::updateDescriptorSets() {
     { matrixWriteDescriptorSet, boneMatrixWriteDescriptorSet,
       posWriteDescriptorSet, selectionWriteDescriptorSet, faceAnimWriteDescriptorSet };
 
-      vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(skinningSelectionWriteDescriptorSets.size()),
-        skinningSelectionWriteDescriptorSets.data(), 0, nullptr);
+      DescriptorCache::updateDescriptorSets(mRenderData, skinningSelectionWriteDescriptorSets);
   }
 
   {
     /* line-drawing shader */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
@@ -2244,14 +2398,13 @@ void VkRenderer::updateDescriptorSets() {
     std::vector<VkWriteDescriptorSet> writeDescriptorSets =
     { matrixWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(writeDescriptorSets.size()),
-      writeDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, writeDescriptorSets);
   }
 
   {
     /* ground-mesh-drawing shader */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
@@ -2266,14 +2419,13 @@ void VkRenderer::updateDescriptorSets() {
     std::vector<VkWriteDescriptorSet> writeDescriptorSets =
     { matrixWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(writeDescriptorSets.size()),
-      writeDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, writeDescriptorSets);
   }
 
   {
     /* skybox shader */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
@@ -2288,8 +2440,7 @@ void VkRenderer::updateDescriptorSets() {
     std::vector<VkWriteDescriptorSet> writeDescriptorSets =
       { matrixWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(writeDescriptorSets.size()),
-      writeDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, writeDescriptorSets);
   }
 }
 
@@ -2298,12 +2449,12 @@ void VkRenderer::updateComputeDescriptorSets() {
   {
     /* transform compute shader */
     VkDescriptorBufferInfo transformInfo{};
-    transformInfo.buffer = mPerInstanceAnimDataBuffer.buffer;
+    transformInfo.buffer = mPerInstanceAnimDataBuffer.at(mRenderData.rdCurrentFrame).buffer;
     transformInfo.offset = 0;
     transformInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo trsInfo{};
-    trsInfo.buffer = mShaderTRSMatrixBuffer.buffer;
+    trsInfo.buffer = mShaderTRSMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     trsInfo.offset = 0;
     trsInfo.range = VK_WHOLE_SIZE;
 
@@ -2326,19 +2477,18 @@ void VkRenderer::updateComputeDescriptorSets() {
     std::vector<VkWriteDescriptorSet> transformWriteDescriptorSets =
       { transformWriteDescriptorSet, trsWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(transformWriteDescriptorSets.size()),
-       transformWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, transformWriteDescriptorSets);
   }
 
   {
     /* matrix multiplication compute shader, global data */
     VkDescriptorBufferInfo trsInfo{};
-    trsInfo.buffer = mShaderTRSMatrixBuffer.buffer;
+    trsInfo.buffer = mShaderTRSMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     trsInfo.offset = 0;
     trsInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo boneMatrixInfo{};
-    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.buffer;
+    boneMatrixInfo.buffer = mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     boneMatrixInfo.offset = 0;
     boneMatrixInfo.range = VK_WHOLE_SIZE;
 
@@ -2361,8 +2511,7 @@ void VkRenderer::updateComputeDescriptorSets() {
     std::vector<VkWriteDescriptorSet> matrixMultWriteDescriptorSets =
       { trsWriteDescriptorSet, boneMatrixWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(matrixMultWriteDescriptorSets.size()),
-       matrixMultWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, matrixMultWriteDescriptorSets);
   }
 }
 
@@ -2371,12 +2520,12 @@ void VkRenderer::updateLevelDescriptorSets() {
   {
     /* level shader */
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo worldPosInfo{};
-    worldPosInfo.buffer = mShaderLevelRootMatrixBuffer.buffer;
+    worldPosInfo.buffer = mShaderLevelRootMatrixBuffer.at(mRenderData.rdCurrentFrame).buffer;
     worldPosInfo.offset = 0;
     worldPosInfo.range = VK_WHOLE_SIZE;
 
@@ -2399,8 +2548,7 @@ void VkRenderer::updateLevelDescriptorSets() {
     std::vector<VkWriteDescriptorSet> writeDescriptorSets =
     { matrixWriteDescriptorSet, posWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(writeDescriptorSets.size()),
-      writeDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, writeDescriptorSets);
   }
 }
 
@@ -2437,8 +2585,7 @@ void VkRenderer::updateSphereComputeDescriptorSets() {
     std::vector<VkWriteDescriptorSet> transformWriteDescriptorSets =
       { transformWriteDescriptorSet, trsWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(transformWriteDescriptorSets.size()),
-       transformWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, transformWriteDescriptorSets);
   }
 
   {
@@ -2472,12 +2619,11 @@ void VkRenderer::updateSphereComputeDescriptorSets() {
     std::vector<VkWriteDescriptorSet> matrixMultWriteDescriptorSets =
       { trsWriteDescriptorSet, boneMatrixWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(matrixMultWriteDescriptorSets.size()),
-       matrixMultWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, matrixMultWriteDescriptorSets);
   }
 
-  {
-    /* bounding spheres compute shader, global data */
+  /* bounding spheres compute shader, the bounding sphere buffer is per frame */
+  for (unsigned int i = 0; i < mRenderData.rdFramesInFlight; ++i) {
     VkDescriptorBufferInfo boneMatrixInfo{};
     boneMatrixInfo.buffer = mSphereBoneMatrixBuffer.buffer;
     boneMatrixInfo.offset = 0;
@@ -2489,14 +2635,14 @@ void VkRenderer::updateSphereComputeDescriptorSets() {
     worldPosInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo boundingSphereInfo{};
-    boundingSphereInfo.buffer = mBoundingSphereBuffer.buffer;
+    boundingSphereInfo.buffer = mBoundingSphereBuffer.at(i).buffer;
     boundingSphereInfo.offset = 0;
     boundingSphereInfo.range = VK_WHOLE_SIZE;
 
     VkWriteDescriptorSet boneMatrixWriteDescriptorSet{};
     boneMatrixWriteDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     boneMatrixWriteDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    boneMatrixWriteDescriptorSet.dstSet = mRenderData.rdAssimpComputeBoundingSpheresDescriptorSet;
+    boneMatrixWriteDescriptorSet.dstSet = mRenderData.rdPerFrameData.at(i).pfAssimpComputeBoundingSpheresDescriptorSet;
     boneMatrixWriteDescriptorSet.dstBinding = 0;
     boneMatrixWriteDescriptorSet.descriptorCount = 1;
     boneMatrixWriteDescriptorSet.pBufferInfo = &boneMatrixInfo;
@@ -2504,7 +2650,7 @@ void VkRenderer::updateSphereComputeDescriptorSets() {
     VkWriteDescriptorSet worldPosWriteDescriptorSet{};
     worldPosWriteDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     worldPosWriteDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    worldPosWriteDescriptorSet.dstSet = mRenderData.rdAssimpComputeBoundingSpheresDescriptorSet;
+    worldPosWriteDescriptorSet.dstSet = mRenderData.rdPerFrameData.at(i).pfAssimpComputeBoundingSpheresDescriptorSet;
     worldPosWriteDescriptorSet.dstBinding = 1;
     worldPosWriteDescriptorSet.descriptorCount = 1;
     worldPosWriteDescriptorSet.pBufferInfo = &worldPosInfo;
@@ -2512,7 +2658,7 @@ void VkRenderer::updateSphereComputeDescriptorSets() {
     VkWriteDescriptorSet boundingSphereWriteDescriptorSet{};
     boundingSphereWriteDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     boundingSphereWriteDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    boundingSphereWriteDescriptorSet.dstSet = mRenderData.rdAssimpComputeBoundingSpheresDescriptorSet;
+    boundingSphereWriteDescriptorSet.dstSet = mRenderData.rdPerFrameData.at(i).pfAssimpComputeBoundingSpheresDescriptorSet;
     boundingSphereWriteDescriptorSet.dstBinding = 2;
     boundingSphereWriteDescriptorSet.descriptorCount = 1;
     boundingSphereWriteDescriptorSet.pBufferInfo = &boundingSphereInfo;
@@ -2520,26 +2666,25 @@ void VkRenderer::updateSphereComputeDescriptorSets() {
     std::vector<VkWriteDescriptorSet> boundingSphereWriteDescriptorSets =
       { boneMatrixWriteDescriptorSet, worldPosWriteDescriptorSet, boundingSphereWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(boundingSphereWriteDescriptorSets.size()),
-       boundingSphereWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, boundingSphereWriteDescriptorSets);
   }
 
-  {
-    /* sphere-drawing shader */
+  /* sphere-drawing shader */
+  for (unsigned int i = 0; i < mRenderData.rdFramesInFlight; ++i) {
     VkDescriptorBufferInfo matrixInfo{};
-    matrixInfo.buffer = mPerspectiveViewMatrixUBO.buffer;
+    matrixInfo.buffer = mPerspectiveViewMatrixUBO.at(i).buffer;
     matrixInfo.offset = 0;
     matrixInfo.range = VK_WHOLE_SIZE;
 
     VkDescriptorBufferInfo boundingSpheresInfo{};
-    boundingSpheresInfo.buffer = mBoundingSphereBuffer.buffer;
+    boundingSpheresInfo.buffer = mBoundingSphereBuffer.at(i).buffer;
     boundingSpheresInfo.offset = 0;
     boundingSpheresInfo.range = VK_WHOLE_SIZE;
 
     VkWriteDescriptorSet matrixWriteDescriptorSet{};
     matrixWriteDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     matrixWriteDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    matrixWriteDescriptorSet.dstSet = mRenderData.rdSphereDescriptorSet;
+    matrixWriteDescriptorSet.dstSet = mRenderData.rdPerFrameData.at(i).pfSphereDescriptorSet;
     matrixWriteDescriptorSet.dstBinding = 0;
     matrixWriteDescriptorSet.descriptorCount = 1;
     matrixWriteDescriptorSet.pBufferInfo = &matrixInfo;
@@ -2547,7 +2692,7 @@ void VkRenderer::updateSphereComputeDescriptorSets() {
     VkWriteDescriptorSet boundingSpheresWriteDescriptorSet{};
     boundingSpheresWriteDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     boundingSpheresWriteDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-    boundingSpheresWriteDescriptorSet.dstSet = mRenderData.rdSphereDescriptorSet;
+    boundingSpheresWriteDescriptorSet.dstSet = mRenderData.rdPerFrameData.at(i).pfSphereDescriptorSet;
     boundingSpheresWriteDescriptorSet.dstBinding = 1;
     boundingSpheresWriteDescriptorSet.descriptorCount = 1;
     boundingSpheresWriteDescriptorSet.pBufferInfo = &boundingSpheresInfo;
@@ -2555,8 +2700,7 @@ void VkRenderer::updateSphereComputeDescriptorSets() {
     std::vector<VkWriteDescriptorSet> writeDescriptorSets =
     { matrixWriteDescriptorSet, boundingSpheresWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(writeDescriptorSets.size()),
-      writeDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, writeDescriptorSets);
   }
 }
 
@@ -2593,8 +2737,7 @@ void VkRenderer::updateIKComputeDescriptorSets() {
     std::vector<VkWriteDescriptorSet> matrixMultWriteDescriptorSets =
       { trsWriteDescriptorSet, boneMatrixWriteDescriptorSet };
 
-    vkUpdateDescriptorSets(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(matrixMultWriteDescriptorSets.size()),
-       matrixMultWriteDescriptorSets.data(), 0, nullptr);
+    DescriptorCache::updateDescriptorSets(mRenderData, matrixMultWriteDescriptorSets);
   }
 }
 
@@ -2772,14 +2915,37 @@ bool VkRenderer::recreateSwapchain() {
 }
 
 bool VkRenderer::createVertexBuffers() {
-  if (!VertexBuffer::init(mRenderData, mLineVertexBuffer, 1024)) {
-    Logger::log(1, "%s error: could not create line vertex buffer\n", __FUNCTION__);
-    return false;
-  }
+  mLineVertexBuffer.resize(mRenderData.rdFramesInFlight);
+  mSphereVertexBuffer.resize(mRenderData.rdFramesInFlight);
+  mIKLinesVertexBuffer.resize(mRenderData.rdFramesInFlight);
+  mGroundMeshNeighborVertexBuffer.resize(mRenderData.rdFramesInFlight);
+  mInstancePathVertexBuffer.resize(mRenderData.rdFramesInFlight);
+
+  for (unsigned int i = 0; i < mRenderData.rdFramesInFlight; ++i) {
+    if (!VertexBuffer::init(mRenderData, mLineVertexBuffer.at(i), 1024)) {
+      Logger::log(1, "%s error: could not create line vertex buffer\n", __FUNCTION__);
+      return false;
+    }
 
-  if (!VertexBuffer::init(mRenderData, mSphereVertexBuffer, 1024)) {
-    Logger::log(1, "%s error: could not create sphere vertex buffer\n", __FUNCTION__);
-    return false;
+    if (!VertexBuffer::init(mRenderData, mSphereVertexBuffer.at(i), 1024)) {
+      Logger::log(1, "%s error: could not create sphere vertex buffer\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!VertexBuffer::init(mRenderData, mIKLinesVertexBuffer.at(i), 1024)) {
+      Logger::log(1, "%s error: could not create IK Lines vertex buffer\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!VertexBuffer::init(mRenderData, mGroundMeshNeighborVertexBuffer.at(i), 1024)) {
+      Logger::log(1, "%s error: could not create ground mesh neighbor triangles vertex buffer\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!VertexBuffer::init(mRenderData, mInstancePathVertexBuffer.at(i), 1024)) {
+      Logger::log(1, "%s error: could not create instance path vertex buffer\n", __FUNCTION__);
+      return false;
+    }
   }
 
   if (!VertexBuffer::init(mRenderData, mLevelAABBVertexBuffer, 1024)) {
@@ -2797,26 +2963,11 @@ bool VkRenderer::createVertexBuffers() {
     return false;
   }
 
-  if (!VertexBuffer::init(mRenderData, mIKLinesVertexBuffer, 1024)) {
-    Logger::log(1, "%s error: could not create IK Lines vertex buffer\n", __FUNCTION__);
-    return false;
-  }
-
   if (!VertexBuffer::init(mRenderData, mGroundMeshVertexBuffer, 1024)) {
     Logger::log(1, "%s error: could not create ground mesh vertex buffer\n", __FUNCTION__);
     return false;
   }
 
-  if (!VertexBuffer::init(mRenderData, mGroundMeshNeighborVertexBuffer, 1024)) {
-    Logger::log(1, "%s error: could not create ground mesh neighbor triangles vertex buffer\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!VertexBuffer::init(mRenderData, mInstancePathVertexBuffer, 1024)) {
-    Logger::log(1, "%s error: could not create instance path vertex buffer\n", __FUNCTION__);
-    return false;
-  }
-
   if (!VertexBuffer::init(mRenderData, mSkyboxBuffer, 1024)) {
     Logger::log(1, "%s error: could not create skybox vertex buffer\n", __FUNCTION__);
     return false;
@@ -2826,73 +2977,98 @@ bool VkRenderer::createVertexBuffers() {
 }
 
 bool VkRenderer::createMatrixUBO() {
-  if (!UniformBuffer::init(mRenderData, mPerspectiveViewMatrixUBO)) {
-    Logger::log(1, "%s error: could not create matrix uniform buffers\n", __FUNCTION__);
-    return false;
+  mPerspectiveViewMatrixUBO.resize(mRenderData.rdFramesInFlight);
+
+  for (auto& ubo : mPerspectiveViewMatrixUBO) {
+    if (!UniformBuffer::init(mRenderData, ubo)) {
+      Logger::log(1, "%s error: could not create matrix uniform buffers\n", __FUNCTION__);
+      return false;
+    }
   }
   return true;
 }
 
 bool VkRenderer::createSSBOs() {
-  if (!ShaderStorageBuffer::init(mRenderData, mShaderTRSMatrixBuffer)) {
-    Logger::log(1, "%s error: could not create TRS matrices SSBO\n", __FUNCTION__);
-    return false;
+  mShaderTRSMatrixBuffer.resize(mRenderData.rdFramesInFlight);
+  mShaderModelRootMatrixBuffer.resize(mRenderData.rdFramesInFlight);
+  mPerInstanceAnimDataBuffer.resize(mRenderData.rdFramesInFlight);
+  mShaderBoneMatrixBuffer.resize(mRenderData.rdFramesInFlight);
+  mSelectedInstanceBuffer.resize(mRenderData.rdFramesInFlight);
+  mFaceAnimPerInstanceDataBuffer.resize(mRenderData.rdFramesInFlight);
+  mShaderLevelRootMatrixBuffer.resize(mRenderData.rdFramesInFlight);
+  mBoundingSphereBuffer.resize(mRenderData.rdFramesInFlight);
+
+  for (unsigned int i = 0; i < mRenderData.rdFramesInFlight; ++i) {
+    /* guarded by the fence of frame i, a resize can destroy the old buffer at once */
+    mShaderTRSMatrixBuffer.at(i).perFrameBuffer = true;
+    mShaderModelRootMatrixBuffer.at(i).perFrameBuffer = true;
+    mPerInstanceAnimDataBuffer.at(i).perFrameBuffer = true;
+    mShaderBoneMatrixBuffer.at(i).perFrameBuffer = true;
+    mSelectedInstanceBuffer.at(i).perFrameBuffer = true;
+    mFaceAnimPerInstanceDataBuffer.at(i).perFrameBuffer = true;
+    mShaderLevelRootMatrixBuffer.at(i).perFrameBuffer = true;
+    mBoundingSphereBuffer.at(i).perFrameBuffer = true;
+
+    if (!ShaderStorageBuffer::init(mRenderData, mShaderTRSMatrixBuffer.at(i))) {
+      Logger::log(1, "%s error: could not create TRS matrices SSBO\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!ShaderStorageBuffer::init(mRenderData, mShaderModelRootMatrixBuffer.at(i))) {
+      Logger::log(1, "%s error: could not create nodel root position SSBO\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!ShaderStorageBuffer::init(mRenderData, mPerInstanceAnimDataBuffer.at(i))) {
+      Logger::log(1, "%s error: could not create node transform SSBO\n", __FUNCTION__);
+      return false;
+    }
+
+    /* we must read back data */
+    if (!ShaderStorageBuffer::init(mRenderData, mShaderBoneMatrixBuffer.at(i))) {
+      Logger::log(1, "%s error: could not create bone matrix SSBO\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!ShaderStorageBuffer::init(mRenderData, mSelectedInstanceBuffer.at(i))) {
+      Logger::log(1, "%s error: could not create selection SSBO\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!ShaderStorageBuffer::init(mRenderData, mFaceAnimPerInstanceDataBuffer.at(i))) {
+      Logger::log(1, "%s error: could not create face anim SSBO\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!ShaderStorageBuffer::init(mRenderData, mShaderLevelRootMatrixBuffer.at(i))) {
+      Logger::log(1, "%s error: could not create level world pos SSBO\n", __FUNCTION__);
+      return false;
+    }
+
+    /* we must read back data */
+    if (!ShaderStorageBuffer::init(mRenderData, mBoundingSphereBuffer.at(i))) {
+      Logger::log(1, "%s error: could not create bounding sphere SSBO\n", __FUNCTION__);
+      return false;
+    }
   }
 
-  if (!ShaderStorageBuffer::init(mRenderData, mShaderModelRootMatrixBuffer)) {
+  if (!ShaderStorageBuffer::init(mRenderData, mSphereModelRootMatrixBuffer)) {
     Logger::log(1, "%s error: could not create nodel root position SSBO\n", __FUNCTION__);
     return false;
   }
 
-  if (!ShaderStorageBuffer::init(mRenderData, mPerInstanceAnimDataBuffer)) {
+  if (!ShaderStorageBuffer::init(mRenderData, mSpherePerInstanceAnimDataBuffer)) {
     Logger::log(1, "%s error: could not create node transform SSBO\n", __FUNCTION__);
     return false;
   }
 
-  /* we must read back data */
-  if (!ShaderStorageBuffer::init(mRenderData, mShaderBoneMatrixBuffer)) {
-    Logger::log(1, "%s error: could not create bone matrix SSBO\n", __FUNCTION__);
+  if (!ShaderStorageBuffer::init(mRenderData, mSphereTRSMatrixBuffer)) {
+    Logger::log(1, "%s error: could not create TRS matrices SSBO\n", __FUNCTION__);
     return false;
   }
 
-  if (!ShaderStorageBuffer::init(mRenderData, mSelectedInstanceBuffer)) {
-    Logger::log(1, "%s error: could not create selection SSBO\n", __FUNCTION__);
-    return false;
-  }
-
-  /* we must read back data */
-  if (!ShaderStorageBuffer::init(mRenderData, mBoundingSphereBuffer)) {
-    Logger::log(1, "%s error: could not create bounding sphere SSBO\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!ShaderStorageBuffer::init(mRenderData, mSphereModelRootMatrixBuffer)) {
-    Logger::log(1, "%s error: could not create nodel root position SSBO\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!ShaderStorageBuffer::init(mRenderData, mSpherePerInstanceAnimDataBuffer)) {
-    Logger::log(1, "%s error: could not create node transform SSBO\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!ShaderStorageBuffer::init(mRenderData, mSphereTRSMatrixBuffer)) {
-    Logger::log(1, "%s error: could not create TRS matrices SSBO\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!ShaderStorageBuffer::init(mRenderData, mSphereBoneMatrixBuffer)) {
-    Logger::log(1, "%s error: could not create bone matrix SSBO\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!ShaderStorageBuffer::init(mRenderData, mFaceAnimPerInstanceDataBuffer)) {
-    Logger::log(1, "%s error: could not create face anim SSBO\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!ShaderStorageBuffer::init(mRenderData, mShaderLevelRootMatrixBuffer)) {
-    Logger::log(1, "%s error: could not create level world pos SSBO\n", __FUNCTION__);
+  if (!ShaderStorageBuffer::init(mRenderData, mSphereBoneMatrixBuffer)) {
+    Logger::log(1, "%s error: could not create bone matrix SSBO\n", __FUNCTION__);
     return false;
   }
 
@@ -2940,74 +3116,79 @@ bool VkRenderer::createRenderPass() {
 bool VkRenderer::createPipelineLayouts() {
   /* non-animated model */
   std::vector<VkDescriptorSetLayout> layouts = {
-    mRenderData.rdAssimpTextureDescriptorLayout,
+    mRenderData.rdGlobalTextureDescriptorLayout,
     mRenderData.rdAssimpDescriptorLayout };
 
   std::vector<VkPushConstantRange> pushConstants = { { VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(VkPushConstants) } };
 
-  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpPipelineLayout, layouts, pushConstants)) {
+  /* the fragment shader gets the index into the global texture array */
+  std::vector<VkPushConstantRange> texturedPushConstants = {
+    { VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(VkPushConstants) },
+    { VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(VkPushConstants), sizeof(VkTexturePushConstants) } };
+
+  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpPipelineLayout, layouts, texturedPushConstants)) {
     Logger::log(1, "%s error: could not init Assimp pipeline layout\n", __FUNCTION__);
     return false;
   }
 
   /* animated model, needs push constant */
   std::vector<VkDescriptorSetLayout> skinningLayouts = {
-    mRenderData.rdAssimpTextureDescriptorLayout,
+    mRenderData.rdGlobalTextureDescriptorLayout,
     mRenderData.rdAssimpSkinningDescriptorLayout };
 
-  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSkinningPipelineLayout, skinningLayouts, pushConstants)) {
+  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSkinningPipelineLayout, skinningLayouts, texturedPushConstants)) {
     Logger::log(1, "%s error: could not init Assimp Skinning pipeline layout\n", __FUNCTION__);
     return false;
   }
 
   /* selection, non-animated */
   std::vector<VkDescriptorSetLayout> selectionLayouts = {
-    mRenderData.rdAssimpTextureDescriptorLayout,
+    mRenderData.rdGlobalTextureDescriptorLayout,
     mRenderData.rdAssimpSelectionDescriptorLayout };
 
-  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSelectionPipelineLayout, selectionLayouts, pushConstants)) {
+  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSelectionPipelineLayout, selectionLayouts, texturedPushConstants)) {
     Logger::log(1, "%s error: could not init Assimp selection pipeline layout\n", __FUNCTION__);
     return false;
   }
 
   /* selection, animated */
   std::vector<VkDescriptorSetLayout> skinningSelectionLayouts = {
-    mRenderData.rdAssimpTextureDescriptorLayout,
+    mRenderData.rdGlobalTextureDescriptorLayout,
     mRenderData.rdAssimpSkinningSelectionDescriptorLayout };
 
-  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSkinningSelectionPipelineLayout, skinningSelectionLayouts, pushConstants)) {
+  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSkinningSelectionPipelineLayout, skinningSelectionLayouts, texturedPushConstants)) {
     Logger::log(1, "%s error: could not init Assimp skinning selection pipeline layout\n", __FUNCTION__);
     return false;
   }
 
   /* animated model plus morph */
   std::vector<VkDescriptorSetLayout> skinningMorphLayouts = {
-    mRenderData.rdAssimpTextureDescriptorLayout,
+    mRenderData.rdGlobalTextureDescriptorLayout,
     mRenderData.rdAssimpSkinningMorphDescriptorLayout,
     mRenderData.rdAssimpSkinningMorphPerModelDescriptorLayout };
 
-  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSkinningMorphPipelineLayout, skinningMorphLayouts, pushConstants)) {
+  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSkinningMorphPipelineLayout, skinningMorphLayouts, texturedPushConstants)) {
     Logger::log(1, "%s error: could not init Assimp morph skinning pipeline layout\n", __FUNCTION__);
     return false;
   }
 
   /* selection, animated, morphs */
   std::vector<VkDescriptorSetLayout> skinningMorphSelectionLayouts = {
-    mRenderData.rdAssimpTextureDescriptorLayout,
+    mRenderData.rdGlobalTextureDescriptorLayout,
     mRenderData.rdAssimpSkinningMorphSelectionDescriptorLayout,
     mRenderData.rdAssimpSkinningMorphPerModelDescriptorLayout };
 
-  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSkinningMorphSelectionPipelineLayout, skinningMorphSelectionLayouts, pushConstants)) {
+  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpSkinningMorphSelectionPipelineLayout, skinningMorphSelectionLayouts, texturedPushConstants)) {
     Logger::log(1, "%s error: could not init Assimp morph skinning selection pipeline layout\n", __FUNCTION__);
     return false;
   }
 
   /* level */
   std::vector<VkDescriptorSetLayout> levelLayouts = {
-    mRenderData.rdAssimpTextureDescriptorLayout,
+    mRenderData.rdGlobalTextureDescriptorLayout,
     mRenderData.rdAssimpLevelDescriptorLayout };
 
-  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpLevelPipelineLayout, levelLayouts, pushConstants)) {
+  if (!PipelineLayout::init(mRenderData, mRenderData.rdAssimpLevelPipelineLayout, levelLayouts, texturedPushConstants)) {
     Logger::log(1, "%s error: could not init Assimp Level pipeline layout\n", __FUNCTION__);
     return false;
   }
@@ -3236,28 +3417,66 @@ bool VkRenderer::createCommandPools() {
     return false;
   }
 
+  for (auto& frameData : mRenderData.rdPerFrameData) {
+    frameData.pfRecordCommandPools.resize(mRenderData.rdRecordJobs);
+    for (auto& pool : frameData.pfRecordCommandPools) {
+      if (!CommandPool::init(mRenderData, vkb::QueueType::graphics, pool)) {
+        Logger::log(1, "%s error: could not create command recording pool\n", __FUNCTION__);
+        return false;
+      }
+    }
+  }
+
   return true;
 }
 
 bool VkRenderer::createCommandBuffers() {
-  if (!CommandBuffer::init(mRenderData,mRenderData.rdCommandPool, mRenderData.rdCommandBuffer)) {
-    Logger::log(1, "%s error: could not create command buffers\n", __FUNCTION__);
-    return false;
-  }
+  for (auto& frameData : mRenderData.rdPerFrameData) {
+    if (!CommandBuffer::init(mRenderData,mRenderData.rdCommandPool, frameData.pfCommandBuffer)) {
+      Logger::log(1, "%s error: could not create command buffers\n", __FUNCTION__);
+      return false;
+    }
 
-  if (!CommandBuffer::init(mRenderData,mRenderData.rdCommandPool, mRenderData.rdImGuiCommandBuffer)) {
-    Logger::log(1, "%s error: could not create ImGui command buffers\n", __FUNCTION__);
-    return false;
-  }
+    if (!CommandBuffer::init(mRenderData,mRenderData.rdCommandPool, frameData.pfImGuiCommandBuffer)) {
+      Logger::log(1, "%s error: could not create ImGui command buffers\n", __FUNCTION__);
+      return false;
+    }
 
-  if (!CommandBuffer::init(mRenderData,mRenderData.rdCommandPool, mRenderData.rdLineCommandBuffer)) {
-    Logger::log(1, "%s error: could not create line drawing command buffers\n", __FUNCTION__);
-    return false;
-  }
+    if (!CommandBuffer::init(mRenderData,mRenderData.rdCommandPool, frameData.pfLineCommandBuffer)) {
+      Logger::log(1, "%s error: could not create line drawing command buffers\n", __FUNCTION__);
+      return false;
+    }
 
-  if (!CommandBuffer::init(mRenderData,mRenderData.rdComputeCommandPool, mRenderData.rdComputeCommandBuffer)) {
-    Logger::log(1, "%s error: could not create compute command buffers\n", __FUNCTION__);
-    return false;
+    if (!CommandBuffer::init(mRenderData,mRenderData.rdComputeCommandPool, frameData.pfComputeCommandBuffer)) {
+      Logger::log(1, "%s error: could not create compute command buffers\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!CommandBuffer::init(mRenderData,mRenderData.rdCommandPool, frameData.pfUploadCommandBuffer)) {
+      Logger::log(1, "%s error: could not create upload command buffers\n", __FUNCTION__);
+      return false;
+    }
+
+    if (!CommandBuffer::init(mRenderData,mRenderData.rdCommandPool, frameData.pfAcquireCommandBuffer)) {
+      Logger::log(1, "%s error: could not create upload acquire command buffers\n", __FUNCTION__);
+      return false;
+    }
+
+    frameData.pfLevelCommandBuffers.resize(mRenderData.rdRecordJobs);
+    frameData.pfModelCommandBuffers.resize(mRenderData.rdRecordJobs);
+    for (unsigned int i = 0; i < mRenderData.rdRecordJobs; ++i) {
+      if (!CommandBuffer::init(mRenderData, frameData.pfRecordCommandPools.at(i), frameData.pfLevelCommandBuffers.at(i),
+          VK_COMMAND_BUFFER_LEVEL_SECONDARY)) {
+        Logger::log(1, "%s error: could not create level secondary command buffers\n", __FUNCTION__);
+        return false;
+      }
+
+      if (!CommandBuffer::init(mRenderData, frameData.pfRecordCommandPools.at(i), frameData.pfModelCommandBuffers.at(i),
+          VK_COMMAND_BUFFER_LEVEL_SECONDARY)) {
+        Logger::log(1, "%s error: could not create model secondary command buffers\n", __FUNCTION__);
+        return false;
+      }
+    }
   }
 
   return true;
@@ -3271,6 +3490,39 @@ bool VkRenderer::createSyncObjects() {
   return true;
 }
 
+void VkRenderer::selectFrame(unsigned int frame) {
+  mRenderData.rdCurrentFrame = frame;
+  const VkPerFrameData& frameData = mRenderData.rdPerFrameData.at(frame);
+
+  mRenderData.rdCommandBuffer = frameData.pfCommandBuffer;
+  mRenderData.rdImGuiCommandBuffer = frameData.pfImGuiCommandBuffer;
+  mRenderData.rdLineCommandBuffer = frameData.pfLineCommandBuffer;
+  mRenderData.rdComputeCommandBuffer = frameData.pfComputeCommandBuffer;
+  mRenderData.rdUploadCommandBuffer = frameData.pfUploadCommandBuffer;
+  mRenderData.rdAcquireCommandBuffer = frameData.pfAcquireCommandBuffer;
+
+  mRenderData.rdPresentSemaphore = frameData.pfPresentSemaphore;
+  mRenderData.rdRenderSemaphore = frameData.pfRenderSemaphore;
+  mRenderData.rdComputeSemaphore = frameData.pfComputeSemaphore;
+  mRenderData.rdRenderFence = frameData.pfRenderFence;
+  mRenderData.rdComputeFence = frameData.pfComputeFence;
+
+  mRenderData.rdAssimpDescriptorSet = frameData.pfAssimpDescriptorSet;
+  mRenderData.rdAssimpSkinningDescriptorSet = frameData.pfAssimpSkinningDescriptorSet;
+  mRenderData.rdAssimpComputeTransformDescriptorSet = frameData.pfAssimpComputeTransformDescriptorSet;
+  mRenderData.rdAssimpComputeMatrixMultDescriptorSet = frameData.pfAssimpComputeMatrixMultDescriptorSet;
+  mRenderData.rdAssimpSelectionDescriptorSet = frameData.pfAssimpSelectionDescriptorSet;
+  mRenderData.rdAssimpSkinningSelectionDescriptorSet = frameData.pfAssimpSkinningSelectionDescriptorSet;
+  mRenderData.rdAssimpSkinningMorphDescriptorSet = frameData.pfAssimpSkinningMorphDescriptorSet;
+  mRenderData.rdAssimpSkinningMorphSelectionDescriptorSet = frameData.pfAssimpSkinningMorphSelectionDescriptorSet;
+  mRenderData.rdAssimpComputeBoundingSpheresDescriptorSet = frameData.pfAssimpComputeBoundingSpheresDescriptorSet;
+  mRenderData.rdAssimpLevelDescriptorSet = frameData.pfAssimpLevelDescriptorSet;
+  mRenderData.rdLineDescriptorSet = frameData.pfLineDescriptorSet;
+  mRenderData.rdSphereDescriptorSet = frameData.pfSphereDescriptorSet;
+  mRenderData.rdGroundMeshDescriptorSet = frameData.pfGroundMeshDescriptorSet;
+  mRenderData.rdSkyboxDescriptorSet = frameData.pfSkyboxDescriptorSet;
+}
+
 bool VkRenderer::initVma() {
   VmaAllocatorCreateInfo allocatorInfo{};
   allocatorInfo.physicalDevice = mRenderData.rdVkbPhysicalDevice.physical_device;
@@ -3318,11 +3570,25 @@ bool VkRenderer::addModel(std::string modelFileName, bool addInitialInstance, bo
     return false;
   }
 
+  /* the GPU copies run in the background, the model is drawn once they have finished */
+  if (!UploadManager::beginBatch(mRenderData)) {
+    return false;
+  }
+
   std::shared_ptr<AssimpModel> model = std::make_shared<AssimpModel>();
-  if (!model->loadModel(mRenderData, modelFileName)) {
+  bool modelLoaded = model->loadModel(mRenderData, modelFileName);
+
+  uint64_t uploadBatch = 0;
+  if (!UploadManager::submitBatch(mRenderData, uploadBatch)) {
+    Logger::log(1, "%s error: could not upload data of model file '%s'\n", __FUNCTION__, modelFileName.c_str());
+    return false;
+  }
+
+  if (!modelLoaded) {
     Logger::log(1, "%s error: could not load model file '%s'\n", __FUNCTION__, modelFileName.c_str());
     return false;
   }
+  model->setUploadBatch(uploadBatch);
 
   mModelInstCamData.micModelList.emplace_back(model);
 
@@ -3846,11 +4112,25 @@ bool VkRenderer::addLevel(std::string levelFileName, bool updateVertexData) {
     return false;
   }
 
+  /* the GPU copies run in the background, the level is drawn once they have finished */
+  if (!UploadManager::beginBatch(mRenderData)) {
+    return false;
+  }
+
   std::shared_ptr<AssimpLevel> level = std::make_shared<AssimpLevel>();
-  if (!level->loadLevel(mRenderData, levelFileName)) {
+  bool levelLoaded = level->loadLevel(mRenderData, levelFileName);
+
+  uint64_t uploadBatch = 0;
+  if (!UploadManager::submitBatch(mRenderData, uploadBatch)) {
+    Logger::log(1, "%s error: could not upload data of level file '%s'\n", __FUNCTION__, levelFileName.c_str());
+    return false;
+  }
+
+  if (!levelLoaded) {
     Logger::log(1, "%s error: could not load level file '%s'\n", __FUNCTION__, levelFileName.c_str());
     return false;
   }
+  level->setUploadBatch(uploadBatch);
 
   mModelInstCamData.micLevels.emplace_back(level);
 
@@ -3907,6 +4187,12 @@ void VkRenderer::addNullLevel() {
 }
 
 void VkRenderer::generateLevelVertexData() {
+  /* level debug vertex buffers are shared by all frames in flight, wait until none of them reads the data.
+   * the background uploads on the transfer queue do not touch these buffers */
+  if (!waitForRenderFences()) {
+    return;
+  }
+
   generateLevelAABB();
   generateLevelOctree();
   generateLevelWireframe();
@@ -4815,15 +5101,20 @@ bool VkRenderer::createAABBLookup(std::shared_ptr<AssimpModel> model) {
       clipToStore += numberOfClips;
     }
 
+    /* the animation compute shaders of this frame use the same buffers */
+    if (!waitForComputeFence()) {
+      return false;
+    }
+
     /* we need to update descriptors after the upload if buffer size changed */
     bool bufferResized = false;
     mUploadToUBOTimer.start();
-    bufferResized = ShaderStorageBuffer::uploadSsboData(mRenderData, mPerInstanceAnimDataBuffer, mPerInstanceAnimData);
+    bufferResized = ShaderStorageBuffer::uploadSsboData(mRenderData, mPerInstanceAnimDataBuffer.at(mRenderData.rdCurrentFrame), mPerInstanceAnimData);
     mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
     /* resize SSBO if needed */
-    bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mShaderBoneMatrixBuffer, bufferMatrixSize);
-    bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mShaderTRSMatrixBuffer, trsMatrixSize);
+    bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame), bufferMatrixSize);
+    bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mShaderTRSMatrixBuffer.at(mRenderData.rdCurrentFrame), trsMatrixSize);
 
     if (bufferResized) {
       updateDescriptorSets();
@@ -4885,7 +5176,7 @@ bool VkRenderer::createAABBLookup(std::shared_ptr<AssimpModel> model) {
 
     /* extract bone matrix from SSBO */
     mDownloadFromUBOTimer.start();
-    std::vector<glm::mat4> boneMatrix = ShaderStorageBuffer::getSsboDataMat4(mRenderData, mShaderBoneMatrixBuffer,
+    std::vector<glm::mat4> boneMatrix = ShaderStorageBuffer::getSsboDataMat4(mRenderData, mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame),
       0, LOOKUP_SIZE * numberOfClips * numberOfBones);
     mRenderData.rdDownloadFromUBOTime += mDownloadFromUBOTimer.stop();
 
@@ -4969,7 +5260,7 @@ bool VkRenderer::checkForInstanceCollisions() {
     }
 
     /* resize SSBO if needed */
-    bool bufferResized = ShaderStorageBuffer::checkForResize(mRenderData, mBoundingSphereBuffer, totalSpheres * sizeof(glm::vec4));
+    bool bufferResized = ShaderStorageBuffer::checkForResize(mRenderData, mBoundingSphereBuffer.at(mRenderData.rdCurrentFrame), totalSpheres * sizeof(glm::vec4));
 
     if (bufferResized) {
       updateSphereComputeDescriptorSets();
@@ -5032,6 +5323,11 @@ bool VkRenderer::checkForInstanceCollisions() {
       /* in case data was changed */
       model->updateBoundingSphereAdjustments(mRenderData);
 
+      /* the animation compute shaders of this frame may still be running */
+      if (!waitForComputeFence()) {
+        return false;
+      }
+
       /* record compute commands */
       VkResult result = vkResetFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdComputeFence);
       if (result != VK_SUCCESS) {
@@ -5080,7 +5376,7 @@ bool VkRenderer::checkForInstanceCollisions() {
 
     /* read sphere SSBO */
     mDownloadFromUBOTimer.start();
-    std::vector<glm::vec4> boundingSpheres = ShaderStorageBuffer::getSsboDataVec4(mRenderData, mBoundingSphereBuffer, totalSpheres);
+    std::vector<glm::vec4> boundingSpheres = ShaderStorageBuffer::getSsboDataVec4(mRenderData, mBoundingSphereBuffer.at(mRenderData.rdCurrentFrame), totalSpheres);
     mRenderData.rdDownloadFromUBOTime += mDownloadFromUBOTimer.stop();
 
     sphereModelOffset = 0;
@@ -5352,7 +5648,14 @@ void VkRenderer::runComputeShaders(std::shared_ptr<AssimpModel> model, int numIn
     VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(sizeof(VkComputePushConstants)), &mComputeModelData);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
+  /* the AABB lookup bake runs the shaders a thousand times per model load, do not time it */
+  if (!useEmptyBoneOffsets) {
+    mGpuTimer.start(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::transformCompute);
+  }
   vkCmdDispatch(mRenderData.rdComputeCommandBuffer, numberOfBones, static_cast<uint32_t>(std::ceil(numInstances / 32.0f)), 1);
+  if (!useEmptyBoneOffsets) {
+    mGpuTimer.stop(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::transformCompute);
+  }
 
   /* memroy barrier between the compute shaders
    * wait for TRS buffer to be written  */
@@ -5389,7 +5692,13 @@ void VkRenderer::runComputeShaders(std::shared_ptr<AssimpModel> model, int numIn
     VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(sizeof(VkComputePushConstants)), &mComputeModelData);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
+  if (!useEmptyBoneOffsets) {
+    mGpuTimer.start(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::matrixCompute);
+  }
   vkCmdDispatch(mRenderData.rdComputeCommandBuffer, numberOfBones, static_cast<uint32_t>(std::ceil(numInstances / 32.0f)), 1);
+  if (!useEmptyBoneOffsets) {
+    mGpuTimer.stop(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::matrixCompute);
+  }
 
   /* memroy barrier after compute shader
    * wait for bone matrix buffer to be written  */
@@ -5423,7 +5732,9 @@ void VkRenderer::runBoundingSphereComputeShaders(std::shared_ptr<AssimpModel> mo
     VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(sizeof(VkComputePushConstants)), &mComputeModelData);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
+  mGpuTimer.start(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::sphereTransformCompute);
   vkCmdDispatch(mRenderData.rdComputeCommandBuffer, numberOfBones, static_cast<uint32_t>(std::ceil(numInstances / 32.0f)), 1);
+  mGpuTimer.stop(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::sphereTransformCompute);
 
   /* memroy barrier between the compute shaders
    * wait for TRS buffer to be written  */
@@ -5453,7 +5764,9 @@ void VkRenderer::runBoundingSphereComputeShaders(std::shared_ptr<AssimpModel> mo
     VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(sizeof(VkComputePushConstants)), &mComputeModelData);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
+  mGpuTimer.start(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::sphereMatrixCompute);
   vkCmdDispatch(mRenderData.rdComputeCommandBuffer, numberOfBones, static_cast<uint32_t>(std::ceil(numInstances / 32.0f)), 1);
+  mGpuTimer.stop(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::sphereMatrixCompute);
 
   /* memroy barrier after compute shader
    * wait for bone matrix buffer to be written  */
@@ -5481,7 +5794,9 @@ void VkRenderer::runBoundingSphereComputeShaders(std::shared_ptr<AssimpModel> mo
     VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(sizeof(VkComputePushConstants)), &mComputeModelData);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
+  mGpuTimer.start(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::boundingSphereCompute);
   vkCmdDispatch(mRenderData.rdComputeCommandBuffer, numberOfBones, static_cast<uint32_t>(std::ceil(numInstances / 32.0f)), 1);
+  mGpuTimer.stop(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::boundingSphereCompute);
 
   /* memroy barrier between the compute shaders
    * wait for bounding sphere buffer to be written  */
@@ -5503,6 +5818,11 @@ bool VkRenderer::runIKComputeShaders(std::shared_ptr<AssimpModel> model, int num
   ShaderStorageBuffer::uploadSsboData(mRenderData, mIKTRSMatrixBuffer, mTRSData, modelOffset);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
+  /* the animation compute shaders of this frame may still be running */
+  if (!waitForComputeFence()) {
+    return false;
+  }
+
   VkResult result = vkResetFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdComputeFence);
   if (result != VK_SUCCESS) {
     Logger::log(1, "%s error: compute fence reset failed (error: %i)\n", __FUNCTION__, result);
@@ -5534,7 +5854,9 @@ bool VkRenderer::runIKComputeShaders(std::shared_ptr<AssimpModel> model, int num
     VK_SHADER_STAGE_COMPUTE_BIT, 0, static_cast<uint32_t>(sizeof(VkComputePushConstants)), &mComputeModelData);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
+  mGpuTimer.start(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::ikCompute);
   vkCmdDispatch(mRenderData.rdComputeCommandBuffer, numberOfBones, static_cast<uint32_t>(std::ceil(numInstances / 32.0f)), 1);
+  mGpuTimer.stop(mRenderData, mRenderData.rdComputeCommandBuffer, gpuPass::ikCompute);
 
   /* memroy barrier after compute shader
    * wait for bone matrix buffer to be written  */
@@ -5962,7 +6284,7 @@ bool VkRenderer::createSelectedBoundingSpheres() {
     /* resize SSBO if needed */
     bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mSphereBoneMatrixBuffer, bufferMatrixSize);
     bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mSphereTRSMatrixBuffer, trsMatrixSize);
-    bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mBoundingSphereBuffer, numberOfSpheres * sizeof(glm::vec4));
+    bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mBoundingSphereBuffer.at(mRenderData.rdCurrentFrame), numberOfSpheres * sizeof(glm::vec4));
 
     if (bufferResized) {
       updateDescriptorSets();
@@ -5972,6 +6294,11 @@ bool VkRenderer::createSelectedBoundingSpheres() {
     /* in case data was changed */
     model->updateBoundingSphereAdjustments(mRenderData);
 
+    /* the animation compute shaders of this frame may still be running */
+    if (!waitForComputeFence()) {
+      return false;
+    }
+
     /* record compute commands */
     VkResult result = vkResetFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdComputeFence);
     if (result != VK_SUCCESS) {
@@ -6019,7 +6346,7 @@ bool VkRenderer::createSelectedBoundingSpheres() {
 
   if (mCollidingSphereCount > 0) {
     mUploadToVBOTimer.start();
-    VertexBuffer::uploadData(mRenderData, mSphereVertexBuffer, mSphereMesh);
+    VertexBuffer::uploadData(mRenderData, mSphereVertexBuffer.at(mRenderData.rdCurrentFrame), mSphereMesh);
     mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
   }
 
@@ -6055,7 +6382,7 @@ bool VkRenderer::createCollidingBoundingSpheres() {
 
   /* resize SSBO if needed */
   bool bufferResized = false;
-  bufferResized = ShaderStorageBuffer::checkForResize(mRenderData, mBoundingSphereBuffer, totalSpheres * sizeof(glm::vec4));
+  bufferResized = ShaderStorageBuffer::checkForResize(mRenderData, mBoundingSphereBuffer.at(mRenderData.rdCurrentFrame), totalSpheres * sizeof(glm::vec4));
 
   if (bufferResized) {
     updateSphereComputeDescriptorSets();
@@ -6117,6 +6444,11 @@ bool VkRenderer::createCollidingBoundingSpheres() {
     /* in case data was changed */
     model->updateBoundingSphereAdjustments(mRenderData);
 
+    /* the animation compute shaders of this frame may still be running */
+    if (!waitForComputeFence()) {
+      return false;
+    }
+
     /* record compute commands */
     VkResult result = vkResetFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdComputeFence);
     if (result != VK_SUCCESS) {
@@ -6165,7 +6497,7 @@ bool VkRenderer::createCollidingBoundingSpheres() {
 
   if (mCollidingSphereCount > 0) {
     mUploadToVBOTimer.start();
-    VertexBuffer::uploadData(mRenderData, mSphereVertexBuffer, mCollidingSphereMesh);
+    VertexBuffer::uploadData(mRenderData, mSphereVertexBuffer.at(mRenderData.rdCurrentFrame), mCollidingSphereMesh);
     mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
   }
 
@@ -6192,7 +6524,7 @@ bool VkRenderer::createAllBoundingSpheres() {
 
   /* resize SSBO if needed */
   bool bufferResized = false;
-  bufferResized = ShaderStorageBuffer::checkForResize(mRenderData, mBoundingSphereBuffer, totalSpheres * sizeof(glm::vec4));
+  bufferResized = ShaderStorageBuffer::checkForResize(mRenderData, mBoundingSphereBuffer.at(mRenderData.rdCurrentFrame), totalSpheres * sizeof(glm::vec4));
 
   if (bufferResized) {
     updateSphereComputeDescriptorSets();
@@ -6253,6 +6585,11 @@ bool VkRenderer::createAllBoundingSpheres() {
     /* in case data was changed */
     model->updateBoundingSphereAdjustments(mRenderData);
 
+    /* the animation compute shaders of this frame may still be running */
+    if (!waitForComputeFence()) {
+      return false;
+    }
+
     /* record compute commands */
     VkResult result = vkResetFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdComputeFence);
     if (result != VK_SUCCESS) {
@@ -6301,13 +6638,231 @@ bool VkRenderer::createAllBoundingSpheres() {
 
   if (mCollidingSphereCount > 0) {
     mUploadToVBOTimer.start();
-    VertexBuffer::uploadData(mRenderData, mSphereVertexBuffer, mSphereMesh);
+    VertexBuffer::uploadData(mRenderData, mSphereVertexBuffer.at(mRenderData.rdCurrentFrame), mSphereMesh);
     mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
   }
 
   return true;
 }
 
+bool VkRenderer::waitForComputeFence() {
+  /* returns immediately if the fence is already signaled */
+  VkResult result = vkWaitForFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdComputeFence, VK_TRUE, UINT64_MAX);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: waiting for compute fence failed (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+  return true;
+}
+
+bool VkRenderer::waitForRenderFences() {
+  std::vector<VkFence> renderFences{};
+  for (unsigned int i = 0; i < mRenderData.rdFramesInFlight; ++i) {
+    /* a reset fence that was not submitted yet would never be signaled, the frame has no GPU work pending */
+    if (mRenderFenceReset && i == mRenderData.rdCurrentFrame) {
+      continue;
+    }
+    renderFences.emplace_back(mRenderData.rdPerFrameData.at(i).pfRenderFence);
+  }
+
+  VkResult result = vkWaitForFences(mRenderData.rdVkbDevice.device, static_cast<uint32_t>(renderFences.size()),
+    renderFences.data(), VK_TRUE, UINT64_MAX);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: waiting for render fences failed (error: %i)\n", __FUNCTION__, result);
+    return false;
+  }
+  return true;
+}
+
+/* runs on a worker thread, records the skybox/level and the model chunks of job 'job' */
+bool VkRenderer::recordSecondaryCommands(unsigned int job, const VkRenderPassBeginInfo& levelPassInfo,
+    const VkRenderPassBeginInfo& modelPassInfo, const VkViewport& viewport, const VkRect2D& scissor) {
+  const VkPerFrameData& frameData = mRenderData.rdPerFrameData.at(mRenderData.rdCurrentFrame);
+  VkCommandBuffer levelCommandBuffer = frameData.pfLevelCommandBuffers.at(job);
+  VkCommandBuffer modelCommandBuffer = frameData.pfModelCommandBuffers.at(job);
+  unsigned int numJobs = mRenderData.rdRecordJobs;
+
+  /* resetting the pool is cheaper than resetting every buffer */
+  VkResult result = vkResetCommandPool(mRenderData.rdVkbDevice.device, frameData.pfRecordCommandPools.at(job), 0);
+  if (result != VK_SUCCESS) {
+    Logger::log(1, "%s error: could not reset command pool of job %i (error: %i)\n", __FUNCTION__, job, result);
+    return false;
+  }
+
+  VkPushConstants modelData{};
+
+  /* skybox and levels */
+  if (!CommandBuffer::beginSecondary(levelCommandBuffer, levelPassInfo.renderPass, levelPassInfo.framebuffer)) {
+    Logger::log(1, "%s error: failed to begin level command buffer of job %i\n", __FUNCTION__, job);
+    return false;
+  }
+
+  /* dynamic state is not inherited from the primary command buffer */
+  vkCmdSetViewport(levelCommandBuffer, 0, 1, &viewport);
+  vkCmdSetScissor(levelCommandBuffer, 0, 1, &scissor);
+
+  if (job == 0 && mRenderData.rdDrawSkybox) {
+    vkCmdBindPipeline(levelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdSkyboxPipeline);
+
+    vkCmdBindDescriptorSets(levelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+     mRenderData.rdSkyboxPipelineLayout, 0, 1,
+     &mSkyboxTexture.descriptorSet, 0, nullptr);
+    vkCmdBindDescriptorSets(levelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdSkyboxPipelineLayout, 1, 1,
+      &mRenderData.rdSkyboxDescriptorSet, 0, nullptr);
+
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(levelCommandBuffer, 0, 1, &mSkyboxBuffer.buffer, &offset);
+
+    vkCmdDraw(levelCommandBuffer, static_cast<uint32_t>(mSphereModel.getVertexData().vertices.size()), 1, 0, 0);
+  }
+
+  /* global texture array, all level and model layouts share set 0, the meshes only push the texture index */
+  vkCmdBindDescriptorSets(levelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+    mRenderData.rdAssimpLevelPipelineLayout, 0, 1,
+    &mRenderData.rdGlobalTextureDescriptorSet, 0, nullptr);
+
+  size_t levelStart = mLevelDrawEntries.size() * job / numJobs;
+  size_t levelEnd = mLevelDrawEntries.size() * (job + 1) / numJobs;
+  for (size_t i = levelStart; i < levelEnd; ++i) {
+    const LevelDrawEntry& entry = mLevelDrawEntries.at(i);
+
+    vkCmdBindPipeline(levelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdAssimpLevelPipeline);
+
+    vkCmdBindDescriptorSets(levelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+      mRenderData.rdAssimpLevelPipelineLayout, 1, 1,
+      &mRenderData.rdAssimpLevelDescriptorSet, 0, nullptr);
+
+    modelData.pkWorldPosOffset = entry.levelPosOffset;
+    vkCmdPushConstants(levelCommandBuffer, mRenderData.rdAssimpLevelPipelineLayout,
+      VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &modelData);
+
+    entry.level->draw(mRenderData, levelCommandBuffer);
+  }
+
+  if (!CommandBuffer::end(levelCommandBuffer)) {
+    Logger::log(1, "%s error: failed to end level command buffer of job %i\n", __FUNCTION__, job);
+    return false;
+  }
+
+  /* models */
+  if (!CommandBuffer::beginSecondary(modelCommandBuffer, modelPassInfo.renderPass, modelPassInfo.framebuffer)) {
+    Logger::log(1, "%s error: failed to begin model command buffer of job %i\n", __FUNCTION__, job);
+    return false;
+  }
+
+  vkCmdSetViewport(modelCommandBuffer, 0, 1, &viewport);
+  vkCmdSetScissor(modelCommandBuffer, 0, 1, &scissor);
+
+  vkCmdBindDescriptorSets(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+    mRenderData.rdAssimpPipelineLayout, 0, 1,
+    &mRenderData.rdGlobalTextureDescriptorSet, 0, nullptr);
+
+  size_t modelStart = mModelDrawEntries.size() * job / numJobs;
+  size_t modelEnd = mModelDrawEntries.size() * (job + 1) / numJobs;
+  for (size_t i = modelStart; i < modelEnd; ++i) {
+    const ModelDrawEntry& entry = mModelDrawEntries.at(i);
+    const std::shared_ptr<AssimpModel>& model = entry.model;
+
+    /* animated models */
+    if (model->hasAnimations() && !model->getBoneList().empty()) {
+      size_t numberOfBones = model->getBoneList().size();
+
+      /* draw all meshes without morph anims first */
+      if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
+        vkCmdBindPipeline(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+          mRenderData.rdAssimpSkinningSelectionPipeline);
+
+        vkCmdBindDescriptorSets(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+          mRenderData.rdAssimpSkinningSelectionPipelineLayout, 1, 1,
+         &mRenderData.rdAssimpSkinningSelectionDescriptorSet, 0, nullptr);
+      } else {
+        vkCmdBindPipeline(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+          mRenderData.rdAssimpSkinningPipeline);
+
+        vkCmdBindDescriptorSets(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+          mRenderData.rdAssimpSkinningPipelineLayout, 1, 1,
+          &mRenderData.rdAssimpSkinningDescriptorSet, 0, nullptr);
+      }
+
+      modelData.pkModelStride = numberOfBones;
+      modelData.pkWorldPosOffset = entry.worldPosOffset;
+      modelData.pkSkinMatOffset = entry.skinMatOffset;
+      if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
+        vkCmdPushConstants(modelCommandBuffer, mRenderData.rdAssimpSkinningSelectionPipelineLayout,
+          VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &modelData);
+      } else {
+        vkCmdPushConstants(modelCommandBuffer, mRenderData.rdAssimpSkinningPipelineLayout,
+          VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &modelData);
+      }
+
+      model->drawInstancedNoMorphAnims(mRenderData, modelCommandBuffer, entry.numberOfInstances, mMousePick);
+
+      /* and if the model has morph anims, draw them in a separate pass  */
+      if (model->hasAnimMeshes()) {
+        if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
+          vkCmdBindPipeline(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+            mRenderData.rdAssimpSkinningMorphSelectionPipeline);
+
+          vkCmdBindDescriptorSets(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+            mRenderData.rdAssimpSkinningMorphSelectionPipelineLayout, 1, 1,
+            &mRenderData.rdAssimpSkinningMorphSelectionDescriptorSet, 0, nullptr);
+        } else {
+          vkCmdBindPipeline(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+            mRenderData.rdAssimpSkinningMorphPipeline);
+
+          vkCmdBindDescriptorSets(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+            mRenderData.rdAssimpSkinningMorphPipelineLayout, 1, 1,
+            &mRenderData.rdAssimpSkinningMorphDescriptorSet, 0, nullptr);
+        }
+
+        if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
+          vkCmdPushConstants(modelCommandBuffer, mRenderData.rdAssimpSkinningMorphSelectionPipelineLayout,
+            VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &modelData);
+        } else {
+          vkCmdPushConstants(modelCommandBuffer, mRenderData.rdAssimpSkinningMorphPipelineLayout,
+            VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &modelData);
+        }
+
+        model->drawInstancedMorphAnims(mRenderData, modelCommandBuffer, entry.numberOfInstances, mMousePick);
+      }
+    } else {
+      /* non-animated models */
+      if (mMousePick) {
+        vkCmdBindPipeline(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdAssimpSelectionPipeline);
+
+        vkCmdBindDescriptorSets(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+          mRenderData.rdAssimpSelectionPipelineLayout, 1, 1, &mRenderData.rdAssimpSelectionDescriptorSet, 0, nullptr);
+      } else {
+        vkCmdBindPipeline(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdAssimpPipeline);
+
+        vkCmdBindDescriptorSets(modelCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+          mRenderData.rdAssimpPipelineLayout, 1, 1, &mRenderData.rdAssimpDescriptorSet, 0, nullptr);
+      }
+
+      modelData.pkWorldPosOffset = entry.worldPosOffset;
+      if (mMousePick) {
+        vkCmdPushConstants(modelCommandBuffer, mRenderData.rdAssimpSelectionPipelineLayout,
+          VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &modelData);
+      } else {
+        vkCmdPushConstants(modelCommandBuffer, mRenderData.rdAssimpPipelineLayout,
+          VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &modelData);
+      }
+
+      model->drawInstanced(mRenderData, modelCommandBuffer, entry.numberOfInstances, mMousePick);
+    }
+  }
+
+  if (!CommandBuffer::end(modelCommandBuffer)) {
+    Logger::log(1, "%s error: failed to end model command buffer of job %i\n", __FUNCTION__, job);
+    return false;
+  }
+
+  return true;
+}
+
 bool VkRenderer::draw(float deltaTime) {
   if (!mApplicationRunning) {
     return false;
@@ -6350,6 +6905,9 @@ bool VkRenderer::draw(float deltaTime) {
   mRenderData.rdPathFindingTime = 0.0f;
   mRenderData.rdLevelGroundNeighborUpdateTime = 0.0f;
 
+  /* advance to the next frame in flight, its fences guard all per-frame buffers and descriptor sets */
+  selectFrame((mRenderData.rdCurrentFrame + 1) % mRenderData.rdFramesInFlight);
+
   /* wait for both fences before getting the new framebuffer image */
   std::vector<VkFence> waitFences = { mRenderData.rdComputeFence, mRenderData.rdRenderFence };
   VkResult result = vkWaitForFences(mRenderData.rdVkbDevice.device,
@@ -6359,6 +6917,27 @@ bool VkRenderer::draw(float deltaTime) {
     return false;
   }
 
+  /* one more frame in flight has finished, shared buffers of older resizes may be unused now */
+  ShaderStorageBuffer::destroyPendingBuffers(mRenderData);
+
+  /* a mouse pick recorded the last time this frame was used has finished now */
+  float selectedInstanceId = 0.0f;
+  if (SelectionFramebuffer::getReadbackPixelValue(mRenderData, selectedInstanceId) &&
+      mRenderData.rdApplicationMode == appMode::edit) {
+    if (selectedInstanceId >= 0.0f) {
+      mModelInstCamData.micSelectedInstance = static_cast<int>(selectedInstanceId);
+    } else {
+      mModelInstCamData.micSelectedInstance = 0;
+    }
+    mModelInstCamData.micSettingsContainer->applySelectInstance(mModelInstCamData.micSelectedInstance, mSavedSelectedInstanceId);
+  }
+
+  /* GPU times of the last use of this frame in flight, shown in the next UI frame */
+  mGpuTimer.beginFrame(mRenderData);
+  for (unsigned int i = 0; i < static_cast<unsigned int>(gpuPass::NUM); ++i) {
+    mRenderData.rdGpuPassTimes.at(i) = mGpuTimer.getPassTime(static_cast<gpuPass>(i));
+  }
+
   uint32_t imageIndex = 0;
   result = vkAcquireNextImageKHR(mRenderData.rdVkbDevice.device,
       mRenderData.rdVkbSwapchain.swapchain,
@@ -6376,6 +6955,12 @@ bool VkRenderer::draw(float deltaTime) {
     }
   }
 
+  /* collect vertex and index uploads until the graphics submit */
+  StagingBuffer::beginFrame(mRenderData);
+
+  /* take over finished model and level uploads, they can be drawn from this frame on */
+  bool uploadsAcquired = UploadManager::recordFinishedBatches(mRenderData, mRenderData.rdAcquireCommandBuffer);
+
   /* calculate the size of the lookup matrix buffer over all animated instances */
   size_t boneMatrixBufferSize = 0;
   size_t lookupBufferSize = 0;
@@ -6786,21 +7371,21 @@ bool VkRenderer::draw(float deltaTime) {
 
   /* upload vertex data for instance paths and neighbor triangles */
   mUploadToVBOTimer.start();
-  VertexBuffer::uploadData(mRenderData, mInstancePathVertexBuffer, *mInstancePathMesh);
-  VertexBuffer::uploadData(mRenderData, mGroundMeshNeighborVertexBuffer, *mLevelGroundNeighborsMesh);
+  VertexBuffer::uploadData(mRenderData, mInstancePathVertexBuffer.at(mRenderData.rdCurrentFrame), *mInstancePathMesh);
+  VertexBuffer::uploadData(mRenderData, mGroundMeshNeighborVertexBuffer.at(mRenderData.rdCurrentFrame), *mLevelGroundNeighborsMesh);
   mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
 
   /* we need to update descriptors after the upload if buffer size changed */
   bool bufferResized = false;
   mUploadToUBOTimer.start();
-  bufferResized = ShaderStorageBuffer::uploadSsboData(mRenderData, mPerInstanceAnimDataBuffer, mPerInstanceAnimData);
-  bufferResized |= ShaderStorageBuffer::uploadSsboData(mRenderData, mSelectedInstanceBuffer, mSelectedInstance);
-  bufferResized |= ShaderStorageBuffer::uploadSsboData(mRenderData, mFaceAnimPerInstanceDataBuffer, mFaceAnimPerInstanceData);
+  bufferResized = ShaderStorageBuffer::uploadSsboData(mRenderData, mPerInstanceAnimDataBuffer.at(mRenderData.rdCurrentFrame), mPerInstanceAnimData);
+  bufferResized |= ShaderStorageBuffer::uploadSsboData(mRenderData, mSelectedInstanceBuffer.at(mRenderData.rdCurrentFrame), mSelectedInstance);
+  bufferResized |= ShaderStorageBuffer::uploadSsboData(mRenderData, mFaceAnimPerInstanceDataBuffer.at(mRenderData.rdCurrentFrame), mFaceAnimPerInstanceData);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
   /* resize SSBO if needed */
-  bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mShaderTRSMatrixBuffer, boneMatrixBufferSize * 3 * sizeof(glm::vec4));
-  bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mShaderBoneMatrixBuffer, boneMatrixBufferSize * sizeof(glm::mat4));
+  bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mShaderTRSMatrixBuffer.at(mRenderData.rdCurrentFrame), boneMatrixBufferSize * 3 * sizeof(glm::vec4));
+  bufferResized |= ShaderStorageBuffer::checkForResize(mRenderData, mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame), boneMatrixBufferSize * sizeof(glm::mat4));
 
   if (bufferResized) {
     updateDescriptorSets();
@@ -6848,16 +7433,14 @@ bool VkRenderer::draw(float deltaTime) {
       return false;
     }
 
-    /* submit compute commands */
-    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-
+    /* submit compute commands, no need to wait for the previous frame as all written buffers are per frame.
+     * the graphics submit waits on the semaphore, the CPU only waits on the fence if it reads data back */
     VkSubmitInfo computeSubmitInfo{};
     computeSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
     computeSubmitInfo.commandBufferCount = 1;
     computeSubmitInfo.pCommandBuffers = &mRenderData.rdComputeCommandBuffer;
-    computeSubmitInfo.waitSemaphoreCount = 1;
-    computeSubmitInfo.pWaitSemaphores = &mRenderData.rdGraphicSemaphore;
-    computeSubmitInfo.pWaitDstStageMask = &waitStage;
+    computeSubmitInfo.signalSemaphoreCount = 1;
+    computeSubmitInfo.pSignalSemaphores = &mRenderData.rdComputeSemaphore;
 
     result = vkQueueSubmit(mRenderData.rdComputeQueue, 1, &computeSubmitInfo, mRenderData.rdComputeFence);
     if (result != VK_SUCCESS) {
@@ -6865,14 +7448,11 @@ bool VkRenderer::draw(float deltaTime) {
       return false;
     };
   } else {
-    /* do an empty submit if we don't have animated models to satisfy fence and semaphore */
-    VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-
+    /* do an empty submit if we don't have animated models to satisfy the fence and the semaphore */
     VkSubmitInfo computeSubmitInfo{};
     computeSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    computeSubmitInfo.waitSemaphoreCount = 1;
-    computeSubmitInfo.pWaitSemaphores = &mRenderData.rdGraphicSemaphore;
-    computeSubmitInfo.pWaitDstStageMask = &waitStage;
+    computeSubmitInfo.signalSemaphoreCount = 1;
+    computeSubmitInfo.pSignalSemaphores = &mRenderData.rdComputeSemaphore;
 
     result = vkQueueSubmit(mRenderData.rdComputeQueue, 1, &computeSubmitInfo, mRenderData.rdComputeFence);
     if (result != VK_SUCCESS) {
@@ -6881,25 +7461,23 @@ bool VkRenderer::draw(float deltaTime) {
     };
   }
 
-  /* we must wait for the compute shaders to finish before we can read the bone data */
-  result = vkWaitForFences(mRenderData.rdVkbDevice.device, 1, &mRenderData.rdComputeFence, VK_TRUE, UINT64_MAX);
-  if (result != VK_SUCCESS) {
-    Logger::log(1, "%s error: waiting for compute fence failed (error: %i)\n", __FUNCTION__, result);
-    return false;
-  }
-
   /* first person follow cam node */
   if (camSettings.csCamType == cameraType::firstPerson && cam->getInstanceToFollow()) {
     std::shared_ptr<AssimpModel> model = cam->getInstanceToFollow()->getModel();
     size_t numberOfBones = model->getBoneList().size();
     if (numberOfBones > 0) {
+      /* we must wait for the compute shaders to finish before we can read the bone data */
+      if (!waitForComputeFence()) {
+        return false;
+      }
+
       int selectedBone = camSettings.csFirstPersonBoneToFollow;
 
       glm::mat4 offsetMatrix = glm::translate(glm::mat4(1.0f), camSettings.csFirstPersonOffsets);
 
       /* get the bone matrix of the selected bone from the SSBO */
       mDownloadFromUBOTimer.start();
-      glm::mat4 boneMatrix = ShaderStorageBuffer::getSsboDataMat4(mRenderData, mShaderBoneMatrixBuffer,
+      glm::mat4 boneMatrix = ShaderStorageBuffer::getSsboDataMat4(mRenderData, mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame),
         firstPersonCamBoneMatrixPos + selectedBone);
       mRenderData.rdDownloadFromUBOTime += mDownloadFromUBOTimer.stop();
 
@@ -6916,6 +7494,11 @@ bool VkRenderer::draw(float deltaTime) {
   }
 
   if (mRenderData.rdEnableFeetIK && boneMatrixBufferSize > 0) {
+    /* read back of the node positions needs the results of the compute shaders */
+    if (!waitForComputeFence()) {
+      return false;
+    }
+
     mIKTimer.start();
 
     mIKMatrices.clear();
@@ -6925,8 +7508,8 @@ bool VkRenderer::draw(float deltaTime) {
 
     /* read back all node positions for foot positions  */
     mDownloadFromUBOTimer.start();
-    mIKMatrices = ShaderStorageBuffer::getSsboDataMat4(mRenderData, mShaderBoneMatrixBuffer, 0, boneMatrixBufferSize);
-    mTRSData = ShaderStorageBuffer::getSsboDataTRSMatrixData(mRenderData, mShaderTRSMatrixBuffer, 0, boneMatrixBufferSize);
+    mIKMatrices = ShaderStorageBuffer::getSsboDataMat4(mRenderData, mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame), 0, boneMatrixBufferSize);
+    mTRSData = ShaderStorageBuffer::getSsboDataTRSMatrixData(mRenderData, mShaderTRSMatrixBuffer.at(mRenderData.rdCurrentFrame), 0, boneMatrixBufferSize);
     mRenderData.rdDownloadFromUBOTime += mDownloadFromUBOTimer.stop();
 
     /* resize SSBO if needed */
@@ -7101,13 +7684,13 @@ bool VkRenderer::draw(float deltaTime) {
 
     if (!mIKFootPointMesh->vertices.empty()) {
       mUploadToVBOTimer.start();
-      VertexBuffer::uploadData(mRenderData, mIKLinesVertexBuffer, *mIKFootPointMesh);
+      VertexBuffer::uploadData(mRenderData, mIKLinesVertexBuffer.at(mRenderData.rdCurrentFrame), *mIKFootPointMesh);
       mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
     }
 
     /* update original bone matrix buffer for drawing */
     mUploadToUBOTimer.start();
-    ShaderStorageBuffer::uploadSsboData(mRenderData, mShaderBoneMatrixBuffer, mIKMatrices);
+    ShaderStorageBuffer::uploadSsboData(mRenderData, mShaderBoneMatrixBuffer.at(mRenderData.rdCurrentFrame), mIKMatrices);
     mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
     mRenderData.rdIKTime += mIKTimer.stop();
@@ -7199,8 +7782,8 @@ bool VkRenderer::draw(float deltaTime) {
 
   /* we need to update descriptors after the upload if buffer size changed */
   mUploadToUBOTimer.start();
-  UniformBuffer::uploadData(mRenderData, mPerspectiveViewMatrixUBO, mMatrices);
-  bufferResized = ShaderStorageBuffer::uploadSsboData(mRenderData, mShaderModelRootMatrixBuffer, mWorldPosMatrices);
+  UniformBuffer::uploadData(mRenderData, mPerspectiveViewMatrixUBO.at(mRenderData.rdCurrentFrame), mMatrices);
+  bufferResized = ShaderStorageBuffer::uploadSsboData(mRenderData, mShaderModelRootMatrixBuffer.at(mRenderData.rdCurrentFrame), mWorldPosMatrices);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
   if (bufferResized) {
@@ -7222,7 +7805,7 @@ bool VkRenderer::draw(float deltaTime) {
 
   /* we need to update descriptors after the upload if buffer size changed */
   mUploadToUBOTimer.start();
-  bufferResized = ShaderStorageBuffer::uploadSsboData(mRenderData, mShaderLevelRootMatrixBuffer, mLevelWorldPosMatrices);
+  bufferResized = ShaderStorageBuffer::uploadSsboData(mRenderData, mShaderLevelRootMatrixBuffer.at(mRenderData.rdCurrentFrame), mLevelWorldPosMatrices);
   mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
 
   if (bufferResized) {
@@ -7235,16 +7818,7 @@ bool VkRenderer::draw(float deltaTime) {
     Logger::log(1, "%s error:  fence reset failed (error: %i)\n", __FUNCTION__, result);
     return false;
   }
-
-  if (!CommandBuffer::reset(mRenderData.rdCommandBuffer, 0)) {
-    Logger::log(1, "%s error: failed to reset command buffer\n", __FUNCTION__);
-    return false;
-  }
-
-  if (!CommandBuffer::beginSingleShot(mRenderData.rdCommandBuffer)) {
-    Logger::log(1, "%s error: failed to begin command buffer\n", __FUNCTION__);
-    return false;
-  }
+  mRenderFenceReset = true;
 
   std::vector<VkClearValue> colorClearValues{};
   VkClearValue colorClearValue;
@@ -7254,21 +7828,45 @@ bool VkRenderer::draw(float deltaTime) {
   VkClearValue depthValue;
   depthValue.depthStencil.depth = 1.0f;
 
-  std::vector<VkClearValue> clearValues{};
-  clearValues.insert(clearValues.end(), colorClearValues.begin(), colorClearValues.end());
-  clearValues.emplace_back(depthValue);
+  std::vector<VkClearValue> levelClearValues{};
+  levelClearValues.insert(levelClearValues.end(), colorClearValues.begin(), colorClearValues.end());
+  levelClearValues.emplace_back(depthValue);
 
-  VkRenderPassBeginInfo rpInfo{};
-  rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-  rpInfo.renderPass = mRenderData.rdLevelRenderpass;
-  rpInfo.framebuffer = mRenderData.rdFramebuffers.at(imageIndex);
+  VkRenderPassBeginInfo levelPassInfo{};
+  levelPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+  levelPassInfo.renderPass = mRenderData.rdLevelRenderpass;
+  levelPassInfo.framebuffer = mRenderData.rdFramebuffers.at(imageIndex);
 
-  rpInfo.renderArea.offset.x = 0;
-  rpInfo.renderArea.offset.y = 0;
-  rpInfo.renderArea.extent = mRenderData.rdVkbSwapchain.extent;
+  levelPassInfo.renderArea.offset.x = 0;
+  levelPassInfo.renderArea.offset.y = 0;
+  levelPassInfo.renderArea.extent = mRenderData.rdVkbSwapchain.extent;
 
-  rpInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-  rpInfo.pClearValues = clearValues.data();
+  levelPassInfo.clearValueCount = static_cast<uint32_t>(levelClearValues.size());
+  levelPassInfo.pClearValues = levelClearValues.data();
+
+  /* draw instances second */
+  VkRenderPassBeginInfo modelPassInfo = levelPassInfo;
+  std::vector<VkClearValue> modelClearValues{};
+  if (mMousePick) {
+    modelPassInfo.renderPass = mRenderData.rdSelectionRenderpass;
+    modelPassInfo.framebuffer = mRenderData.rdSelectionFramebuffers.at(imageIndex);
+
+    VkClearValue selectionClearValue;
+    selectionClearValue.color = { { -1.0f } };
+
+    /* first value will be ignored, loadOp is VK_ATTACHMENT_LOAD_OP_LOAD */
+    modelClearValues.emplace_back(colorClearValue);
+    modelClearValues.emplace_back(selectionClearValue);
+
+    modelPassInfo.clearValueCount = static_cast<uint32_t>(modelClearValues.size());
+    modelPassInfo.pClearValues = modelClearValues.data();
+  } else {
+    modelPassInfo.renderPass = mRenderData.rdRenderpass;
+    modelPassInfo.framebuffer = mRenderData.rdFramebuffers.at(imageIndex);
+
+    modelPassInfo.clearValueCount = 0;
+    modelPassInfo.pClearValues = VK_NULL_HANDLE;
+  }
 
   /* flip viewport to be compatible with OpenGL */
   VkViewport viewport{};
@@ -7283,190 +7881,91 @@ bool VkRenderer::draw(float deltaTime) {
   scissor.offset = { 0, 0 };
   scissor.extent = mRenderData.rdVkbSwapchain.extent;
 
-  vkCmdSetViewport(mRenderData.rdCommandBuffer, 0, 1, &viewport);
-  vkCmdSetScissor(mRenderData.rdCommandBuffer, 0, 1, &scissor);
-
-  /* draw skybox and levels first */
-  vkCmdBeginRenderPass(mRenderData.rdCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-  if (mRenderData.rdDrawSkybox) {
-    vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      mRenderData.rdSkyboxPipeline);
-
-    vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-     mRenderData.rdSkyboxPipelineLayout, 0, 1,
-     &mSkyboxTexture.descriptorSet, 0, nullptr);
-    vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      mRenderData.rdSkyboxPipelineLayout, 1, 1,
-      &mRenderData.rdSkyboxDescriptorSet, 0, nullptr);
-
-    VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(mRenderData.rdCommandBuffer, 0, 1, &mSkyboxBuffer.buffer, &offset);
-
-    vkCmdDraw(mRenderData.rdCommandBuffer, static_cast<uint32_t>(mSphereModel.getVertexData().vertices.size()), 1, 0, 0);
-  }
-
+  /* collect levels and models with their buffer offsets, the jobs only read these lists */
+  mLevelDrawEntries.clear();
   uint32_t levelPosOffset = 0;
   for (const auto& level : mModelInstCamData.micLevels) {
     if (level->getTriangleCount() == 0) {
       continue;
     }
-
-    vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      mRenderData.rdAssimpLevelPipeline);
-
-    vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-      mRenderData.rdAssimpLevelPipelineLayout, 1, 1,
-      &mRenderData.rdAssimpLevelDescriptorSet, 0, nullptr);
-
-    mUploadToUBOTimer.start();
-    mModelData.pkWorldPosOffset = levelPosOffset;
-    vkCmdPushConstants(mRenderData.rdCommandBuffer, mRenderData.rdAssimpLevelPipelineLayout,
-      VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &mModelData);
-
-    mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
-    level->draw(mRenderData);
+    /* keep the offset, the matrix buffer contains all levels */
+    if (UploadManager::isBatchFinished(mRenderData, level->getUploadBatch())) {
+      mLevelDrawEntries.emplace_back(LevelDrawEntry{level, levelPosOffset});
+    }
     ++levelPosOffset;
   }
 
-  vkCmdEndRenderPass(mRenderData.rdCommandBuffer);
-
-  /* draw instances second */
-  if (mMousePick) {
-    rpInfo.renderPass = mRenderData.rdSelectionRenderpass;
-    rpInfo.framebuffer = mRenderData.rdSelectionFramebuffers.at(imageIndex);
-
-    VkClearValue selectionClearValue;
-    selectionClearValue.color = { { -1.0f } };
-
-    clearValues.clear();
-    /* first value will be ignored, loadOp is VK_ATTACHMENT_LOAD_OP_LOAD */
-    clearValues.emplace_back(colorClearValue);
-    clearValues.emplace_back(selectionClearValue);
-
-    rpInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
-    rpInfo.pClearValues = clearValues.data();
-  } else {
-    rpInfo.renderPass = mRenderData.rdRenderpass;
-    rpInfo.framebuffer = mRenderData.rdFramebuffers.at(imageIndex);
-
-    rpInfo.clearValueCount = 0;
-    rpInfo.pClearValues = VK_NULL_HANDLE;
-  }
-
-  vkCmdBeginRenderPass(mRenderData.rdCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
-
+  mModelDrawEntries.clear();
   uint32_t worldPosOffset = 0;
   uint32_t skinMatOffset = 0;
   for (const auto& model : mModelInstCamData.micModelList) {
     size_t numberOfInstances = mModelInstCamData.micAssimpInstancesPerModel[model->getModelFileName()].size();
     if (numberOfInstances > 0 && model->getTriangleCount() > 0) {
+      /* models still uploading are skipped until their data is on the GPU */
+      if (UploadManager::isBatchFinished(mRenderData, model->getUploadBatch())) {
+        mModelDrawEntries.emplace_back(ModelDrawEntry{model, static_cast<uint32_t>(numberOfInstances),
+          worldPosOffset, skinMatOffset});
+      }
 
-      /* animated models */
+      worldPosOffset += numberOfInstances;
       if (model->hasAnimations() && !model->getBoneList().empty()) {
-        size_t numberOfBones = model->getBoneList().size();
-
-        /* draw all meshes without morph anims first */
-        if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
-          vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            mRenderData.rdAssimpSkinningSelectionPipeline);
-
-          vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            mRenderData.rdAssimpSkinningSelectionPipelineLayout, 1, 1,
-           &mRenderData.rdAssimpSkinningSelectionDescriptorSet, 0, nullptr);
-        } else {
-          vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            mRenderData.rdAssimpSkinningPipeline);
-
-          vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            mRenderData.rdAssimpSkinningPipelineLayout, 1, 1,
-            &mRenderData.rdAssimpSkinningDescriptorSet, 0, nullptr);
-        }
-
-        mUploadToUBOTimer.start();
-        mModelData.pkModelStride = numberOfBones;
-        mModelData.pkWorldPosOffset = worldPosOffset;
-        mModelData.pkSkinMatOffset = skinMatOffset;
-        if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
-          vkCmdPushConstants(mRenderData.rdCommandBuffer, mRenderData.rdAssimpSkinningSelectionPipelineLayout,
-            VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &mModelData);
-        } else {
-          vkCmdPushConstants(mRenderData.rdCommandBuffer, mRenderData.rdAssimpSkinningPipelineLayout,
-            VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &mModelData);
-        }
-        mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
-
-        model->drawInstancedNoMorphAnims(mRenderData, numberOfInstances, mMousePick);
-
-        /* and if the model has morph anims, draw them in a separate pass  */
-        if (model->hasAnimMeshes()) {
-          if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
-            vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-              mRenderData.rdAssimpSkinningMorphSelectionPipeline);
-
-            vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-              mRenderData.rdAssimpSkinningMorphSelectionPipelineLayout, 1, 1,
-              &mRenderData.rdAssimpSkinningMorphSelectionDescriptorSet, 0, nullptr);
-          } else {
-            vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-              mRenderData.rdAssimpSkinningMorphPipeline);
+        skinMatOffset += numberOfInstances * model->getBoneList().size();
+      }
+    }
+  }
 
-            vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-              mRenderData.rdAssimpSkinningMorphPipelineLayout, 1, 1,
-              &mRenderData.rdAssimpSkinningMorphDescriptorSet, 0, nullptr);
-          }
+  /* record the secondary command buffers in parallel, every job uses its own command pool */
+  mCommandRecordTimer.start();
+  std::vector<std::future<bool>> recordJobs{};
+  for (unsigned int i = 0; i < mRenderData.rdRecordJobs; ++i) {
+    recordJobs.emplace_back(mRecordThreadPool.submit([&, i]() {
+      return recordSecondaryCommands(i, levelPassInfo, modelPassInfo, viewport, scissor);
+    }));
+  }
 
-          mUploadToUBOTimer.start();
-          mModelData.pkModelStride = numberOfBones;
-          mModelData.pkWorldPosOffset = worldPosOffset;
-          mModelData.pkSkinMatOffset = skinMatOffset;
-          if (mMousePick && mRenderData.rdApplicationMode == appMode::edit) {
-            vkCmdPushConstants(mRenderData.rdCommandBuffer, mRenderData.rdAssimpSkinningMorphSelectionPipelineLayout,
-              VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &mModelData);
-          } else {
-            vkCmdPushConstants(mRenderData.rdCommandBuffer, mRenderData.rdAssimpSkinningMorphPipelineLayout,
-              VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &mModelData);
-          }
-          mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
+  bool recordSuccess = true;
+  for (auto& job : recordJobs) {
+    recordSuccess &= job.get();
+  }
+  mRenderData.rdCommandRecordTime = mCommandRecordTimer.stop();
 
-          model->drawInstancedMorphAnims(mRenderData, numberOfInstances, mMousePick);
-        }
+  if (!recordSuccess) {
+    Logger::log(1, "%s error: failed to record secondary command buffers\n", __FUNCTION__);
+    return false;
+  }
 
-        worldPosOffset += numberOfInstances;
-        skinMatOffset += numberOfInstances * numberOfBones;
-      } else {
-        /* non-animated models */
-        if (mMousePick) {
-          vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdAssimpSelectionPipeline);
+  const VkPerFrameData& frameData = mRenderData.rdPerFrameData.at(mRenderData.rdCurrentFrame);
 
-          vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            mRenderData.rdAssimpSelectionPipelineLayout, 1, 1, &mRenderData.rdAssimpSelectionDescriptorSet, 0, nullptr);
-        } else {
-          vkCmdBindPipeline(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdAssimpPipeline);
+  if (!CommandBuffer::reset(mRenderData.rdCommandBuffer, 0)) {
+    Logger::log(1, "%s error: failed to reset command buffer\n", __FUNCTION__);
+    return false;
+  }
 
-          vkCmdBindDescriptorSets(mRenderData.rdCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
-            mRenderData.rdAssimpPipelineLayout, 1, 1, &mRenderData.rdAssimpDescriptorSet, 0, nullptr);
-        }
+  if (!CommandBuffer::beginSingleShot(mRenderData.rdCommandBuffer)) {
+    Logger::log(1, "%s error: failed to begin command buffer\n", __FUNCTION__);
+    return false;
+  }
 
-        mUploadToUBOTimer.start();
-        mModelData.pkWorldPosOffset = worldPosOffset;
-        if (mMousePick) {
-          vkCmdPushConstants(mRenderData.rdCommandBuffer, mRenderData.rdAssimpSelectionPipelineLayout,
-            VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &mModelData);
-        } else {
-          vkCmdPushConstants(mRenderData.rdCommandBuffer, mRenderData.rdAssimpPipelineLayout,
-            VK_SHADER_STAGE_VERTEX_BIT, 0, static_cast<uint32_t>(sizeof(VkPushConstants)), &mModelData);
-        }
-        mRenderData.rdUploadToUBOTime += mUploadToUBOTimer.stop();
+  /* draw skybox and levels first */
+  mGpuTimer.start(mRenderData, mRenderData.rdCommandBuffer, gpuPass::level);
+  vkCmdBeginRenderPass(mRenderData.rdCommandBuffer, &levelPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+  vkCmdExecuteCommands(mRenderData.rdCommandBuffer, static_cast<uint32_t>(frameData.pfLevelCommandBuffers.size()),
+    frameData.pfLevelCommandBuffers.data());
+  vkCmdEndRenderPass(mRenderData.rdCommandBuffer);
+  mGpuTimer.stop(mRenderData, mRenderData.rdCommandBuffer, gpuPass::level);
 
-        model->drawInstanced(mRenderData, numberOfInstances, mMousePick);
+  gpuPass modelPass = mMousePick ? gpuPass::selection : gpuPass::models;
+  mGpuTimer.start(mRenderData, mRenderData.rdCommandBuffer, modelPass);
+  vkCmdBeginRenderPass(mRenderData.rdCommandBuffer, &modelPassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+  vkCmdExecuteCommands(mRenderData.rdCommandBuffer, static_cast<uint32_t>(frameData.pfModelCommandBuffers.size()),
+    frameData.pfModelCommandBuffers.data());
+  vkCmdEndRenderPass(mRenderData.rdCommandBuffer);
 
-        worldPosOffset += numberOfInstances;
-      }
-    }
+  /* the selected instance is read when this frame in flight is used again, no queue wait needed */
+  if (mMousePick) {
+    SelectionFramebuffer::recordPixelReadback(mRenderData, mRenderData.rdCommandBuffer, mMouseXPos, mMouseYPos);
   }
-
-  vkCmdEndRenderPass(mRenderData.rdCommandBuffer);
+  mGpuTimer.stop(mRenderData, mRenderData.rdCommandBuffer, modelPass);
 
   if (!CommandBuffer::end(mRenderData.rdCommandBuffer)) {
     Logger::log(1, "%s error: failed to end command buffer\n", __FUNCTION__);
@@ -7533,9 +8032,20 @@ bool VkRenderer::draw(float deltaTime) {
     return false;
   }
 
+  /* line and ImGui passes load the color and depth attachments, no clear values needed */
+  VkRenderPassBeginInfo rpInfo{};
+  rpInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
   rpInfo.renderPass = mRenderData.rdLineRenderpass;
   rpInfo.framebuffer = mRenderData.rdFramebuffers.at(imageIndex);
 
+  rpInfo.renderArea.offset.x = 0;
+  rpInfo.renderArea.offset.y = 0;
+  rpInfo.renderArea.extent = mRenderData.rdVkbSwapchain.extent;
+
+  rpInfo.clearValueCount = 0;
+  rpInfo.pClearValues = nullptr;
+
+  mGpuTimer.start(mRenderData, mRenderData.rdLineCommandBuffer, gpuPass::debugLines);
   vkCmdBeginRenderPass(mRenderData.rdLineCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
 
   vkCmdSetViewport(mRenderData.rdLineCommandBuffer, 0, 1, &viewport);
@@ -7543,7 +8053,7 @@ bool VkRenderer::draw(float deltaTime) {
 
   if (mLineIndexCount > 0) {
     mUploadToVBOTimer.start();
-    VertexBuffer::uploadData(mRenderData, mLineVertexBuffer, *mLineMesh);
+    VertexBuffer::uploadData(mRenderData, mLineVertexBuffer.at(mRenderData.rdCurrentFrame), *mLineMesh);
     mRenderData.rdUploadToVBOTime += mUploadToVBOTimer.stop();
 
     vkCmdBindPipeline(mRenderData.rdLineCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mRenderData.rdLinePipeline);
@@ -7552,7 +8062,7 @@ bool VkRenderer::draw(float deltaTime) {
       mRenderData.rdLinePipelineLayout, 0, 1, &mRenderData.rdLineDescriptorSet, 0, nullptr);
 
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mLineVertexBuffer.buffer, &offset);
+    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mLineVertexBuffer.at(mRenderData.rdCurrentFrame).buffer, &offset);
     vkCmdSetLineWidth(mRenderData.rdLineCommandBuffer, 3.0f);
     vkCmdDraw(mRenderData.rdLineCommandBuffer, static_cast<uint32_t>(mLineMesh->vertices.size()), 1, 0, 0);
   }
@@ -7589,7 +8099,7 @@ bool VkRenderer::draw(float deltaTime) {
       mRenderData.rdSpherePipelineLayout, 0, 1, &mRenderData.rdSphereDescriptorSet, 0, nullptr);
 
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mSphereVertexBuffer.buffer, &offset);
+    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mSphereVertexBuffer.at(mRenderData.rdCurrentFrame).buffer, &offset);
     vkCmdSetLineWidth(mRenderData.rdLineCommandBuffer, 3.0f);
     vkCmdDraw(mRenderData.rdLineCommandBuffer, sphereVertexCount, mCollidingSphereCount, 0, 0);
   }
@@ -7626,20 +8136,20 @@ bool VkRenderer::draw(float deltaTime) {
 
   if (mRenderData.rdDrawIKDebugLines && !mIKFootPointMesh->vertices.empty()) {
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mIKLinesVertexBuffer.buffer, &offset);
+    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mIKLinesVertexBuffer.at(mRenderData.rdCurrentFrame).buffer, &offset);
     vkCmdDraw(mRenderData.rdLineCommandBuffer, static_cast<uint32_t>(mIKFootPointMesh->vertices.size()), 1, 0, 0);
   }
   mRenderData.rdLevelCollisionTime += mLevelCollisionTimer.stop();
 
   if (mRenderData.rdDrawInstancePaths && !mInstancePathMesh->vertices.empty()) {
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mInstancePathVertexBuffer.buffer, &offset);
+    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mInstancePathVertexBuffer.at(mRenderData.rdCurrentFrame).buffer, &offset);
     vkCmdDraw(mRenderData.rdLineCommandBuffer, static_cast<uint32_t>(mInstancePathMesh->vertices.size()), 1, 0, 0);
   }
 
   if (mRenderData.rdDrawNeighborTriangles && !mLevelGroundNeighborsMesh->vertices.empty()) {
     VkDeviceSize offset = 0;
-    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mGroundMeshNeighborVertexBuffer.buffer, &offset);
+    vkCmdBindVertexBuffers(mRenderData.rdLineCommandBuffer, 0, 1, &mGroundMeshNeighborVertexBuffer.at(mRenderData.rdCurrentFrame).buffer, &offset);
     vkCmdDraw(mRenderData.rdLineCommandBuffer, static_cast<uint32_t>(mLevelGroundNeighborsMesh->vertices.size()), 1, 0, 0);
   }
 
@@ -7657,6 +8167,7 @@ bool VkRenderer::draw(float deltaTime) {
   mRenderData.rdLevelGroundNeighborUpdateTime += mLevelGroundNeighborUpdateTimer.stop();
 
   vkCmdEndRenderPass(mRenderData.rdLineCommandBuffer);
+  mGpuTimer.stop(mRenderData, mRenderData.rdLineCommandBuffer, gpuPass::debugLines);
 
   if (!CommandBuffer::end(mRenderData.rdLineCommandBuffer)) {
     Logger::log(1, "%s error: failed to end line drawing command buffer\n", __FUNCTION__);
@@ -7706,6 +8217,7 @@ bool VkRenderer::draw(float deltaTime) {
   rpInfo.renderPass = mRenderData.rdImGuiRenderpass;
   rpInfo.framebuffer = mRenderData.rdFramebuffers.at(imageIndex);
 
+  mGpuTimer.start(mRenderData, mRenderData.rdImGuiCommandBuffer, gpuPass::ui);
   vkCmdBeginRenderPass(mRenderData.rdImGuiCommandBuffer, &rpInfo, VK_SUBPASS_CONTENTS_INLINE);
 
   vkCmdSetViewport(mRenderData.rdImGuiCommandBuffer, 0, 1, &viewport);
@@ -7716,6 +8228,7 @@ bool VkRenderer::draw(float deltaTime) {
   mRenderData.rdUIDrawTime = mUIDrawTimer.stop();
 
   vkCmdEndRenderPass(mRenderData.rdImGuiCommandBuffer);
+  mGpuTimer.stop(mRenderData, mRenderData.rdImGuiCommandBuffer, gpuPass::ui);
 
   if (!CommandBuffer::end(mRenderData.rdImGuiCommandBuffer)) {
     Logger::log(1, "%s error: failed to end ImGui command buffer\n", __FUNCTION__);
@@ -7726,25 +8239,33 @@ bool VkRenderer::draw(float deltaTime) {
   VkSubmitInfo submitInfo{};
   submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-  /* compute shader: contine if vertex input ready
-   * vertex shader: wait for color attachment output ready */
-  //std::vector<VkSemaphore> waitSemaphores = { mRenderData.rdComputeSemaphore, mRenderData.rdPresentSemaphore };
-  //std::vector<VkPipelineStageFlags> waitStages = { VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-
-  std::vector<VkSemaphore> waitSemaphores = { mRenderData.rdPresentSemaphore };
-  std::vector<VkPipelineStageFlags> waitStages = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+  /* compute shader: bone matrices must be ready before the vertex shader reads them
+   * color output: wait until the swapchain image is available */
+  std::vector<VkSemaphore> waitSemaphores = { mRenderData.rdComputeSemaphore, mRenderData.rdPresentSemaphore };
+  std::vector<VkPipelineStageFlags> waitStages = { VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
   submitInfo.pWaitDstStageMask = waitStages.data();
 
   submitInfo.waitSemaphoreCount = static_cast<uint32_t>(waitSemaphores.size());
   submitInfo.pWaitSemaphores = waitSemaphores.data();
 
-  std::vector<VkSemaphore> signalSemaphores = { mRenderData.rdRenderSemaphore, mRenderData.rdGraphicSemaphore };
+  std::vector<VkSemaphore> signalSemaphores = { mRenderData.rdRenderSemaphore };
 
   submitInfo.signalSemaphoreCount = static_cast<uint32_t>(signalSemaphores.size());
   submitInfo.pSignalSemaphores = signalSemaphores.data();
 
-  std::vector<VkCommandBuffer> commandBuffers =
-    { mRenderData.rdCommandBuffer, mRenderData.rdLineCommandBuffer, mRenderData.rdImGuiCommandBuffer };
+  std::vector<VkCommandBuffer> commandBuffers{};
+
+  /* ownership of finished background uploads first */
+  if (uploadsAcquired) {
+    commandBuffers.emplace_back(mRenderData.rdAcquireCommandBuffer);
+  }
+
+  /* all buffer copies of this frame in front of the graphics commands */
+  if (StagingBuffer::recordFrameCopies(mRenderData, mRenderData.rdUploadCommandBuffer)) {
+    commandBuffers.emplace_back(mRenderData.rdUploadCommandBuffer);
+  }
+  commandBuffers.insert(commandBuffers.end(),
+    { mRenderData.rdCommandBuffer, mRenderData.rdLineCommandBuffer, mRenderData.rdImGuiCommandBuffer });
 
   submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
   submitInfo.pCommandBuffers = commandBuffers.data();
@@ -7754,24 +8275,11 @@ bool VkRenderer::draw(float deltaTime) {
     Logger::log(1, "%s error: failed to submit draw command buffer (%i)\n", __FUNCTION__, result);
     return false;
   }
+  mRenderFenceReset = false;
+  mGpuTimer.endFrame();
 
-  /* we must wait for the image to be created before we can pick  */
-  if (mRenderData.rdApplicationMode == appMode::edit) {
-    if (mMousePick) {
-      /* wait for queue to be idle */
-      vkQueueWaitIdle(mRenderData.rdGraphicsQueue);
-
-      float selectedInstanceId = SelectionFramebuffer::getPixelValueFromPos(mRenderData, mMouseXPos, mMouseYPos);
-
-      if (selectedInstanceId >= 0.0f) {
-        mModelInstCamData.micSelectedInstance = static_cast<int>(selectedInstanceId);
-      } else {
-        mModelInstCamData.micSelectedInstance = 0;
-      }
-      mModelInstCamData.micSettingsContainer->applySelectInstance(mModelInstCamData.micSelectedInstance, mSavedSelectedInstanceId);
-      mMousePick = false;
-    }
-  }
+  /* pick has been submitted, the result is applied rdFramesInFlight frames later */
+  mMousePick = false;
 
   /* trigger swapchain image presentation */
   VkPresentInfoKHR presentInfo{};
@@ -7824,23 +8332,39 @@ void VkRenderer::cleanup() {
   mUserInterface.cleanup(mRenderData);
 
   SyncObjects::cleanup(mRenderData);
-  CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandPool, mRenderData.rdCommandBuffer);
-  CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandPool, mRenderData.rdImGuiCommandBuffer);
-  CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandPool, mRenderData.rdLineCommandBuffer);
-  CommandBuffer::cleanup(mRenderData, mRenderData.rdComputeCommandPool, mRenderData.rdComputeCommandBuffer);
+  for (auto& frameData : mRenderData.rdPerFrameData) {
+    CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandPool, frameData.pfCommandBuffer);
+    CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandPool, frameData.pfImGuiCommandBuffer);
+    CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandPool, frameData.pfLineCommandBuffer);
+    CommandBuffer::cleanup(mRenderData, mRenderData.rdComputeCommandPool, frameData.pfComputeCommandBuffer);
+    CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandPool, frameData.pfUploadCommandBuffer);
+    CommandBuffer::cleanup(mRenderData, mRenderData.rdCommandPool, frameData.pfAcquireCommandBuffer);
+
+    /* destroying the pool frees the secondary buffers too */
+    for (auto& pool : frameData.pfRecordCommandPools) {
+      CommandPool::cleanup(mRenderData, pool);
+    }
+  }
   CommandPool::cleanup(mRenderData, mRenderData.rdCommandPool);
   CommandPool::cleanup(mRenderData, mRenderData.rdComputeCommandPool);
 
-  VertexBuffer::cleanup(mRenderData, mLineVertexBuffer);
-  VertexBuffer::cleanup(mRenderData, mSphereVertexBuffer);
+  for (unsigned int i = 0; i < mRenderData.rdFramesInFlight; ++i) {
+    VertexBuffer::cleanup(mRenderData, mLineVertexBuffer.at(i));
+    VertexBuffer::cleanup(mRenderData, mSphereVertexBuffer.at(i));
+    VertexBuffer::cleanup(mRenderData, mIKLinesVertexBuffer.at(i));
+    VertexBuffer::cleanup(mRenderData, mGroundMeshNeighborVertexBuffer.at(i));
+    VertexBuffer::cleanup(mRenderData, mInstancePathVertexBuffer.at(i));
+  }
   VertexBuffer::cleanup(mRenderData, mLevelAABBVertexBuffer);
   VertexBuffer::cleanup(mRenderData, mLevelOctreeVertexBuffer);
   VertexBuffer::cleanup(mRenderData, mLevelWireframeVertexBuffer);
-  VertexBuffer::cleanup(mRenderData, mIKLinesVertexBuffer);
   VertexBuffer::cleanup(mRenderData, mGroundMeshVertexBuffer);
-  VertexBuffer::cleanup(mRenderData, mGroundMeshNeighborVertexBuffer);
-  VertexBuffer::cleanup(mRenderData, mInstancePathVertexBuffer);
   VertexBuffer::cleanup(mRenderData, mSkyboxBuffer);
+  StagingBuffer::cleanup(mRenderData);
+  UploadManager::cleanup(mRenderData);
+  DescriptorCache::cleanup(mRenderData);
+  SelectionFramebuffer::cleanupReadbackBuffers(mRenderData);
+  mGpuTimer.cleanup(mRenderData);
 
   Framebuffer::cleanup(mRenderData);
   SelectionFramebuffer::cleanup(mRenderData);
@@ -7862,6 +8386,10 @@ void VkRenderer::cleanup() {
   ComputePipeline::cleanup(mRenderData, mRenderData.rdAssimpComputeMatrixMultPipeline);
   ComputePipeline::cleanup(mRenderData, mRenderData.rdAssimpComputeBoundingSpheresPipeline);
 
+  /* store the cache for the next start */
+  PipelineCache::save(mRenderData, mPipelineCacheFileName);
+  PipelineCache::cleanup(mRenderData);
+
   PipelineLayout::cleanup(mRenderData, mRenderData.rdAssimpPipelineLayout);
   PipelineLayout::cleanup(mRenderData, mRenderData.rdAssimpSkinningPipelineLayout);
   PipelineLayout::cleanup(mRenderData, mRenderData.rdAssimpComputeTransformaPipelineLayout);
@@ -7883,62 +8411,68 @@ void VkRenderer::cleanup() {
   SecondaryRenderpass::cleanup(mRenderData, mRenderData.rdLineRenderpass);
   SelectionRenderpass::cleanup(mRenderData);
 
-  UniformBuffer::cleanup(mRenderData, mPerspectiveViewMatrixUBO);
-  ShaderStorageBuffer::cleanup(mRenderData, mShaderTRSMatrixBuffer);
-  ShaderStorageBuffer::cleanup(mRenderData, mPerInstanceAnimDataBuffer);
-  ShaderStorageBuffer::cleanup(mRenderData, mShaderModelRootMatrixBuffer);
-  ShaderStorageBuffer::cleanup(mRenderData, mShaderBoneMatrixBuffer);
-  ShaderStorageBuffer::cleanup(mRenderData, mSelectedInstanceBuffer);
-  ShaderStorageBuffer::cleanup(mRenderData, mBoundingSphereBuffer);
+  for (unsigned int i = 0; i < mRenderData.rdFramesInFlight; ++i) {
+    UniformBuffer::cleanup(mRenderData, mPerspectiveViewMatrixUBO.at(i));
+    ShaderStorageBuffer::cleanup(mRenderData, mShaderTRSMatrixBuffer.at(i));
+    ShaderStorageBuffer::cleanup(mRenderData, mPerInstanceAnimDataBuffer.at(i));
+    ShaderStorageBuffer::cleanup(mRenderData, mShaderModelRootMatrixBuffer.at(i));
+    ShaderStorageBuffer::cleanup(mRenderData, mShaderBoneMatrixBuffer.at(i));
+    ShaderStorageBuffer::cleanup(mRenderData, mSelectedInstanceBuffer.at(i));
+    ShaderStorageBuffer::cleanup(mRenderData, mFaceAnimPerInstanceDataBuffer.at(i));
+    ShaderStorageBuffer::cleanup(mRenderData, mShaderLevelRootMatrixBuffer.at(i));
+    ShaderStorageBuffer::cleanup(mRenderData, mBoundingSphereBuffer.at(i));
+  }
   ShaderStorageBuffer::cleanup(mRenderData, mSphereModelRootMatrixBuffer);
   ShaderStorageBuffer::cleanup(mRenderData, mSpherePerInstanceAnimDataBuffer);
   ShaderStorageBuffer::cleanup(mRenderData, mSphereTRSMatrixBuffer);
   ShaderStorageBuffer::cleanup(mRenderData, mSphereBoneMatrixBuffer);
-  ShaderStorageBuffer::cleanup(mRenderData, mFaceAnimPerInstanceDataBuffer);
-  ShaderStorageBuffer::cleanup(mRenderData, mShaderLevelRootMatrixBuffer);
   ShaderStorageBuffer::cleanup(mRenderData, mIKBoneMatrixBuffer);
   ShaderStorageBuffer::cleanup(mRenderData, mIKTRSMatrixBuffer);
+  ShaderStorageBuffer::destroyPendingBuffers(mRenderData, true);
 
   Texture::cleanup(mRenderData, mSkyboxTexture);
 
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpSkinningDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpComputeTransformDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpComputeMatrixMultDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpSelectionDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpSkinningSelectionDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpSkinningMorphDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpSkinningMorphSelectionDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpLevelDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdLineDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdSphereDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdGroundMeshDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdSkyboxDescriptorSet);
+  for (auto& frameData : mRenderData.rdPerFrameData) {
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpSkinningDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpComputeTransformDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpComputeMatrixMultDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpSelectionDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpSkinningSelectionDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpSkinningMorphDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpSkinningMorphSelectionDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpComputeBoundingSpheresDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfAssimpLevelDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfLineDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfSphereDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfGroundMeshDescriptorSet);
+    vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
+      &frameData.pfSkyboxDescriptorSet);
+  }
   vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
     &mRenderData.rdAssimpComputeSphereTransformDescriptorSet);
   vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
     &mRenderData.rdAssimpComputeSphereMatrixMultDescriptorSet);
   vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
     &mRenderData.rdAssimpComputeIKDescriptorSet);
-  vkFreeDescriptorSets(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, 1,
-    &mRenderData.rdAssimpComputeBoundingSpheresDescriptorSet);
 
   vkDestroyDescriptorSetLayout(mRenderData.rdVkbDevice.device, mRenderData.rdAssimpDescriptorLayout, nullptr);
   vkDestroyDescriptorSetLayout(mRenderData.rdVkbDevice.device, mRenderData.rdAssimpSkinningDescriptorLayout, nullptr);
   vkDestroyDescriptorSetLayout(mRenderData.rdVkbDevice.device, mRenderData.rdAssimpTextureDescriptorLayout, nullptr);
+  vkDestroyDescriptorSetLayout(mRenderData.rdVkbDevice.device, mRenderData.rdGlobalTextureDescriptorLayout, nullptr);
   vkDestroyDescriptorSetLayout(mRenderData.rdVkbDevice.device, mRenderData.rdAssimpComputeTransformDescriptorLayout, nullptr);
   vkDestroyDescriptorSetLayout(mRenderData.rdVkbDevice.device, mRenderData.rdAssimpComputeTransformPerModelDescriptorLayout, nullptr);
   vkDestroyDescriptorSetLayout(mRenderData.rdVkbDevice.device, mRenderData.rdAssimpComputeMatrixMultDescriptorLayout, nullptr);
@@ -7957,6 +8491,8 @@ void VkRenderer::cleanup() {
   vkDestroyDescriptorSetLayout(mRenderData.rdVkbDevice.device, mRenderData.rdSkyboxDescriptorLayout, nullptr);
 
   vkDestroyDescriptorPool(mRenderData.rdVkbDevice.device, mRenderData.rdDescriptorPool, nullptr);
+  /* frees the global texture set too */
+  vkDestroyDescriptorPool(mRenderData.rdVkbDevice.device, mRenderData.rdGlobalTextureDescriptorPool, nullptr);
 
   vkDestroyImageView(mRenderData.rdVkbDevice.device, mRenderData.rdDepthImageView, nullptr);
   vmaDestroyImage(mRenderData.rdAllocator, mRenderData.rdDepthImage, mRenderData.rdDepthImageAlloc);
@@ -19,6 +19,8 @@
 #include <vk_mem_alloc.h>
 
 #include "Timer.h"
+#include "GpuTimer.h"
+#include "ThreadPool.h"
 #include "Texture.h"
 #include "UniformBuffer.h"
 #include "UserInterface.h"
@@ -53,7 +55,8 @@ class VkRenderer {
   public:
     VkRenderer(GLFWwindow *window);
 
-    bool init(unsigned int width, unsigned int height);
+    /* framesInFlight is clamped to 2 or 3 */
+    bool init(unsigned int width, unsigned int height, unsigned int framesInFlight = 2);
     void setSize(unsigned int width, unsigned int height);
 
     bool draw(float deltaTime);
@@ -127,34 +130,57 @@ class VkRenderer {
     Timer mIKTimer{};
     Timer mLevelGroundNeighborUpdateTimer{};
     Timer mPathFindingTimer{};
+    Timer mPipelineCreateTimer{};
+    Timer mCommandRecordTimer{};
+
+    /* timestamps of the render passes and compute dispatches */
+    GpuTimer mGpuTimer{};
+
+    /* workers recording the secondary command buffers, at most mMaxRecordJobs are used */
+    ThreadPool mRecordThreadPool{};
+    const unsigned int mMaxRecordJobs = 8;
+
+    /* collected on the main thread, read by the recording jobs */
+    struct LevelDrawEntry {
+      std::shared_ptr<AssimpLevel> level;
+      uint32_t levelPosOffset;
+    };
+    struct ModelDrawEntry {
+      std::shared_ptr<AssimpModel> model;
+      uint32_t numberOfInstances;
+      uint32_t worldPosOffset;
+      uint32_t skinMatOffset;
+    };
+    std::vector<LevelDrawEntry> mLevelDrawEntries{};
+    std::vector<ModelDrawEntry> mModelDrawEntries{};
 
     UserInterface mUserInterface{};
 
-    VkPushConstants mModelData{};
     VkComputePushConstants mComputeModelData{};
-    VkUniformBufferData mPerspectiveViewMatrixUBO{};
-    VkVertexBufferData mLineVertexBuffer{};
-    VkVertexBufferData mSphereVertexBuffer{};
+    /* buffers written by the CPU every frame exist once per frame in flight */
+    std::vector<VkUniformBufferData> mPerspectiveViewMatrixUBO{};
+    std::vector<VkVertexBufferData> mLineVertexBuffer{};
+    std::vector<VkVertexBufferData> mSphereVertexBuffer{};
     VkVertexBufferData mLevelAABBVertexBuffer{};
     VkVertexBufferData mLevelOctreeVertexBuffer{};
     VkVertexBufferData mLevelWireframeVertexBuffer{};
-    VkVertexBufferData mIKLinesVertexBuffer{};
+    std::vector<VkVertexBufferData> mIKLinesVertexBuffer{};
     VkVertexBufferData mGroundMeshVertexBuffer{};
-    VkVertexBufferData mGroundMeshNeighborVertexBuffer{};
-    VkVertexBufferData mInstancePathVertexBuffer{};
+    std::vector<VkVertexBufferData> mGroundMeshNeighborVertexBuffer{};
+    std::vector<VkVertexBufferData> mInstancePathVertexBuffer{};
 
     /* for animated and non-animated models */
-    VkShaderStorageBufferData mShaderModelRootMatrixBuffer{};
+    std::vector<VkShaderStorageBufferData> mShaderModelRootMatrixBuffer{};
     std::vector<glm::mat4> mWorldPosMatrices{};
 
     /* color hightlight for selection etc */
     std::vector<glm::vec2> mSelectedInstance{};
-    VkShaderStorageBufferData mSelectedInstanceBuffer{};
+    std::vector<VkShaderStorageBufferData> mSelectedInstanceBuffer{};
 
     /* for animated models */
-    VkShaderStorageBufferData mShaderBoneMatrixBuffer{};
+    std::vector<VkShaderStorageBufferData> mShaderBoneMatrixBuffer{};
     std::vector<PerInstanceAnimData> mPerInstanceAnimData{};
-    VkShaderStorageBufferData mPerInstanceAnimDataBuffer{};
+    std::vector<VkShaderStorageBufferData> mPerInstanceAnimDataBuffer{};
     std::vector<glm::mat4> mShaderBoneMatrices{};
 
     std::vector<AABB> mPerInstanceAABB{};
@@ -162,7 +188,7 @@ class VkRenderer {
 
     /* for compute shader */
     bool mHasDedicatedComputeQueue = false;
-    VkShaderStorageBufferData mShaderTRSMatrixBuffer{};
+    std::vector<VkShaderStorageBufferData> mShaderTRSMatrixBuffer{};
 
     /* bounding sphere compute shader */
     VkShaderStorageBufferData mSphereModelRootMatrixBuffer{};
@@ -172,8 +198,8 @@ class VkRenderer {
     VkShaderStorageBufferData mSphereTRSMatrixBuffer{};
     VkShaderStorageBufferData mSphereBoneMatrixBuffer{};
 
-    /* x/y/z is shpere center, w is radius */
-    VkShaderStorageBufferData mBoundingSphereBuffer{};
+    /* x/y/z is shpere center, w is radius, per frame as the line pass draws the spheres */
+    std::vector<VkShaderStorageBufferData> mBoundingSphereBuffer{};
 
     CoordArrowsModel mCoordArrowsModel{};
     RotationArrowsModel mRotationArrowsModel{};
@@ -202,6 +228,9 @@ class VkRenderer {
     bool mMousePick = false;
     int mSavedSelectedInstanceId = 0;
 
+    /* the render fence of the current frame has been reset, but not submitted yet */
+    bool mRenderFenceReset = false;
+
     bool mMouseMove = false;
     bool mMouseMoveVertical = false;
     int mMouseMoveVerticalShiftKey = 0;
@@ -231,6 +260,7 @@ class VkRenderer {
     void clearUndoRedoStacks();
 
     const std::string mDefaultConfigFileName = "config/conf.acfg";
+    const std::string mPipelineCacheFileName = "config/pipeline.cache";
     bool loadConfigFile(std::string configFileName);
     bool saveConfigFile(std::string configFileName);
     void createEmptyConfig();
@@ -281,9 +311,9 @@ class VkRenderer {
     instanceNodeActionCallback mInstanceNodeActionCallbackFunction;
 
     std::vector<glm::vec4> mFaceAnimPerInstanceData{};
-    VkShaderStorageBufferData mFaceAnimPerInstanceDataBuffer{};
+    std::vector<VkShaderStorageBufferData> mFaceAnimPerInstanceDataBuffer{};
 
-    VkShaderStorageBufferData mShaderLevelRootMatrixBuffer{};
+    std::vector<VkShaderStorageBufferData> mShaderLevelRootMatrixBuffer{};
     std::vector<glm::mat4> mLevelWorldPosMatrices{};
 
     void generateLevelVertexData();
@@ -356,6 +386,7 @@ class VkRenderer {
     bool createCommandPools();
     bool createCommandBuffers();
     bool createSyncObjects();
+    void selectFrame(unsigned int frame);
 
     bool initUserInterface();
 
@@ -374,5 +405,9 @@ class VkRenderer {
       uint32_t modelOffset);
 
     bool runIKComputeShaders(std::shared_ptr<AssimpModel> model, int numInstances, uint32_t modelOffset);
+    bool waitForComputeFence();
+    bool waitForRenderFences();
+    bool recordSecondaryCommands(unsigned int job, const VkRenderPassBeginInfo& levelPassInfo,
+      const VkRenderPassBeginInfo& modelPassInfo, const VkViewport& viewport, const VkRect2D& scissor);
 
 };
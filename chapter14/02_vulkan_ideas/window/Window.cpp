@@ -2,7 +2,7 @@
 #include "Logger.h"
 #include "ModelInstanceCamData.h"
 
-bool Window::init(unsigned int width, unsigned int height, std::string title) {
+bool Window::init(unsigned int width, unsigned int height, std::string title, unsigned int framesInFlight) {
   if (!glfwInit()) {
     Logger::log(1, "%s: glfwInit() error\n", __FUNCTION__);
     return false;
@@ -70,7 +70,7 @@ bool Window::init(unsigned int width, unsigned int height, std::string title) {
     }
   );
 
-  if (!mRenderer->init(width, height)) {
+  if (!mRenderer->init(width, height, framesInFlight)) {
     glfwTerminate();
     Logger::log(1, "%s error: Could not init Vulkan\n", __FUNCTION__);
     return false;
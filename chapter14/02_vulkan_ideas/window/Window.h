@@ -10,7 +10,7 @@
 
 class Window {
   public:
-    bool init(unsigned int width, unsigned int height, std::string title);
+    bool init(unsigned int width, unsigned int height, std::string title, unsigned int framesInFlight = 2);
     void mainLoop();
     void cleanup();
 